@@ -0,0 +1,1437 @@
+//=======================================================================
+/** Benchmarks.cpp
+ * Offline throughput benchmarks for the portable audio code
+ */
+//=======================================================================
+
+#include "Benchmarks.h"
+
+#include "SoundInterface/CommandQueue.h"
+#include "SoundInterface/DeviceRegistry.h"
+#include "SoundInterface/GainCurves.h"
+#include "SoundInterface/LatencyStats.h"
+#include "SoundInterface/Backend/SoftwareBackend.h"
+#include "SoundInterface/Dsp/Ambisonics.h"
+#include "SoundInterface/Dsp/ConvolutionReverb.h"
+#include "SoundInterface/Dsp/Ducking.h"
+#include "SoundInterface/Dsp/EarlyReflections.h"
+#include "SoundInterface/Dsp/Limiter.h"
+#include "SoundInterface/Dsp/MixKernels.h"
+#include "SoundInterface/Dsp/Resampler.h"
+#include "Cooldowns.h"
+#include "StatEvents.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::uint32_t BENCH_SAMPLE_RATE = 48000;
+    constexpr std::uint32_t BENCH_BLOCK_SIZE  = 480; // 10 ms, like XAudio2's quantum
+    constexpr float         BENCH_SECONDS     = 20.0f;
+
+    template <typename... Args>
+    std::string Format(const char* format, Args... args)
+    {
+        char buffer[256];
+        std::snprintf(buffer, sizeof(buffer), format, args...);
+        return buffer;
+    }
+
+    Benchmarks::Report RunConvolution()
+    {
+        using namespace SoundInterface::Dsp;
+
+        constexpr std::uint32_t channels = 2;
+        const auto              blocks   = static_cast<std::uint32_t>(BENCH_SECONDS * BENCH_SAMPLE_RATE / BENCH_BLOCK_SIZE);
+
+        std::mt19937                          random(42);
+        std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+
+        std::vector<float> block(static_cast<std::size_t>(BENCH_BLOCK_SIZE) * channels);
+
+        Benchmarks::Report report;
+        report.Lines.push_back(Format(
+            "Stereo, %u Hz, %u-frame blocks, %.0f s of audio per IR",
+            BENCH_SAMPLE_RATE, BENCH_BLOCK_SIZE, BENCH_SECONDS));
+        report.Lines.emplace_back(
+            "Blocks arrive faster than real time here, so the worst case includes waiting for the tail worker");
+
+        for (const float irSeconds : {0.25f, 0.5f, 1.0f, 2.0f, 4.0f, 8.0f})
+        {
+            // Exponentially decaying noise, like a real room
+            ImpulseResponse ir;
+            ir.SampleRate = BENCH_SAMPLE_RATE;
+            ir.Channels.resize(channels);
+
+            const auto length = static_cast<std::size_t>(irSeconds * BENCH_SAMPLE_RATE);
+            for (auto& channel : ir.Channels)
+            {
+                channel.resize(length);
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    channel[i] = noise(random) * std::exp(-6.9f * static_cast<float>(i) / static_cast<float>(length));
+                }
+            }
+
+            ConvolutionReverb reverb;
+            reverb.Prepare(BENCH_SAMPLE_RATE, channels, BENCH_BLOCK_SIZE);
+            reverb.SetImpulseResponse(ir);
+
+            double worst = 0.0;
+            const auto start = Clock::now();
+            for (std::uint32_t b = 0; b < blocks; ++b)
+            {
+                for (float& sample : block) sample = noise(random);
+
+                const auto blockStart = Clock::now();
+                reverb.Process(block.data(), block.data(), BENCH_BLOCK_SIZE);
+                worst = std::max(worst, std::chrono::duration<double, std::micro>(Clock::now() - blockStart).count());
+            }
+            const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+            report.Lines.push_back(Format(
+                "IR %5.2f s: %7.1fx realtime, %6.1f us per block on average, %7.1f us worst",
+                irSeconds,
+                BENCH_SECONDS / elapsed,
+                elapsed * 1e6 / blocks,
+                worst));
+        }
+
+        return report;
+    }
+
+    Benchmarks::Report RunMixKernels()
+    {
+        using namespace SoundInterface::Dsp;
+
+        constexpr std::uint32_t frames     = 512;
+        constexpr std::uint32_t iterations = 20000;
+        constexpr double        blockTime  = static_cast<double>(frames) / BENCH_SAMPLE_RATE;
+
+        std::mt19937                          random(3);
+        std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+
+        std::vector<float> input(frames);
+        for (float& sample : input) sample = noise(random);
+
+        const SimdLevel supported = GetSupportedSimdLevel();
+
+        Benchmarks::Report report;
+        report.Lines.push_back(Format(
+            "One mono voice per kernel call, %u-frame blocks at %u Hz, gains ramping every block; this CPU runs %s",
+            frames, BENCH_SAMPLE_RATE, GetSimdLevelLabel(supported).c_str()));
+
+        for (const std::uint32_t channels : {2u, 6u, 8u, 16u})
+        {
+            // Two gain sets to ramp back and forth between
+            std::vector<float> gainsA(channels);
+            std::vector<float> gainsB(channels);
+            for (std::uint32_t c = 0; c < channels; ++c)
+            {
+                gainsA[c] = 0.5f + 0.5f * noise(random);
+                gainsB[c] = 0.5f + 0.5f * noise(random);
+            }
+
+            std::vector<float> reference(static_cast<std::size_t>(frames) * channels, 0.0f);
+            GetMixKernel(channels, SimdLevel::Scalar)(input.data(), reference.data(), channels, frames, gainsA.data(), gainsB.data());
+
+            std::vector<float> output(reference.size());
+
+            double scalarTime = 0.0;
+            for (std::uint8_t l = 0; l <= static_cast<std::uint8_t>(supported); ++l)
+            {
+                const auto      level  = static_cast<SimdLevel>(l);
+                const MixKernel kernel = GetMixKernel(channels, level);
+
+                // Check against the scalar kernel before timing
+                std::fill(output.begin(), output.end(), 0.0f);
+                kernel(input.data(), output.data(), channels, frames, gainsA.data(), gainsB.data());
+
+                float deviation = 0.0f;
+                for (std::size_t i = 0; i < output.size(); ++i)
+                {
+                    deviation = std::max(deviation, std::abs(output[i] - reference[i]));
+                }
+
+                const auto start = Clock::now();
+                for (std::uint32_t i = 0; i < iterations; ++i)
+                {
+                    const bool forward = (i & 1) == 0;
+                    kernel(
+                        input.data(), output.data(), channels, frames,
+                        forward ? gainsA.data() : gainsB.data(),
+                        forward ? gainsB.data() : gainsA.data());
+                }
+                const double perVoice = std::chrono::duration<double>(Clock::now() - start).count() / iterations;
+                if (level == SimdLevel::Scalar) scalarTime = perVoice;
+
+                report.Lines.push_back(Format(
+                    "%2u channels, %-7s: %8.0f voices per core, %6.3f us per voice block, %4.1fx scalar, max deviation %.1e",
+                    channels,
+                    GetSimdLevelLabel(level).c_str(),
+                    blockTime / perVoice,
+                    perVoice * 1e6,
+                    scalarTime / perVoice,
+                    static_cast<double>(deviation)));
+            }
+        }
+
+        return report;
+    }
+
+    Benchmarks::Report RunResampler()
+    {
+        using namespace SoundInterface::Dsp;
+
+        constexpr std::uint32_t frames     = 512;
+        constexpr std::uint32_t iterations = 20000;
+        constexpr double        blockTime  = static_cast<double>(frames) / BENCH_SAMPLE_RATE;
+
+        std::mt19937                          random(4);
+        std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+
+        // A second of mono sound, long enough that a block never runs off its end
+        std::vector<float> input(BENCH_SAMPLE_RATE * 2);
+        for (float& sample : input) sample = noise(random);
+
+        // Nothing is wider than AVX2 yet
+        const SimdLevel vectorized = std::min(GetSupportedSimdLevel(), SimdLevel::Avx2);
+
+        Benchmarks::Report report;
+        report.Lines.push_back(Format(
+            "One mono voice per call, %u-frame blocks read from a shared buffer; the vectorized kernel here is %s",
+            frames, GetSimdLevelLabel(vectorized).c_str()));
+
+        // A semitone down, a few cents off, and most of an octave up
+        for (const double step : {0.9439, 1.0058, 1.7818})
+        {
+            std::vector<float> reference(frames);
+            double             referencePosition = 0.0;
+            GetResampleKernel(SimdLevel::Scalar)(input.data(), static_cast<std::uint32_t>(input.size()), 1, referencePosition, step, reference.data(), frames);
+
+            std::vector<float> output(frames);
+
+            double scalarTime = 0.0;
+            for (const SimdLevel level : {SimdLevel::Scalar, vectorized})
+            {
+                const ResampleKernel kernel = GetResampleKernel(level);
+
+                double position = 0.0;
+                kernel(input.data(), static_cast<std::uint32_t>(input.size()), 1, position, step, output.data(), frames);
+
+                float deviation = 0.0f;
+                for (std::uint32_t i = 0; i < frames; ++i)
+                {
+                    deviation = std::max(deviation, std::abs(output[i] - reference[i]));
+                }
+
+                const auto start = Clock::now();
+                for (std::uint32_t i = 0; i < iterations; ++i)
+                {
+                    position = static_cast<double>(i % 64);
+                    kernel(input.data(), static_cast<std::uint32_t>(input.size()), 1, position, step, output.data(), frames);
+                }
+                const double perVoice = std::chrono::duration<double>(Clock::now() - start).count() / iterations;
+                if (level == SimdLevel::Scalar) scalarTime = perVoice;
+
+                report.Lines.push_back(Format(
+                    "step %.4f, %-7s: %8.0f voices per core, %6.3f us per voice block, %4.1fx scalar, max deviation %.1e",
+                    step,
+                    GetSimdLevelLabel(level).c_str(),
+                    blockTime / perVoice,
+                    perVoice * 1e6,
+                    scalarTime / perVoice,
+                    static_cast<double>(deviation)));
+
+                if (level == vectorized) break;
+            }
+        }
+
+        return report;
+    }
+
+    // Peak of one channel on a 16x oversampled copy, with a much longer filter than the limiter's
+    float MeasureTruePeak(const float* samples, const std::uint32_t channels, const std::uint32_t channel, const std::size_t frames)
+    {
+        constexpr int    phases = 16;
+        constexpr int    taps   = 32;
+        constexpr double pi     = 3.14159265358979323846;
+
+        std::vector<float> coefficients(static_cast<std::size_t>(phases) * taps);
+        for (int m = 0; m < phases * taps; ++m)
+        {
+            const double x      = (m - phases * taps / 2.0) / phases;
+            const double sinc   = x == 0.0 ? 1.0 : std::sin(pi * x) / (pi * x);
+            const double window = 0.42 - 0.5 * std::cos(2.0 * pi * m / (phases * taps)) + 0.08 * std::cos(4.0 * pi * m / (phases * taps));
+            coefficients[m]     = static_cast<float>(sinc * window);
+        }
+
+        float peak = 0.0f;
+        for (std::size_t f = taps; f < frames; ++f)
+        {
+            for (int k = 0; k < phases; ++k)
+            {
+                float sum = 0.0f;
+                for (int j = 0; j < taps; ++j)
+                {
+                    sum += coefficients[static_cast<std::size_t>(j) * phases + k] * samples[(f - j) * channels + channel];
+                }
+                peak = std::max(peak, std::abs(sum));
+            }
+        }
+        return peak;
+    }
+
+    Benchmarks::Report RunLimiter()
+    {
+        using namespace SoundInterface::Dsp;
+
+        constexpr std::uint32_t channels = 2;
+        constexpr float         ceiling  = -1.0f;
+        const auto              blocks   = static_cast<std::uint32_t>(BENCH_SECONDS * BENCH_SAMPLE_RATE / BENCH_BLOCK_SIZE);
+        const std::size_t       frames   = static_cast<std::size_t>(blocks) * BENCH_BLOCK_SIZE;
+
+        std::mt19937                          random(11);
+        std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+
+        /*
+         * A quarter-second of something loud at a time: sines with their
+         * peaks between samples, square-ish bursts and decaying noise, up
+         * to 10x full scale like a 500% sound doubled by PlaySound. The
+         * noise is low-passed like anything decoded from a file would be.
+         */
+        std::vector<float> input(frames * channels);
+        const std::size_t  segment = BENCH_SAMPLE_RATE / 4;
+        float              lowpass[2] = {0.0f, 0.0f};
+        for (std::size_t start = 0; start < frames; start += segment)
+        {
+            const float amplitude = 0.2f + 9.8f * uniform(random) * uniform(random);
+            const int   shape     = static_cast<int>(uniform(random) * 3.0f);
+            const float frequency = shape == 0 ? BENCH_SAMPLE_RATE / 4.0f : 50.0f + 8000.0f * uniform(random);
+
+            for (std::size_t f = start; f < std::min(start + segment, frames); ++f)
+            {
+                const float t     = static_cast<float>(f - start) / BENCH_SAMPLE_RATE;
+                const float phase = 6.2831853f * frequency * t + 0.7853982f;
+
+                float sample;
+                switch (shape)
+                {
+                case 0:
+                    sample = std::sin(phase);
+                    break;
+                case 1:
+                    sample = std::tanh(4.0f * std::sin(phase));
+                    break;
+                default:
+                    lowpass[0] += 0.5f * (2.0f * uniform(random) - 1.0f - lowpass[0]);
+                    lowpass[1] += 0.5f * (lowpass[0] - lowpass[1]);
+                    sample = 3.0f * lowpass[1] * std::exp(-20.0f * t);
+                    break;
+                }
+
+                for (std::uint32_t c = 0; c < channels; ++c)
+                {
+                    input[f * channels + c] = amplitude * sample * (c == 0 ? 1.0f : 0.8f);
+                }
+            }
+        }
+
+        Limiter limiter;
+        limiter.SetParams({true, ceiling, 80.0f});
+        limiter.Prepare(BENCH_SAMPLE_RATE, channels, BENCH_BLOCK_SIZE);
+
+        std::vector<float> output(input.size());
+
+        double     worst = 0.0;
+        float      deepest = 0.0f;
+        const auto start = Clock::now();
+        for (std::uint32_t b = 0; b < blocks; ++b)
+        {
+            const std::size_t offset = static_cast<std::size_t>(b) * BENCH_BLOCK_SIZE * channels;
+
+            const auto blockStart = Clock::now();
+            limiter.Process(input.data() + offset, output.data() + offset, BENCH_BLOCK_SIZE);
+            worst   = std::max(worst, std::chrono::duration<double, std::micro>(Clock::now() - blockStart).count());
+            deepest = std::max(deepest, limiter.GetGainReduction());
+        }
+        const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        float inputPeak  = 0.0f;
+        float outputPeak = 0.0f;
+        for (std::uint32_t c = 0; c < channels; ++c)
+        {
+            inputPeak  = std::max(inputPeak, MeasureTruePeak(input.data(), channels, c, frames));
+            outputPeak = std::max(outputPeak, MeasureTruePeak(output.data(), channels, c, frames));
+        }
+
+        Benchmarks::Report report;
+        report.Lines.push_back(Format(
+            "Stereo, %u Hz, %u-frame blocks, %.0f s of material far over full scale; %ux oversampled detection, %.0f ms lookahead",
+            BENCH_SAMPLE_RATE, BENCH_BLOCK_SIZE, BENCH_SECONDS, TRUE_PEAK_OVERSAMPLING, LIMITER_LOOKAHEAD));
+        report.Lines.push_back(Format(
+            "%7.1fx realtime, %.2f%% of a core, %5.2f us per block on average, %6.2f us worst",
+            BENCH_SECONDS / elapsed,
+            100.0 * elapsed / BENCH_SECONDS,
+            elapsed * 1e6 / blocks,
+            worst));
+        report.Lines.push_back(Format(
+            "Latency %u frames (%.2f ms); deepest reduction %.1f dB, of which %.2f dB is headroom for the detector",
+            limiter.GetLatency(),
+            1000.0 * limiter.GetLatency() / BENCH_SAMPLE_RATE,
+            static_cast<double>(deepest),
+            static_cast<double>(limiter.GetHeadroom())));
+        report.IsPassing = 20.0 * std::log10(outputPeak) <= ceiling;
+        report.Lines.push_back(Format(
+            "True peak in %+.2f dBTP, out %+.2f dBTP against a %+.2f dBTP ceiling; %s",
+            20.0 * std::log10(inputPeak),
+            20.0 * std::log10(outputPeak),
+            static_cast<double>(ceiling),
+            report.IsPassing ? "held" : "OVER THE CEILING"));
+
+        return report;
+    }
+
+    /*
+     * The plugin's play path on the software backend: pooled mono voices
+     * at the file's own rate, each sending to the master, reflections,
+     * convolution and ambisonic buses, and re-spatialized every block
+     * the way Update3D does it.
+     */
+    class PlayPathRig
+    {
+    public:
+        using Engine = SoundInterface::Backend::SoftwareEngine;
+
+        struct PooledVoice final : SoundInterface::Backend::VoiceCallback
+        {
+            void OnBufferStart() override
+            {
+                const auto queued = this->Queued.exchange(Clock::time_point::rep{0});
+                if (queued != 0) this->Rig->RecordLatency(Clock::now() - Clock::time_point(Clock::duration(queued)));
+            }
+
+            void OnStreamEnd() override
+            {
+                this->Active = false;
+            }
+
+            PlayPathRig*                        Rig    = nullptr;
+            SoundInterface::Backend::Voice*     Handle = nullptr;
+            std::atomic<bool>                   Active = false;
+            std::atomic<Clock::time_point::rep> Queued = 0; // When the game side started it
+            float                               Angle  = 0.0f;
+        };
+
+        explicit PlayPathRig(const std::uint32_t voices)
+        {
+            using namespace SoundInterface;
+
+            Backend::DeviceFormat format;
+            format.SampleRate = BENCH_SAMPLE_RATE;
+
+            this->Mixer = std::make_unique<Engine>(format, std::make_unique<Backend::NullSink>());
+            this->Mixer->SetMasterEffect(std::make_shared<Dsp::Limiter>());
+
+            std::mt19937                          random(7);
+            std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+
+            // A short decaying burst at 44.1 kHz, so every voice resamples
+            this->Clip.resize(CLIP_FRAMES);
+            for (std::size_t i = 0; i < this->Clip.size(); ++i)
+            {
+                this->Clip[i] = 0.5f * noise(random) * std::exp(-5.0f * static_cast<float>(i) / CLIP_FRAMES);
+            }
+
+            const Dsp::SpeakerLayout layout = Dsp::MakeSpeakerLayout(format.ChannelMask, format.Channels);
+
+            auto reflections = std::make_shared<Dsp::EarlyReflections>();
+            {
+                Dsp::ImageSourceModel model;
+                model.SetRoom({{-40.0f, 0.0f, -50.0f}, {40.0f, 20.0f, 50.0f}});
+                model.SetLayout(layout);
+
+                const Dsp::Vec3     emitters[] = {{5.0f, 1.0f, 10.0f}, {-12.0f, 3.0f, -4.0f}};
+                const Dsp::Listener listener   = {{0.0f, 2.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f, 0.0f}};
+
+                Dsp::ReflectionTaps taps;
+                model.Compute(emitters, 2, listener, true, taps);
+                reflections->SetTaps(taps);
+            }
+
+            auto convolution = std::make_shared<Dsp::ConvolutionReverb>();
+            {
+                Dsp::ImpulseResponse ir;
+                ir.SampleRate = BENCH_SAMPLE_RATE;
+                ir.Channels.assign(2, std::vector<float>(BENCH_SAMPLE_RATE));
+                for (auto& channel : ir.Channels)
+                {
+                    for (std::size_t i = 0; i < channel.size(); ++i)
+                    {
+                        channel[i] = noise(random) * std::exp(-6.9f * static_cast<float>(i) / static_cast<float>(channel.size()));
+                    }
+                }
+                convolution->SetImpulseResponse(ir);
+            }
+
+            auto decoder = std::make_shared<Dsp::AmbisonicDecoder>(layout);
+            decoder->SetParams({Dsp::MAX_AMBISONIC_ORDER, false});
+
+            // Impacts go through their category bus, ducked by the (idle) match results bus
+            const auto sidechain = std::make_shared<Dsp::Sidechain>();
+            this->Mixer->CreateBus(format.Channels, format.Channels, std::make_shared<Dsp::SidechainKey>(sidechain), &this->Results);
+            this->Mixer->CreateBus(format.Channels, format.Channels, std::make_shared<Dsp::Ducker>(sidechain), &this->Impacts);
+
+            this->Mixer->CreateBus(format.Channels, format.Channels, reflections, &this->Reflections, this->Impacts);
+            this->Mixer->CreateBus(2, 2, convolution, &this->Convolution);
+            this->Mixer->CreateBus(Dsp::MAX_AMBISONIC_CHANNELS, format.Channels, decoder, &this->Ambisonics, this->Impacts);
+
+            Backend::Bus* sends[] = {this->Impacts, this->Reflections, this->Convolution, this->Ambisonics};
+
+            this->Pool = std::vector<PooledVoice>(voices);
+            for (std::uint32_t v = 0; v < voices; ++v)
+            {
+                auto& voice = this->Pool[v];
+                voice.Rig   = this;
+                voice.Angle = 6.2831853f * static_cast<float>(v) / static_cast<float>(voices);
+
+                this->Mixer->CreateVoice({CLIP_RATE, 1}, &voice, sends, 4, &voice.Handle);
+
+                // The ambisonic bus does the panning, so the direct path is silent
+                const float silent[2]   = {0.0f, 0.0f};
+                const float reflect[2]  = {1.0f, 1.0f};
+                const float convolve[2] = {0.3f, 0.3f};
+                voice.Handle->SetOutputMatrix(this->Impacts, 1, 2, silent);
+                voice.Handle->SetOutputMatrix(this->Reflections, 1, 2, reflect);
+                voice.Handle->SetOutputMatrix(this->Convolution, 1, 2, convolve);
+            }
+        }
+
+        ~PlayPathRig()
+        {
+            // The engine deletes whatever is left
+            this->Mixer.reset();
+        }
+
+        PlayPathRig(const PlayPathRig&)            = delete;
+        PlayPathRig& operator=(const PlayPathRig&) = delete;
+
+        // Restarts every voice that has finished, like new events coming in
+        void TriggerIdle(const bool timed)
+        {
+            for (auto& voice : this->Pool)
+            {
+                if (voice.Active) continue;
+
+                voice.Active = true;
+                if (timed) voice.Queued = Clock::now().time_since_epoch().count();
+
+                voice.Handle->Submit({this->Clip.data(), CLIP_FRAMES});
+                voice.Handle->Start();
+            }
+        }
+
+        // Moves every emitter a little and re-encodes them all in one batch
+        void Update3D()
+        {
+            const std::size_t count = this->Pool.size();
+
+            this->X.resize(count);
+            this->Y.resize(count);
+            this->Z.resize(count);
+            this->Gains.assign(count, 0.5f);
+            this->Encoded.resize(SoundInterface::Dsp::MAX_AMBISONIC_CHANNELS * count);
+
+            for (std::size_t e = 0; e < count; ++e)
+            {
+                auto& voice = this->Pool[e];
+                voice.Angle += 0.01f;
+
+                this->X[e] = std::cos(voice.Angle);
+                this->Y[e] = std::sin(voice.Angle);
+                this->Z[e] = 0.2f;
+            }
+
+            SoundInterface::Dsp::EncodeAmbisonics(
+                this->X.data(), this->Y.data(), this->Z.data(), this->Gains.data(),
+                count, SoundInterface::Dsp::MAX_AMBISONIC_ORDER,
+                this->Encoded.data(), count);
+
+            std::array<float, SoundInterface::Dsp::MAX_AMBISONIC_CHANNELS> levels;
+            for (std::size_t e = 0; e < count; ++e)
+            {
+                for (std::size_t n = 0; n < levels.size(); ++n)
+                {
+                    levels[n] = this->Encoded[n * count + e];
+                }
+                this->Pool[e].Handle->SetOutputMatrix(this->Ambisonics, 1, SoundInterface::Dsp::MAX_AMBISONIC_CHANNELS, levels.data());
+            }
+        }
+
+        void RecordLatency(const Clock::duration latency)
+        {
+            const double micros = std::chrono::duration<double, std::micro>(latency).count();
+
+            std::lock_guard lock(this->LatencyLock);
+            ++this->LatencyCount;
+            this->LatencyTotal += micros;
+            this->LatencyMax = std::max(this->LatencyMax, micros);
+        }
+
+        [[nodiscard]] std::pair<double, double> GetLatency() const
+        {
+            std::lock_guard lock(this->LatencyLock);
+            if (this->LatencyCount == 0) return {0.0, 0.0};
+            return {this->LatencyTotal / static_cast<double>(this->LatencyCount), this->LatencyMax};
+        }
+
+        Engine& GetEngine()
+        {
+            return *this->Mixer;
+        }
+
+        static constexpr std::uint32_t CLIP_RATE   = 44100;
+        static constexpr std::uint32_t CLIP_FRAMES = CLIP_RATE * 3 / 10;
+
+    private:
+        std::unique_ptr<Engine>       Mixer;
+        std::vector<float>            Clip;
+        std::vector<PooledVoice>      Pool;
+        SoundInterface::Backend::Bus* Results     = nullptr;
+        SoundInterface::Backend::Bus* Impacts     = nullptr;
+        SoundInterface::Backend::Bus* Reflections = nullptr;
+        SoundInterface::Backend::Bus* Convolution = nullptr;
+        SoundInterface::Backend::Bus* Ambisonics  = nullptr;
+
+        std::vector<float> X;
+        std::vector<float> Y;
+        std::vector<float> Z;
+        std::vector<float> Gains;
+        std::vector<float> Encoded;
+
+        mutable std::mutex LatencyLock;
+        std::uint64_t      LatencyCount = 0;
+        double             LatencyTotal = 0.0;
+        double             LatencyMax   = 0.0;
+    };
+
+    Benchmarks::Report RunPlayPath()
+    {
+        using namespace SoundInterface::Backend;
+
+        const auto blocks = static_cast<std::uint32_t>(BENCH_SECONDS * BENCH_SAMPLE_RATE / BENCH_BLOCK_SIZE);
+
+        Benchmarks::Report report;
+        report.Lines.push_back(Format(
+            "Software mixer, stereo, %u Hz, %u-frame blocks; mono %u Hz voices through reflections, convolution and 3rd order ambisonics into a ducked impacts bus, then the limiter",
+            BENCH_SAMPLE_RATE, BENCH_BLOCK_SIZE, PlayPathRig::CLIP_RATE));
+
+        for (const std::uint32_t voices : {8u, 32u, 128u})
+        {
+            PlayPathRig     rig(voices);
+            SimulatedDevice device(rig.GetEngine(), BENCH_BLOCK_SIZE);
+
+            const auto start = Clock::now();
+            for (std::uint32_t b = 0; b < blocks; ++b)
+            {
+                rig.TriggerIdle(false);
+                rig.Update3D();
+                device.RunOffline(1);
+            }
+            const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+            const DeviceTiming timing = device.GetTiming();
+            report.Lines.push_back(Format(
+                "Offline, %3u voices: %7.1fx realtime, %7.1f us per block on average, %7.1f us worst render",
+                voices,
+                BENCH_SECONDS / elapsed,
+                elapsed * 1e6 / blocks,
+                timing.MaxRenderMicros));
+        }
+
+        // Wall-clock paced, with the game side triggering from another thread
+        constexpr std::uint32_t voices  = 32;
+        constexpr auto          runtime = std::chrono::seconds(3);
+
+        PlayPathRig     rig(voices);
+        SimulatedDevice device(rig.GetEngine(), BENCH_BLOCK_SIZE);
+
+        device.Start();
+        const auto end = Clock::now() + runtime;
+        while (Clock::now() < end)
+        {
+            rig.TriggerIdle(true);
+            rig.Update3D();
+            std::this_thread::sleep_for(device.GetPeriod());
+        }
+        device.Stop();
+
+        const DeviceTiming timing            = device.GetTiming();
+        const auto [meanLatency, maxLatency] = rig.GetLatency();
+
+        report.Lines.push_back(Format(
+            "Real time, %u voices: %llu periods, %llu missed, %.1f us mean render, %.1f us worst wake-up delay",
+            voices,
+            static_cast<unsigned long long>(timing.Callbacks),
+            static_cast<unsigned long long>(timing.MissedDeadlines),
+            timing.MeanRenderMicros,
+            timing.MaxLateMicros));
+        report.Lines.push_back(Format(
+            "Real time, %u voices: play to first render %.2f ms on average, %.2f ms worst",
+            voices,
+            meanLatency / 1000.0,
+            maxLatency / 1000.0));
+
+        return report;
+    }
+
+    // Roughly the plugin's GameEvent, which needs the SDK's Vector
+    struct BenchCommand
+    {
+        Clock::time_point PostedAt;
+        float             Location[3];
+        float             Listener[9];
+        float             VolumeMultiplier;
+        std::uint8_t      Event;
+        bool              Is3D;
+        bool              FromMenu;
+    };
+
+    constexpr std::size_t BENCH_COMMAND_CAPACITY = 256;
+
+    using BenchCommandThread = SoundInterface::CommandThread<BenchCommand, BENCH_COMMAND_CAPACITY>;
+
+    class CommandLatency
+    {
+    public:
+        void Record(const Clock::time_point postedAt)
+        {
+            const double micros = std::chrono::duration<double, std::micro>(Clock::now() - postedAt).count();
+
+            // Only the command thread writes
+            this->Count.fetch_add(1, std::memory_order_relaxed);
+            this->Total += micros;
+            this->Max = std::max(this->Max, micros);
+        }
+
+        // After the command thread has stopped
+        [[nodiscard]] std::uint64_t GetCount() const { return this->Count.load(std::memory_order_relaxed); }
+        [[nodiscard]] double        GetMean() const { return this->GetCount() ? this->Total / static_cast<double>(this->GetCount()) : 0.0; }
+        [[nodiscard]] double        GetMax() const { return this->Max; }
+
+    private:
+        std::atomic<std::uint64_t> Count = 0;
+        double                     Total = 0.0;
+        double                     Max   = 0.0;
+    };
+
+    // Roughly what taking a voice and submitting to it costs
+    void SpinFor(const std::chrono::nanoseconds duration)
+    {
+        const auto end = Clock::now() + duration;
+        while (Clock::now() < end) {}
+    }
+
+    Benchmarks::Report RunCommandQueue()
+    {
+        constexpr std::uint32_t bursts    = 20000;
+        constexpr std::uint32_t burstSize = 8;
+        constexpr auto          work      = std::chrono::microseconds(20);
+
+        Benchmarks::Report report;
+        report.Lines.push_back(Format(
+            "%zu-byte commands, %zu slots; the command thread spends %lld us on each, like a play would",
+            sizeof(BenchCommand), BENCH_COMMAND_CAPACITY, static_cast<long long>(work.count())));
+
+        // What timing a post costs by itself, taken off every sample
+        Clock::duration overhead = Clock::duration::max();
+        for (int i = 0; i < 1000; ++i)
+        {
+            const auto before = Clock::now();
+            overhead          = std::min(overhead, Clock::now() - before);
+        }
+
+        // The queue alone, with nothing to wake or share cache lines with
+        {
+            constexpr std::uint32_t rounds = 10000;
+
+            SoundInterface::MpscQueue<BenchCommand, BENCH_COMMAND_CAPACITY> queue;
+            BenchCommand                                                      command{};
+
+            double total = 0.0;
+            for (std::uint32_t r = 0; r < rounds; ++r)
+            {
+                const auto start = Clock::now();
+                for (std::size_t i = 0; i < BENCH_COMMAND_CAPACITY; ++i)
+                {
+                    queue.TryPush(command);
+                }
+                total += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+                while (queue.TryPop(command)) {}
+            }
+
+            report.Lines.push_back(Format(
+                "Queue alone: push %.1f ns mean",
+                total / (static_cast<double>(rounds) * BENCH_COMMAND_CAPACITY)));
+        }
+
+        // One producer, like the game thread: a few events at once, then a frame's pause
+        {
+            CommandLatency     latency;
+            BenchCommandThread thread;
+            thread.Start(
+                [&latency, work](const BenchCommand& command)
+                {
+                    SpinFor(work);
+                    latency.Record(command.PostedAt);
+                });
+
+            // The first of a burst finds the command thread asleep and has to wake it
+            std::vector<double> waking;
+            std::vector<double> costs;
+            waking.reserve(bursts);
+            costs.reserve(static_cast<std::size_t>(bursts) * (burstSize - 1));
+
+            BenchCommand command{};
+            command.Is3D = true;
+            for (std::uint32_t b = 0; b < bursts; ++b)
+            {
+                for (std::uint32_t i = 0; i < burstSize; ++i)
+                {
+                    command.Event    = static_cast<std::uint8_t>(i);
+                    const auto start = Clock::now();
+                    command.PostedAt = start;
+                    thread.Post(command);
+                    const auto cost  = Clock::now() - start - overhead;
+                    (i == 0 ? waking : costs).push_back(std::chrono::duration<double, std::nano>(cost).count());
+                }
+
+                // Let the command thread catch up and go back to sleep, so posts pay for waking it
+                std::this_thread::sleep_for(std::chrono::microseconds(500));
+            }
+            thread.Stop();
+
+            for (auto* samples : {&waking, &costs})
+            {
+                std::sort(samples->begin(), samples->end());
+                double mean = 0.0;
+                for (const double cost : *samples) mean += cost;
+                mean /= static_cast<double>(samples->size());
+
+                report.Lines.push_back(Format(
+                    "1 producer, bursts of %u, %s: post %.0f ns mean, %.0f ns median, %.0f ns p99, %.0f ns worst",
+                    burstSize,
+                    samples == &waking ? "waking the thread" : "thread awake     ",
+                    mean,
+                    (*samples)[samples->size() / 2],
+                    (*samples)[samples->size() * 99 / 100],
+                    samples->back()));
+            }
+            report.Lines.push_back(Format(
+                "1 producer: post to handled %.1f us mean, %.1f us worst; %llu dropped",
+                latency.GetMean(),
+                latency.GetMax(),
+                static_cast<unsigned long long>(thread.GetDropped())));
+        }
+
+        // Several producers flat out, far faster than the command thread can play
+        for (const std::uint32_t producers : {2u, 4u})
+        {
+            constexpr std::uint32_t posts = 200000;
+
+            CommandLatency     latency;
+            BenchCommandThread thread;
+            thread.Start(
+                [&latency](const BenchCommand& command)
+                {
+                    SpinFor(std::chrono::microseconds(1));
+                    latency.Record(command.PostedAt);
+                });
+
+            std::atomic<std::int64_t> totalNanos = 0;
+            std::vector<std::thread>  threads;
+            for (std::uint32_t p = 0; p < producers; ++p)
+            {
+                threads.emplace_back(
+                    [&thread, &totalNanos]
+                    {
+                        BenchCommand command{};
+                        const auto   start = Clock::now();
+                        for (std::uint32_t i = 0; i < posts; ++i)
+                        {
+                            command.PostedAt = Clock::now();
+                            thread.Post(command);
+                        }
+                        totalNanos.fetch_add(
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+                    });
+            }
+            for (auto& producer : threads) producer.join();
+            thread.Stop();
+
+            const double handled = static_cast<double>(latency.GetCount());
+            report.Lines.push_back(Format(
+                "%u producers, saturated: post %.0f ns mean, %.1f%% handled, %.1f%% dropped when full",
+                producers,
+                static_cast<double>(totalNanos.load()) / (static_cast<double>(posts) * producers),
+                100.0 * handled / (static_cast<double>(posts) * producers),
+                100.0 * static_cast<double>(thread.GetDropped()) / (static_cast<double>(posts) * producers)));
+        }
+
+        return report;
+    }
+
+    // Utils::ComputeVolumeMultiplier as it was before curves replaced it, to measure against
+    float ComputeVolumeMultiplierReference(const float speed)
+    {
+        const float minSpeed = 100.0f;
+        const float midStart = 800.0f;
+        const float midEnd   = 2500.0f;
+        const float maxSpeed = 6000.0f;
+
+        const float minVolume  = 0.0f;
+        const float midVolume  = 0.25f;
+        const float highVolume = 0.85f;
+        const float maxVolume  = 1.2f;
+
+        float volume = 0.0f;
+
+        if (speed < minSpeed) return 0.0f;
+
+        if (speed <= midStart)
+        {
+            const float t = (speed - minSpeed) / (midStart - minSpeed);
+            volume        = minVolume + std::pow(t, 2.0f) * (midVolume - minVolume);
+        }
+        else if (speed <= midEnd)
+        {
+            const float t = (speed - midStart) / (midEnd - midStart);
+            volume        = midVolume + t * (highVolume - midVolume);
+        }
+        else
+        {
+            const float t = (speed - midEnd) / (maxSpeed - midEnd);
+            volume        = highVolume + (1.0f - std::pow(1.0f - t, 2.0f)) * (maxVolume - highVolume);
+        }
+
+        return std::clamp(volume, minVolume, maxVolume);
+    }
+
+    Benchmarks::Report RunGainCurves()
+    {
+        using namespace SoundInterface;
+
+        constexpr std::size_t   count      = 4096;
+        constexpr std::uint32_t iterations = 2000;
+
+        // Ball speeds in the order hits would come, not sorted, so branches don't learn them
+        std::mt19937                          random(9);
+        std::uniform_real_distribution<float> speeds(0.0f, GetCurveInputRange(CurveInput::BallSpeed));
+
+        std::vector<float> inputs(count);
+        for (float& input : inputs) input = speeds(random);
+
+        EventCurve curve = GetCrossbarSpeedCurve();
+        curve.Bake();
+
+        std::vector<float> reference(count);
+        for (std::size_t i = 0; i < count; ++i) reference[i] = ComputeVolumeMultiplierReference(inputs[i]);
+
+        Benchmarks::Report report;
+        report.Lines.push_back(Format(
+            "The crossbar's default curve over %zu random ball speeds, against the hardcoded function it replaced; %u-entry table",
+            count, Dsp::GainLut::SIZE));
+
+        std::vector<float> output(count);
+        const auto measure = [&](const char* label, const auto& evaluate, const double baseline)
+        {
+            const auto start = Clock::now();
+            for (std::uint32_t n = 0; n < iterations; ++n)
+            {
+                evaluate();
+            }
+            const double perValue = std::chrono::duration<double>(Clock::now() - start).count() / (static_cast<double>(iterations) * count);
+
+            float deviation = 0.0f;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                deviation = std::max(deviation, std::abs(output[i] - reference[i]));
+            }
+
+            report.Lines.push_back(Format(
+                "%-10s: %6.2f ns per evaluation, %5.1fx the hardcoded curve, max deviation %.1e",
+                label, perValue * 1e9, baseline > 0.0 ? baseline / perValue : 1.0, static_cast<double>(deviation)));
+            return perValue;
+        };
+
+        const double hardcoded = measure("hardcoded", [&]
+        {
+            for (std::size_t i = 0; i < count; ++i) output[i] = ComputeVolumeMultiplierReference(inputs[i]);
+        }, 0.0);
+
+        measure("points", [&]
+        {
+            for (std::size_t i = 0; i < count; ++i) output[i] = Dsp::EvaluateGainCurve(curve.Curve, inputs[i]);
+        }, hardcoded);
+
+        measure("table", [&]
+        {
+            for (std::size_t i = 0; i < count; ++i) output[i] = curve.Lut->Evaluate(inputs[i]);
+        }, hardcoded);
+
+        measure("batch", [&]
+        {
+            curve.Lut->Evaluate(inputs.data(), count, output.data());
+        }, hardcoded);
+
+        return report;
+    }
+
+    Benchmarks::Report RunDevices()
+    {
+        using namespace SoundInterface;
+
+        constexpr std::uint32_t changes = 200;
+
+        auto  owned    = std::make_unique<ScriptedDeviceProvider>();
+        auto& provider = *owned;
+        provider.Add({L"speakers", L"Speakers"});
+        provider.Add({L"headphones", L"Headphones"});
+        provider.SetDefault(L"speakers");
+
+        DeviceRegistry             registry(std::move(owned));
+        std::atomic<std::uint32_t> notified = 0;
+        registry.Start([&notified] { notified.fetch_add(1, std::memory_order_relaxed); });
+
+        Benchmarks::Report report;
+        report.Lines.push_back(Format(
+            "Reading the device list as the settings window does every frame, while %u device changes are refreshed on another thread",
+            changes));
+
+        // Headphones unplugged and plugged back in, and the default swapped, refreshing after each like the output worker
+        std::atomic<bool> isChurning = true;
+        std::uint32_t     fallbacks  = 0;
+        std::thread       churn([&]
+        {
+            for (std::uint32_t i = 0; i < changes; ++i)
+            {
+                switch (i % 4)
+                {
+                case 0:
+                    provider.Remove(L"headphones");
+                    break;
+                case 1:
+                    provider.Add({L"headphones", L"Headphones"});
+                    break;
+                case 2:
+                    provider.SetDefault(L"headphones");
+                    break;
+                default:
+                    provider.SetDefault(L"speakers");
+                    break;
+                }
+                registry.Refresh();
+
+                // A chosen device that's gone plays on the default
+                const DeviceSnapshotPtr devices = registry.GetSnapshot();
+                if (i % 4 == 0 && devices->Resolve(L"headphones") == L"speakers") ++fallbacks;
+
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            isChurning.store(false, std::memory_order_release);
+        });
+
+        std::uint64_t reads = 0;
+        std::size_t   seen  = 0;
+        const auto    start = Clock::now();
+        while (isChurning.load(std::memory_order_acquire))
+        {
+            const DeviceSnapshotPtr devices = registry.GetSnapshot();
+            const AudioDevice*      device  = devices->Find(L"headphones");
+            seen += device ? device->Name.size() : devices->Devices.size();
+            ++reads;
+        }
+        const double perRead = std::chrono::duration<double>(Clock::now() - start).count() / static_cast<double>(reads);
+        churn.join();
+
+        report.Lines.push_back(Format("%.0f ns per read and lookup, %llu reads (checksum %zu)", perRead * 1e9, static_cast<unsigned long long>(reads), seen));
+        // One enumeration to start with, then one for each change, however often the list was read
+        report.IsPassing = provider.GetEnumerations() == changes + 1 && fallbacks == (changes + 3) / 4;
+        report.Lines.push_back(Format(
+            "%llu enumerations for %u notifications over %llu snapshots; %u of %u unplugs fell back to the default; %s",
+            static_cast<unsigned long long>(provider.GetEnumerations()),
+            notified.load(),
+            static_cast<unsigned long long>(registry.GetSnapshot()->Version),
+            fallbacks,
+            (changes + 3) / 4,
+            report.IsPassing ? "each change enumerated once" : "ENUMERATED WRONG"));
+
+        registry.Stop();
+        return report;
+    }
+
+    Benchmarks::Report RunLatency()
+    {
+        using namespace SoundInterface;
+
+        constexpr std::size_t   count   = 1 << 20;
+        constexpr std::uint32_t threads = 4;
+
+        // Mostly a few milliseconds, with the long tail a stalled frame gives
+        std::mt19937                        random(45);
+        std::lognormal_distribution<double> spread(std::log(3000.0), 0.8);
+        std::vector<std::uint64_t>          values(count);
+        for (auto& value : values) value = static_cast<std::uint64_t>(spread(random));
+
+        Benchmarks::Report report;
+        report.Lines.push_back(Format(
+            "Recording %zu latencies into a %u-bucket histogram, and the percentiles it gives against exact ones",
+            count, LatencyHistogram::NUM_BUCKETS));
+
+        // One thread, as the audio thread records
+        auto histogram = std::make_unique<LatencyHistogram>();
+        auto start     = Clock::now();
+        for (const std::uint64_t value : values) histogram->Record(value);
+        const double perRecord = std::chrono::duration<double>(Clock::now() - start).count() / count;
+
+        // Several at once, as when hooks and the audio thread overlap
+        auto                     shared = std::make_unique<LatencyHistogram>();
+        std::vector<std::thread> recorders;
+        start = Clock::now();
+        for (std::uint32_t t = 0; t < threads; ++t)
+        {
+            recorders.emplace_back([&, t]
+            {
+                for (std::size_t i = t; i < count; i += threads) shared->Record(values[i]);
+            });
+        }
+        for (auto& recorder : recorders) recorder.join();
+        const double perShared = std::chrono::duration<double>(Clock::now() - start).count() / count;
+
+        report.Lines.push_back(Format("%.1f ns per record, %.1f ns across %u threads", perRecord * 1e9, perShared * 1e9, threads));
+
+        // Worst error of the percentiles against sorting everything
+        std::vector<std::uint64_t> sorted = values;
+        std::ranges::sort(sorted);
+
+        const LatencyHistogram::Summary summary = histogram->Summarize();
+        const auto getError = [&sorted](const std::uint64_t estimate, const std::uint64_t percent)
+        {
+            const std::uint64_t exact = sorted[std::max<std::size_t>((sorted.size() * percent + 99) / 100, 1) - 1];
+            return 100.0 * (static_cast<double>(estimate) - static_cast<double>(exact)) / static_cast<double>(exact);
+        };
+
+        // Each percentile within a sub-bucket of the exact one, and nothing lost to the threads racing
+        const double maxError = 100.0 / LatencyHistogram::SUB_BUCKETS;
+        const bool   isLost   = shared->Summarize().Count != count;
+        const bool   isClose  = std::abs(getError(summary.P50, 50)) <= maxError &&
+                                std::abs(getError(summary.P90, 90)) <= maxError &&
+                                std::abs(getError(summary.P99, 99)) <= maxError &&
+                                summary.Max == sorted.back();
+        report.IsPassing = isClose && !isLost;
+
+        report.Lines.push_back(Format(
+            "p50 %llu us (%+.1f%%), p90 %llu us (%+.1f%%), p99 %llu us (%+.1f%%), max %llu us (exact %llu); %s, %s with %llu records",
+            static_cast<unsigned long long>(summary.P50), getError(summary.P50, 50),
+            static_cast<unsigned long long>(summary.P90), getError(summary.P90, 90),
+            static_cast<unsigned long long>(summary.P99), getError(summary.P99, 99),
+            static_cast<unsigned long long>(summary.Max), static_cast<unsigned long long>(sorted.back()),
+            isClose ? Format("all within %.2f%%", maxError).c_str() : Format("NOT WITHIN %.2f%%", maxError).c_str(),
+            isLost ? "LOST SOME" : "none lost",
+            static_cast<unsigned long long>(shared->Summarize().Count)));
+
+        // A whole play's worth, on and off
+        auto                    stats = std::make_unique<LatencyStats>();
+        LatencyProbe            probe;
+        const Clock::time_point now   = Clock::now();
+        probe.HookedAt  = now;
+        probe.PostedAt  = now + std::chrono::microseconds(20);
+        probe.StartedAt = now + std::chrono::microseconds(300);
+
+        for (const bool isEnabled : {false, true})
+        {
+            stats->SetEnabled(isEnabled);
+
+            start = Clock::now();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                probe.Event = i % MAX_LATENCY_EVENTS;
+                stats->Finish(probe, probe.StartedAt + std::chrono::microseconds(values[i]));
+            }
+            const double perPlay = std::chrono::duration<double>(Clock::now() - start).count() / count;
+
+            report.Lines.push_back(Format("%-3s: %.1f ns per play finished", isEnabled ? "on" : "off", perPlay * 1e9));
+        }
+
+        return report;
+    }
+
+    // Stands in for a stat event object, whose name the game keeps as a wide string
+    struct BenchStatEvent
+    {
+        std::wstring Name;
+    };
+
+    // Like the wrapper's GetEventName, a fresh narrow copy each time
+    std::string ReadStatEventName(const std::uintptr_t address)
+    {
+        const std::wstring& name = reinterpret_cast<const BenchStatEvent*>(address)->Name;
+
+        std::string narrow(name.size(), '\0');
+        std::ranges::transform(name, narrow.begin(), [](const wchar_t c) { return static_cast<char>(c); });
+        return narrow;
+    }
+
+    Benchmarks::Report RunStatDispatch()
+    {
+        using namespace RlEvents;
+
+        constexpr std::size_t count = 1 << 20;
+
+        // Every name the table knows, and a couple it doesn't
+        std::vector<std::unique_ptr<BenchStatEvent>> objects;
+        for (std::size_t i = 1; i < NUM_STAT_EVENTS; ++i)
+        {
+            const std::string_view name = STAT_EVENT_NAMES[i];
+            objects.push_back(std::make_unique<BenchStatEvent>(BenchStatEvent{std::wstring(name.begin(), name.end())}));
+        }
+        objects.push_back(std::make_unique<BenchStatEvent>(BenchStatEvent{L"Juggle"}));
+        objects.push_back(std::make_unique<BenchStatEvent>(BenchStatEvent{L"BreakoutDamage"}));
+
+        std::mt19937                               random(47);
+        std::uniform_int_distribution<std::size_t> pick(0, objects.size() - 1);
+        std::vector<std::uintptr_t>                addresses(count);
+        for (auto& address : addresses) address = reinterpret_cast<std::uintptr_t>(objects[pick(random)].get());
+
+        // What the hook did before: read the name, then compare it against each in turn
+        const auto compare = [](const std::uintptr_t address)
+        {
+            const std::string name = ReadStatEventName(address);
+            if (name == "Demolish") return StatEvent::Demolish;
+            if (name == "Goal") return StatEvent::Goal;
+            if (name == "OwnGoal") return StatEvent::OwnGoal;
+            if (name == "Save") return StatEvent::Save;
+            if (name == "Win") return StatEvent::Win;
+            if (name == "Assist") return StatEvent::Assist;
+            return StatEvent::Unknown;
+        };
+
+        const auto hash = [](const std::uintptr_t address)
+        {
+            return GetStatEvent(ReadStatEventName(address));
+        };
+
+        StatEventCache cache;
+        const auto     cached = [&cache](const std::uintptr_t address)
+        {
+            return cache.Resolve(address, [address] { return ReadStatEventName(address); });
+        };
+
+        Benchmarks::Report report;
+        report.Lines.push_back(Format(
+            "Dispatching %zu stat ticker messages over %zu stat events, %zu of them known, hashed into %zu slots with seed %u",
+            count, objects.size(), NUM_STAT_EVENTS - 1, Detail::STAT_EVENT_SLOTS, Detail::STAT_EVENT_SEED));
+
+        // Only the events the compare chain knows, so all three can be checked against each other
+        const auto isRuled = [](const StatEvent stat)
+        {
+            return stat == StatEvent::Demolish || stat == StatEvent::Goal || stat == StatEvent::OwnGoal ||
+                stat == StatEvent::Save || stat == StatEvent::Win || stat == StatEvent::Assist;
+        };
+
+        std::vector<StatEvent> expected(count);
+        std::size_t            mismatches = 0;
+
+        const auto run = [&](const char* name, const auto& dispatch, const bool isReference)
+        {
+            const auto start = Clock::now();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const StatEvent stat = dispatch(addresses[i]);
+                if (isReference) expected[i] = stat;
+                else if (isRuled(stat) != isRuled(expected[i]) || (isRuled(stat) && stat != expected[i])) ++mismatches;
+            }
+            const double perDispatch = std::chrono::duration<double>(Clock::now() - start).count() / count;
+
+            report.Lines.push_back(Format("%-8s: %6.1f ns per message", name, perDispatch * 1e9));
+        };
+
+        run("compare", compare, true);
+        run("hash", hash, false);
+        run("cached", cached, false);
+
+        report.IsPassing = mismatches == 0;
+        report.Lines.push_back(Format(
+            "%zu of %zu stat events cached; %s",
+            cache.GetSize(), objects.size(), mismatches == 0 ? "all agree" : Format("%zu MISMATCHED", mismatches).c_str()));
+
+        return report;
+    }
+
+    // A car and what it bumped into, 0 for a wall, and how long after the last bump
+    struct BenchBump
+    {
+        std::uintptr_t           Car;
+        std::uintptr_t           Other;
+        std::chrono::nanoseconds Gap;
+    };
+
+    std::vector<BenchBump> MakeBumpStorm(
+        const std::size_t              count,
+        const std::size_t              cars,
+        const std::chrono::nanoseconds meanGap,
+        const std::uint32_t            seed)
+    {
+        std::mt19937                               random(seed);
+        std::uniform_int_distribution<std::size_t> pickCar(0, cars - 1);
+        std::uniform_int_distribution<std::size_t> pickOther(0, cars); // The last is a wall
+        std::exponential_distribution<double>      gap(1.0 / static_cast<double>(meanGap.count()));
+
+        // Spaced like objects in the game's heap
+        const auto getAddress = [](const std::size_t car)
+        {
+            return static_cast<std::uintptr_t>(0x7FF600000000ull + car * 0xA40);
+        };
+
+        std::vector<BenchBump> bumps(count);
+        for (BenchBump& bump : bumps)
+        {
+            const std::size_t car   = pickCar(random);
+            std::size_t       other = pickOther(random);
+            if (other == car) other = cars;
+
+            bump.Car   = getAddress(car);
+            bump.Other = other == cars ? 0 : getAddress(other);
+            bump.Gap   = std::chrono::nanoseconds(static_cast<std::int64_t>(gap(random)));
+        }
+
+        return bumps;
+    }
+
+    Benchmarks::Report RunBumpStorm()
+    {
+        using namespace RlEvents;
+        using BumpClock = CooldownTable::Clock;
+
+        constexpr std::size_t count   = 1 << 20;
+        constexpr auto        timeout = std::chrono::milliseconds(200);
+
+        // The bump's default, under the first event's index as the bump is
+        const CooldownPolicy  policy = {0.2f, 0, 1.0f, CooldownScope::Pair};
+        constexpr std::size_t bump   = 0;
+
+        struct Storm
+        {
+            const char*              Name;
+            std::size_t              Cars;
+            std::chrono::nanoseconds MeanGap;
+        };
+
+        // Far past anything a match does, so the table is always busy
+        const Storm storms[] = {
+            {"4v4 scrum", 8, std::chrono::microseconds(100)},
+            {"pileup", 48, std::chrono::microseconds(1000)},
+        };
+
+        Benchmarks::Report report;
+        report.Lines.push_back(Format(
+            "%zu bumps per storm, %lld ms cooldown by pair, a %zu-state table on a %zux%zu-slot wheel of %lld ms ticks",
+            count, static_cast<long long>(timeout.count()), CooldownTable::CAPACITY,
+            TimerWheel<CooldownTable::CAPACITY>::LEVELS, TimerWheel<CooldownTable::CAPACITY>::SLOTS,
+            static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(CooldownTable::TICK).count())));
+
+        for (const Storm& storm : storms)
+        {
+            const std::vector<BenchBump> bumps = MakeBumpStorm(count, storm.Cars, storm.MeanGap, 49);
+
+            std::vector<BumpClock::time_point> times(count);
+            BumpClock::time_point              now = BumpClock::time_point(std::chrono::hours(1));
+            for (std::size_t i = 0; i < count; ++i) times[i] = now += bumps[i].Gap;
+
+            // The table
+            auto              table   = std::make_unique<CooldownTable>();
+            std::vector<bool> played(count);
+            std::size_t       plays   = 0;
+            std::size_t       maxSize = 0;
+            auto              start   = Clock::now();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                played[i]  = table->Admit(bump, bumps[i].Car, bumps[i].Other, policy, 1.0f, times[i]);
+                plays     += played[i];
+                maxSize    = std::max(maxSize, table->GetSize());
+            }
+            const double perTable = std::chrono::duration<double>(Clock::now() - start).count() / count;
+
+            // What it replaced, by car, scanning every noted car on every bump
+            std::map<std::uintptr_t, BumpClock::time_point> noted;
+            start = Clock::now();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                std::erase_if(noted, [&](const auto& entry) { return times[i] - entry.second > timeout; });
+                if (noted.contains(bumps[i].Car)) continue;
+
+                noted[bumps[i].Car] = times[i];
+                if (bumps[i].Other) noted[bumps[i].Other] = times[i];
+            }
+            const double perMap = std::chrono::duration<double>(Clock::now() - start).count() / count;
+
+            // The same rule with a map of pairs, to check the table against
+            std::map<std::pair<std::uintptr_t, std::uintptr_t>, std::uint64_t> expiries;
+            const auto  timeoutTicks = static_cast<std::uint64_t>((timeout + CooldownTable::TICK - BumpClock::duration(1)) / CooldownTable::TICK);
+            std::size_t mismatches   = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto tick = static_cast<std::uint64_t>(times[i].time_since_epoch() / CooldownTable::TICK);
+                const auto pair = std::minmax(bumps[i].Car, bumps[i].Other);
+
+                const auto found  = expiries.find(pair);
+                const bool isPlay = found == expiries.end() || found->second <= tick;
+                if (isPlay) expiries[pair] = tick + timeoutTicks;
+                if (isPlay != played[i]) ++mismatches;
+            }
+
+            if (mismatches != 0) report.IsPassing = false;
+            report.Lines.push_back(Format(
+                "%-10s: %2zu cars, %5.1f ns per bump (the old map: %6.1f ns), %zu played, %zu pairs at most, %llu overflowed; %s",
+                storm.Name, storm.Cars, perTable * 1e9, perMap * 1e9, plays, maxSize,
+                static_cast<unsigned long long>(table->GetOverflows()),
+                mismatches == 0 ? "matches a map of pairs" : Format("%zu MISMATCHED", mismatches).c_str()));
+        }
+
+        return report;
+    }
+}
+
+namespace Benchmarks
+{
+    const std::vector<Benchmark>& GetBenchmarks()
+    {
+        static const std::vector<Benchmark> benchmarks = {
+            {"convolution", "Partitioned convolution reverb per IR length", RunConvolution},
+            {"mixkernels", "Mix-accumulate kernels per channel count and instruction set", RunMixKernels},
+            {"resampler", "Fractional-rate resampling for pitch variation, scalar against vectorized", RunResampler},
+            {"limiter", "Master true-peak limiter cost and ceiling overshoot", RunLimiter},
+            {"playpath", "Full play path on the software mixer", RunPlayPath},
+            {"commandqueue", "Game-thread cost of handing a play to the command thread", RunCommandQueue},
+            {"gaincurves", "Baked gain curve tables against the hardcoded crossbar volume curve", RunGainCurves},
+            {"devices", "Reading the cached device list while devices come and go", RunDevices},
+            {"latency", "Recording event latencies into histograms, and how close their percentiles are", RunLatency},
+            {"statdispatch", "Stat ticker event names to events: compares, the perfect hash, and the address cache", RunStatDispatch},
+            {"bumpstorm", "Bump cooldowns by pair under synthetic bump storms, against the map they replaced", RunBumpStorm},
+        };
+
+        return benchmarks;
+    }
+}
@@ -0,0 +1,33 @@
+//=======================================================================
+/** Benchmarks.h
+ * Offline throughput benchmarks for the portable audio code
+ */
+//=======================================================================
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/*
+ * Nothing in here touches the game or the audio device, so the same
+ * code runs from the eventsfx_bench console command and from the
+ * command-line build in CMakeLists.txt, on any platform.
+ */
+namespace Benchmarks
+{
+    struct Report
+    {
+        std::vector<std::string> Lines;
+        bool                     IsPassing = true; // Cleared by benchmarks whose results fail their own checks
+    };
+
+    struct Benchmark
+    {
+        std::string Name;
+        std::string Description;
+        Report      (*Run)();
+    };
+
+    const std::vector<Benchmark>& GetBenchmarks();
+}
@@ -0,0 +1,47 @@
+//=======================================================================
+/** BenchmarksMain.cpp
+ * Runs the offline benchmarks from the command line, outside the game
+ */
+//=======================================================================
+
+#include "Benchmarks.h"
+
+#include <cstdio>
+#include <string>
+
+// eventsfx_bench [name|all]; exits non-zero when a benchmark fails its checks or there's none by that name
+int main(const int argc, char** argv)
+{
+    const std::string name = argc < 2 ? "all" : argv[1];
+
+    bool found     = false;
+    bool isPassing = true;
+    for (const auto& benchmark : Benchmarks::GetBenchmarks())
+    {
+        if (name != "all" && name != benchmark.Name) continue;
+        found = true;
+
+        std::printf("BENCHMARK: %s (%s)\n", benchmark.Name.c_str(), benchmark.Description.c_str());
+        const Benchmarks::Report report = benchmark.Run();
+        for (const auto& line : report.Lines)
+        {
+            std::printf("  %s\n", line.c_str());
+        }
+        if (!report.IsPassing)
+        {
+            std::printf("  FAILED ITS CHECKS\n");
+            isPassing = false;
+        }
+        std::fflush(stdout);
+    }
+
+    if (!found)
+    {
+        std::fprintf(stderr, "UNKNOWN BENCHMARK '%s'. THERE ARE:", name.c_str());
+        for (const auto& benchmark : Benchmarks::GetBenchmarks()) std::fprintf(stderr, " %s", benchmark.Name.c_str());
+        std::fprintf(stderr, "\n");
+        return 2;
+    }
+
+    return isPassing ? 0 : 1;
+}
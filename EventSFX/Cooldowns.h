@@ -0,0 +1,280 @@
+//=======================================================================
+/** Cooldowns.h
+ * How often each event may play, by the policy its settings give it
+ */
+//=======================================================================
+
+#pragma once
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+constexpr float         MIN_COOLDOWN              = 0.0f;  // Seconds; none
+constexpr float         MAX_COOLDOWN              = 60.0f;
+constexpr std::uint32_t MIN_COOLDOWN_BURST        = 0;     // No bucket
+constexpr std::uint32_t MAX_COOLDOWN_BURST        = 32;
+constexpr float         MIN_COOLDOWN_RATE         = 0.1f;  // Plays a second, while there's a bucket
+constexpr float         MAX_COOLDOWN_RATE         = 50.0f;
+constexpr float         MIN_COOLDOWN_BREAKTHROUGH = 1.0f;  // Times as loud, while it's on
+constexpr float         MAX_COOLDOWN_BREAKTHROUGH = 10.0f;
+
+namespace RlEvents
+{
+    // What an event's cooldown is kept for
+    enum class CooldownScope
+        : std::uint8_t
+    {
+        Event = 0, // The event as a whole
+        Pair,      // Each pair of things that made it, like two cars bumping, either way round
+        Count
+    };
+
+    constexpr std::size_t NUM_COOLDOWN_SCOPES = static_cast<std::size_t>(CooldownScope::Count);
+
+    constexpr const char* GetCooldownScopeLabel(const CooldownScope scope)
+    {
+        switch (scope)
+        {
+        case CooldownScope::Event:
+            return "event";
+        case CooldownScope::Pair:
+            return "pair";
+        default:
+            return "NA";
+        }
+    }
+
+    /*
+     * Plays are let through while both a cooldown since the last and a
+     * token bucket allow them: the bucket holds up to Burst plays and
+     * refills at Rate a second, so a burst gets through at once and
+     * then it's Rate a second. BreakThrough lets a play through the
+     * cooldown, though not the bucket, when it's that many times as loud
+     * as the last, so a hard hit isn't lost behind a soft one.
+     */
+    struct CooldownPolicy
+    {
+        float         Cooldown     = MIN_COOLDOWN; // Seconds
+        std::uint32_t Burst        = MIN_COOLDOWN_BURST;
+        float         Rate         = 1.0f;
+        CooldownScope Scope        = CooldownScope::Event;
+        float         BreakThrough = 0.0f; // Off
+
+        [[nodiscard]] bool IsThrottling() const
+        {
+            return this->Cooldown > 0.0f || this->Burst > 0;
+        }
+    };
+
+    inline void SanitizeCooldownPolicy(CooldownPolicy& policy)
+    {
+        policy.Cooldown = std::clamp(policy.Cooldown, MIN_COOLDOWN, MAX_COOLDOWN);
+        policy.Burst    = std::clamp(policy.Burst, MIN_COOLDOWN_BURST, MAX_COOLDOWN_BURST);
+        policy.Rate     = std::clamp(policy.Rate, MIN_COOLDOWN_RATE, MAX_COOLDOWN_RATE);
+        if (policy.Scope >= CooldownScope::Count) policy.Scope = CooldownScope::Event;
+        if (policy.BreakThrough != 0.0f) policy.BreakThrough = std::clamp(policy.BreakThrough, MIN_COOLDOWN_BREAKTHROUGH, MAX_COOLDOWN_BREAKTHROUGH);
+    }
+
+    /*
+     * Where each event, or pair of things per event, is in its cooldown
+     * and bucket, for every event at once. States come from a fixed pool
+     * and are found through an open-addressing index with linear probing,
+     * so admitting a play is a probe or two and never allocates. Each
+     * state is on the timer wheel for when it's back to how a new one
+     * would start, cooled down with a full bucket, and is dropped then,
+     * so the pool only holds what's throttled right now. Removals shift
+     * the probe chain back instead of leaving tombstones. A full pool
+     * lets plays through rather than silencing them. Only from one
+     * thread.
+     */
+    class CooldownTable
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::size_t     CAPACITY   = 512; // States; 4v4 has 36 pairs of cars, counting walls
+        static constexpr std::size_t     INDEX_SIZE = CAPACITY * 2; // A power of two, so probe chains stay short
+        static constexpr Clock::duration TICK       = std::chrono::milliseconds(10);
+
+        static_assert(std::chrono::seconds(static_cast<long long>(MAX_COOLDOWN)) +
+                      std::chrono::seconds(static_cast<long long>(MAX_COOLDOWN_BURST / MIN_COOLDOWN_RATE)) <
+                      TICK * TimerWheel<CAPACITY>::HORIZON);
+
+        CooldownTable()
+        {
+            this->Clear();
+        }
+
+        // True if the policy lets the play through, which is then counted against it; a and b are 0 for an event's whole scope
+        bool Admit(
+            const std::size_t     event,
+            std::uintptr_t        a,
+            std::uintptr_t        b,
+            const CooldownPolicy& policy,
+            const float           gain,
+            const Clock::time_point now)
+        {
+            const auto tick = static_cast<std::uint64_t>(now.time_since_epoch() / TICK);
+            this->Wheel.Advance(tick, [this](const std::size_t handle) { this->Remove(handle); });
+
+            if (!policy.IsThrottling()) return true;
+
+            // Either way round is the same pair
+            if (policy.Scope == CooldownScope::Event) a = b = 0;
+            else if (b < a) std::swap(a, b);
+
+            std::size_t slot = GetHome(event, a, b);
+            while (this->Index[slot] != NONE)
+            {
+                const State& state = this->States[this->Index[slot]];
+                if (state.Event == event && state.A == a && state.B == b) break;
+                slot = (slot + 1) & (INDEX_SIZE - 1);
+            }
+
+            if (this->Index[slot] == NONE)
+            {
+                if (this->FreeHead == NONE)
+                {
+                    ++this->Overflows;
+                    return true;
+                }
+
+                const std::uint16_t handle = this->FreeHead;
+                this->FreeHead             = this->States[handle].NextFree;
+
+                State& state     = this->States[handle];
+                state            = {};
+                state.Event      = static_cast<std::uint8_t>(event);
+                state.A          = a;
+                state.B          = b;
+                state.Tokens     = static_cast<float>(policy.Burst);
+                state.RefilledAt = tick;
+                this->Index[slot] = handle;
+                ++this->Size;
+            }
+
+            const std::uint16_t handle = this->Index[slot];
+            State&              state  = this->States[handle];
+
+            if (tick < state.ReadyAt && (policy.BreakThrough <= 0.0f || gain < state.LastGain * policy.BreakThrough)) return false;
+
+            if (policy.Burst > 0)
+            {
+                const float refilled = static_cast<float>(tick - state.RefilledAt) * TICK_SECONDS * policy.Rate;
+                state.Tokens         = std::min(state.Tokens + refilled, static_cast<float>(policy.Burst));
+                state.RefilledAt     = tick;
+                if (state.Tokens < 1.0f) return false;
+
+                state.Tokens -= 1.0f;
+            }
+
+            // Whole microseconds first, so 0.2 s is 20 ticks and not 21 by a float's worth
+            const auto cooldown = std::chrono::round<std::chrono::microseconds>(std::chrono::duration<float>(policy.Cooldown));
+            state.ReadyAt       = tick + static_cast<std::uint64_t>((cooldown + TICK - Clock::duration(1)) / TICK);
+            state.LastGain      = gain;
+
+            // Back to new once cooled down with a full bucket, whichever is later
+            std::uint64_t idleAt = state.ReadyAt;
+            if (policy.Burst > 0)
+            {
+                const float missing = static_cast<float>(policy.Burst) - state.Tokens;
+                idleAt              = std::max(idleAt, tick + static_cast<std::uint64_t>(std::ceil(missing / policy.Rate / TICK_SECONDS)));
+            }
+            this->Wheel.Schedule(handle, idleAt);
+
+            return true;
+        }
+
+        void Clear()
+        {
+            this->Wheel.Clear();
+            this->Index.fill(NONE);
+            for (std::size_t i = 0; i < CAPACITY; ++i)
+            {
+                this->States[i].NextFree = i + 1 < CAPACITY ? static_cast<std::uint16_t>(i + 1) : NONE;
+            }
+            this->FreeHead = 0;
+            this->Size     = 0;
+        }
+
+        // States held, each an event or pair still throttled
+        [[nodiscard]] std::size_t GetSize() const
+        {
+            return this->Size;
+        }
+
+        // Plays let through because the pool was full
+        [[nodiscard]] std::uint64_t GetOverflows() const
+        {
+            return this->Overflows;
+        }
+
+    private:
+        static constexpr std::uint16_t NONE         = 0xFFFF;
+        static constexpr float         TICK_SECONDS = std::chrono::duration<float>(TICK).count();
+
+        static_assert(CAPACITY < NONE && (INDEX_SIZE & (INDEX_SIZE - 1)) == 0);
+
+        struct State
+        {
+            std::uintptr_t A          = 0;
+            std::uintptr_t B          = 0;
+            std::uint64_t  ReadyAt    = 0; // In ticks, when the cooldown is over
+            std::uint64_t  RefilledAt = 0; // In ticks, when Tokens was last topped up
+            float          Tokens     = 0.0f;
+            float          LastGain   = 0.0f; // Of the last play let through
+            std::uint16_t  NextFree   = NONE; // In the pool's free list, while not in use
+            std::uint8_t   Event      = 0;
+        };
+
+        static std::size_t GetHome(const std::size_t event, const std::uintptr_t a, const std::uintptr_t b)
+        {
+            // Objects are aligned, so the low bits say nothing
+            std::uint64_t mixed = (static_cast<std::uint64_t>(a >> 3) + event) * 0x9E3779B97F4A7C15ull;
+            mixed              ^= static_cast<std::uint64_t>(b >> 3) + (mixed >> 29);
+            mixed              *= 0xBF58476D1CE4E5B9ull;
+            return static_cast<std::size_t>(mixed >> 32) & (INDEX_SIZE - 1);
+        }
+
+        // Of a state that's due, so unscheduled already
+        void Remove(const std::size_t handle)
+        {
+            State& state = this->States[handle];
+
+            std::size_t slot = GetHome(state.Event, state.A, state.B);
+            while (this->Index[slot] != handle) slot = (slot + 1) & (INDEX_SIZE - 1);
+
+            this->Index[slot] = NONE;
+            state.NextFree    = this->FreeHead;
+            this->FreeHead    = static_cast<std::uint16_t>(handle);
+            --this->Size;
+
+            // Pulls back whatever probed past the hole, as long as that doesn't put it before its home
+            std::size_t hole = slot;
+            for (std::size_t next = (slot + 1) & (INDEX_SIZE - 1); this->Index[next] != NONE; next = (next + 1) & (INDEX_SIZE - 1))
+            {
+                const State&      moved = this->States[this->Index[next]];
+                const std::size_t home  = GetHome(moved.Event, moved.A, moved.B);
+                if (((next - home) & (INDEX_SIZE - 1)) < ((next - hole) & (INDEX_SIZE - 1))) continue;
+
+                this->Index[hole] = this->Index[next];
+                this->Index[next] = NONE;
+                hole              = next;
+            }
+        }
+
+        std::array<State, CAPACITY>           States;
+        std::array<std::uint16_t, INDEX_SIZE> Index; // Into States, by key
+        TimerWheel<CAPACITY>                  Wheel; // When each state is back to new
+        std::uint16_t                         FreeHead  = 0;
+        std::size_t                           Size      = 0;
+        std::uint64_t                         Overflows = 0;
+    };
+}
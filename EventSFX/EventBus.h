@@ -0,0 +1,102 @@
+//=======================================================================
+/** EventBus.h
+ * Hooks publish what happened, subscribers take it from there
+ */
+//=======================================================================
+
+#pragma once
+
+#include "SoundInterface/CommandQueue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace RlEvents
+{
+    /*
+     * Publishing is a slot copy into a preallocated ring and a wake-up,
+     * however many subscribers there are, so hooks stay cheap. One
+     * thread hands every record to each subscriber in turn, in the order
+     * they subscribed and the records were published; a full ring drops
+     * the record and counts it. Subscribers are added before the bus
+     * starts, as its thread reads the list without a lock.
+     */
+    template <typename Event, std::size_t Capacity>
+    class EventBus
+    {
+    public:
+        using Handler = std::function<void(const Event&)>;
+
+        struct Subscriber
+        {
+            std::string Name; // For logs
+            Handler     Handle;
+        };
+
+        EventBus() = default;
+
+        ~EventBus()
+        {
+            this->Stop();
+        }
+
+        EventBus(const EventBus&)            = delete;
+        EventBus& operator=(const EventBus&) = delete;
+
+        // False once the bus is running
+        bool Subscribe(std::string name, Handler handler)
+        {
+            if (this->IsRunning) return false;
+
+            this->Subscribers.push_back({std::move(name), std::move(handler)});
+            return true;
+        }
+
+        void Start()
+        {
+            if (this->IsRunning) return;
+
+            this->IsRunning = true;
+            this->Thread.Start(
+                [this](const Event& event)
+                {
+                    for (const Subscriber& subscriber : this->Subscribers)
+                    {
+                        subscriber.Handle(event);
+                    }
+                });
+        }
+
+        // Records still in the ring are dropped; subscribers stay for the next start
+        void Stop()
+        {
+            this->Thread.Stop();
+            this->IsRunning = false;
+        }
+
+        // Any thread, never blocks; false if the record was dropped
+        bool Publish(const Event& event)
+        {
+            return this->Thread.Post(event);
+        }
+
+        [[nodiscard]] std::uint64_t GetDropped() const
+        {
+            return this->Thread.GetDropped();
+        }
+
+        [[nodiscard]] const std::vector<Subscriber>& GetSubscribers() const
+        {
+            return this->Subscribers;
+        }
+
+    private:
+        std::vector<Subscriber>                        Subscribers;
+        SoundInterface::CommandThread<Event, Capacity> Thread;
+        bool                                           IsRunning = false;
+    };
+}
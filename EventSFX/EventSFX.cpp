@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "EventSFX.h"
+#include "Benchmarks.h"
 
 BAKKESMOD_PLUGIN(EventSfx, "EventSFX", plugin_version, PLUGINTYPE_FREEPLAY)
 
@@ -31,6 +32,7 @@ void EventSfx::onLoad()
     {
         this->Settings->SetDefaults();
     }
+    this->PublishSettings();
 
     // Run the plugin setup
     this->RunSetup();
@@ -131,7 +133,7 @@ void EventSfx::InitializeNotifiers()
     );
 
     // Notifier: Set the volume
-    this->cvarManager->registerNotifier(
+    this->RegisterSettingsNotifier(
         SET_PLUGIN_VOLUME_NOTIFIER,
         [this](const std::vector<std::string>& args)
         {
@@ -164,7 +166,7 @@ void EventSfx::InitializeNotifiers()
     );
 
     // Notifier: Toggle 3D sound tracking
-    this->cvarManager->registerNotifier(
+    this->RegisterSettingsNotifier(
         TOGGLE_SOUNDTRACKING_NOTIFIER,
         [this](std::vector<std::string>)
         {
@@ -184,7 +186,7 @@ void EventSfx::InitializeNotifiers()
     );
 
     // Notifier: Enable 3D sound tracking
-    this->cvarManager->registerNotifier(
+    this->RegisterSettingsNotifier(
         ENABLE_SOUNDTRACKING_NOTIFIER,
         [this](std::vector<std::string>)
         {
@@ -199,7 +201,7 @@ void EventSfx::InitializeNotifiers()
     );
 
     // Notifier: Disable 3D sound tracking
-    this->cvarManager->registerNotifier(
+    this->RegisterSettingsNotifier(
         DISABLE_SOUNDTRACKING_NOTIFIER,
         [this](std::vector<std::string>)
         {
@@ -214,7 +216,7 @@ void EventSfx::InitializeNotifiers()
     );
 
     // Notifier: Toggle crossbar pling
-    this->cvarManager->registerNotifier(
+    this->RegisterSettingsNotifier(
         TOGGLE_PLING_NOTIFIER,
         [this](std::vector<std::string>)
         {
@@ -225,7 +227,7 @@ void EventSfx::InitializeNotifiers()
     );
 
     // Notifier: Disable crossbar pling
-    this->cvarManager->registerNotifier(
+    this->RegisterSettingsNotifier(
         DISABLE_PLING_NOTIFIER,
         [this](std::vector<std::string>)
         {
@@ -236,7 +238,7 @@ void EventSfx::InitializeNotifiers()
     );
 
     // Notifier: Enable crossbar pling
-    this->cvarManager->registerNotifier(
+    this->RegisterSettingsNotifier(
         DISABLE_PLING_NOTIFIER,
         [this](std::vector<std::string>)
         {
@@ -246,12 +248,12 @@ void EventSfx::InitializeNotifiers()
         PERMISSION_ALL
     );
 
-    for (int i = 0; i < this->Settings->Sounds.size(); ++i)
+    for (int i = 0; i < RlEvents::GetEventRegistry().GetCount(); ++i)
     {
         auto eventId = static_cast<RlEvents::Kind>(i);
 
         // Notifier: Toggle rl_events
-        this->cvarManager->registerNotifier(
+        this->RegisterSettingsNotifier(
             TOGGLE_EVENT_NOTIFIER_PARTIAL + GetEventStringId(eventId),
             [this, i](std::vector<std::string>)
             {
@@ -262,7 +264,7 @@ void EventSfx::InitializeNotifiers()
         );
 
         // Notifier: Enable rl_events
-        this->cvarManager->registerNotifier(
+        this->RegisterSettingsNotifier(
             ENABLE_EVENT_NOTIFIER_PARTIAL + GetEventStringId(eventId),
             [this, i](std::vector<std::string>)
             {
@@ -273,7 +275,7 @@ void EventSfx::InitializeNotifiers()
         );
 
         // Notifier: Disable rl_events
-        this->cvarManager->registerNotifier(
+        this->RegisterSettingsNotifier(
             DISABLE_EVENT_NOTIFIER_PARTIAL + GetEventStringId(eventId),
             [this, i](std::vector<std::string>)
             {
@@ -284,26 +286,66 @@ void EventSfx::InitializeNotifiers()
         );
 
         // Notifier: Set sound for event
-        this->cvarManager->registerNotifier(
+        this->RegisterSettingsNotifier(
             SET_EVENT_SOUND_NOTIFIER_PARTIAL + GetEventStringId(eventId),
             [this, i](const std::vector<std::string>& args)
             {
                 if (args.size() < 2) return;
 
-                std::string soundId = args[1];
+                // Any number of them, to be picked between
+                std::vector<std::string> soundIds;
+                for (std::size_t a = 1; a < args.size(); ++a)
+                {
+                    const std::string& soundId = args[a];
+
+                    HRESULT hr = this->SoundManager.LoadSound(soundId, true);
+                    if (FAILED(hr))
+                    {
+                        LOG("LOAD FAILED. SOUNDID: {}, HRESULT: {}", soundId, hr);
+                        return;
+                    }
+                    soundIds.push_back(soundId);
+                }
+
+                // Set the sound IDs
+                SoundSettings& soundSettings = this->Settings->Sounds[i];
+                soundSettings.SoundIds       = std::move(soundIds);
+                this->SoundManager.LoadContainer(i, soundSettings.GetLayers(), soundSettings.Selection, soundSettings.LayerCrossfade);
+            },
+            "Set custom " + GetEventLabel(eventId) + " sounds, one picked per play",
+            PERMISSION_ALL
+        );
+
+        // Notifier: Set how event sounds are picked
+        this->RegisterSettingsNotifier(
+            SET_EVENT_PICK_NOTIFIER_PARTIAL + GetEventStringId(eventId),
+            [this, i](const std::vector<std::string>& args)
+            {
+                if (args.size() < 2) return;
+
+                const std::string& modeStr = args[1];
 
-                HRESULT hr = this->SoundManager.LoadSound(soundId, true);
-                if (FAILED(hr))
+                std::optional<SoundInterface::SelectionMode> mode;
+                for (std::size_t m = 0; m < SoundInterface::NUM_SELECTION_MODES; ++m)
                 {
-                    LOG("LOAD FAILED. SOUNDID: {}, HRESULT: {}", soundId, hr);
+                    const auto candidate = static_cast<SoundInterface::SelectionMode>(m);
+                    if (SoundInterface::GetSelectionModeLabel(candidate) == modeStr)
+                    {
+                        mode = candidate;
+                    }
                 }
-                else
+
+                if (!mode.has_value())
                 {
-                    // Set the sound ID
-                    this->Settings->Sounds[i].SoundId = soundId;
+                    LOG("INVALID ARGUMENT: UNKNOWN SELECTION MODE '" + modeStr + "'.");
+                    return;
                 }
+
+                SoundSettings& soundSettings = this->Settings->Sounds[i];
+                soundSettings.Selection      = mode.value();
+                this->SoundManager.LoadContainer(i, soundSettings.GetLayers(), soundSettings.Selection, soundSettings.LayerCrossfade);
             },
-            "Set custom " + GetEventLabel(eventId) + " sound",
+            "Set how " + GetEventLabel(eventId) + " sounds are picked: random, no-repeat, round-robin or shuffle",
             PERMISSION_ALL
         );
 
@@ -319,7 +361,7 @@ void EventSfx::InitializeNotifiers()
         );
 
         // Notifier: Set event volume
-        this->cvarManager->registerNotifier(
+        this->RegisterSettingsNotifier(
             SET_EVENT_VOLUME_NOTIFIER_PARTIAL + GetEventStringId(eventId),
             [this, i](const std::vector<std::string>& args)
             {
@@ -352,7 +394,7 @@ void EventSfx::InitializeNotifiers()
         );
 
         // Notifier: Set event delay
-        this->cvarManager->registerNotifier(
+        this->RegisterSettingsNotifier(
             SET_EVENT_DELAY_NOTIFIER_PARTIAL + GetEventStringId(eventId),
             [this, i](const std::vector<std::string>& args)
             {
@@ -380,6 +422,235 @@ void EventSfx::InitializeNotifiers()
             "Set the " + GetEventLabel(eventId) + " delay",
             PERMISSION_ALL
         );
+
+        // Notifier: Set event effect send
+        this->RegisterSettingsNotifier(
+            SET_EVENT_SEND_NOTIFIER_PARTIAL + GetEventStringId(eventId),
+            [this, i](const std::vector<std::string>& args)
+            {
+                if (args.size() < 3) return;
+
+                const std::string& busStr   = args[1];
+                const std::string  levelStr = args[2];
+
+                std::optional<std::size_t> busIndex;
+                for (std::size_t b = 0; b < SoundInterface::NUM_EFFECT_BUSES; ++b)
+                {
+                    if (SoundInterface::GetEffectBusLabel(static_cast<SoundInterface::EffectBus>(b)) == busStr)
+                    {
+                        busIndex = b;
+                    }
+                }
+
+                if (!busIndex.has_value())
+                {
+                    LOG("INVALID ARGUMENT: UNKNOWN EFFECT BUS '" + busStr + "'.");
+                    return;
+                }
+
+                try
+                {
+                    const int levelPercentage = std::stof(levelStr);
+                    if (levelPercentage >= MIN_SEND_LEVEL_PERCENTAGE
+                        && levelPercentage <= MAX_SEND_LEVEL_PERCENTAGE)
+                    {
+                        this->Settings->Sounds[i].Sends[busIndex.value()] = levelPercentage / 100.0f;
+                    }
+                    else
+                    {
+                        LOG("INVALID ARGUMENT: SEND LEVEL SHOULD BE BETWEEN {} AND {}.", MIN_SEND_LEVEL_PERCENTAGE,
+                            MAX_SEND_LEVEL_PERCENTAGE);
+                    }
+                }
+                catch ([[maybe_unused]] const std::invalid_argument& e)
+                {
+                    LOG("INVALID ARGUMENT: COULD NOT CONVERT '" + levelStr + "' TO AN INT.");
+                }
+            },
+            "Set the " + GetEventLabel(eventId) + " effect send levels",
+            PERMISSION_ALL
+        );
+
+        // Notifier: Set event instance limit
+        this->RegisterSettingsNotifier(
+            SET_EVENT_LIMIT_NOTIFIER_PARTIAL + GetEventStringId(eventId),
+            [this, i](const std::vector<std::string>& args)
+            {
+                if (args.size() < 2) return;
+
+                const std::string maxStr = args[1];
+
+                SoundInterface::InstanceLimit limit = this->Settings->Sounds[i].Limit;
+                if (args.size() >= 3)
+                {
+                    const std::string& policyStr = args[2];
+
+                    std::optional<SoundInterface::LimitPolicy> policy;
+                    for (std::size_t p = 0; p < SoundInterface::NUM_LIMIT_POLICIES; ++p)
+                    {
+                        const auto candidate = static_cast<SoundInterface::LimitPolicy>(p);
+                        if (SoundInterface::GetLimitPolicyLabel(candidate) == policyStr)
+                        {
+                            policy = candidate;
+                        }
+                    }
+
+                    if (!policy.has_value())
+                    {
+                        LOG("INVALID ARGUMENT: UNKNOWN LIMIT POLICY '" + policyStr + "'.");
+                        return;
+                    }
+                    limit.Policy = policy.value();
+                }
+
+                try
+                {
+                    const int maxInstances = std::stoi(maxStr);
+                    if (maxInstances >= static_cast<int>(MIN_MAX_INSTANCES)
+                        && maxInstances <= static_cast<int>(MAX_MAX_INSTANCES))
+                    {
+                        limit.MaxInstances              = static_cast<std::uint32_t>(maxInstances);
+                        this->Settings->Sounds[i].Limit = limit;
+                    }
+                    else
+                    {
+                        LOG("INVALID ARGUMENT: MAX INSTANCES SHOULD BE BETWEEN {} AND {}.", MIN_MAX_INSTANCES,
+                            MAX_MAX_INSTANCES);
+                    }
+                }
+                catch ([[maybe_unused]] const std::invalid_argument& e)
+                {
+                    LOG("INVALID ARGUMENT: COULD NOT CONVERT '" + maxStr + "' TO AN INT.");
+                }
+            },
+            "Set how many " + GetEventLabel(eventId) + " sounds may play at once (0 for no limit), and what gives beyond that",
+            PERMISSION_ALL
+        );
+
+        // Notifier: Set event cooldown
+        this->RegisterSettingsNotifier(
+            SET_EVENT_COOLDOWN_NOTIFIER_PARTIAL + GetEventStringId(eventId),
+            [this, i](const std::vector<std::string>& args)
+            {
+                if (args.size() < 2) return;
+
+                RlEvents::CooldownPolicy cooldown = this->Settings->Sounds[i].Cooldown;
+                if (args.size() >= 3)
+                {
+                    const std::string& scopeStr = args[2];
+
+                    std::optional<RlEvents::CooldownScope> scope;
+                    for (std::size_t s = 0; s < RlEvents::NUM_COOLDOWN_SCOPES; ++s)
+                    {
+                        const auto candidate = static_cast<RlEvents::CooldownScope>(s);
+                        if (RlEvents::GetCooldownScopeLabel(candidate) == scopeStr)
+                        {
+                            scope = candidate;
+                        }
+                    }
+
+                    if (!scope.has_value())
+                    {
+                        LOG("INVALID ARGUMENT: UNKNOWN COOLDOWN SCOPE '" + scopeStr + "'.");
+                        return;
+                    }
+                    cooldown.Scope = scope.value();
+                }
+
+                try
+                {
+                    cooldown.Cooldown = std::stof(args[1]);
+                    if (args.size() >= 4) cooldown.Burst = static_cast<std::uint32_t>(std::max(std::stoi(args[3]), 0));
+                    if (args.size() >= 5) cooldown.Rate = std::stof(args[4]);
+
+                    if (cooldown.Cooldown >= MIN_COOLDOWN && cooldown.Cooldown <= MAX_COOLDOWN
+                        && cooldown.Burst <= MAX_COOLDOWN_BURST)
+                    {
+                        RlEvents::SanitizeCooldownPolicy(cooldown);
+                        this->Settings->Sounds[i].Cooldown = cooldown;
+                    }
+                    else
+                    {
+                        LOG("INVALID ARGUMENT: COOLDOWN SHOULD BE BETWEEN {} AND {} SECONDS, AND BURST AT MOST {}.",
+                            MIN_COOLDOWN, MAX_COOLDOWN, MAX_COOLDOWN_BURST);
+                    }
+                }
+                catch ([[maybe_unused]] const std::invalid_argument& e)
+                {
+                    LOG("INVALID ARGUMENT: COULD NOT CONVERT THE COOLDOWN, BURST OR RATE TO A NUMBER.");
+                }
+            },
+            "Set how long after a " + GetEventLabel(eventId) + " sound another may play, for the event or each pair"
+            " of things that make it, and optionally a burst of plays let through at once, refilled at a rate a second",
+            PERMISSION_ALL
+        );
+
+        if (!IsEvent3D(eventId)) continue;
+
+        // Notifier: Set event distance curve
+        this->RegisterSettingsNotifier(
+            SET_EVENT_CURVE_NOTIFIER_PARTIAL + GetEventStringId(eventId),
+            [this, i](const std::vector<std::string>& args)
+            {
+                if (args.size() < 4) return;
+
+                const std::string& modelStr = args[1];
+
+                SoundInterface::Dsp::DistanceCurve curve;
+
+                std::optional<SoundInterface::Dsp::DistanceModel> model;
+                for (std::size_t m = 0; m < SoundInterface::Dsp::NUM_DISTANCE_MODELS; ++m)
+                {
+                    const auto candidate = static_cast<SoundInterface::Dsp::DistanceModel>(m);
+                    if (SoundInterface::Dsp::GetDistanceModelLabel(candidate) == modelStr)
+                    {
+                        model = candidate;
+                    }
+                }
+
+                if (!model.has_value())
+                {
+                    LOG("INVALID ARGUMENT: UNKNOWN DISTANCE MODEL '" + modelStr + "'.");
+                    return;
+                }
+                curve.Model = model.value();
+
+                try
+                {
+                    curve.MinDistance = std::stof(args[2]);
+                    curve.MaxDistance = std::stof(args[3]);
+
+                    // Custom points as distance:gain pairs
+                    for (std::size_t p = 4; p < args.size(); ++p)
+                    {
+                        const std::size_t separator = args[p].find(':');
+                        if (separator == std::string::npos)
+                        {
+                            LOG("INVALID ARGUMENT: EXPECTED DISTANCE:GAIN, GOT '" + args[p] + "'.");
+                            return;
+                        }
+
+                        curve.Points.push_back({
+                            std::stof(args[p].substr(0, separator)),
+                            std::stof(args[p].substr(separator + 1))
+                        });
+                    }
+                }
+                catch ([[maybe_unused]] const std::invalid_argument& e)
+                {
+                    LOG("INVALID ARGUMENT: COULD NOT CONVERT THE DISTANCES TO NUMBERS.");
+                    return;
+                }
+
+                SoundInterface::Dsp::SanitizeDistanceCurve(curve);
+
+                SoundSettings& soundSettings = this->Settings->Sounds[i];
+                soundSettings.Distance       = curve;
+                soundSettings.BakeDistanceCurve();
+            },
+            "Set the " + GetEventLabel(eventId) + " distance attenuation curve",
+            PERMISSION_ALL
+        );
     }
 
     // Notifier: Save settings
@@ -416,6 +687,154 @@ void EventSfx::InitializeNotifiers()
         "Load plugin settings",
         PERMISSION_ALL
     );
+
+    // Notifier: Run benchmarks
+    this->cvarManager->registerNotifier(
+        BENCHMARK_NOTIFIER,
+        [](const std::vector<std::string>& args)
+        {
+            const std::string name = args.size() < 2 ? "all" : args[1];
+
+            bool found = false;
+            for (const auto& benchmark : Benchmarks::GetBenchmarks())
+            {
+                if (name != "all" && name != benchmark.Name) continue;
+                found = true;
+
+                LOG("BENCHMARK: {} ({})", benchmark.Name, benchmark.Description);
+                const Benchmarks::Report report = benchmark.Run();
+                for (const auto& line : report.Lines)
+                {
+                    LOG("  {}", line);
+                }
+                if (!report.IsPassing)
+                {
+                    LOG("  FAILED ITS CHECKS");
+                }
+            }
+
+            if (!found)
+            {
+                LOG("INVALID ARGUMENT: UNKNOWN BENCHMARK '" + name + "'.");
+            }
+        },
+        "Run the offline audio benchmarks",
+        PERMISSION_ALL
+    );
+
+    // Notifier: Event latency
+    this->cvarManager->registerNotifier(
+        STATS_NOTIFIER,
+        [this](const std::vector<std::string>& args)
+        {
+            using SoundInterface::LatencyStage;
+
+            SoundInterface::LatencyStats& latency = this->SoundManager.GetLatencyStats();
+
+            const std::string action = args.size() < 2 ? "show" : args[1];
+            if (action == "on" || action == "off")
+            {
+                latency.SetEnabled(action == "on");
+                LOG("LATENCY STATS {}.", action == "on" ? "ENABLED" : "DISABLED");
+                return;
+            }
+            if (action == "reset")
+            {
+                latency.Reset();
+                this->EventCounts.Reset();
+                LOG("LATENCY STATS RESET.");
+                return;
+            }
+            if (action != "show")
+            {
+                LOG("INVALID ARGUMENT: EXPECTED 'show', 'on', 'off' OR 'reset', GOT '" + action + "'.");
+                return;
+            }
+
+            LOG("LATENCY STATS ({}), IN MICROSECONDS:", latency.IsEnabled() ? "on" : "off");
+            for (std::size_t i = 0; i < RlEvents::GetEventRegistry().GetCount(); ++i)
+            {
+                for (std::size_t j = 0; j < SoundInterface::NUM_LATENCY_STAGES; ++j)
+                {
+                    const auto stage   = static_cast<LatencyStage>(j);
+                    const auto summary = latency.Get(i, stage).Summarize();
+                    if (summary.Count == 0) continue;
+
+                    LOG("  {} {}: n={} p50={} p90={} p99={} max={}",
+                        GetEventLabel(RlEvents::Kind(static_cast<int>(i))),
+                        SoundInterface::GetLatencyStageLabel(stage),
+                        summary.Count, summary.P50, summary.P90, summary.P99, summary.Max);
+                }
+            }
+
+            // What went through the bus, sound or not
+            std::string counts;
+            for (std::size_t i = 0; i < RlEvents::NUM_GAME_EVENT_TYPES; ++i)
+            {
+                const auto type = static_cast<RlEvents::GameEventType>(i);
+                counts += std::format(" {}={}", RlEvents::GetGameEventTypeLabel(type), this->EventCounts.Get(type));
+            }
+            LOG("GAME EVENTS:{} dropped={}", counts, this->GameEvents.GetDropped());
+        },
+        "Show event latency percentiles, or turn measuring them on, off or reset them",
+        PERMISSION_ALL
+    );
+
+    // Notifier: Recent game events
+    this->cvarManager->registerNotifier(
+        RECORD_NOTIFIER,
+        [this](const std::vector<std::string>& args)
+        {
+            const std::string action = args.size() < 2 ? "show" : args[1];
+            if (action == "clear")
+            {
+                this->EventRecorder.Clear();
+                LOG("RECORDED EVENTS CLEARED.");
+                return;
+            }
+            if (action == "save")
+            {
+                const std::string filename = args.size() < 3 ? "eventsfx_events.csv" : args[2];
+                if (!this->EventRecorder.SaveCsv(this->gameWrapper->GetDataFolder() / filename))
+                {
+                    LOG("COULD NOT SAVE RECORDED EVENTS TO '" + filename + "'.");
+                    return;
+                }
+                LOG("RECORDED EVENTS SAVED TO '" + filename + "'.");
+                return;
+            }
+            if (action != "show")
+            {
+                LOG("INVALID ARGUMENT: EXPECTED 'show', 'save' OR 'clear', GOT '" + action + "'.");
+                return;
+            }
+
+            std::size_t count = 10;
+            if (args.size() > 2)
+            {
+                try
+                {
+                    count = std::stoul(args[2]);
+                }
+                catch ([[maybe_unused]] const std::exception& e)
+                {
+                    LOG("INVALID ARGUMENT: COULD NOT CONVERT '" + args[2] + "' TO AN INT.");
+                    return;
+                }
+            }
+
+            for (const RlEvents::GameEvent& event : this->EventRecorder.GetRecent(count))
+            {
+                LOG("  {}{} clock={} player={:d} team={:d} at ({:.0f}, {:.0f}, {:.0f})",
+                    RlEvents::GetGameEventTypeLabel(event.Type),
+                    event.Type == RlEvents::GameEventType::Request ? " " + GetEventStringId(event.Event) : "",
+                    event.ClockSeconds, event.IsPlayer, event.IsPlayerTeam,
+                    event.Location.X, event.Location.Y, event.Location.Z);
+            }
+        },
+        "Show the last game events the hooks saw, save them as CSV in the data folder, or clear them",
+        PERMISSION_ALL
+    );
 }
 
 
@@ -423,12 +842,25 @@ void EventSfx::InitializeNotifiers()
 
 void EventSfx::InitializeHooks()
 {
-    // NotedBumps
+    // Addresses from before may be anything now
+    this->StatEvents.Clear();
+
+    // And so may this match's once it's gone, as the next one's objects can be made where they were
+    this->gameWrapper->HookEventPost(
+        "Function TAGame.GameEvent_Soccar_TA.Destroyed",
+        [this](std::string)
+        {
+            this->StatEvents.Clear();
+        });
+
+    // Bumps
     this->gameWrapper->HookEventWithCaller<CarWrapper>(
         "Function TAGame.Car_TA.IsBumperHit",
         [this](const CarWrapper& caller, void* params, std::string)
         {
+            this->MarkHook();
             this->OnBump(caller, static_cast<BumpParams*>(params));
+            this->HookedAt = {};
         });
 
     // Other stats
@@ -436,7 +868,9 @@ void EventSfx::InitializeHooks()
         "Function TAGame.GFxHUD_TA.HandleStatTickerMessage",
         [this](ServerWrapper, void* params, std::string)
         {
+            this->MarkHook();
             this->OnStatTickerMessage(static_cast<StatTickerParams*>(params));
+            this->HookedAt = {};
         });
 
     // Crossbar hit
@@ -444,7 +878,39 @@ void EventSfx::InitializeHooks()
         "Function TAGame.GoalCrossbarVolumeManager_TA.TriggerHit",
         [this](auto caller, void* params, ...)
         {
+            this->MarkHook();
             this->OnCrossbarTrigger(static_cast<CrossbarParams*>(params));
+            this->HookedAt = {};
+        });
+
+    // Overtime
+    this->gameWrapper->HookEventWithCallerPost<ServerWrapper>(
+        "Function TAGame.GameEvent_Soccar_TA.OnOvertimeUpdated",
+        [this](const ServerWrapper& caller, void*, std::string)
+        {
+            this->MarkHook();
+            this->OnOvertime(caller);
+            this->HookedAt = {};
+        });
+
+    // Kickoff countdown
+    this->gameWrapper->HookEventPost(
+        "Function GameEvent_Soccar_TA.Countdown.BeginState",
+        [this](std::string)
+        {
+            this->MarkHook();
+            this->OnKickoffCountdown();
+            this->HookedAt = {};
+        });
+
+    // Ball hit
+    this->gameWrapper->HookEventWithCaller<BallWrapper>(
+        "Function TAGame.Ball_TA.OnCarTouch",
+        [this](const BallWrapper& caller, void* params, std::string)
+        {
+            this->MarkHook();
+            this->OnBallTouch(caller, static_cast<BallTouchParams*>(params));
+            this->HookedAt = {};
         });
 
     // Recommended volume
@@ -496,14 +962,20 @@ void EventSfx::InitializeHooks()
 
 void EventSfx::DeinitializeHooks() const
 {
+    // Each as it was hooked in InitializeHooks, Post or not
     this->UnhookSoundTracking();
-    this->gameWrapper->UnhookEventPost("Function TAGame.GFxData_Settings_TA.SetCameraAngle");
-    this->gameWrapper->UnhookEventPost("Function TAGame.GFxData_Settings_TA.SetCameraHeight");
-    this->gameWrapper->UnhookEventPost("Function TAGame.GFxData_Settings_TA.SetCameraDistance");
-    this->gameWrapper->UnhookEvent("Function TAGame.GFxData_Settings_TA.SetMasterVolume");
+    this->gameWrapper->UnhookEventPost("Function TAGame.GameEvent_Soccar_TA.Destroyed");
+    this->gameWrapper->UnhookEvent("Function TAGame.Car_TA.IsBumperHit");
+    this->gameWrapper->UnhookEventPost("Function TAGame.GFxHUD_TA.HandleStatTickerMessage");
+    this->gameWrapper->UnhookEvent("Function TAGame.GoalCrossbarVolumeManager_TA.TriggerHit");
+    this->gameWrapper->UnhookEventPost("Function TAGame.GameEvent_Soccar_TA.OnOvertimeUpdated");
+    this->gameWrapper->UnhookEventPost("Function GameEvent_Soccar_TA.Countdown.BeginState");
+    this->gameWrapper->UnhookEvent("Function TAGame.Ball_TA.OnCarTouch");
     this->gameWrapper->UnhookEvent("Function TAGame.SoundSettingsManager_TA.SetSoundVolume");
-    this->gameWrapper->UnhookEvent("Function TAGame.GFxHUD_TA.HandleStatTickerMessage");
-    this->gameWrapper->UnhookEvent("Function TAGame.Car_TA.EventBumpedCar");
+    this->gameWrapper->UnhookEvent("Function TAGame.GFxData_Settings_TA.SetMasterVolume");
+    this->gameWrapper->UnhookEventPost("Function TAGame.GFxData_Settings_TA.SetCameraDistance");
+    this->gameWrapper->UnhookEventPost("Function TAGame.GFxData_Settings_TA.SetCameraHeight");
+    this->gameWrapper->UnhookEventPost("Function TAGame.GFxData_Settings_TA.SetCameraAngle");
 }
 
 
@@ -512,8 +984,8 @@ void EventSfx::DeinitializeHooks() const
 bool EventSfx::InitializeAudio()
 {
     // Get relevant settings
-    auto&      outputId = this->Settings->OutputId;
-    const auto volume   = this->Settings->Volume;
+    const auto& outputId = this->Settings->OutputId;
+    const auto  volume   = this->Settings->Volume;
 
     // Initialize sound manager
     HRESULT hr = this->SoundManager.Initialize(outputId, volume);
@@ -526,11 +998,36 @@ bool EventSfx::InitializeAudio()
     // Preload sounds
     this->SoundManager.PreloadSounds();
 
+    // What the hooks publish goes to each of these in turn, off the game thread; event sounds are played from here on
+    this->GameEvents.Subscribe(
+        "sound rules",
+        [this](const RlEvents::GameEvent& event)
+        {
+            const PluginSettingsPtr settings = this->PublishedSettings.load(std::memory_order_acquire);
+
+            const std::optional<RlEvents::Kind> eventId = this->SoundRules.Match(event, *settings);
+            if (eventId.has_value()) this->RunEventSound(event, eventId.value(), *settings);
+        });
+    this->GameEvents.Subscribe(
+        "counts",
+        [this](const RlEvents::GameEvent& event)
+        {
+            this->EventCounts.Count(event);
+        });
+    this->GameEvents.Subscribe(
+        "recorder",
+        [this](const RlEvents::GameEvent& event)
+        {
+            this->EventRecorder.Record(event);
+        });
+    this->GameEvents.Start();
+
     return true;
 }
 
 void EventSfx::DeinitializeAudio()
 {
+    this->GameEvents.Stop();
     this->SoundManager.Unload();
 }
 
@@ -552,33 +1049,39 @@ void EventSfx::UnhookSoundTracking() const
 
 /* EVENTS */
 
+void EventSfx::MarkHook()
+{
+    this->HookedAt = this->SoundManager.GetLatencyStats().IsEnabled()
+                         ? std::chrono::steady_clock::now()
+                         : std::chrono::steady_clock::time_point();
+}
+
 void EventSfx::OnBump(CarWrapper carWrapper, const BumpParams* bumpData)
 {
     if (carWrapper.IsNull()) return;
 
-    const bool isEnabled = this->Settings->Sounds[RlEvents::Kind::Bump].IsEnabled;
-    if (!isEnabled) return;
-
-    const auto now = std::chrono::steady_clock::now();
+    // The other car's hook can fire for the same bump, and pushing keeps them firing; the bump's cooldown, by pair, sees to that
+    const auto carId = carWrapper.memory_address;
 
-    for (auto& [carId, time] : this->NotedBumps)
+    // Against the other car when there is one, so two cars driving side by side barely touch
+    Vector relativeVelocity = carWrapper.GetVelocity();
+    if (bumpData->OtherCar)
     {
-        if (now - time > this->BumpTimeout)
-        {
-            this->NotedBumps.erase(carId);
-        }
+        CarWrapper otherCar(bumpData->OtherCar);
+        if (!otherCar.IsNull()) relativeVelocity = relativeVelocity - otherCar.GetVelocity();
     }
 
-    const auto carId = carWrapper.memory_address;
-    if (this->NotedBumps.contains(carId)) return;
-
-    this->NotedBumps[carId] = now;
-
-    this->PlayBumpSfx(bumpData->HitLocation);
+    RlEvents::GameEvent event;
+    event.Type     = RlEvents::GameEventType::Bump;
+    event.Location = bumpData->HitLocation;
+    event.Actor    = carId;
+    event.Other    = bumpData->OtherCar;
+    event.Is3D     = true;
 
-    if (!bumpData->OtherCar) return;
+    event.Inputs[static_cast<std::size_t>(SoundInterface::CurveInput::ImpactSpeed)] =
+        Utils::ComputeImpactSpeed(relativeVelocity, bumpData->HitNormal);
 
-    this->NotedBumps[bumpData->OtherCar] = now;
+    this->PublishEvent(event);
 
     /*
     // this->tmpBumpsDisabled = true;
@@ -593,117 +1096,61 @@ void EventSfx::OnBump(CarWrapper carWrapper, const BumpParams* bumpData)
 
 void EventSfx::OnStatTickerMessage(const StatTickerParams* statParams)
 {
-    auto receiver  = PriWrapper(statParams->Receiver);
-    auto victim    = PriWrapper(statParams->Victim);
-    auto statEvent = StatEventWrapper(statParams->StatEvent);
+    auto receiver = PriWrapper(statParams->Receiver);
+    auto victim   = PriWrapper(statParams->Victim);
 
     // Check if there is a receiver
     if (!receiver) return;
 
-    // Find the primary player's PRI
-    PlayerControllerWrapper playerController = this->gameWrapper->GetPlayerController();
-
-    if (!playerController)
-    {
-        DEBUGLOG("NULL CONTROLLER.");
-        return;
-    }
-
-    PriWrapper playerPri = playerController.GetPRI();
+    // Only those the rules know of; the name is only read for a stat event not seen before
+    const RlEvents::StatEvent stat = this->StatEvents.Resolve(
+        statParams->StatEvent,
+        [statParams] { return StatEventWrapper(statParams->StatEvent).GetEventName(); });
 
-    if (!playerPri)
-    {
-        DEBUGLOG("NULL PLAYER PRI.");
-        return;
-    }
+    const std::optional<RlEvents::GameEventType> type = RlEvents::GetGameEventType(stat);
+    if (!type.has_value()) return;
 
-    // Check what is enabled
-    const bool demosEnabled       = this->Settings->Sounds[RlEvents::Kind::Demo].IsEnabled;
-    const bool playerGoalsEnabled = this->Settings->Sounds[RlEvents::Kind::PlayerGoal].IsEnabled;
-    const bool teamGoalsEnabled   = this->Settings->Sounds[RlEvents::Kind::TeamGoal].IsEnabled;
-    const bool concedesEnabled    = this->Settings->Sounds[RlEvents::Kind::Concede].IsEnabled;
-    const bool savesEnabled       = this->Settings->Sounds[RlEvents::Kind::Save].IsEnabled;
-    const bool winsEnabled        = this->Settings->Sounds[RlEvents::Kind::Win].IsEnabled;
-    const bool lossesEnabled      = this->Settings->Sounds[RlEvents::Kind::Loss].IsEnabled;
-    const bool assistsEnabled     = this->Settings->Sounds[RlEvents::Kind::Assist].IsEnabled;
-
-    // Anyone
-    if (statEvent.GetEventName() == "Demolish" && demosEnabled)
-    {
-        this->PlayDemoSfx(victim.GetCar().GetLocation());
-        return;
-    }
+    RlEvents::GameEvent event;
+    event.Type  = type.value();
+    event.Stat  = stat;
+    event.Actor = receiver.memory_address;
+    event.Other = victim.memory_address;
 
-    // Player
-    if (playerPri.memory_address == receiver.memory_address)
+    // Heard where the victim was
+    if (event.Type == RlEvents::GameEventType::Demolish && victim)
     {
-        if (statEvent.GetEventName() == "Goal" && playerGoalsEnabled)
+        CarWrapper victimCar = victim.GetCar();
+        if (!victimCar.IsNull())
         {
-            this->PlayPlayerGoalSfx();
-            return;
-        }
-        if (statEvent.GetEventName() == "OwnGoal" && concedesEnabled)
-        {
-            this->PlayConcedeSfx();
-            return;
-        }
-        if (statEvent.GetEventName() == "Save" && savesEnabled)
-        {
-            this->PlaySaveSfx();
-            return;
-        }
-        if (statEvent.GetEventName() == "Win" && winsEnabled)
-        {
-            this->PlayWinSfx();
-            return;
-        }
-        if (statEvent.GetEventName() == "Assist"
-            && assistsEnabled && !teamGoalsEnabled)
-        {
-            this->PlayAssistSfx();
-            return;
+            event.Location = victimCar.GetLocation();
+            event.Is3D     = true;
         }
     }
 
-    // Player's team
-    if (playerPri.GetTeam().GetTeamIndex() == receiver.GetTeam().GetTeamIndex())
+    // Find the primary player's PRI; demolitions are anyone's, so they go without
+    PlayerControllerWrapper playerController = this->gameWrapper->GetPlayerController();
+    PriWrapper              playerPri        = playerController ? playerController.GetPRI() : PriWrapper(0);
+
+    if (playerPri)
     {
-        if (statEvent.GetEventName() == "Goal" && teamGoalsEnabled)
-        {
-            this->PlayTeamGoalSfx();
-        }
+        event.IsPlayer     = playerPri.memory_address == receiver.memory_address;
+        event.IsPlayerTeam = playerPri.GetTeam().GetTeamIndex() == receiver.GetTeam().GetTeamIndex();
     }
-    // Opponents' team
-    else
+    else if (event.Type != RlEvents::GameEventType::Demolish)
     {
-        if (statEvent.GetEventName() == "Goal" && concedesEnabled)
-        {
-            this->PlayConcedeSfx();
-            return;
-        }
-
-        if (statEvent.GetEventName() == "Win" && lossesEnabled)
-        {
-            if (this->TmpLossesDisabled) return;
-
-            this->TmpLossesDisabled = true;
-
-            this->PlayLossSfx();
-
-            // Time out so it won't play multiple times
-            this->gameWrapper->SetTimeout([this](GameWrapper*)
-            {
-                this->TmpLossesDisabled = true;
-            }, 1.0f);
-        }
+        DEBUGLOG(playerController ? "NULL PLAYER PRI." : "NULL CONTROLLER.");
+        return;
     }
+
+    this->PublishEvent(event);
 }
 
 void EventSfx::OnCrossbarTrigger(CrossbarParams* crossbarParams)
 {
-    const bool customEnabled = this->Settings->Sounds[RlEvents::Kind::Crossbar].IsEnabled;
-
-    const Vector location = crossbarParams->HitLocation;
+    RlEvents::GameEvent event;
+    event.Type     = RlEvents::GameEventType::Crossbar;
+    event.Location = crossbarParams->HitLocation;
+    event.Is3D     = true;
 
     // Is default pling enabled?
     if (!this->Settings->CrossbarPlingEnabled)
@@ -711,13 +1158,11 @@ void EventSfx::OnCrossbarTrigger(CrossbarParams* crossbarParams)
         crossbarParams->HitLocation = { 0, 0, 0 };
     }
 
-    if (!customEnabled) return;
-
     // Do we have a game state?
     auto state = this->gameWrapper->GetCurrentGameState();
     if (state.IsNull())
     {
-        this->PlayCrossbarSfx(location);
+        this->PublishEvent(event);
         return;
     }
 
@@ -725,50 +1170,75 @@ void EventSfx::OnCrossbarTrigger(CrossbarParams* crossbarParams)
     auto ball = state.GetBall();
     if (ball.IsNull())
     {
-        this->PlayCrossbarSfx(location);
+        this->PublishEvent(event);
         return;
     }
 
-    float multiplier;
+    // The layer follows the ball, and so does the volume the crossbar's cooldown compares hits by
+    const float speed = ball.GetVelocity().magnitude();
 
-    // Compute the multiplier
-    if (this->Settings->FixedCrossbarVolume)
-    {
-        multiplier = 1.0;
+    event.Actor = ball.memory_address;
+    event.Inputs[static_cast<std::size_t>(SoundInterface::CurveInput::ImpactSpeed)] = speed;
+    event.Inputs[static_cast<std::size_t>(SoundInterface::CurveInput::BallSpeed)]   = speed;
 
-        // LOG("MULTIPLIER: {}", multiplier);
-    }
-    else
-    {
-        float speed = ball.GetVelocity().magnitude();
-        multiplier = Utils::ComputeVolumeMultiplier(speed);
+    this->PublishEvent(event);
+}
 
-        // LOG("SPEED: {} ({}kph), MULTIPLIER: {}", speed, (speed * 60 * 60) / 100 / 1000, multiplier);
-    }
+void EventSfx::OnOvertime(ServerWrapper server)
+{
+    // Also called when it's set back at the end
+    if (server.IsNull() || !server.GetbOverTime()) return;
 
-    const auto now = std::chrono::steady_clock::now();
+    RlEvents::GameEvent event;
+    event.Type = RlEvents::GameEventType::Overtime;
 
-    // Is the sound still timed out or too close in volume to the previous?
-    if (now - this->LastPling < this->CrossbarTimeout && multiplier / this->lastMultiplier < 3.0f)
-        return;
+    this->PublishEvent(event);
+}
 
-    // Note timestamp etc.
-    this->LastPling = now;
-    this->lastMultiplier = multiplier;
+void EventSfx::OnKickoffCountdown()
+{
+    RlEvents::GameEvent event;
+    event.Type = RlEvents::GameEventType::Kickoff;
 
-    // Play the sound
-    this->PlayCrossbarSfx(location, multiplier);
+    this->PublishEvent(event);
+}
+
+void EventSfx::OnBallTouch(BallWrapper ball, const BallTouchParams* touchParams)
+{
+    if (ball.IsNull()) return;
+
+    CarWrapper car(touchParams->HitCar);
+    if (car.IsNull()) return;
+
+    RlEvents::GameEvent event;
+    event.Type     = RlEvents::GameEventType::BallHit;
+    event.Location = ball.GetLocation();
+    event.Actor    = car.memory_address;
+    event.Other    = ball.memory_address;
+    event.Is3D     = true;
+
+    // How fast the car and the ball closed in on each other
+    event.Inputs[static_cast<std::size_t>(SoundInterface::CurveInput::ImpactSpeed)] =
+        (car.GetVelocity() - ball.GetVelocity()).magnitude();
+
+    this->PublishEvent(event);
 }
 
 
 /* AUDIO */
 
 inline void EventSfx::PlaySoundFile(
-    const std::string&                    soundId,
-    const SoundInterface::PlaybackParams& params,
-    const float                           volume)
+    const std::string&                         soundId,
+    const SoundInterface::PlaybackParams&      params,
+    const float                                volume,
+    const SoundInterface::SendLevels&          sends,
+    const SoundInterface::Dsp::DistanceLutPtr& distance,
+    const SoundInterface::SoundCategory        category,
+    const std::uint64_t                        startFrame)
 {
-    HRESULT hr = this->SoundManager.PlaySound(soundId, params, volume);
+    HRESULT hr = this->SoundManager.PlaySound(
+        this->SoundManager.GetSound(soundId),
+        params, volume, sends, distance, category, startFrame);
     if (FAILED(hr))
     {
         LOG("FAILED TO PLAY SOUND ({}). HRESULT: {}", soundId, hr);
@@ -778,30 +1248,172 @@ inline void EventSfx::PlaySoundFile(
 void EventSfx::PlayEventSound(
     const RlEvents::Kind                  eventId,
     const SoundInterface::PlaybackParams& params,
-    float                                 volumeMultiplier)
+    const float                           volumeMultiplier,
+    const float                           impactSpeed)
 {
-    const SoundSettings& soundSettings = this->Settings->Sounds[static_cast<int>(eventId)];
+    RlEvents::GameEvent event;
+    event.Type             = RlEvents::GameEventType::Request;
+    event.Event            = eventId;
+    event.VolumeMultiplier = volumeMultiplier;
+    event.Is3D             = params.has_value();
 
-    float volume = soundSettings.Volume * volumeMultiplier;
+    event.Inputs[static_cast<std::size_t>(SoundInterface::CurveInput::ImpactSpeed)] = impactSpeed;
 
-    if (constexpr float epsilon = 0.04f; soundSettings.Delay <= epsilon)
+    if (event.Is3D)
     {
-        this->PlaySoundFile(soundSettings.SoundId, params, volume);
+        const auto& [location, fromMenu] = params.value();
+
+        event.Location = location;
+        event.FromMenu = fromMenu;
     }
-    else
+
+    this->PublishEvent(event);
+}
+
+void EventSfx::PublishEvent(RlEvents::GameEvent& event)
+{
+    event.HookedAt = this->HookedAt;
+    event.PostedAt = std::chrono::steady_clock::now();
+
+    // Contacts fire on every frame they last, so their cooldowns are checked here, before the game's read for them if they can be
+    const PluginSettingsPtr settings = this->PublishedSettings.load(std::memory_order_acquire);
+    const bool              isLate   = RlEvents::ContactFilter::IsGainUsed(event, *settings);
+    if (!isLate && !this->ContactFilter.Admit(event, *settings)) return;
+
+    // The sound isn't picked yet, so it's whatever any event's curves follow that's read from the game
+    using SoundInterface::CurveInput;
+    const auto isUsed = [&settings](const CurveInput input)
     {
-        this->gameWrapper->SetTimeout(
-            [this, soundSettings, params, volume](GameWrapper*)
+        return std::ranges::any_of(
+            settings->Sounds,
+            [input](const SoundSettings& sound)
             {
-                this->PlaySoundFile(soundSettings.SoundId, params, volume);
-            }, soundSettings.Delay);
+                return sound.UsesCurveInput(input);
+            });
+    };
+
+    ServerWrapper state = this->gameWrapper->GetCurrentGameState();
+    if (!state.IsNull())
+    {
+        event.ClockSeconds = state.GetSecondsRemaining();
+
+        BallWrapper ball = state.GetBall();
+        if (!ball.IsNull() && isUsed(CurveInput::BallSpeed))
+        {
+            event.Inputs[static_cast<std::size_t>(CurveInput::BallSpeed)] = ball.GetVelocity().magnitude();
+        }
+    }
+    if (isUsed(CurveInput::CarSpeed) || isUsed(CurveInput::Boost))
+    {
+        CarWrapper car = this->gameWrapper->GetLocalCar();
+        if (!car.IsNull())
+        {
+            BoostWrapper boost = car.GetBoostComponent();
+
+            event.Inputs[static_cast<std::size_t>(CurveInput::CarSpeed)] = car.GetVelocity().magnitude();
+            event.Inputs[static_cast<std::size_t>(CurveInput::Boost)]    = boost.IsNull() ? 0.0f : boost.GetCurrentBoostAmount() * 100.0f;
+        }
+    }
+
+    // Those breaking through by how loud they'd be only now
+    if (isLate && !this->ContactFilter.Admit(event, *settings)) return;
+
+    // The camera can only be read here, so the listener travels with the event
+    if (event.Is3D)
+    {
+        const X3DAUDIO_VEC_ROT listener = SoundInterface::SourceVoiceManager::GetListenerInfo(event.FromMenu);
+
+        event.ListenerLocation = listener.first;
+        event.ListenerFront    = listener.second.first;
+        event.ListenerTop      = listener.second.second;
+    }
+
+    if (!this->GameEvents.Publish(event))
+    {
+        DEBUGLOG("EVENT BUS FULL, DROPPED A {} EVENT", RlEvents::GetGameEventTypeLabel(event.Type));
     }
 }
 
-inline void EventSfx::PlayBumpSfx(const Vector& location, bool fromMenu)
+void EventSfx::RunEventSound(const RlEvents::GameEvent& event, const RlEvents::Kind eventId, const PluginSettings& settings)
+{
+    const SoundSettings& soundSettings = settings.Sounds[static_cast<int>(eventId)];
+
+    const auto category = GetEventCategory(eventId);
+
+    // A little different every time; the voice resamples the one shared buffer
+    Utils::FastRandom& random = Utils::GetRandom();
+
+    const float pitchCents = random.Uniform(-soundSettings.PitchVariation, soundSettings.PitchVariation);
+    const float volumeDb   = random.Uniform(-soundSettings.VolumeVariation, soundSettings.VolumeVariation);
+    const float pitch      = std::exp2(pitchCents / 1200.0f);
+    float       volume     = soundSettings.Volume * event.VolumeMultiplier * std::pow(10.0f, volumeDb / 20.0f);
+
+    // The delay is counted by the mixer, to the sample, from when the hook fired
+    const std::chrono::duration<float> queued = std::chrono::steady_clock::now() - event.PostedAt;
+    const std::uint64_t startFrame = this->SoundManager.GetStartFrame(soundSettings.Delay - queued.count());
+
+    SoundInterface::PlaybackParams params   = std::nullopt;
+    X3DAUDIO_VEC_ROT               listener = {};
+    if (event.Is3D)
+    {
+        params   = std::make_pair(event.Location, event.FromMenu);
+        listener = {event.ListenerLocation, {event.ListenerFront, event.ListenerTop}};
+    }
+
+    // Each curve is a clamp and a table read; the crossbar's fixed volume setting turns its off
+    if (eventId != RlEvents::Kind::Crossbar || !settings.FixedCrossbarVolume)
+    {
+        SoundInterface::CurveInputs inputs = event.Inputs;
+        if (event.Is3D)
+        {
+            inputs[static_cast<std::size_t>(SoundInterface::CurveInput::Distance)] =
+                SoundInterface::SourceVoiceManager::GetListenerDistance(event.Location, listener);
+        }
+
+        volume *= soundSettings.EvaluateCurves(inputs);
+    }
+
+    // Preloaded with the event, so this is an index, not a file lookup; two between velocity layers
+    const SoundInterface::PickedSounds picked = this->SoundManager.PickSounds(
+        static_cast<std::size_t>(eventId),
+        event.Inputs[static_cast<std::size_t>(SoundInterface::CurveInput::ImpactSpeed)],
+        random.Next());
+    if (!picked[0].Sound && !picked[1].Sound) return;
+
+    // Only the first sound is timed, once per play
+    SoundInterface::LatencyProbe        probe;
+    const SoundInterface::LatencyProbe* pending = nullptr;
+    if (this->SoundManager.GetLatencyStats().IsEnabled())
+    {
+        probe.HookedAt = event.HookedAt;
+        probe.PostedAt = event.PostedAt;
+        probe.Event    = static_cast<std::size_t>(eventId);
+        pending        = &probe;
+    }
+
+    // Both layers at once, so they're one instance against the event's limit
+    const HRESULT hr = this->SoundManager.PlaySounds(
+        picked,
+        params,
+        volume,
+        soundSettings.Sends,
+        soundSettings.DistanceLut,
+        category,
+        startFrame,
+        event.Is3D ? &listener : nullptr,
+        {static_cast<std::uint8_t>(eventId), soundSettings.Limit},
+        pitch,
+        pending);
+    if (FAILED(hr))
+    {
+        LOG("FAILED TO PLAY {} SOUND. HRESULT: {}", GetEventLabel(eventId), hr);
+    }
+}
+
+inline void EventSfx::PlayBumpSfx(const Vector& location, float speed, bool fromMenu)
 {
     auto params = std::make_pair(location, fromMenu);
-    this->PlayEventSound(RlEvents::Kind::Bump, params);
+    this->PlayEventSound(RlEvents::Kind::Bump, params, 1.0f, speed);
 }
 
 inline void EventSfx::PlayDemoSfx(const Vector& location, bool fromMenu)
@@ -810,20 +1422,10 @@ inline void EventSfx::PlayDemoSfx(const Vector& location, bool fromMenu)
     this->PlayEventSound(RlEvents::Kind::Demo, params);
 }
 
-inline void EventSfx::PlayCrossbarSfx(const Vector& location, float multiplier, bool fromMenu)
+inline void EventSfx::PlayCrossbarSfx(const Vector& location, float speed, bool fromMenu)
 {
-    /*
-    for (float testSpeed = 0 ; testSpeed <= 6000.0f ; testSpeed += 250.0f)
-    {
-        float testMult = computeMultiplier(testSpeed);
-        LOG("SPEED {} -> {}", testSpeed, testMult);
-    }
-
-    LOG("MULTIPLIER: {}", multiplier);
-    */
-
     auto params = std::make_pair(location, fromMenu);
-    this->PlayEventSound(RlEvents::Kind::Crossbar, params, multiplier);
+    this->PlayEventSound(RlEvents::Kind::Crossbar, params, 1.0f, speed);
 }
 
 inline void EventSfx::PlayPlayerGoalSfx()
@@ -866,6 +1468,8 @@ inline void EventSfx::PlayAssistSfx()
 
 void EventSfx::ApplySettings(const std::wstring& oldOutputId)
 {
+    this->PublishSettings();
+
     HRESULT hr = this->SoundManager.SetVolume(this->Settings->Volume);
     if (FAILED(hr))
     {
@@ -882,8 +1486,28 @@ void EventSfx::ApplySettings(const std::wstring& oldOutputId)
         }
     }
 
-    this->SoundManager.UnloadSounds();
+    // Sounds the new settings still use are kept, so a device change alone reloads nothing
     this->SoundManager.PreloadSounds();
+
+    hr = this->SoundManager.SetImpulseResponse(this->Settings->ImpulseResponseId);
+    if (FAILED(hr))
+    {
+        LOG("FAILED TO SET LOADED IMPULSE RESPONSE. HRESULT: {}", hr);
+    }
+
+    for (std::size_t i = 0; i < SoundInterface::NUM_SOUND_CATEGORIES; ++i)
+    {
+        const auto category = static_cast<SoundInterface::SoundCategory>(i);
+
+        hr = this->SoundManager.SetCategoryVolume(category, this->Settings->CategoryVolumes[i]);
+        if (FAILED(hr))
+        {
+            LOG("FAILED TO SET LOADED {} VOLUME. HRESULT: {}", GetSoundCategoryLabel(category), hr);
+        }
+    }
+
+    this->SoundManager.SetDucking(this->Settings->Ducking);
+    this->SoundManager.SetLimiter(this->Settings->Limiter);
 }
 
 void EventSfx::ApplyDefaultSettings()
@@ -913,6 +1537,30 @@ inline bool EventSfx::SaveSettings(const std::string& filename) const
     return this->Settings->Save(filename);
 }
 
+void EventSfx::PublishSettings()
+{
+    // A whole copy, tables and all, so nothing the bus's thread holds is ever written to
+    this->PublishedSettings.store(std::make_shared<const PluginSettings>(*this->Settings), std::memory_order_release);
+}
+
+void EventSfx::RegisterSettingsNotifier(
+    const std::string&                             cvar,
+    std::function<void(std::vector<std::string>)> notifier,
+    const std::string&                             description,
+    const unsigned char                            permissions)
+{
+    this->cvarManager->registerNotifier(
+        cvar,
+        [this, notifier = std::move(notifier)](const std::vector<std::string>& args)
+        {
+            notifier(args);
+            this->PublishSettings();
+        },
+        description,
+        permissions
+    );
+}
+
 /*
 struct AGoalCrossbarVolumeManager_TA_execTriggerHit_Parameters
 {
@@ -5,6 +5,9 @@
 #include "bakkesmod/plugin/pluginwindow.h"
 
 #include "SoundInterface/SoundManager.h"
+#include "EventBus.h"
+#include "GameEvents.h"
+#include "SoundRules.h"
 #include "Params.h"
 
 // Version information
@@ -45,30 +48,57 @@ public:
     void ApplySettings(const std::wstring& oldOutputId); // NOTE(sushi): For only changing output device when necessary
     void ApplyDefaultSettings();
 
+    // Copies the settings for the threads that play sounds; call after changing them
+    void PublishSettings();
+
+    // Like registering any notifier, but the settings are published after it runs
+    void RegisterSettingsNotifier(
+        const std::string&                             cvar,
+        std::function<void(std::vector<std::string>)> notifier,
+        const std::string&                             description,
+        unsigned char                                  permissions);
+
     /* On events */
 
     void OnBump(CarWrapper carWrapper, const BumpParams* bumpData);
     void OnStatTickerMessage(const StatTickerParams* statParams);
     void OnCrossbarTrigger(CrossbarParams* crossbarParams);
+    void OnOvertime(ServerWrapper server);
+    void OnKickoffCountdown();
+    void OnBallTouch(BallWrapper ball, const BallTouchParams* touchParams);
+
+    // At the top of the event hooks, which clear it at the bottom; only reads the clock while latency is measured
+    void MarkHook();
 
     /* Audio */
 
     // Playing sound from filename
     inline void PlaySoundFile(
-        const std::string& soundId,
-        const SoundInterface::PlaybackParams& params = std::nullopt,
-        float                                 volume = 1.0f);
-
-    // Playing sound from event type
+        const std::string&                         soundId,
+        const SoundInterface::PlaybackParams&      params     = std::nullopt,
+        float                                      volume     = 1.0f,
+        const SoundInterface::SendLevels&          sends      = {},
+        const SoundInterface::Dsp::DistanceLutPtr& distance   = nullptr,
+        SoundInterface::SoundCategory              category   = SoundInterface::SoundCategory::PlayerEvents,
+        std::uint64_t                              startFrame = 0);
+
+    // Playing sound from event type, whether or not it's enabled; only publishes a request, so it's cheap enough for hooks
     void PlayEventSound(
         RlEvents::Kind                        eventId,
         const SoundInterface::PlaybackParams& params = std::nullopt,
-        float                                 volumeMultiplier = 1.0f);
+        float                                 volumeMultiplier = 1.0f,
+        float                                 impactSpeed      = 0.0f);
+
+    // Stamps the event, fills in what only the game thread can read, and hands it to the bus
+    void PublishEvent(RlEvents::GameEvent& event);
+
+    // On the bus's thread, for the sound the rules picked, by the settings published when it was taken off the bus
+    void RunEventSound(const RlEvents::GameEvent& event, RlEvents::Kind eventId, const PluginSettings& settings);
 
     // Helpers
-    inline void PlayBumpSfx(const Vector& location, bool fromMenu = false);
+    inline void PlayBumpSfx(const Vector& location, float speed = 0.0f, bool fromMenu = false);
     inline void PlayDemoSfx(const Vector& location, bool fromMenu = false);
-    inline void PlayCrossbarSfx(const Vector& location, float multiplier = 1.0f, bool fromMenu = false);
+    inline void PlayCrossbarSfx(const Vector& location, float speed = 0.0f, bool fromMenu = false);
     inline void PlayPlayerGoalSfx();
     inline void PlayTeamGoalSfx();
     inline void PlayConcedeSfx();
@@ -92,7 +122,18 @@ public:
 
     void GenerateSoundFileCombo(
         RlEvents::Kind eventId,
-        SoundSettings& soundSettings);
+        SoundSettings& soundSettings,
+        std::size_t    layer = 0); // 0 for the event's own sounds, then its velocity layers
+
+    void RenderEffectSends();
+    void RenderMixBuses();
+    void RenderDistanceCurves();
+    void RenderInstanceLimits();
+    void RenderCooldowns();
+    void RenderVariations();
+    void RenderVelocityLayers();
+    void RenderGainCurves();
+    void RenderLatencyStats();
 
     /* Hooks */
 
@@ -107,26 +148,34 @@ public:
     // Global camera info. Don't ask.
     std::shared_ptr<CameraInfo> CamInfo = std::make_shared<CameraInfo>();
 
-    // Active settings
+    // Active settings, changed in place by the game thread and the GUI
     std::shared_ptr<PluginSettings> Settings = std::make_shared<PluginSettings>();
 
-    // Timing out bumps
-    using TimeStampMap = std::map<uintptr_t, std::chrono::steady_clock::time_point>;
-    TimeStampMap NotedBumps;
-    const std::chrono::milliseconds BumpTimeout = std::chrono::milliseconds(200);
+    // The last copy of them published, which is all the bus's thread reads
+    std::atomic<PluginSettingsPtr> PublishedSettings;
+
+    // Whether a GUI item was being edited last frame, so letting go of it publishes too
+    bool WasEditingSettings = false;
 
-    // Timing out crossbar sound
-    const std::chrono::milliseconds CrossbarTimeout = std::chrono::milliseconds(200);
-    std::chrono::steady_clock::time_point LastPling = std::chrono::steady_clock::time_point();
-    float lastMultiplier = 1.0f;
+    // Stat ticker events by their object's address, so names are read once
+    RlEvents::StatEventCache StatEvents;
 
     // The sound interface
     SoundInterface::SoundManager SoundManager;
 
+    // Bumps, ball hits and crossbar hits past their cooldowns, so contacts don't flood the bus
+    RlEvents::ContactFilter ContactFilter;
+
+    // Takes what the hooks saw off the game thread, to the sound rules, the counts and the recorder, which outlive it
+    RlEvents::SoundRules                                         SoundRules;
+    RlEvents::GameEventCounts                                    EventCounts;
+    RlEvents::GameEventRecorder                                  EventRecorder;
+    RlEvents::EventBus<RlEvents::GameEvent, GAME_EVENT_CAPACITY> GameEvents;
+
     // For recommended volume
     std::optional<float> LastMasterVolume   = std::nullopt;
     std::optional<float> LastGameplayVolume = std::nullopt;
 
-    // For timing out the loss event
-    bool TmpLossesDisabled = false;
+    // When the running event hook fired, for the event it publishes
+    std::chrono::steady_clock::time_point HookedAt;
 };
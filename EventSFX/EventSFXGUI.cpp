@@ -53,7 +53,7 @@ inline void NoteClick(EventSfx* pPlugin, const RlEvents::Kind eventId, const Vec
     lastPositionTime = std::chrono::steady_clock::now();
 
     const SoundSettings& soundSettings = pPlugin->Settings->Sounds[eventId];
-    const std::string&   soundId       = soundSettings.SoundId;
+    const std::string    soundId       = soundSettings.SoundIds.empty() ? "" : soundSettings.SoundIds.front();
 
     const double durationSeconds      = pPlugin->SoundManager.GetSoundDuration(soundId);
     const int    durationMilliseconds = std::lround(durationSeconds * 1000.0f);
@@ -111,6 +111,10 @@ void EventSfx::RenderSettings()
             "When 3D sound tracking is enabled, in-game 3D sounds will be adjusted continuously to reflect their positions relative to the camera.");
         ImGui::BulletText(
             "When fixed crossbar volume is disabled, the volume of the custom crossbar sound will increase with the speed of the ball.");
+        ImGui::BulletText(
+            "When early reflections are enabled, 3D sounds also echo off the arena walls, floor and ceiling.");
+        ImGui::BulletText(
+            "With ambisonics, 3D sounds are mixed into one surround bus that is decoded once for your speakers, or for headphones when binaural is checked.");
         ImGui::BulletText("The recommended plugin volume is your master volume multiplied by your gameplay volume.");
         ImGui::Indent();
         ImGui::BulletText(
@@ -123,6 +127,12 @@ void EventSfx::RenderSettings()
         ImGui::Unindent();
         ImGui::BulletText(
             "For each event you can set the sound file, individual volume, and delay. The checkbox toggles the event.");
+        ImGui::BulletText(
+            "Each event can also send some of its sound into the shared reverb, delay, EQ and convolution buses (see 'Effect sends').");
+        ImGui::Indent();
+        ImGui::BulletText(
+            "The convolution bus uses an impulse response recording (.wav or .aiff) from the sounds folder.");
+        ImGui::Unindent();
         ImGui::BulletText("Use the interactive map or the play buttons to test the audio levels.");
         ImGui::BulletText(
             "The plugin also provides the following console commands:\n"
@@ -199,6 +209,21 @@ void EventSfx::RenderSettings()
         ImGui::Text(
             "Sets the delay of <event> to <delay> if the latter is between %.2f and %.2f.",
             MIN_SOUND_DELAY, MAX_SOUND_DELAY);
+        //ImGui::Bullet();
+        ImGui::TextColored(
+            ImVec4(1.0f, 0.0f, 1.0f, 1.0f),
+            SET_EVENT_SEND_NOTIFIER_PARTIAL "<event> " " <bus> <level>");
+        ImGui::SameLine(CMD_WIDTH + ITEM_SEP);
+        ImGui::Text(
+            "Sets the (reverb|delay|eq|convolution) send of <event> to <level> if the latter is between %d and %d.",
+            MIN_SEND_LEVEL_PERCENTAGE, MAX_SEND_LEVEL_PERCENTAGE);
+        //ImGui::Bullet();
+        ImGui::TextColored(
+            ImVec4(1.0f, 0.0f, 1.0f, 1.0f),
+            SET_EVENT_CURVE_NOTIFIER_PARTIAL "<event> " " <model> <min> <max> [d:g ...]");
+        ImGui::SameLine(CMD_WIDTH + ITEM_SEP);
+        ImGui::Text(
+            "Sets the (inverse|linear|custom) distance curve of a 3D <event>, in meters. <max> 0 never culls.");
 
         // Storage
         //ImGui::Bullet();
@@ -215,6 +240,15 @@ void EventSfx::RenderSettings()
         ImGui::SameLine(CMD_WIDTH + ITEM_SEP);
         ImGui::Text(
             "Loads the settings stored in [file] in the data folder.");
+
+        // Diagnostics
+        //ImGui::Bullet();
+        ImGui::TextColored(
+            ImVec4(1.0f, 0.0f, 1.0f, 1.0f),
+            BENCHMARK_NOTIFIER "  [name:all]");
+        ImGui::SameLine(CMD_WIDTH + ITEM_SEP);
+        ImGui::Text(
+            "Runs the offline audio benchmarks and logs the results. The game stalls while they run.");
         ImGui::Unindent();
         ImGui::Unindent();
         ImGui::BulletText(
@@ -237,7 +271,7 @@ void EventSfx::RenderSettings()
 
     ImGui::BeginChild(
         "GeneralArea",
-        ImVec2(ITEM_WIDTH * 2 + ITEM_SEP * 2, 620),
+        ImVec2(ITEM_WIDTH * 2 + ITEM_SEP * 2, 645),
         false,
         ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse);
 
@@ -335,6 +369,59 @@ void EventSfx::RenderSettings()
         this->Settings->FixedCrossbarVolume = fixedVolumeEnabled;
     }
 
+    // Early reflections
+    bool reflectionsEnabled = this->Settings->ReflectionsEnabled;
+
+    if (ImGui::Checkbox("Early reflections", &reflectionsEnabled))
+    {
+        this->Settings->ReflectionsEnabled = reflectionsEnabled;
+    }
+    ImGui::SameLine();
+
+    // Second-order reflections
+    bool secondOrderReflections = this->Settings->SecondOrderReflections;
+
+    if (ImGui::Checkbox("Second-order reflections", &secondOrderReflections))
+    {
+        this->Settings->SecondOrderReflections = secondOrderReflections;
+    }
+
+    // 3D panner
+    constexpr std::array<std::pair<std::uint32_t, const char*>, 3> spatializers = {{
+        {0, "X3DAudio"},
+        {1, "1st-order ambisonics"},
+        {3, "3rd-order ambisonics"}
+    }};
+
+    const char* spatializerLabel = spatializers[0].second;
+    for (const auto& [order, label] : spatializers)
+    {
+        if (order == this->Settings->AmbisonicOrder) spatializerLabel = label;
+    }
+
+    ImGui::PushItemWidth(ITEM_WIDTH);
+    if (ImGui::BeginCombo("##spatializer", spatializerLabel))
+    {
+        for (const auto& [order, label] : spatializers)
+        {
+            if (ImGui::Selectable(label, order == this->Settings->AmbisonicOrder))
+            {
+                this->Settings->AmbisonicOrder = order;
+            }
+        }
+        ImGui::EndCombo();
+    }
+    ImGui::PopItemWidth();
+    ImGui::SameLine();
+
+    // Binaural decoding, only used by ambisonics
+    bool binauralEnabled = this->Settings->BinauralEnabled;
+
+    if (ImGui::Checkbox("Binaural (headphones)", &binauralEnabled))
+    {
+        this->Settings->BinauralEnabled = binauralEnabled;
+    }
+
     // Volume
     ImGui::Separator();
 
@@ -383,16 +470,15 @@ void EventSfx::RenderSettings()
 
     SameLineColumn();
 
-    // Audio device
-    SoundInterface::AudioDevice              outputDevice;
-    std::vector<SoundInterface::AudioDevice> devices =
-        this->SoundManager.ConsolidateAudioDevices(outputDevice, true);
-    std::string outputName = Utils::WStringToString(outputDevice.Name);
+    // Audio device, from the cached list; a chosen device that's gone shows as the default it falls back to
+    SoundInterface::AudioDevice             outputDevice;
+    const SoundInterface::DeviceSnapshotPtr devices = this->SoundManager.GetAudioDevices(outputDevice);
+    std::string                             outputName = Utils::WStringToString(outputDevice.Name);
 
     ImGui::PushItemWidth(ITEM_WIDTH);
     if (ImGui::BeginCombo("##Output device", outputName.c_str()))
     {
-        for (const auto& device : devices)
+        for (const auto& device : devices->Devices)
         {
             std::string name = Utils::WStringToString(device.Name);
 
@@ -507,7 +593,7 @@ void EventSfx::RenderSettings()
 
 
     // Sounds
-    for (int i = 0; i < this->Settings->Sounds.size(); ++i)
+    for (int i = 0; i < RlEvents::GetEventRegistry().GetCount(); ++i)
     {
         auto eventId = static_cast<RlEvents::Kind>(i);
         SoundSettings& soundSettings = this->Settings->Sounds[i];
@@ -697,6 +783,722 @@ void EventSfx::RenderSettings()
 
     // End area
     ImGui::EndChild();
+
+    /*
+     * EFFECT SENDS AREA
+     */
+
+    this->RenderEffectSends();
+    this->RenderMixBuses();
+    this->RenderDistanceCurves();
+    this->RenderInstanceLimits();
+    this->RenderCooldowns();
+    this->RenderVariations();
+    this->RenderVelocityLayers();
+    this->RenderGainCurves();
+    this->RenderLatencyStats();
+
+    // Whatever was being edited this frame, or let go of since the last, goes to the threads that play sounds
+    const bool isEditing = ImGui::IsAnyItemActive();
+    if (isEditing || this->WasEditingSettings) this->PublishSettings();
+    this->WasEditingSettings = isEditing;
+}
+
+void EventSfx::RenderEffectSends()
+{
+    ImGui::Separator();
+    if (!ImGui::CollapsingHeader("Effect sends")) return;
+
+    // Impulse response for the convolution bus
+    const std::string& irId    = this->Settings->ImpulseResponseId;
+    const std::string  irLabel = irId.empty() ? "No impulse response" : irId;
+
+    ImGui::PushItemWidth(ITEM_WIDTH);
+    if (ImGui::BeginCombo("##impulseresponse", irLabel.c_str()))
+    {
+        std::vector<std::string> irFiles = this->SoundManager.ListSoundFiles();
+        irFiles.insert(irFiles.begin(), "");
+
+        for (const auto& irFile : irFiles)
+        {
+            const bool        isSelected = irFile == irId;
+            const std::string label      = irFile.empty() ? "No impulse response" : irFile;
+
+            if (ImGui::Selectable(label.c_str(), isSelected))
+            {
+                HRESULT hr = this->SoundManager.SetImpulseResponse(irFile);
+                if (FAILED(hr))
+                {
+                    this->gameWrapper->Toast(
+                        "Failed to load impulse response",
+                        "Try converting it to e.g. 16-bit PCM",
+                        "default", 5.0, ToastType_Warning);
+
+                    LOG("IMPULSE RESPONSE LOAD FAILED. SOUNDID: {}, HRESULT: {}", irFile, hr);
+                }
+                else
+                {
+                    this->Settings->ImpulseResponseId = irFile;
+                }
+            }
+
+            if (isSelected)
+            {
+                ImGui::SetItemDefaultFocus();
+            }
+        }
+
+        ImGui::EndCombo();
+    }
+    ImGui::PopItemWidth();
+    SameLineColumn();
+    ImGui::TextUnformatted("Convolution impulse response");
+
+    constexpr auto numBuses  = SoundInterface::NUM_EFFECT_BUSES;
+    const float    sendWidth = (ITEM_WIDTH * 2 - HALF_ITEM_WIDTH - ITEM_SEP * numBuses) / numBuses;
+
+    for (int i = 0; i < RlEvents::GetEventRegistry().GetCount(); ++i)
+    {
+        auto           eventId       = static_cast<RlEvents::Kind>(i);
+        SoundSettings& soundSettings = this->Settings->Sounds[i];
+
+        ImGui::TextUnformatted(GetEventLabel(eventId).c_str());
+        ImGui::SameLine(HALF_ITEM_WIDTH, ITEM_SEP);
+
+        for (std::size_t b = 0; b < numBuses; ++b)
+        {
+            const auto  bus        = static_cast<SoundInterface::EffectBus>(b);
+            std::string busLabel   = SoundInterface::GetEffectBusLabel(bus);
+            std::string sendLabel  = "##send" + busLabel + std::to_string(i);
+            std::string sendFormat = busLabel + ": %d%%";
+
+            int sendPercentage = std::lround(soundSettings.Sends[b] * 100.0f);
+            ImGui::PushItemWidth(sendWidth);
+            if (ImGui::DragInt(sendLabel.c_str(), &sendPercentage, 0.5f, MIN_SEND_LEVEL_PERCENTAGE,
+                               MAX_SEND_LEVEL_PERCENTAGE, sendFormat.c_str()))
+            {
+                soundSettings.Sends[b] = static_cast<float>(sendPercentage) / 100.0f;
+            }
+            ImGui::PopItemWidth();
+
+            // Preview sound when releasing slider
+            if (this->Settings->PreviewsEnabled && ImGui::IsItemDeactivated())
+            {
+                if (IsEvent3D(eventId))
+                {
+                    // Generate random vector at camera distance
+                    Vector location = Utils::GetRandomVector(this->CamInfo->Distance);
+
+                    this->gameWrapper->Execute(
+                        [this, eventId, location](GameWrapper*)
+                        {
+                            // Play the sound
+                            std::pair<Vector, bool> params = std::make_pair(location, true);
+                            this->PlayEventSound(eventId, params);
+
+                            // Store random position for rendering
+                            NoteClick(this, eventId, location);
+                        });
+                }
+                else
+                {
+                    this->gameWrapper->Execute(
+                        [this, eventId](GameWrapper*)
+                        {
+                            // Play the sound
+                            this->PlayEventSound(eventId);
+                        });
+                }
+            }
+
+            if (b + 1 < numBuses) ImGui::SameLine(0.0f, ITEM_SEP);
+        }
+    }
+}
+
+void EventSfx::RenderMixBuses()
+{
+    ImGui::Separator();
+    if (!ImGui::CollapsingHeader("Mix buses")) return;
+
+    using namespace SoundInterface;
+
+    // Category volumes
+    for (std::size_t i = 0; i < NUM_SOUND_CATEGORIES; ++i)
+    {
+        const auto        category = static_cast<SoundCategory>(i);
+        const std::string label    = "##categoryvolume" + std::to_string(i);
+
+        int volumePercentage = std::lround(this->Settings->CategoryVolumes[i] * 100.0f);
+        ImGui::PushItemWidth(ITEM_WIDTH);
+        if (ImGui::DragInt(label.c_str(), &volumePercentage, 0.5f, MIN_CATEGORY_VOLUME_PERCENTAGE,
+                           MAX_CATEGORY_VOLUME_PERCENTAGE, "%d%%"))
+        {
+            const float volume = static_cast<float>(volumePercentage) / 100.0f;
+
+            HRESULT hr = this->SoundManager.SetCategoryVolume(category, volume);
+            if (FAILED(hr))
+            {
+                LOG("FAILED TO SET {} VOLUME. HRESULT: {}", GetSoundCategoryLabel(category), hr);
+            }
+            this->Settings->CategoryVolumes[i] = volume;
+        }
+        ImGui::PopItemWidth();
+        SameLineColumn();
+        ImGui::TextUnformatted(GetSoundCategoryLabel(category).c_str());
+    }
+
+    // Ducking of impacts under goals and results
+    Dsp::DuckingParams& ducking = this->Settings->Ducking;
+    bool                changed = false;
+
+    changed |= ImGui::Checkbox("Duck impacts under match results", &ducking.Enabled);
+
+    ImGui::PushItemWidth(HALF_ITEM_WIDTH);
+    changed |= ImGui::DragFloat("##duckingthreshold", &ducking.Threshold, 0.25f,
+                                Dsp::MIN_DUCKING_THRESHOLD, Dsp::MAX_DUCKING_THRESHOLD, "threshold: %.1f dB");
+    ImGui::SameLine(0.0f, ITEM_SEP);
+    changed |= ImGui::DragFloat("##duckingdepth", &ducking.Depth, 0.1f,
+                                Dsp::MIN_DUCKING_DEPTH, Dsp::MAX_DUCKING_DEPTH, "depth: %.1f dB");
+    ImGui::SameLine(0.0f, ITEM_SEP);
+    changed |= ImGui::DragFloat("##duckingattack", &ducking.Attack, 0.5f,
+                                Dsp::MIN_DUCKING_ATTACK, Dsp::MAX_DUCKING_ATTACK, "attack: %.0f ms");
+    ImGui::SameLine(0.0f, ITEM_SEP);
+    changed |= ImGui::DragFloat("##duckingrelease", &ducking.Release, 5.0f,
+                                Dsp::MIN_DUCKING_RELEASE, Dsp::MAX_DUCKING_RELEASE, "release: %.0f ms");
+    ImGui::PopItemWidth();
+
+    if (changed)
+    {
+        Dsp::SanitizeDuckingParams(ducking);
+        this->SoundManager.SetDucking(ducking);
+    }
+
+    // How far the impacts are ducked right now
+    const float       reduction = this->SoundManager.GetDuckingReduction();
+    const std::string overlay   = std::format("-{:.1f} dB", reduction);
+    ImGui::ProgressBar(reduction / Dsp::MAX_DUCKING_DEPTH, ImVec2(ITEM_WIDTH, 0.0f), overlay.c_str());
+    SameLineColumn();
+    ImGui::TextUnformatted("Impacts ducking");
+
+    // True-peak limiter on the master
+    Dsp::LimiterParams& limiter = this->Settings->Limiter;
+    changed                     = false;
+
+    changed |= ImGui::Checkbox("Limit the master to the ceiling", &limiter.Enabled);
+
+    ImGui::PushItemWidth(HALF_ITEM_WIDTH);
+    changed |= ImGui::DragFloat("##limiterceiling", &limiter.Ceiling, 0.05f,
+                                Dsp::MIN_LIMITER_CEILING, Dsp::MAX_LIMITER_CEILING, "ceiling: %.1f dBTP");
+    ImGui::SameLine(0.0f, ITEM_SEP);
+    changed |= ImGui::DragFloat("##limiterrelease", &limiter.Release, 1.0f,
+                                Dsp::MIN_LIMITER_RELEASE, Dsp::MAX_LIMITER_RELEASE, "release: %.0f ms");
+    ImGui::PopItemWidth();
+    ImGui::SameLine(0.0f, ITEM_SEP);
+    ImGui::Text("latency: %.1f ms", this->SoundManager.GetLimiterLatency());
+
+    if (changed)
+    {
+        Dsp::SanitizeLimiterParams(limiter);
+        this->SoundManager.SetLimiter(limiter);
+    }
+
+    // Meter up to 12 dB; anything past that is pinned
+    constexpr float   limiterRange     = 12.0f;
+    const float       limiterReduction = this->SoundManager.GetLimiterReduction();
+    const std::string limiterOverlay   = std::format("-{:.1f} dB", limiterReduction);
+    ImGui::ProgressBar(std::min(limiterReduction / limiterRange, 1.0f), ImVec2(ITEM_WIDTH, 0.0f), limiterOverlay.c_str());
+    SameLineColumn();
+    ImGui::TextUnformatted("Limiter gain reduction");
+}
+
+void EventSfx::RenderDistanceCurves()
+{
+    ImGui::Separator();
+    if (!ImGui::CollapsingHeader("Distance curves")) return;
+
+    using namespace SoundInterface::Dsp;
+
+    for (int i = 0; i < RlEvents::GetEventRegistry().GetCount(); ++i)
+    {
+        auto eventId = static_cast<RlEvents::Kind>(i);
+        if (!IsEvent3D(eventId)) continue;
+
+        SoundSettings& soundSettings = this->Settings->Sounds[i];
+        DistanceCurve& curve         = soundSettings.Distance;
+        const auto     id            = std::to_string(i);
+        bool           changed       = false;
+
+        ImGui::TextUnformatted(GetEventLabel(eventId).c_str());
+        ImGui::SameLine(HALF_ITEM_WIDTH, ITEM_SEP);
+
+        // Model
+        ImGui::PushItemWidth(HALF_ITEM_WIDTH);
+        if (ImGui::BeginCombo(("##distancemodel" + id).c_str(), GetDistanceModelLabel(curve.Model)))
+        {
+            for (std::size_t m = 0; m < NUM_DISTANCE_MODELS; ++m)
+            {
+                const auto model = static_cast<DistanceModel>(m);
+                if (ImGui::Selectable(GetDistanceModelLabel(model), model == curve.Model))
+                {
+                    curve.Model = model;
+                    changed     = true;
+                }
+            }
+            ImGui::EndCombo();
+        }
+        ImGui::SameLine(0.0f, ITEM_SEP);
+
+        // Full volume and cutoff distances
+        changed |= ImGui::DragFloat(("##distancemin" + id).c_str(), &curve.MinDistance, 0.1f,
+                                    MIN_FULL_DISTANCE, MAX_CURVE_DISTANCE, "full: %.1f m");
+        ImGui::SameLine(0.0f, ITEM_SEP);
+        changed |= ImGui::DragFloat(("##distancemax" + id).c_str(), &curve.MaxDistance, 0.5f,
+                                    MIN_CURVE_DISTANCE, MAX_CURVE_DISTANCE,
+                                    curve.MaxDistance > 0.0f ? "cutoff: %.1f m" : "no cutoff");
+        ImGui::PopItemWidth();
+
+        // Custom points, in any order
+        if (curve.Model == DistanceModel::Custom)
+        {
+            ImGui::Indent(HALF_ITEM_WIDTH + ITEM_SEP);
+            for (std::size_t p = 0; p < curve.Points.size(); ++p)
+            {
+                const auto pointId = id + "_" + std::to_string(p);
+                auto&      point   = curve.Points[p];
+
+                ImGui::PushItemWidth(HALF_ITEM_WIDTH);
+                changed |= ImGui::DragFloat(("##pointdistance" + pointId).c_str(), &point.Distance, 0.5f,
+                                            MIN_CURVE_DISTANCE, MAX_CURVE_DISTANCE, "at %.1f m");
+                ImGui::SameLine(0.0f, ITEM_SEP);
+                changed |= ImGui::DragFloat(("##pointgain" + pointId).c_str(), &point.Gain, 0.01f,
+                                            MIN_CURVE_GAIN, MAX_CURVE_GAIN, "gain %.2f");
+                ImGui::PopItemWidth();
+                ImGui::SameLine(0.0f, ITEM_SEP);
+
+                if (ImGui::Button(("Remove##point" + pointId).c_str()))
+                {
+                    curve.Points.erase(curve.Points.begin() + static_cast<std::ptrdiff_t>(p));
+                    changed = true;
+                    break;
+                }
+            }
+
+            if (ImGui::Button(("Add point##" + id).c_str()))
+            {
+                const float last = curve.Points.empty() ? 0.0f : curve.Points.back().Distance;
+                curve.Points.push_back({std::min(last + 10.0f, MAX_CURVE_DISTANCE), 0.5f});
+                changed = true;
+            }
+            ImGui::Unindent(HALF_ITEM_WIDTH + ITEM_SEP);
+        }
+
+        if (changed)
+        {
+            soundSettings.BakeDistanceCurve();
+        }
+    }
+}
+
+void EventSfx::RenderInstanceLimits()
+{
+    ImGui::Separator();
+    if (!ImGui::CollapsingHeader("Instance limits")) return;
+
+    using namespace SoundInterface;
+
+    for (int i = 0; i < RlEvents::GetEventRegistry().GetCount(); ++i)
+    {
+        auto           eventId = static_cast<RlEvents::Kind>(i);
+        InstanceLimit& limit   = this->Settings->Sounds[i].Limit;
+        const auto     id      = std::to_string(i);
+
+        ImGui::TextUnformatted(GetEventLabel(eventId).c_str());
+        ImGui::SameLine(HALF_ITEM_WIDTH, ITEM_SEP);
+
+        ImGui::PushItemWidth(HALF_ITEM_WIDTH);
+        int maxInstances = static_cast<int>(limit.MaxInstances);
+        if (ImGui::SliderInt(("##maxinstances" + id).c_str(), &maxInstances,
+                             MIN_MAX_INSTANCES, MAX_MAX_INSTANCES,
+                             maxInstances > 0 ? "at most %d" : "no limit"))
+        {
+            limit.MaxInstances = static_cast<std::uint32_t>(maxInstances);
+        }
+        ImGui::SameLine(0.0f, ITEM_SEP);
+
+        // What gives once it's reached
+        if (ImGui::BeginCombo(("##limitpolicy" + id).c_str(), GetLimitPolicyLabel(limit.Policy)))
+        {
+            for (std::size_t p = 0; p < NUM_LIMIT_POLICIES; ++p)
+            {
+                const auto policy = static_cast<LimitPolicy>(p);
+                if (ImGui::Selectable(GetLimitPolicyLabel(policy), policy == limit.Policy))
+                {
+                    limit.Policy = policy;
+                }
+            }
+            ImGui::EndCombo();
+        }
+        ImGui::PopItemWidth();
+    }
+}
+
+void EventSfx::RenderCooldowns()
+{
+    ImGui::Separator();
+    if (!ImGui::CollapsingHeader("Cooldowns")) return;
+
+    using namespace RlEvents;
+
+    ImGui::TextWrapped("How soon an event may play again, for the event or for each pair of things that make it, "
+                       "like two cars bumping. A burst lets that many through at once, then refills at its rate.");
+
+    for (int i = 0; i < GetEventRegistry().GetCount(); ++i)
+    {
+        auto            eventId  = static_cast<Kind>(i);
+        CooldownPolicy& cooldown = this->Settings->Sounds[i].Cooldown;
+        const auto      id       = std::to_string(i);
+
+        ImGui::TextUnformatted(GetEventLabel(eventId).c_str());
+        ImGui::SameLine(HALF_ITEM_WIDTH, ITEM_SEP);
+
+        ImGui::PushItemWidth(HALF_ITEM_WIDTH);
+        ImGui::DragFloat(("##cooldown" + id).c_str(), &cooldown.Cooldown, 0.01f, MIN_COOLDOWN, MAX_COOLDOWN,
+                         cooldown.Cooldown > 0.0f ? "%.2f s apart" : "no cooldown");
+        ImGui::SameLine(0.0f, ITEM_SEP);
+
+        // Kept for the event, or for each pair of things that make it
+        if (ImGui::BeginCombo(("##cooldownscope" + id).c_str(), GetCooldownScopeLabel(cooldown.Scope)))
+        {
+            for (std::size_t s = 0; s < NUM_COOLDOWN_SCOPES; ++s)
+            {
+                const auto scope = static_cast<CooldownScope>(s);
+                if (ImGui::Selectable(GetCooldownScopeLabel(scope), scope == cooldown.Scope))
+                {
+                    cooldown.Scope = scope;
+                }
+            }
+            ImGui::EndCombo();
+        }
+
+        // A burst let through at once, then the rate
+        ImGui::Indent(HALF_ITEM_WIDTH + ITEM_SEP);
+        int burst = static_cast<int>(cooldown.Burst);
+        if (ImGui::SliderInt(("##cooldownburst" + id).c_str(), &burst, MIN_COOLDOWN_BURST, MAX_COOLDOWN_BURST,
+                             burst > 0 ? "burst of %d" : "no burst limit"))
+        {
+            cooldown.Burst = static_cast<std::uint32_t>(burst);
+        }
+        ImGui::SameLine(0.0f, ITEM_SEP);
+        ImGui::DragFloat(("##cooldownrate" + id).c_str(), &cooldown.Rate, 0.05f, MIN_COOLDOWN_RATE, MAX_COOLDOWN_RATE,
+                         "refilled at %.2f a second");
+
+        // So a hard hit isn't lost behind a soft one; only for events with gain curves
+        if (!this->Settings->Sounds[i].Curves.empty())
+        {
+            bool breaksThrough = cooldown.BreakThrough > 0.0f;
+            if (ImGui::Checkbox(("Louder plays break through##cooldownbreak" + id).c_str(), &breaksThrough))
+            {
+                cooldown.BreakThrough = breaksThrough ? 3.0f : 0.0f;
+            }
+            if (breaksThrough)
+            {
+                ImGui::SameLine(0.0f, ITEM_SEP);
+                ImGui::DragFloat(("##cooldownbreakthrough" + id).c_str(), &cooldown.BreakThrough, 0.05f,
+                                 MIN_COOLDOWN_BREAKTHROUGH, MAX_COOLDOWN_BREAKTHROUGH, "at %.1fx as loud");
+            }
+        }
+        ImGui::Unindent(HALF_ITEM_WIDTH + ITEM_SEP);
+        ImGui::PopItemWidth();
+    }
+}
+
+void EventSfx::RenderVariations()
+{
+    ImGui::Separator();
+    if (!ImGui::CollapsingHeader("Variation")) return;
+
+    for (int i = 0; i < RlEvents::GetEventRegistry().GetCount(); ++i)
+    {
+        auto           eventId       = static_cast<RlEvents::Kind>(i);
+        SoundSettings& soundSettings = this->Settings->Sounds[i];
+        const auto     id            = std::to_string(i);
+
+        ImGui::TextUnformatted(GetEventLabel(eventId).c_str());
+        ImGui::SameLine(HALF_ITEM_WIDTH, ITEM_SEP);
+
+        // Either way from the sound as recorded, picked for every play
+        ImGui::PushItemWidth(HALF_ITEM_WIDTH);
+        ImGui::DragFloat(("##pitchvariation" + id).c_str(), &soundSettings.PitchVariation, 1.0f,
+                         MIN_PITCH_VARIATION, MAX_PITCH_VARIATION, "pitch: +/- %.0f cents");
+        ImGui::SameLine(0.0f, ITEM_SEP);
+        ImGui::DragFloat(("##volumevariation" + id).c_str(), &soundSettings.VolumeVariation, 0.05f,
+                         MIN_VOLUME_VARIATION, MAX_VOLUME_VARIATION, "volume: +/- %.1f dB");
+        ImGui::SameLine(0.0f, ITEM_SEP);
+
+        // Which of the event's sounds plays next, when it has several
+        using SoundInterface::SelectionMode;
+        if (ImGui::BeginCombo(("##selection" + id).c_str(), SoundInterface::GetSelectionModeLabel(soundSettings.Selection)))
+        {
+            for (std::size_t m = 0; m < SoundInterface::NUM_SELECTION_MODES; ++m)
+            {
+                const auto mode = static_cast<SelectionMode>(m);
+                if (ImGui::Selectable(SoundInterface::GetSelectionModeLabel(mode), mode == soundSettings.Selection))
+                {
+                    soundSettings.Selection = mode;
+                    this->SoundManager.LoadContainer(i, soundSettings.GetLayers(), soundSettings.Selection, soundSettings.LayerCrossfade);
+                }
+            }
+            ImGui::EndCombo();
+        }
+        ImGui::PopItemWidth();
+    }
+}
+
+void EventSfx::RenderVelocityLayers()
+{
+    ImGui::Separator();
+    if (!ImGui::CollapsingHeader("Velocity layers")) return;
+
+    using namespace SoundInterface;
+
+    ImGui::TextWrapped("Harder hits can play other sounds. Each layer plays from its speed up (in uu/s), "
+                       "and the event's own sounds are the softest. Crossfading blends neighbouring layers near each speed.");
+
+    for (int i = 0; i < RlEvents::GetEventRegistry().GetCount(); ++i)
+    {
+        auto eventId = static_cast<RlEvents::Kind>(i);
+        if (!HasImpactSpeed(eventId)) continue;
+
+        SoundSettings& soundSettings = this->Settings->Sounds[i];
+        auto&          layers        = soundSettings.Layers;
+        const auto     id            = std::to_string(i);
+        bool           changed       = false;
+
+        ImGui::TextUnformatted(GetEventLabel(eventId).c_str());
+        ImGui::SameLine(HALF_ITEM_WIDTH, ITEM_SEP);
+
+        ImGui::PushItemWidth(HALF_ITEM_WIDTH);
+        ImGui::DragFloat(("##layercrossfade" + id).c_str(), &soundSettings.LayerCrossfade, 5.0f,
+                         MIN_LAYER_CROSSFADE, MAX_LAYER_CROSSFADE,
+                         soundSettings.LayerCrossfade > 0.0f ? "crossfade: %.0f" : "no crossfade");
+        changed |= ImGui::IsItemDeactivatedAfterEdit();
+        ImGui::PopItemWidth();
+
+        // The harder layers, each with its own sounds
+        ImGui::Indent(HALF_ITEM_WIDTH + ITEM_SEP);
+        for (std::size_t l = 0; l < layers.size(); ++l)
+        {
+            const auto layerId = id + "_" + std::to_string(l);
+
+            ImGui::PushItemWidth(HALF_ITEM_WIDTH);
+            ImGui::DragFloat(("##layerspeed" + layerId).c_str(), &layers[l].MinSpeed, 10.0f,
+                             MIN_LAYER_SPEED, MAX_LAYER_SPEED, "from %.0f");
+            changed |= ImGui::IsItemDeactivatedAfterEdit();
+            ImGui::PopItemWidth();
+            ImGui::SameLine(0.0f, ITEM_SEP);
+
+            this->GenerateSoundFileCombo(eventId, soundSettings, l + 1);
+            ImGui::SameLine(0.0f, ITEM_SEP);
+
+            if (ImGui::Button(("Remove##layer" + layerId).c_str()))
+            {
+                layers.erase(layers.begin() + static_cast<std::ptrdiff_t>(l));
+                changed = true;
+                break;
+            }
+        }
+
+        if (layers.size() + 1 < MAX_VELOCITY_LAYERS && ImGui::Button(("Add layer##" + id).c_str()))
+        {
+            // Starting out with the softest sounds, to be swapped for harder ones
+            const float last = layers.empty() ? 0.0f : layers.back().MinSpeed;
+            layers.push_back({std::min(last + 1000.0f, MAX_LAYER_SPEED), soundSettings.SoundIds});
+            changed = true;
+        }
+        ImGui::Unindent(HALF_ITEM_WIDTH + ITEM_SEP);
+
+        if (changed)
+        {
+            this->SoundManager.LoadContainer(i, soundSettings.GetLayers(), soundSettings.Selection, soundSettings.LayerCrossfade);
+        }
+    }
+}
+
+void EventSfx::RenderGainCurves()
+{
+    ImGui::Separator();
+    if (!ImGui::CollapsingHeader("Gain curves")) return;
+
+    using namespace SoundInterface;
+    using namespace SoundInterface::Dsp;
+
+    ImGui::TextWrapped("Volume by what's going on in the game. An event's curves multiply together; "
+                       "the preview is the baked table that plays.");
+
+    for (int i = 0; i < RlEvents::GetEventRegistry().GetCount(); ++i)
+    {
+        auto           eventId       = static_cast<RlEvents::Kind>(i);
+        SoundSettings& soundSettings = this->Settings->Sounds[i];
+        auto&          curves        = soundSettings.Curves;
+        const auto     id            = std::to_string(i);
+        bool           changed       = false;
+
+        ImGui::TextUnformatted(GetEventLabel(eventId).c_str());
+        ImGui::SameLine(HALF_ITEM_WIDTH, ITEM_SEP);
+        if (curves.size() < MAX_EVENT_CURVES && ImGui::Button(("Add curve##" + id).c_str()))
+        {
+            EventCurve curve;
+            curve.Input        = HasImpactSpeed(eventId) ? CurveInput::ImpactSpeed : CurveInput::Boost;
+            curve.Curve.Points = {{0.0f, 1.0f}, {GetCurveInputRange(curve.Input), 1.0f}};
+            curves.push_back(std::move(curve));
+            changed = true;
+        }
+
+        ImGui::Indent(HALF_ITEM_WIDTH + ITEM_SEP);
+        for (std::size_t c = 0; c < curves.size(); ++c)
+        {
+            const auto  curveId = id + "_" + std::to_string(c);
+            EventCurve& curve   = curves[c];
+            const float range   = GetCurveInputRange(curve.Input);
+
+            // Input
+            ImGui::PushItemWidth(HALF_ITEM_WIDTH);
+            if (ImGui::BeginCombo(("##curveinput" + curveId).c_str(), GetCurveInputLabel(curve.Input)))
+            {
+                for (std::size_t n = 0; n < NUM_CURVE_INPUTS; ++n)
+                {
+                    const auto input = static_cast<CurveInput>(n);
+                    if (ImGui::Selectable(GetCurveInputLabel(input), input == curve.Input))
+                    {
+                        curve.Input = input;
+                        changed     = true;
+                    }
+                }
+                ImGui::EndCombo();
+            }
+            ImGui::PopItemWidth();
+            ImGui::SameLine(0.0f, ITEM_SEP);
+
+            if (ImGui::Button(("Remove##curve" + curveId).c_str()))
+            {
+                curves.erase(curves.begin() + static_cast<std::ptrdiff_t>(c));
+                changed = true;
+                break;
+            }
+
+            // Preview, read back from the table
+            if (curve.Lut)
+            {
+                constexpr int              samples = 64;
+                std::array<float, samples> values{};
+                for (int s = 0; s < samples; ++s)
+                {
+                    values[s] = curve.Lut->Evaluate(range * static_cast<float>(s) / static_cast<float>(samples - 1));
+                }
+
+                const std::string overlay = std::format("0 - {:.0f}", range);
+                ImGui::PlotLines(("##curvepreview" + curveId).c_str(), values.data(), samples, 0, overlay.c_str(),
+                                 MIN_CURVE_MULTIPLIER, MAX_CURVE_MULTIPLIER, ImVec2(ITEM_WIDTH, 60.0f));
+            }
+
+            // Points, in any order
+            for (std::size_t p = 0; p < curve.Curve.Points.size(); ++p)
+            {
+                const auto  pointId = curveId + "_" + std::to_string(p);
+                CurvePoint& point   = curve.Curve.Points[p];
+
+                ImGui::PushItemWidth(HALF_ITEM_WIDTH);
+                changed |= ImGui::DragFloat(("##curvepointinput" + pointId).c_str(), &point.Input, range / 500.0f,
+                                            0.0f, range, "at %.1f");
+                ImGui::SameLine(0.0f, ITEM_SEP);
+                changed |= ImGui::DragFloat(("##curvepointgain" + pointId).c_str(), &point.Gain, 0.01f,
+                                            MIN_CURVE_MULTIPLIER, MAX_CURVE_MULTIPLIER, "gain %.2f");
+                ImGui::SameLine(0.0f, ITEM_SEP);
+                if (ImGui::BeginCombo(("##curvepointshape" + pointId).c_str(), GetCurveShapeLabel(point.Shape)))
+                {
+                    for (std::size_t s = 0; s < NUM_CURVE_SHAPES; ++s)
+                    {
+                        const auto shape = static_cast<CurveShape>(s);
+                        if (ImGui::Selectable(GetCurveShapeLabel(shape), shape == point.Shape))
+                        {
+                            point.Shape = shape;
+                            changed     = true;
+                        }
+                    }
+                    ImGui::EndCombo();
+                }
+                ImGui::PopItemWidth();
+                ImGui::SameLine(0.0f, ITEM_SEP);
+
+                if (ImGui::Button(("Remove##curvepoint" + pointId).c_str()))
+                {
+                    curve.Curve.Points.erase(curve.Curve.Points.begin() + static_cast<std::ptrdiff_t>(p));
+                    changed = true;
+                    break;
+                }
+            }
+
+            if (ImGui::Button(("Add point##curve" + curveId).c_str()))
+            {
+                const float last = curve.Curve.Points.empty() ? 0.0f : curve.Curve.Points.back().Input;
+                curve.Curve.Points.push_back({std::min(last + range / 10.0f, range), 1.0f});
+                changed = true;
+            }
+        }
+        ImGui::Unindent(HALF_ITEM_WIDTH + ITEM_SEP);
+
+        if (changed)
+        {
+            soundSettings.BakeCurves();
+        }
+    }
+}
+
+void EventSfx::RenderLatencyStats()
+{
+    ImGui::Separator();
+    if (!ImGui::CollapsingHeader("Latency")) return;
+
+    using namespace SoundInterface;
+
+    LatencyStats& latency = this->SoundManager.GetLatencyStats();
+
+    // Off by default; it costs a clock read at each step of a play
+    bool isEnabled = latency.IsEnabled();
+    if (ImGui::Checkbox("Measure from the hooks to the first mixed block", &isEnabled))
+    {
+        latency.SetEnabled(isEnabled);
+    }
+    ImGui::SameLine(0.0f, ITEM_SEP);
+    if (ImGui::Button("Reset##latency"))
+    {
+        latency.Reset();
+    }
+
+    constexpr auto toMs = [](const std::uint64_t micros)
+    {
+        return static_cast<double>(micros) / 1000.0;
+    };
+
+    for (std::size_t i = 0; i < RlEvents::GetEventRegistry().GetCount(); ++i)
+    {
+        const auto total = latency.Get(i, LatencyStage::Total).Summarize();
+        if (total.Count == 0) continue;
+
+        ImGui::TextUnformatted(GetEventLabel(RlEvents::Kind(static_cast<int>(i))).c_str());
+        ImGui::SameLine(HALF_ITEM_WIDTH, ITEM_SEP);
+        ImGui::Text("p50 %.1f  p90 %.1f  p99 %.1f  max %.1f ms  (%llu plays)",
+                    toMs(total.P50), toMs(total.P90), toMs(total.P99), toMs(total.Max),
+                    static_cast<unsigned long long>(total.Count));
+
+        // Where the median goes
+        ImGui::SameLine(0.0f, ITEM_SEP);
+        ImGui::TextDisabled("hook %.2f  queue %.2f  render %.1f ms",
+                            toMs(latency.Get(i, LatencyStage::Hook).Summarize().P50),
+                            toMs(latency.Get(i, LatencyStage::Queue).Summarize().P50),
+                            toMs(latency.Get(i, LatencyStage::Render).Summarize().P50));
+    }
 }
 
 
@@ -767,8 +1569,8 @@ void EventSfx::DrawMapAndPositions(
             this->gameWrapper->Execute(
                 [this, location](GameWrapper*)
                 {
-                    // Play the sound at given position
-                    this->PlayBumpSfx(location, true);
+                    // Play the sound at given position, at a random impact speed
+                    this->PlayBumpSfx(location, Utils::GetRandomFloat(0.0f, 4000.0f), true);
 
                     // Store information
                     NoteClick(this, RlEvents::Kind::Bump, location);
@@ -797,10 +1599,9 @@ void EventSfx::DrawMapAndPositions(
                 {
                     // Compute random ball speed
                     float speed = Utils::GetRandomFloat(500.0f, 5000.0f);
-                    float multiplier = Utils::ComputeVolumeMultiplier(speed);
 
-                    // Play the sound at given position
-                    this->PlayCrossbarSfx(location, multiplier, true);
+                    // Play the sound at given position; its curves set the volume
+                    this->PlayCrossbarSfx(location, speed, true);
 
                     // Store information
                     NoteClick(this, RlEvents::Kind::Crossbar, location);
@@ -1060,17 +1861,24 @@ void EventSfx::DrawCameraAndCarIcons(
 
 void EventSfx::GenerateSoundFileCombo(
     const RlEvents::Kind eventId,
-    SoundSettings&       soundSettings)
+    SoundSettings&       soundSettings,
+    const std::size_t    layer)
 {
-    const std::string identifier = "##sound" + std::to_string(eventId);
+    std::string identifier = "##sound" + std::to_string(eventId);
+    if (layer > 0) identifier += "_" + std::to_string(layer);
 
-    const std::string soundFile = soundSettings.SoundId;
+    // The first sound, and how many more there are to pick from
+    std::vector<std::string>& soundIds     = layer > 0 ? soundSettings.Layers[layer - 1].SoundIds : soundSettings.SoundIds;
+    const float               previewSpeed = layer > 0 ? soundSettings.Layers[layer - 1].MinSpeed : 0.0f;
+
+    std::string preview = soundIds.empty() ? "" : soundIds.front();
+    if (soundIds.size() > 1) preview += " +" + std::to_string(soundIds.size() - 1);
 
     static std::vector<std::string> soundFiles;
     static bool                     needToUpdateList = true;
 
     ImGui::PushItemWidth(ITEM_WIDTH);
-    if (ImGui::BeginCombo(identifier.c_str(), soundFile.c_str()))
+    if (ImGui::BeginCombo(identifier.c_str(), preview.c_str()))
     {
         if (!isComboOpen)
         {
@@ -1082,38 +1890,57 @@ void EventSfx::GenerateSoundFileCombo(
             isComboOpen = true;
         }
 
+        // Ctrl-click to pick several, of which one plays each time
+        const bool multiSelect = ImGui::GetIO().KeyCtrl;
+
         for (const auto& soundFileName : soundFiles)
         {
             std::string soundId = soundFileName;
 
-            const bool isSelected = (soundFile == soundFileName);
-            if (ImGui::Selectable(soundFileName.c_str(), isSelected))
+            const auto selected   = std::ranges::find(soundIds, soundFileName);
+            const bool isSelected = selected != soundIds.end();
+            if (ImGui::Selectable(soundFileName.c_str(), isSelected, multiSelect ? ImGuiSelectableFlags_DontClosePopups : 0))
             {
-                // Load sound
-                HRESULT hr = this->SoundManager.LoadSound(soundId, true);
-                if (FAILED(hr))
+                if (multiSelect && isSelected)
                 {
-                    // Toast
-                    this->gameWrapper->Toast(
-                        "Failed to load sound",
-                        "Try converting it to e.g. 16-bit PCM",
-                        "default", 5.0, ToastType_Warning);
-
-                    LOG("LOAD FAILED. SOUNDID: {}, HRESULT: {}", soundId, hr);
+                    // Keep at least one
+                    if (soundIds.size() > 1) soundIds.erase(selected);
                 }
                 else
                 {
-                    // Set the sound ID
-                    soundSettings.SoundId = soundId;
+                    // Load sound
+                    HRESULT hr = this->SoundManager.LoadSound(soundId, true);
+                    if (FAILED(hr))
+                    {
+                        // Toast
+                        this->gameWrapper->Toast(
+                            "Failed to load sound",
+                            "Try converting it to e.g. 16-bit PCM",
+                            "default", 5.0, ToastType_Warning);
+
+                        LOG("LOAD FAILED. SOUNDID: {}, HRESULT: {}", soundId, hr);
+                    }
+                    else if (multiSelect)
+                    {
+                        soundIds.push_back(soundId);
+                    }
+                    else
+                    {
+                        // Set the sound ID
+                        soundIds = {soundId};
+                    }
                 }
 
-                // Preview the sound
+                // Preload them as a group, so playing only picks between them
+                this->SoundManager.LoadContainer(eventId, soundSettings.GetLayers(), soundSettings.Selection, soundSettings.LayerCrossfade);
+
+                // Preview the sound, at the layer's speed
                 if (this->Settings->PreviewsEnabled)
                 {
                     this->gameWrapper->SetTimeout(
-                        [this, eventId](GameWrapper*)
+                        [this, eventId, previewSpeed](GameWrapper*)
                         {
-                            this->PlayEventSound(eventId);
+                            this->PlayEventSound(eventId, std::nullopt, 1.0f, previewSpeed);
                         },
                         std::min(0.1f, soundSettings.Delay));
                 }
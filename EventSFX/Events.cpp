@@ -0,0 +1,76 @@
+//=======================================================================
+/** Events.cpp
+ * The event registry, and the events built into it
+ */
+//=======================================================================
+
+#include "pch.h"
+#include "Events.h"
+
+namespace RlEvents
+{
+    EventRegistry::EventRegistry()
+    {
+        this->ByStat.fill(NO_EVENT);
+
+        using SoundInterface::SoundCategory;
+
+        // In Kind's order; those added later are off until picked, so updating doesn't change what's heard
+        const EventInfo builtIn[] = {
+            {"bump", "bump", true, true, SoundCategory::Impacts, "bonk.wav", true, 0},
+            {"demo", "demo", true, false, SoundCategory::Impacts, "sm64_mario_so_long_bowser.wav", true, 0},
+            {"crossbar", "crossbar", true, true, SoundCategory::Impacts, "goofy_collision.wav", true, 0},
+            {"win", "win", false, false, SoundCategory::MatchResults, "sm64_mario_game_over.wav", true, 70},
+            {"loss", "loss", false, false, SoundCategory::MatchResults, "sm64_mario_lost_a_life.wav", true, 70},
+            {"playergoal", "player goal", false, false, SoundCategory::MatchResults, "sm64_mario_waha.wav", true, 40},
+            {"teamgoal", "team goal", false, false, SoundCategory::MatchResults, "sm64_mario_lets_go.wav", true, 30},
+            {"concede", "concede", false, false, SoundCategory::MatchResults, "sm64_mario_mamma-mia.wav", true, 30},
+            {"save", "save", false, false, SoundCategory::PlayerEvents, "sm64_mario_hoohoo.wav", true, 10},
+            {"assist", "assist", false, false, SoundCategory::PlayerEvents, "sm64_mario_haha.wav", true, 10},
+            {"epicsave", "epic save", false, false, SoundCategory::PlayerEvents, "sm64_mario_ungh.wav", false, 20, StatEvent::EpicSave},
+            {"aerialgoal", "aerial goal", false, false, SoundCategory::MatchResults, "augh.wav", false, 50, StatEvent::AerialGoal},
+            {"hattrick", "hat trick", false, false, SoundCategory::MatchResults, "breakmonitor.wav", false, 60, StatEvent::HatTrick},
+            {"mvp", "MVP", false, false, SoundCategory::MatchResults, "roblox.wav", false, 80, StatEvent::MVP},
+            {"overtime", "overtime", false, false, SoundCategory::MatchResults, "sm64_mario_doh.wav", false, 20},
+            {"kickoff", "kickoff countdown", false, false, SoundCategory::MatchResults, "sm64_mario_here_we_go.wav", false, 20},
+            {"ballhit", "ball hit", true, true, SoundCategory::Impacts, "bonk.wav", false, 0},
+        };
+        static_assert(std::size(builtIn) == Kind::NumBuiltIn);
+
+        for (const EventInfo& info : builtIn)
+        {
+            this->Register(info);
+        }
+    }
+
+    std::optional<Kind> EventRegistry::Register(EventInfo info)
+    {
+        if (this->Events.size() >= MAX_EVENTS || this->Find(info.StringId).has_value()) return std::nullopt;
+
+        const auto eventId = Kind(static_cast<int>(this->Events.size()));
+
+        // A stat plays the first event that asks for it
+        if (info.Stat != StatEvent::Unknown && this->ByStat[static_cast<std::size_t>(info.Stat)] == NO_EVENT)
+        {
+            this->ByStat[static_cast<std::size_t>(info.Stat)] = static_cast<std::uint8_t>(eventId);
+        }
+
+        this->Events.push_back(std::move(info));
+        return eventId;
+    }
+
+    std::optional<Kind> EventRegistry::Find(const std::string_view stringId) const
+    {
+        for (std::size_t i = 0; i < this->Events.size(); ++i)
+        {
+            if (this->Events[i].StringId == stringId) return Kind(static_cast<int>(i));
+        }
+        return std::nullopt;
+    }
+
+    EventRegistry& GetEventRegistry()
+    {
+        static EventRegistry registry;
+        return registry;
+    }
+}
@@ -1,10 +1,24 @@
 #pragma once
 
+#include "SoundInterface/InstanceLimits.h"
+#include "SoundInterface/LatencyStats.h"
+#include "SoundInterface/SoundCategories.h"
+#include "SoundInterface/SoundContainer.h"
+#include "StatEvents.h"
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
 namespace RlEvents
 {
+	// An index into the event registry, and into everything kept per event
 	class Kind
 	{
 	public:
+		// The built-in events, registered in this order; any registered after them go by index
 		enum EventType
 			: std::uint8_t
 		{
@@ -17,7 +31,15 @@ namespace RlEvents
 			TeamGoal,
 			Concede,
 			Save,
-			Assist
+			Assist,
+			EpicSave,
+			AerialGoal,
+			HatTrick,
+			Mvp,
+			Overtime,
+			Kickoff,
+			BallHit,
+			NumBuiltIn
 		};
 
 		Kind(const EventType t) : Value(t)
@@ -35,50 +57,90 @@ namespace RlEvents
 		EventType Value;
 	};
 
-	inline bool IsEvent3D(const Kind eventId)
+	// One sound container, voice group and row of latencies each
+	constexpr std::size_t MAX_EVENTS = SoundInterface::MAX_SOUND_CONTAINERS;
+	static_assert(MAX_EVENTS <= SoundInterface::MAX_VOICE_GROUPS && MAX_EVENTS <= SoundInterface::MAX_LATENCY_EVENTS);
+	static_assert(Kind::NumBuiltIn <= MAX_EVENTS);
+
+	struct EventInfo
 	{
-		return static_cast<int>(eventId) < 3;
-	}
+		std::string                   StringId;                  // For notifiers and settings files, so it never changes
+		std::string                   Label;                     // For the settings window and logs
+		bool                          Is3D               = false;
+		bool                          HasImpactSpeed     = false; // Hooked with a speed to pick velocity layers by
+		SoundInterface::SoundCategory Category           = SoundInterface::SoundCategory::PlayerEvents;
+		std::string                   DefaultSound;              // From the sounds folder
+		bool                          IsEnabledByDefault = true;
+		std::int32_t                  Priority           = 0;    // Of events that land together, those below one that played are skipped
+		StatEvent                     Stat               = StatEvent::Unknown; // The player's own stat that plays it, for events without rules of their own
+	};
 
-	inline std::string GetEventLabel(const Kind eventId)
+	/*
+	 * What's known about each event, in one flat list indexed by Kind, so
+	 * looking an event up when it plays is an index. The built-in events
+	 * come first; more can be registered at startup, before settings are
+	 * loaded, as settings, notifiers and the settings window are all made
+	 * from the list. After that it's only read, from any thread.
+	 */
+	class EventRegistry
 	{
-		switch (eventId)
+	public:
+		// With the built-in events
+		EventRegistry();
+
+		// Null when the id is taken, or there's no room for another
+		std::optional<Kind> Register(EventInfo info);
+
+		[[nodiscard]] std::size_t GetCount() const
 		{
-		case Kind::Bump:
-			return "bump";
-		case Kind::Demo:
-			return "demo";
-		case Kind::Crossbar:
-			return "crossbar";
-		case Kind::Win:
-			return "win";
-		case Kind::Loss:
-			return "loss";
-		case Kind::PlayerGoal:
-			return "player goal";
-		case Kind::TeamGoal:
-			return "team goal";
-		case Kind::Concede:
-			return "concede";
-		case Kind::Save:
-			return "save";
-		case Kind::Assist:
-			return "assist";
-		default:
-			return "NA";
+			return this->Events.size();
 		}
-	}
 
-	inline std::string GetEventStringId(const Kind eventId)
-	{
-		switch (eventId)
+		[[nodiscard]] const EventInfo& Get(const Kind eventId) const
 		{
-		case Kind::PlayerGoal:
-			return "playergoal";
-		case Kind::TeamGoal:
-			return "teamgoal";
-		default:
-			return GetEventLabel(eventId);
+			return this->Events[static_cast<int>(eventId)];
 		}
+
+		[[nodiscard]] std::optional<Kind> Find(std::string_view stringId) const;
+
+		[[nodiscard]] std::optional<Kind> FindByStat(const StatEvent stat) const
+		{
+			const std::uint8_t index = this->ByStat[static_cast<std::size_t>(stat)];
+			return index == NO_EVENT ? std::nullopt : std::optional(Kind(index));
+		}
+
+	private:
+		static constexpr std::uint8_t NO_EVENT = 0xFF;
+
+		std::vector<EventInfo>                    Events;
+		std::array<std::uint8_t, NUM_STAT_EVENTS> ByStat; // To the event the stat plays, if any
+	};
+
+	EventRegistry& GetEventRegistry();
+
+	inline bool IsEvent3D(const Kind eventId)
+	{
+		return GetEventRegistry().Get(eventId).Is3D;
+	}
+
+	// Those hooked with a speed to pick velocity layers by
+	inline bool HasImpactSpeed(const Kind eventId)
+	{
+		return GetEventRegistry().Get(eventId).HasImpactSpeed;
+	}
+
+	inline SoundInterface::SoundCategory GetEventCategory(const Kind eventId)
+	{
+		return GetEventRegistry().Get(eventId).Category;
+	}
+
+	inline const std::string& GetEventLabel(const Kind eventId)
+	{
+		return GetEventRegistry().Get(eventId).Label;
+	}
+
+	inline const std::string& GetEventStringId(const Kind eventId)
+	{
+		return GetEventRegistry().Get(eventId).StringId;
 	}
 }
@@ -0,0 +1,84 @@
+//=======================================================================
+/** GameEvents.cpp
+ * What the hooks saw happen, and the subscribers that don't play sounds
+ */
+//=======================================================================
+
+#include "pch.h"
+#include "GameEvents.h"
+
+#include <fstream>
+
+namespace RlEvents
+{
+    GameEventRecorder::GameEventRecorder()
+        : Events(RECORDED_EVENT_CAPACITY)
+    {}
+
+    void GameEventRecorder::Record(const GameEvent& event)
+    {
+        const std::lock_guard lock(this->Lock);
+
+        this->Events[this->Next] = event;
+        this->Next               = (this->Next + 1) % RECORDED_EVENT_CAPACITY;
+        this->Count              = std::min(this->Count + 1, RECORDED_EVENT_CAPACITY);
+    }
+
+    void GameEventRecorder::Clear()
+    {
+        const std::lock_guard lock(this->Lock);
+
+        this->Next  = 0;
+        this->Count = 0;
+    }
+
+    std::vector<GameEvent> GameEventRecorder::GetRecent(const std::size_t count) const
+    {
+        const std::lock_guard lock(this->Lock);
+
+        const std::size_t taken = std::min(count, this->Count);
+
+        std::vector<GameEvent> recent;
+        recent.reserve(taken);
+        for (std::size_t i = taken; i > 0; --i)
+        {
+            recent.push_back(this->Events[(this->Next + RECORDED_EVENT_CAPACITY - i) % RECORDED_EVENT_CAPACITY]);
+        }
+
+        return recent;
+    }
+
+    bool GameEventRecorder::SaveCsv(const std::filesystem::path& path) const
+    {
+        const std::vector<GameEvent> recent = this->GetRecent();
+
+        std::ofstream file(path);
+        if (!file.is_open()) return false;
+
+        // Times from the first one, as steady clock times mean nothing on their own
+        const auto start = recent.empty() ? std::chrono::steady_clock::time_point() : recent.front().PostedAt;
+
+        file << "seconds,type,event,stat,clock,player,team,x,y,z,impact_speed,ball_speed,actor,other\n";
+        for (const GameEvent& event : recent)
+        {
+            using SoundInterface::CurveInput;
+
+            file << std::format(
+                "{:.3f},{},{},{},{},{:d},{:d},{:.0f},{:.0f},{:.0f},{:.0f},{:.0f},{:#x},{:#x}\n",
+                std::chrono::duration<double>(event.PostedAt - start).count(),
+                GetGameEventTypeLabel(event.Type),
+                event.Type == GameEventType::Request ? GetEventStringId(event.Event) : "",
+                GetStatEventName(event.Stat),
+                event.ClockSeconds,
+                event.IsPlayer,
+                event.IsPlayerTeam,
+                event.Location.X, event.Location.Y, event.Location.Z,
+                event.Inputs[static_cast<std::size_t>(CurveInput::ImpactSpeed)],
+                event.Inputs[static_cast<std::size_t>(CurveInput::BallSpeed)],
+                event.Actor,
+                event.Other);
+        }
+
+        return file.good();
+    }
+}
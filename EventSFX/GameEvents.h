@@ -0,0 +1,188 @@
+//=======================================================================
+/** GameEvents.h
+ * What the hooks saw happen, and the subscribers that don't play sounds
+ */
+//=======================================================================
+
+#pragma once
+
+#include "SoundInterface/GainCurves.h"
+#include "StatEvents.h"
+
+#include <x3daudio.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Plenty for a frame's worth of events, even with a slow drain
+constexpr std::size_t GAME_EVENT_CAPACITY = 256;
+
+// The last this many are kept by the recorder
+constexpr std::size_t RECORDED_EVENT_CAPACITY = 1024;
+
+namespace RlEvents
+{
+    // In the game's terms; which sound that makes, if any, is up to the sound rules
+    enum class GameEventType
+        : std::uint8_t
+    {
+        Bump = 0, // A car hitting another, or anything else
+        Crossbar, // The ball off the crossbar or a post
+        Demolish,
+        Goal,
+        OwnGoal,
+        Save,
+        Win,
+        Assist,
+        Stat,     // Any other stat ticker event, by its StatEvent
+        Overtime, // Overtime starting
+        Kickoff,  // The countdown to a kickoff starting
+        BallHit,  // A car touching the ball
+        Request,  // An event's sound asked for directly, from a notifier or the settings
+        Count
+    };
+
+    constexpr std::size_t NUM_GAME_EVENT_TYPES = static_cast<std::size_t>(GameEventType::Count);
+
+    constexpr const char* GetGameEventTypeLabel(const GameEventType type)
+    {
+        switch (type)
+        {
+        case GameEventType::Bump:
+            return "bump";
+        case GameEventType::Crossbar:
+            return "crossbar";
+        case GameEventType::Demolish:
+            return "demolish";
+        case GameEventType::Goal:
+            return "goal";
+        case GameEventType::OwnGoal:
+            return "own-goal";
+        case GameEventType::Save:
+            return "save";
+        case GameEventType::Win:
+            return "win";
+        case GameEventType::Assist:
+            return "assist";
+        case GameEventType::Stat:
+            return "stat";
+        case GameEventType::Overtime:
+            return "overtime";
+        case GameEventType::Kickoff:
+            return "kickoff";
+        case GameEventType::BallHit:
+            return "ball-hit";
+        case GameEventType::Request:
+            return "request";
+        default:
+            return "NA";
+        }
+    }
+
+    // Those with rules of their own by type, the rest for whichever event the registry has for them
+    constexpr std::optional<GameEventType> GetGameEventType(const StatEvent stat)
+    {
+        switch (stat)
+        {
+        case StatEvent::Demolish:
+            return GameEventType::Demolish;
+        case StatEvent::Goal:
+            return GameEventType::Goal;
+        case StatEvent::OwnGoal:
+            return GameEventType::OwnGoal;
+        case StatEvent::Save:
+            return GameEventType::Save;
+        case StatEvent::Win:
+            return GameEventType::Win;
+        case StatEvent::Assist:
+            return GameEventType::Assist;
+        case StatEvent::Unknown:
+            return std::nullopt;
+        default:
+            return GameEventType::Stat;
+        }
+    }
+
+    /*
+     * Everything a subscriber gets to know, read on the game thread when
+     * it happened, as only that thread may read the game. Copied whole
+     * through the bus, so it stays plain data.
+     */
+    struct GameEvent
+    {
+        std::chrono::steady_clock::time_point HookedAt; // Only while latency is measured, and for events from hooks
+        std::chrono::steady_clock::time_point PostedAt;
+        Vector                                Location; // The rest is for 3D events only
+        X3DAUDIO_VECTOR                       ListenerLocation;
+        X3DAUDIO_VECTOR                       ListenerFront;
+        X3DAUDIO_VECTOR                       ListenerTop;
+        std::uintptr_t                        Actor            = 0;  // The car that bumped or hit the ball, or the stat's receiver
+        std::uintptr_t                        Other            = 0;  // The car bumped into, the stat's victim, or the ball
+        SoundInterface::CurveInputs           Inputs{};              // For gain curves and velocity layers
+        float                                 VolumeMultiplier = 1.0f;
+        std::int32_t                          ClockSeconds     = -1; // Left on the match clock, -1 outside of a match
+        GameEventType                         Type             = GameEventType::Request;
+        Kind                                  Event            = Kind::Bump; // The sound asked for, for requests
+        StatEvent                             Stat             = StatEvent::Unknown; // For events from the stat ticker
+        bool                                  IsPlayer         = false; // The player's own stat
+        bool                                  IsPlayerTeam     = false; // A stat of the player's team, the player's included
+        bool                                  Is3D             = false;
+        bool                                  FromMenu         = false;
+    };
+
+    // How many of each went through, for the stats notifier
+    class GameEventCounts
+    {
+    public:
+        void Count(const GameEvent& event)
+        {
+            this->Counts[static_cast<std::size_t>(event.Type)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] std::uint64_t Get(const GameEventType type) const
+        {
+            return this->Counts[static_cast<std::size_t>(type)].load(std::memory_order_relaxed);
+        }
+
+        void Reset()
+        {
+            for (auto& count : this->Counts) count.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        std::array<std::atomic<std::uint64_t>, NUM_GAME_EVENT_TYPES> Counts{};
+    };
+
+    /*
+     * The last RECORDED_EVENT_CAPACITY events, oldest overwritten first,
+     * in a ring allocated up front. Recorded on the bus's thread and read
+     * from the game's, which is rare enough for a lock.
+     */
+    class GameEventRecorder
+    {
+    public:
+        GameEventRecorder();
+
+        void Record(const GameEvent& event);
+        void Clear();
+
+        // Newest last
+        [[nodiscard]] std::vector<GameEvent> GetRecent(std::size_t count = RECORDED_EVENT_CAPACITY) const;
+
+        // One line per event, oldest first
+        [[nodiscard]] bool SaveCsv(const std::filesystem::path& path) const;
+
+    private:
+        mutable std::mutex     Lock;
+        std::vector<GameEvent> Events;
+        std::size_t            Next  = 0; // Where the next one goes
+        std::size_t            Count = 0;
+    };
+}
@@ -24,3 +24,9 @@ struct CrossbarParams
     Vector HitLocation;
     Vector HitNormal;
 };
+
+struct BallTouchParams
+{
+    uintptr_t HitCar;
+    uint8_t   HitType;
+};
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "PluginSettings.h"
+#include "SoundInterface/Dsp/Ambisonics.h"
 
 #include "nlohmann/json.hpp"
 #include "utils/parser.h"
@@ -19,15 +20,305 @@ inline std::filesystem::path GetSettingsFilePath(const std::string& filename)
     return globalGameWrapper->GetDataFolder() / filename;
 }
 
+void SoundSettings::BakeDistanceCurve()
+{
+    // Bake a cleaned-up copy so points being edited keep their order
+    SoundInterface::Dsp::DistanceCurve curve = this->Distance;
+    SoundInterface::Dsp::SanitizeDistanceCurve(curve);
+
+    this->DistanceLut = std::make_shared<const SoundInterface::Dsp::DistanceLut>(curve);
+}
+
+void SoundSettings::BakeCurves()
+{
+    for (auto& curve : this->Curves)
+    {
+        curve.Bake();
+    }
+}
+
+float SoundSettings::EvaluateCurves(const SoundInterface::CurveInputs& inputs) const
+{
+    float gain = 1.0f;
+    for (const auto& curve : this->Curves)
+    {
+        if (curve.Lut) gain *= curve.Lut->Evaluate(inputs[static_cast<std::size_t>(curve.Input)]);
+    }
+    return gain;
+}
+
+bool SoundSettings::UsesCurveInput(const SoundInterface::CurveInput input) const
+{
+    return std::ranges::any_of(this->Curves, [input](const auto& curve) { return curve.Input == input; });
+}
+
+std::vector<SoundInterface::VelocityLayer> SoundSettings::GetLayers() const
+{
+    std::vector<SoundInterface::VelocityLayer> layers = {{0.0f, this->SoundIds}};
+    layers.insert(layers.end(), this->Layers.begin(), this->Layers.end());
+    return layers;
+}
+
+// Define how to serialize a DistanceCurve
+// ReSharper disable once CppInconsistentNaming
+void to_json(json& j, const SoundInterface::Dsp::DistanceCurve& c)
+{
+    json points = json::array();
+    for (const auto& [distance, gain] : c.Points)
+    {
+        points.push_back({to_string_with_precision(distance, 2), to_string_with_precision(gain, 2)});
+    }
+
+    j = json{
+        {"model", SoundInterface::Dsp::GetDistanceModelLabel(c.Model)},
+        {"min", to_string_with_precision(c.MinDistance, 2)},
+        {"max", to_string_with_precision(c.MaxDistance, 2)},
+        {"points", points}
+    };
+}
+
+// Define how to deserialize a DistanceCurve
+// ReSharper disable once CppInconsistentNaming
+void from_json(const json& j, SoundInterface::Dsp::DistanceCurve& c)
+{
+    c = {};
+
+    const std::string model = j.value("model", "");
+    for (std::size_t i = 0; i < SoundInterface::Dsp::NUM_DISTANCE_MODELS; ++i)
+    {
+        const auto candidate = static_cast<SoundInterface::Dsp::DistanceModel>(i);
+        if (model == SoundInterface::Dsp::GetDistanceModelLabel(candidate)) c.Model = candidate;
+    }
+
+    if (j.contains("min")) c.MinDistance = get_safe_float(j["min"]);
+    if (j.contains("max")) c.MaxDistance = get_safe_float(j["max"]);
+
+    if (j.contains("points"))
+    {
+        for (const json& point : j["points"])
+        {
+            if (!point.is_array() || point.size() != 2) continue;
+            c.Points.push_back({get_safe_float(point[0]), get_safe_float(point[1])});
+        }
+    }
+}
+
+// Define how to serialize DuckingParams
+// ReSharper disable once CppInconsistentNaming
+void to_json(json& j, const SoundInterface::Dsp::DuckingParams& d)
+{
+    j = json{
+        {"enabled", d.Enabled},
+        {"threshold", to_string_with_precision(d.Threshold, 2)},
+        {"depth", to_string_with_precision(d.Depth, 2)},
+        {"attack", to_string_with_precision(d.Attack, 2)},
+        {"release", to_string_with_precision(d.Release, 2)}
+    };
+}
+
+// Define how to deserialize DuckingParams
+// ReSharper disable once CppInconsistentNaming
+void from_json(const json& j, SoundInterface::Dsp::DuckingParams& d)
+{
+    d = {};
+
+    d.Enabled = j.value("enabled", d.Enabled);
+    if (j.contains("threshold")) d.Threshold = get_safe_float(j["threshold"]);
+    if (j.contains("depth")) d.Depth = get_safe_float(j["depth"]);
+    if (j.contains("attack")) d.Attack = get_safe_float(j["attack"]);
+    if (j.contains("release")) d.Release = get_safe_float(j["release"]);
+
+    SoundInterface::Dsp::SanitizeDuckingParams(d);
+}
+
+// Define how to serialize LimiterParams
+// ReSharper disable once CppInconsistentNaming
+void to_json(json& j, const SoundInterface::Dsp::LimiterParams& l)
+{
+    j = json{
+        {"enabled", l.Enabled},
+        {"ceiling", to_string_with_precision(l.Ceiling, 2)},
+        {"release", to_string_with_precision(l.Release, 2)}
+    };
+}
+
+// Define how to deserialize LimiterParams
+// ReSharper disable once CppInconsistentNaming
+void from_json(const json& j, SoundInterface::Dsp::LimiterParams& l)
+{
+    l = {};
+
+    l.Enabled = j.value("enabled", l.Enabled);
+    if (j.contains("ceiling")) l.Ceiling = get_safe_float(j["ceiling"]);
+    if (j.contains("release")) l.Release = get_safe_float(j["release"]);
+
+    SoundInterface::Dsp::SanitizeLimiterParams(l);
+}
+
+// Define how to serialize an InstanceLimit
+// ReSharper disable once CppInconsistentNaming
+void to_json(json& j, const SoundInterface::InstanceLimit& l)
+{
+    j = json{
+        {"max", l.MaxInstances},
+        {"policy", SoundInterface::GetLimitPolicyLabel(l.Policy)}
+    };
+}
+
+// Define how to deserialize an InstanceLimit
+// ReSharper disable once CppInconsistentNaming
+void from_json(const json& j, SoundInterface::InstanceLimit& l)
+{
+    l = {};
+
+    l.MaxInstances = std::min(j.value("max", MIN_MAX_INSTANCES), MAX_MAX_INSTANCES);
+
+    const std::string policy = j.value("policy", "");
+    for (std::size_t i = 0; i < SoundInterface::NUM_LIMIT_POLICIES; ++i)
+    {
+        const auto candidate = static_cast<SoundInterface::LimitPolicy>(i);
+        if (policy == SoundInterface::GetLimitPolicyLabel(candidate)) l.Policy = candidate;
+    }
+}
+
+// Define how to serialize a CooldownPolicy
+// ReSharper disable once CppInconsistentNaming
+void to_json(json& j, const RlEvents::CooldownPolicy& c)
+{
+    j = json{
+        {"seconds", to_string_with_precision(c.Cooldown, 2)},
+        {"burst", c.Burst},
+        {"rate", to_string_with_precision(c.Rate, 2)},
+        {"scope", RlEvents::GetCooldownScopeLabel(c.Scope)},
+        {"break_through", to_string_with_precision(c.BreakThrough, 1)}
+    };
+}
+
+// Define how to deserialize a CooldownPolicy
+// ReSharper disable once CppInconsistentNaming
+void from_json(const json& j, RlEvents::CooldownPolicy& c)
+{
+    c = {};
+
+    c.Cooldown     = j.contains("seconds") ? get_safe_float(j["seconds"]) : MIN_COOLDOWN;
+    c.Burst        = j.value("burst", MIN_COOLDOWN_BURST);
+    c.Rate         = j.contains("rate") ? get_safe_float(j["rate"]) : c.Rate;
+    c.BreakThrough = j.contains("break_through") ? get_safe_float(j["break_through"]) : 0.0f;
+
+    const std::string scope = j.value("scope", "");
+    for (std::size_t i = 0; i < RlEvents::NUM_COOLDOWN_SCOPES; ++i)
+    {
+        const auto candidate = static_cast<RlEvents::CooldownScope>(i);
+        if (scope == RlEvents::GetCooldownScopeLabel(candidate)) c.Scope = candidate;
+    }
+
+    RlEvents::SanitizeCooldownPolicy(c);
+}
+
+// Define how to serialize an EventCurve
+// ReSharper disable once CppInconsistentNaming
+void to_json(json& j, const SoundInterface::EventCurve& c)
+{
+    json points = json::array();
+    for (const auto& [input, gain, shape] : c.Curve.Points)
+    {
+        points.push_back({
+            to_string_with_precision(input, 2),
+            to_string_with_precision(gain, 2),
+            SoundInterface::Dsp::GetCurveShapeLabel(shape)
+        });
+    }
+
+    j = json{
+        {"input", SoundInterface::GetCurveInputLabel(c.Input)},
+        {"points", points}
+    };
+}
+
+// Define how to deserialize an EventCurve
+// ReSharper disable once CppInconsistentNaming
+void from_json(const json& j, SoundInterface::EventCurve& c)
+{
+    c = {};
+
+    const std::string input = j.value("input", "");
+    for (std::size_t i = 0; i < SoundInterface::NUM_CURVE_INPUTS; ++i)
+    {
+        const auto candidate = static_cast<SoundInterface::CurveInput>(i);
+        if (input == SoundInterface::GetCurveInputLabel(candidate)) c.Input = candidate;
+    }
+
+    if (j.contains("points"))
+    {
+        for (const json& point : j["points"])
+        {
+            if (!point.is_array() || point.size() < 2) continue;
+
+            SoundInterface::Dsp::CurvePoint parsed = {get_safe_float(point[0]), get_safe_float(point[1])};
+
+            const std::string shape = point.size() > 2 ? point[2].get<std::string>() : "";
+            for (std::size_t s = 0; s < SoundInterface::Dsp::NUM_CURVE_SHAPES; ++s)
+            {
+                const auto candidate = static_cast<SoundInterface::Dsp::CurveShape>(s);
+                if (shape == SoundInterface::Dsp::GetCurveShapeLabel(candidate)) parsed.Shape = candidate;
+            }
+
+            c.Curve.Points.push_back(parsed);
+        }
+    }
+
+    SoundInterface::Dsp::SanitizeGainCurve(c.Curve, 0.0f, SoundInterface::GetCurveInputRange(c.Input));
+}
+
+// Define how to serialize a VelocityLayer
+// ReSharper disable once CppInconsistentNaming
+void to_json(json& j, const SoundInterface::VelocityLayer& l)
+{
+    j = json{
+        {"min_speed", to_string_with_precision(l.MinSpeed, 0)},
+        {"sound_ids", l.SoundIds}
+    };
+}
+
+// Define how to deserialize a VelocityLayer
+// ReSharper disable once CppInconsistentNaming
+void from_json(const json& j, SoundInterface::VelocityLayer& l)
+{
+    l = {};
+
+    if (j.contains("min_speed")) l.MinSpeed = get_safe_float(j["min_speed"]);
+    l.MinSpeed = std::clamp(l.MinSpeed, SoundInterface::MIN_LAYER_SPEED, SoundInterface::MAX_LAYER_SPEED);
+
+    if (j.contains("sound_ids")) l.SoundIds = j["sound_ids"].get<std::vector<std::string>>();
+}
+
 // Define how to serialize SoundSettings
 // ReSharper disable once CppInconsistentNaming
 void to_json(json& j, const SoundSettings& s)
 {
+    json sends = json::object();
+    for (std::size_t i = 0; i < SoundInterface::NUM_EFFECT_BUSES; ++i)
+    {
+        const auto bus = static_cast<SoundInterface::EffectBus>(i);
+        sends[SoundInterface::GetEffectBusLabel(bus)] = to_string_with_precision(s.Sends[i], 2);
+    }
+
     j = json{
-        {"sound_id", s.SoundId},
+        {"sound_id", s.SoundIds.empty() ? "" : s.SoundIds.front()}, // For older versions
+        {"sound_ids", s.SoundIds},
+        {"selection", SoundInterface::GetSelectionModeLabel(s.Selection)},
         {"enabled", s.IsEnabled},
         {"delay", to_string_with_precision(s.Delay, 2)},
-        {"volume", to_string_with_precision(s.Volume, 2)}
+        {"volume", to_string_with_precision(s.Volume, 2)},
+        {"sends", sends},
+        {"distance", s.Distance},
+        {"limit", s.Limit},
+        {"cooldown", s.Cooldown},
+        {"pitch_variation", to_string_with_precision(s.PitchVariation, 0)},
+        {"volume_variation", to_string_with_precision(s.VolumeVariation, 1)},
+        {"layers", s.Layers},
+        {"curves", s.Curves},
+        {"layer_crossfade", to_string_with_precision(s.LayerCrossfade, 0)}
     };
 }
 
@@ -35,7 +326,18 @@ void to_json(json& j, const SoundSettings& s)
 // ReSharper disable once CppInconsistentNaming
 void from_json(const json& j, SoundSettings& s)
 {
-    j.at("sound_id").get_to(s.SoundId);
+    // Added later; older settings files have the one sound
+    s.SoundIds = j.contains("sound_ids") ? j["sound_ids"].get<std::vector<std::string>>() : std::vector<std::string>{};
+    if (s.SoundIds.empty()) s.SoundIds = {j.at("sound_id").get<std::string>()};
+
+    s.Selection                 = SoundInterface::SelectionMode::Random;
+    const std::string selection = j.value("selection", "");
+    for (std::size_t i = 0; i < SoundInterface::NUM_SELECTION_MODES; ++i)
+    {
+        const auto candidate = static_cast<SoundInterface::SelectionMode>(i);
+        if (selection == SoundInterface::GetSelectionModeLabel(candidate)) s.Selection = candidate;
+    }
+
     j.at("enabled").get_to(s.IsEnabled);
     s.Delay  = get_safe_float(j["delay"]);
     s.Volume = get_safe_float(j["volume"]);
@@ -45,12 +347,70 @@ void from_json(const json& j, SoundSettings& s)
 
     if (s.Delay < MIN_SOUND_DELAY) s.Delay = MIN_SOUND_DELAY;
     if (s.Delay > MAX_SOUND_DELAY) s.Delay = MAX_SOUND_DELAY;
+
+    // Added later; older settings files play dry
+    s.Sends.fill(0.0f);
+    if (j.contains("sends"))
+    {
+        const json& sends = j["sends"];
+        for (std::size_t i = 0; i < SoundInterface::NUM_EFFECT_BUSES; ++i)
+        {
+            const auto label = SoundInterface::GetEffectBusLabel(static_cast<SoundInterface::EffectBus>(i));
+            if (!sends.contains(label)) continue;
+
+            s.Sends[i] = std::clamp(get_safe_float(sends[label]), MIN_SEND_LEVEL, MAX_SEND_LEVEL);
+        }
+    }
+
+    // Same for distance curves, which default to the old fixed one
+    s.Distance = j.contains("distance") ? j["distance"].get<SoundInterface::Dsp::DistanceCurve>() : SoundInterface::Dsp::DistanceCurve{};
+    SoundInterface::Dsp::SanitizeDistanceCurve(s.Distance);
+    s.BakeDistanceCurve();
+
+    // And limits, which default to none
+    s.Limit = j.contains("limit") ? j["limit"].get<SoundInterface::InstanceLimit>() : SoundInterface::InstanceLimit{};
+
+    // Cooldowns were fixed in code before, so older files keep what the defaults give them
+    if (j.contains("cooldown")) s.Cooldown = j["cooldown"].get<RlEvents::CooldownPolicy>();
+
+    // And variations, which default to none
+    s.PitchVariation  = j.contains("pitch_variation") ? get_safe_float(j["pitch_variation"]) : 0.0f;
+    s.VolumeVariation = j.contains("volume_variation") ? get_safe_float(j["volume_variation"]) : 0.0f;
+    s.PitchVariation  = std::clamp(s.PitchVariation, MIN_PITCH_VARIATION, MAX_PITCH_VARIATION);
+    s.VolumeVariation = std::clamp(s.VolumeVariation, MIN_VOLUME_VARIATION, MAX_VOLUME_VARIATION);
+
+    // And velocity layers, which default to the one set for every speed
+    s.Layers = j.contains("layers") ? j["layers"].get<std::vector<SoundInterface::VelocityLayer>>() : std::vector<SoundInterface::VelocityLayer>{};
+    if (s.Layers.size() >= SoundInterface::MAX_VELOCITY_LAYERS) s.Layers.resize(SoundInterface::MAX_VELOCITY_LAYERS - 1);
+
+    s.LayerCrossfade = j.contains("layer_crossfade") ? get_safe_float(j["layer_crossfade"]) : 0.0f;
+    s.LayerCrossfade = std::clamp(s.LayerCrossfade, SoundInterface::MIN_LAYER_CROSSFADE, SoundInterface::MAX_LAYER_CROSSFADE);
+
+    // And gain curves, which default to none
+    s.Curves = j.contains("curves") ? j["curves"].get<std::vector<SoundInterface::EventCurve>>() : std::vector<SoundInterface::EventCurve>{};
+    if (s.Curves.size() > SoundInterface::MAX_EVENT_CURVES) s.Curves.resize(SoundInterface::MAX_EVENT_CURVES);
+    s.BakeCurves();
 }
 
 // Define JSON serialization for PluginSettings
 // ReSharper disable once CppInconsistentNaming
 void to_json(json& j, const PluginSettings& p)
 {
+    json categoryVolumes = json::object();
+    for (std::size_t i = 0; i < SoundInterface::NUM_SOUND_CATEGORIES; ++i)
+    {
+        const auto category = static_cast<SoundInterface::SoundCategory>(i);
+        categoryVolumes[SoundInterface::GetSoundCategoryLabel(category)] = to_string_with_precision(p.CategoryVolumes[i], 2);
+    }
+
+    // By id, so events added later don't move the others
+    const RlEvents::EventRegistry& registry = RlEvents::GetEventRegistry();
+    json                           sounds   = json::object();
+    for (std::size_t i = 0; i < p.Sounds.size(); ++i)
+    {
+        sounds[registry.Get(RlEvents::Kind(static_cast<int>(i))).StringId] = p.Sounds[i];
+    }
+
     j = json{
         {"volume", to_string_with_precision(p.Volume, 2)},
         {"output_id", Utils::WStringToString(p.OutputId)},
@@ -58,7 +418,15 @@ void to_json(json& j, const PluginSettings& p)
         {"previews_enabled", p.PreviewsEnabled},
         {"pling_enabled", p.CrossbarPlingEnabled},
         {"fixed_crossbar_vol", p.FixedCrossbarVolume},
-        {"sounds", p.Sounds}
+        {"reflections_enabled", p.ReflectionsEnabled},
+        {"second_order_reflections", p.SecondOrderReflections},
+        {"ambisonic_order", p.AmbisonicOrder},
+        {"binaural", p.BinauralEnabled},
+        {"impulse_response", p.ImpulseResponseId},
+        {"category_volumes", categoryVolumes},
+        {"ducking", p.Ducking},
+        {"limiter", p.Limiter},
+        {"sounds", sounds}
     };
 }
 
@@ -72,10 +440,57 @@ void from_json(const json& j, PluginSettings& p)
     j.at("previews_enabled").get_to(p.PreviewsEnabled);
     j.at("pling_enabled").get_to(p.CrossbarPlingEnabled);
     j.at("fixed_crossbar_vol").get_to(p.FixedCrossbarVolume);
-    j.at("sounds").get_to(p.Sounds);
+
+    // Older settings files list the first ten events in order; events they don't have keep their defaults
+    const RlEvents::EventRegistry& registry = RlEvents::GetEventRegistry();
+    const json&                    sounds   = j.at("sounds");
+    const auto getSound = [&registry, &sounds](const std::size_t i) -> const json*
+    {
+        if (sounds.is_array()) return i < sounds.size() ? &sounds[i] : nullptr;
+
+        const std::string& stringId = registry.Get(RlEvents::Kind(static_cast<int>(i))).StringId;
+        return sounds.contains(stringId) ? &sounds[stringId] : nullptr;
+    };
+
+    for (std::size_t i = 0; i < p.Sounds.size(); ++i)
+    {
+        if (const json* sound = getSound(i)) sound->get_to(p.Sounds[i]);
+    }
+
+    // The crossbar's volume followed the ball's speed in code before it had curves
+    const json* crossbar = getSound(RlEvents::Kind::Crossbar);
+    if (crossbar && !crossbar->contains("curves"))
+    {
+        p.Sounds[RlEvents::Kind::Crossbar].Curves = {SoundInterface::GetCrossbarSpeedCurve()};
+        p.Sounds[RlEvents::Kind::Crossbar].BakeCurves();
+    }
+
+    // Added later; older settings files fall back to the defaults
+    p.ReflectionsEnabled     = j.value("reflections_enabled", true);
+    p.SecondOrderReflections = j.value("second_order_reflections", false);
+    p.ImpulseResponseId      = j.value("impulse_response", "");
+    p.AmbisonicOrder         = j.value("ambisonic_order", 0u);
+    p.BinauralEnabled        = j.value("binaural", false);
+    p.Ducking                = j.contains("ducking") ? j["ducking"].get<SoundInterface::Dsp::DuckingParams>() : SoundInterface::Dsp::DuckingParams{};
+    p.Limiter                = j.contains("limiter") ? j["limiter"].get<SoundInterface::Dsp::LimiterParams>() : SoundInterface::Dsp::LimiterParams{};
+
+    p.CategoryVolumes.fill(1.0f);
+    if (j.contains("category_volumes"))
+    {
+        const json& volumes = j["category_volumes"];
+        for (std::size_t i = 0; i < SoundInterface::NUM_SOUND_CATEGORIES; ++i)
+        {
+            const auto label = SoundInterface::GetSoundCategoryLabel(static_cast<SoundInterface::SoundCategory>(i));
+            if (!volumes.contains(label)) continue;
+
+            p.CategoryVolumes[i] = std::clamp(get_safe_float(volumes[label]), MIN_CATEGORY_VOLUME, MAX_CATEGORY_VOLUME);
+        }
+    }
 
     if (p.Volume < MIN_PLUGIN_VOLUME) p.Volume = MIN_PLUGIN_VOLUME;
     if (p.Volume > MAX_PLUGIN_VOLUME) p.Volume = MAX_PLUGIN_VOLUME;
+
+    p.AmbisonicOrder = std::min(p.AmbisonicOrder, SoundInterface::Dsp::MAX_AMBISONIC_ORDER);
 }
 
 PluginSettings::PluginSettings()
@@ -91,16 +506,56 @@ void PluginSettings::SetDefaults()
     this->PreviewsEnabled                    = true;
     this->CrossbarPlingEnabled               = true;
     this->FixedCrossbarVolume                = false;
-    this->Sounds[RlEvents::Kind::Bump]       = {"bonk.wav", true, 0.0f, 1.0f};
-    this->Sounds[RlEvents::Kind::Demo]       = {"sm64_mario_so_long_bowser.wav", true, 0.0f, 1.0f};
-    this->Sounds[RlEvents::Kind::Crossbar]   = {"goofy_collision.wav", true, 0.0f, 1.0f};
-    this->Sounds[RlEvents::Kind::Win]        = {"sm64_mario_game_over.wav", true, 0.1f, 1.0f};
-    this->Sounds[RlEvents::Kind::Loss]       = {"sm64_mario_lost_a_life.wav", true, 0.1f, 1.0f};
-    this->Sounds[RlEvents::Kind::PlayerGoal] = {"sm64_mario_waha.wav", true, 0.1f, 1.0f};
-    this->Sounds[RlEvents::Kind::TeamGoal]   = {"sm64_mario_lets_go.wav", true, 0.1f, 1.0f};
-    this->Sounds[RlEvents::Kind::Concede]    = {"sm64_mario_mamma-mia.wav", true, 0.1f, 1.0f};
-    this->Sounds[RlEvents::Kind::Save]       = {"sm64_mario_hoohoo.wav", true, 0.1f, 1.0f};
-    this->Sounds[RlEvents::Kind::Assist]     = {"sm64_mario_haha.wav", true, 0.1f, 1.0f};
+    this->ReflectionsEnabled                 = true;
+    this->SecondOrderReflections             = false;
+    this->AmbisonicOrder                     = 0;
+    this->BinauralEnabled                    = false;
+    this->ImpulseResponseId                  = "";
+    this->Ducking                            = {};
+    this->Limiter                            = {};
+    this->CategoryVolumes.fill(1.0f);
+
+    // The registry's sound for each, right away for 3D events and a moment later for the rest
+    const RlEvents::EventRegistry& registry = RlEvents::GetEventRegistry();
+    this->Sounds.assign(registry.GetCount(), {});
+    for (std::size_t i = 0; i < this->Sounds.size(); ++i)
+    {
+        const RlEvents::EventInfo& info = registry.Get(RlEvents::Kind(static_cast<int>(i)));
+        this->Sounds[i] = {{info.DefaultSound}, info.IsEnabledByDefault, info.Is3D ? 0.0f : 0.1f, 1.0f, {}};
+    }
+
+    this->Sounds[RlEvents::Kind::Bump].Sends       = {0.1f, 0.0f, 0.0f};
+    this->Sounds[RlEvents::Kind::Demo].Sends       = {0.2f, 0.0f, 0.0f};
+    this->Sounds[RlEvents::Kind::Crossbar].Sends   = {0.3f, 0.0f, 0.0f, 0.3f};
+    this->Sounds[RlEvents::Kind::PlayerGoal].Sends = {0.0f, 0.0f, 0.0f, 0.3f};
+    this->Sounds[RlEvents::Kind::TeamGoal].Sends   = {0.0f, 0.0f, 0.0f, 0.3f};
+    this->Sounds[RlEvents::Kind::AerialGoal].Sends = {0.0f, 0.0f, 0.0f, 0.3f};
+    this->Sounds[RlEvents::Kind::BallHit].Sends    = {0.1f, 0.0f, 0.0f};
+
+    // Impacts can come in bursts; goal and match sounds are one-offs anyway
+    this->Sounds[RlEvents::Kind::Bump].Limit     = {4, SoundInterface::LimitPolicy::StealQuietest};
+    this->Sounds[RlEvents::Kind::Demo].Limit     = {3, SoundInterface::LimitPolicy::KillOldest};
+    this->Sounds[RlEvents::Kind::Crossbar].Limit = {1, SoundInterface::LimitPolicy::Retrigger};
+    this->Sounds[RlEvents::Kind::BallHit].Limit  = {2, SoundInterface::LimitPolicy::StealQuietest};
+
+    // What the hooks used to time out by hand: a pair of cars bumps once per 200 ms, and the
+    // crossbar rings once per 200 ms unless hit three times as hard
+    this->Sounds[RlEvents::Kind::Bump].Cooldown     = {0.2f, 0, 1.0f, RlEvents::CooldownScope::Pair};
+    this->Sounds[RlEvents::Kind::Crossbar].Cooldown = {0.2f, 0, 1.0f, RlEvents::CooldownScope::Event, 3.0f};
+    this->Sounds[RlEvents::Kind::BallHit].Cooldown  = {0.1f, 0, 1.0f, RlEvents::CooldownScope::Pair};
+
+    // Louder the harder the ball hits, like it always was
+    this->Sounds[RlEvents::Kind::Crossbar].Curves = {SoundInterface::GetCrossbarSpeedCurve()};
+
+    // Bumps are heard the most, so they vary by default
+    this->Sounds[RlEvents::Kind::Bump].PitchVariation  = 100.0f;
+    this->Sounds[RlEvents::Kind::Bump].VolumeVariation = 1.5f;
+
+    for (auto& sound : this->Sounds)
+    {
+        sound.BakeDistanceCurve();
+        sound.BakeCurves();
+    }
 }
 
 bool PluginSettings::Load(const std::string& filename)
@@ -1,5 +1,16 @@
 #pragma once
 
+#include "Cooldowns.h"
+#include "SoundInterface/EffectBuses.h"
+#include "SoundInterface/GainCurves.h"
+#include "SoundInterface/InstanceLimits.h"
+#include "SoundInterface/SoundContainer.h"
+#include "SoundInterface/VelocityLayers.h"
+#include "SoundInterface/SoundCategories.h"
+#include "SoundInterface/Dsp/DistanceCurve.h"
+#include "SoundInterface/Dsp/Ducking.h"
+#include "SoundInterface/Dsp/Limiter.h"
+
 constexpr float MIN_PLUGIN_VOLUME = 0.0f;
 constexpr float MAX_PLUGIN_VOLUME = 1.0f;
 constexpr float MIN_SOUND_VOLUME  = 0.0f;
@@ -7,10 +18,20 @@ constexpr float MAX_SOUND_VOLUME  = 5.0f;
 constexpr float MIN_SOUND_DELAY   = 0.0f;
 constexpr float MAX_SOUND_DELAY   = 5.0f;
 
-#define MIN_PLUGIN_VOLUME_PERCENTAGE std::lround(MIN_PLUGIN_VOLUME * 100.0f)
-#define MAX_PLUGIN_VOLUME_PERCENTAGE std::lround(MAX_PLUGIN_VOLUME * 100.0f)
-#define MIN_SOUND_VOLUME_PERCENTAGE  std::lround(MIN_SOUND_VOLUME  * 100.0f)
-#define MAX_SOUND_VOLUME_PERCENTAGE  std::lround(MAX_SOUND_VOLUME  * 100.0f)
+// Random spread either way, picked anew for every play
+constexpr float MIN_PITCH_VARIATION  = 0.0f;    // Cents
+constexpr float MAX_PITCH_VARIATION  = 1200.0f; // An octave, as far up as voices go
+constexpr float MIN_VOLUME_VARIATION = 0.0f;    // Decibels
+constexpr float MAX_VOLUME_VARIATION = 12.0f;
+
+#define MIN_PLUGIN_VOLUME_PERCENTAGE   std::lround(MIN_PLUGIN_VOLUME   * 100.0f)
+#define MAX_PLUGIN_VOLUME_PERCENTAGE   std::lround(MAX_PLUGIN_VOLUME   * 100.0f)
+#define MIN_SOUND_VOLUME_PERCENTAGE    std::lround(MIN_SOUND_VOLUME    * 100.0f)
+#define MAX_SOUND_VOLUME_PERCENTAGE    std::lround(MAX_SOUND_VOLUME    * 100.0f)
+#define MIN_SEND_LEVEL_PERCENTAGE      std::lround(MIN_SEND_LEVEL      * 100.0f)
+#define MAX_SEND_LEVEL_PERCENTAGE      std::lround(MAX_SEND_LEVEL      * 100.0f)
+#define MIN_CATEGORY_VOLUME_PERCENTAGE std::lround(MIN_CATEGORY_VOLUME * 100.0f)
+#define MAX_CATEGORY_VOLUME_PERCENTAGE std::lround(MAX_CATEGORY_VOLUME * 100.0f)
 
 #define DEFAULT_SETTINGS_FILE "eventsfx.json"
 
@@ -20,22 +41,68 @@ inline std::filesystem::path GetSettingsFilePath(const std::string& filename = D
 
 struct SoundSettings
 {
-    std::string SoundId;
+    std::vector<std::string> SoundIds; // One is picked each time the event plays, by Selection
     bool        IsEnabled;
     float       Delay;
     float       Volume;
+
+    // Default send levels into the shared effect buses
+    SoundInterface::SendLevels Sends{};
+
+    // How many may play at once, and what gives when one more is played
+    SoundInterface::InstanceLimit Limit{};
+
+    // How often it may play at all, before it's a sound to limit
+    RlEvents::CooldownPolicy Cooldown{};
+
+    // So the same sound doesn't come out identical every time, without a file per variation
+    float PitchVariation  = 0.0f; // Cents either way
+    float VolumeVariation = 0.0f; // Decibels either way
+
+    SoundInterface::SelectionMode Selection = SoundInterface::SelectionMode::Random;
+
+    // Harder-hitting sets on top of SoundIds, for events with an impact speed
+    std::vector<SoundInterface::VelocityLayer> Layers;
+    float                                      LayerCrossfade = 0.0f; // Width of the band around each threshold
+
+    // SoundIds as the softest layer, then Layers
+    [[nodiscard]] std::vector<SoundInterface::VelocityLayer> GetLayers() const;
+
+    // Volume by what's going on in the game, all multiplied together
+    std::vector<SoundInterface::EventCurve> Curves;
+
+    // Call after changing Curves
+    void BakeCurves();
+
+    [[nodiscard]] float EvaluateCurves(const SoundInterface::CurveInputs& inputs) const;
+    [[nodiscard]] bool  UsesCurveInput(SoundInterface::CurveInput input) const;
+
+    // Distance attenuation for 3D playback, and its baked table
+    SoundInterface::Dsp::DistanceCurve  Distance{};
+    SoundInterface::Dsp::DistanceLutPtr DistanceLut;
+
+    // Call after changing Distance
+    void BakeDistanceCurve();
 };
 
 class PluginSettings
 {
 public:
-    float                         Volume;
-    std::wstring                  OutputId;
-    bool                          SoundTrackingEnabled;
-    bool                          PreviewsEnabled;
-    bool                          CrossbarPlingEnabled;
-    bool                          FixedCrossbarVolume;
-    std::array<SoundSettings, 10> Sounds;
+    float                              Volume;
+    std::wstring                       OutputId;
+    bool                               SoundTrackingEnabled;
+    bool                               PreviewsEnabled;
+    bool                               CrossbarPlingEnabled;
+    bool                               FixedCrossbarVolume;
+    bool                               ReflectionsEnabled;
+    bool                               SecondOrderReflections;
+    std::uint32_t                      AmbisonicOrder;  // 0 for X3DAudio panning
+    bool                               BinauralEnabled; // Decode ambisonics for headphones
+    std::string                        ImpulseResponseId; // Empty for none
+    SoundInterface::CategoryVolumes    CategoryVolumes;
+    SoundInterface::Dsp::DuckingParams Ducking; // Of impacts by match results
+    SoundInterface::Dsp::LimiterParams Limiter; // On the master
+    std::vector<SoundSettings>         Sounds; // Indexed by event, one for each the registry has
 
     PluginSettings();
 
@@ -43,3 +110,6 @@ public:
     bool Load(const std::string& filename = DEFAULT_SETTINGS_FILE);
     bool Save(const std::string& filename = DEFAULT_SETTINGS_FILE);
 };
+
+// A copy that's never changed again, for reading off the game thread
+using PluginSettingsPtr = std::shared_ptr<const PluginSettings>;
@@ -0,0 +1,183 @@
+//=======================================================================
+/** AudioBackend.h
+ * Engine, bus and voice interfaces that the sound code plays through
+ */
+//=======================================================================
+
+#pragma once
+
+#include "SoundInterface/EffectBuses.h"
+#include "SoundInterface/Dsp/Envelope.h"
+#include "SoundInterface/Dsp/Processor.h"
+
+#include <cstdint>
+#include <memory>
+#include <tuple>
+
+namespace SoundInterface::Backend
+{
+    /*
+     * Results use HRESULT values, so Windows code can keep checking them
+     * with FAILED() while the portable backends never see a Windows header.
+     */
+    using Status = std::int32_t;
+
+    constexpr Status STATUS_OK              = 0;
+    constexpr Status STATUS_FALSE           = 1;
+    constexpr Status STATUS_NOT_IMPLEMENTED = static_cast<Status>(0x80004001);
+    constexpr Status STATUS_FAIL            = static_cast<Status>(0x80004005);
+    constexpr Status STATUS_INVALID_ARG     = static_cast<Status>(0x80070057);
+
+    constexpr bool Failed(const Status status)
+    {
+        return status < 0;
+    }
+
+    constexpr std::uint32_t MAX_BUS_CHANNELS = 64; // As many as XAudio2 allows
+
+    // Voices can be played up to an octave up, XAudio2's default, and down as far as it goes
+    constexpr float MIN_FREQUENCY_RATIO = 1.0f / 1024.0f;
+    constexpr float MAX_FREQUENCY_RATIO = 2.0f;
+
+    struct DeviceFormat
+    {
+        std::uint32_t SampleRate  = 48000;
+        std::uint32_t Channels    = 2;
+        std::uint32_t ChannelMask = 0x3; // SPEAKER_* bits, front left and right
+    };
+
+    // Voices always play 32-bit float samples
+    struct VoiceFormat
+    {
+        std::uint32_t SampleRate = 48000;
+        std::uint32_t Channels   = 1;
+
+        bool operator<(const VoiceFormat& other) const
+        {
+            return std::tie(SampleRate, Channels) < std::tie(other.SampleRate, other.Channels);
+        }
+    };
+
+    // Interleaved samples that must stay alive until the voice is done with them
+    struct VoiceBuffer
+    {
+        const float*  Samples = nullptr;
+        std::uint32_t Frames  = 0;
+    };
+
+    // Called from the audio thread
+    class VoiceCallback
+    {
+    public:
+        virtual ~VoiceCallback() = default;
+
+        virtual void OnBufferStart()
+        {}
+
+        virtual void OnStreamEnd() = 0;
+    };
+
+    class Bus
+    {
+    public:
+        [[nodiscard]] virtual std::uint32_t GetInputChannels() const = 0;
+
+        virtual Status SetVolume(float volume) = 0;
+
+        // Deletes the bus; no voice or bus may still send to it
+        virtual void Destroy() = 0;
+
+    protected:
+        virtual ~Bus() = default;
+    };
+
+    class Voice
+    {
+    public:
+        virtual Status SetVolume(float volume) = 0;
+
+        // Speeds playback up or slows it down, and the pitch with it; 1 plays as recorded
+        virtual Status SetFrequencyRatio(float ratio) = 0;
+
+        // Levels are destination-major: levels[d * sourceChannels + s]
+        virtual Status SetOutputMatrix(
+            Bus*          destination,
+            std::uint32_t sourceChannels,
+            std::uint32_t destinationChannels,
+            const float*  levels) = 0;
+
+        // Queues a buffer; the last one queued ends the stream
+        virtual Status Submit(const VoiceBuffer& buffer) = 0;
+
+        // Plays from the given frame of the engine's sample clock, or right away once that has passed
+        virtual Status Start(
+            std::uint64_t    startFrame = 0,
+            const Dsp::Fade& attack     = {}) = 0;
+
+        /*
+         * Fades out, then stops and flushes. The stream ends once it's
+         * silent, with the same callback as a natural end. A voice with
+         * nothing left to play returns STATUS_FALSE.
+         */
+        virtual Status Release(const Dsp::Fade& release = Dsp::STOP_FADE) = 0;
+
+        // Both cut the sound off on the spot; Release is the click-free way
+        virtual Status Stop()  = 0;
+        virtual Status Flush() = 0;
+
+        // Deletes the voice
+        virtual void Destroy() = 0;
+
+    protected:
+        virtual ~Voice() = default;
+    };
+
+    class Engine
+    {
+    public:
+        virtual ~Engine() = default;
+
+        [[nodiscard]] virtual const DeviceFormat& GetDeviceFormat() const = 0;
+
+        /*
+         * Frames mixed since the engine was created, counted at the start
+         * of the next block to be mixed. Start times for voices are on
+         * this clock, so adding a delay to it schedules a voice that far
+         * ahead, to the sample.
+         */
+        [[nodiscard]] virtual std::uint64_t GetSampleClock() const = 0;
+
+        virtual Bus* GetMaster() = 0;
+
+        /*
+         * A bus that runs an optional effect and feeds the master, or
+         * another bus when given one. The effect may change the channel
+         * count from inputChannels to outputChannels.
+         */
+        virtual Status CreateBus(
+            std::uint32_t                          inputChannels,
+            std::uint32_t                          outputChannels,
+            const std::shared_ptr<Dsp::Processor>& effect,
+            Bus**                                  outBus,
+            Bus*                                   output = nullptr) = 0;
+
+        /*
+         * An effect on the master's mix, ahead of its volume, for the
+         * limiter. It must keep the channel count; null removes it.
+         */
+        virtual Status SetMasterEffect(const std::shared_ptr<Dsp::Processor>& effect) = 0;
+
+        // The engine's own effect for a send bus, if it has one
+        virtual Status CreateBuiltinBus(
+            EffectBus kind,
+            Bus**     outBus) = 0;
+
+        // Sends are the only buses the voice may set an output matrix for
+        virtual Status CreateVoice(
+            const VoiceFormat& format,
+            VoiceCallback*     callback,
+            Bus* const*        sends,
+            std::uint32_t      sendCount,
+            Voice**            outVoice) = 0;
+    };
+}
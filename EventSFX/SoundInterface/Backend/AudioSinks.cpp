@@ -0,0 +1,88 @@
+//=======================================================================
+/** AudioSinks.cpp
+ * Where the software mixer's output goes when there is no device
+ */
+//=======================================================================
+
+#include "SoundInterface/Backend/AudioSinks.h"
+
+#include <array>
+#include <cstring>
+
+namespace
+{
+    constexpr std::uint16_t WAVE_FORMAT_FLOAT = 3;
+    constexpr std::uint32_t HEADER_SIZE       = 44;
+
+    // WAV is little endian, like every platform this builds for
+    template <typename T>
+    void Put(std::uint8_t*& out, const T value)
+    {
+        std::memcpy(out, &value, sizeof(T));
+        out += sizeof(T);
+    }
+}
+
+namespace SoundInterface::Backend
+{
+    WavSink::~WavSink()
+    {
+        if (!this->File) return;
+
+        this->WriteHeader();
+        std::fclose(this->File);
+    }
+
+    Status WavSink::Open(const DeviceFormat& format)
+    {
+        if (this->File) return STATUS_FAIL;
+
+        this->File = std::fopen(this->Path.c_str(), "wb");
+        if (!this->File) return STATUS_FAIL;
+
+        this->Format        = format;
+        this->FramesWritten = 0;
+
+        // Placeholder until the length is known
+        this->WriteHeader();
+        return STATUS_OK;
+    }
+
+    void WavSink::Write(const float* samples, const std::uint32_t frames)
+    {
+        if (!this->File) return;
+
+        std::fwrite(samples, sizeof(float) * this->Format.Channels, frames, this->File);
+        this->FramesWritten += frames;
+    }
+
+    void WavSink::WriteHeader()
+    {
+        const std::uint32_t blockAlign = sizeof(float) * this->Format.Channels;
+        const auto          dataBytes  = static_cast<std::uint32_t>(this->FramesWritten * blockAlign);
+
+        std::array<std::uint8_t, HEADER_SIZE> header{};
+        std::uint8_t*                         out = header.data();
+
+        std::memcpy(out, "RIFF", 4);
+        out += 4;
+        Put<std::uint32_t>(out, HEADER_SIZE - 8 + dataBytes);
+        std::memcpy(out, "WAVEfmt ", 8);
+        out += 8;
+        Put<std::uint32_t>(out, 16);
+        Put<std::uint16_t>(out, WAVE_FORMAT_FLOAT);
+        Put<std::uint16_t>(out, static_cast<std::uint16_t>(this->Format.Channels));
+        Put<std::uint32_t>(out, this->Format.SampleRate);
+        Put<std::uint32_t>(out, this->Format.SampleRate * blockAlign);
+        Put<std::uint16_t>(out, static_cast<std::uint16_t>(blockAlign));
+        Put<std::uint16_t>(out, 32);
+        std::memcpy(out, "data", 4);
+        out += 4;
+        Put<std::uint32_t>(out, dataBytes);
+
+        const long position = std::ftell(this->File);
+        std::fseek(this->File, 0, SEEK_SET);
+        std::fwrite(header.data(), 1, header.size(), this->File);
+        if (position > static_cast<long>(HEADER_SIZE)) std::fseek(this->File, position, SEEK_SET);
+    }
+}
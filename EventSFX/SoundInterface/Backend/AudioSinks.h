@@ -0,0 +1,75 @@
+//=======================================================================
+/** AudioSinks.h
+ * Where the software mixer's output goes when there is no device
+ */
+//=======================================================================
+
+#pragma once
+
+#include "SoundInterface/Backend/AudioBackend.h"
+
+#include <cstdio>
+#include <string>
+#include <utility>
+
+namespace SoundInterface::Backend
+{
+    class Sink
+    {
+    public:
+        virtual ~Sink() = default;
+
+        virtual Status Open(const DeviceFormat& format) = 0;
+
+        // Interleaved in the device format
+        virtual void Write(const float* samples, std::uint32_t frames) = 0;
+    };
+
+    // Discards everything, for measuring the mixer alone
+    class NullSink final : public Sink
+    {
+    public:
+        Status Open(const DeviceFormat&) override
+        {
+            return STATUS_OK;
+        }
+
+        void Write(const float*, const std::uint32_t frames) override
+        {
+            this->FramesWritten += frames;
+        }
+
+        [[nodiscard]] std::uint64_t GetFramesWritten() const
+        {
+            return this->FramesWritten;
+        }
+
+    private:
+        std::uint64_t FramesWritten = 0;
+    };
+
+    // 32-bit float WAV file; the header is completed on destruction
+    class WavSink final : public Sink
+    {
+    public:
+        explicit WavSink(std::string path)
+            : Path(std::move(path))
+        {}
+
+        ~WavSink() override;
+
+        WavSink(const WavSink&)            = delete;
+        WavSink& operator=(const WavSink&) = delete;
+
+        Status Open(const DeviceFormat& format) override;
+        void   Write(const float* samples, std::uint32_t frames) override;
+
+    private:
+        void WriteHeader();
+
+        std::string   Path;
+        std::FILE*    File = nullptr;
+        DeviceFormat  Format;
+        std::uint64_t FramesWritten = 0;
+    };
+}
@@ -0,0 +1,762 @@
+//=======================================================================
+/** SoftwareBackend.cpp
+ * Portable in-process mixer and a simulated audio device to drive it
+ */
+//=======================================================================
+
+#include "SoundInterface/Backend/SoftwareBackend.h"
+#include "SoundInterface/Dsp/MixKernels.h"
+#include "SoundInterface/Dsp/Resampler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+
+namespace
+{
+    constexpr float MONO_SPREAD = 0.70710678f; // Constant power, mono into two channels
+
+    // What XAudio2 would do without an explicit matrix, near enough
+    void GetDefaultLevels(
+        const std::uint32_t sourceChannels,
+        const std::uint32_t destinationChannels,
+        std::vector<float>& levels)
+    {
+        levels.assign(static_cast<std::size_t>(sourceChannels) * destinationChannels, 0.0f);
+
+        if (sourceChannels == 1 && destinationChannels >= 2)
+        {
+            levels[0] = MONO_SPREAD;
+            levels[1] = MONO_SPREAD;
+            return;
+        }
+        if (destinationChannels == 1)
+        {
+            std::fill(levels.begin(), levels.end(), 1.0f / static_cast<float>(sourceChannels));
+            return;
+        }
+
+        for (std::uint32_t c = 0; c < std::min(sourceChannels, destinationChannels); ++c)
+        {
+            levels[c * sourceChannels + c] = 1.0f;
+        }
+    }
+
+    // Returns false if every gain is zero
+    bool ScaleLevels(const std::vector<float>& levels, const float volume, std::vector<float>& outGains)
+    {
+        outGains.resize(levels.size());
+
+        bool audible = false;
+        for (std::size_t i = 0; i < levels.size(); ++i)
+        {
+            outGains[i] = levels[i] * volume;
+            audible     = audible || outGains[i] != 0.0f;
+        }
+        return audible;
+    }
+}
+
+namespace SoundInterface::Backend
+{
+    class SoftwareBus final : public Bus
+    {
+    public:
+        SoftwareBus(
+            SoftwareEngine&                 engine,
+            const std::uint32_t             inputChannels,
+            const std::uint32_t             outputChannels,
+            std::shared_ptr<Dsp::Processor> effect,
+            SoftwareBus*                    target)
+            : Owner(engine),
+              InputChannels(inputChannels),
+              OutputChannels(outputChannels),
+              Effect(std::move(effect)),
+              Target(target),
+              Input(static_cast<std::size_t>(MAX_MIX_FRAMES) * inputChannels)
+        {
+            if (this->Effect)
+            {
+                this->Effect->Prepare(engine.Format.SampleRate, inputChannels, MAX_MIX_FRAMES);
+                this->Output.resize(static_cast<std::size_t>(MAX_MIX_FRAMES) * outputChannels);
+            }
+
+            const std::uint32_t targetChannels = target ? target->InputChannels : engine.Format.Channels;
+            GetDefaultLevels(outputChannels, targetChannels, this->OutputLevels);
+        }
+
+        [[nodiscard]] std::uint32_t GetInputChannels() const override
+        {
+            return this->InputChannels;
+        }
+
+        Status SetVolume(const float volume) override
+        {
+            std::lock_guard lock(this->Owner.Lock);
+            this->Volume = volume;
+            return STATUS_OK;
+        }
+
+        void Destroy() override;
+
+        void Clear(const std::uint32_t frames)
+        {
+            std::fill_n(this->Input.begin(), static_cast<std::size_t>(frames) * this->InputChannels, 0.0f);
+        }
+
+        // Runs the effect and mixes the result into the target's input
+        void Render(const std::uint32_t frames)
+        {
+            SoftwareBus& target = this->Target ? *this->Target : *this->Owner.Master;
+
+            const float* output = this->Input.data();
+            if (this->Effect)
+            {
+                this->Effect->Process(this->Input.data(), this->Output.data(), frames);
+                output = this->Output.data();
+            }
+
+            // Volume changes ramp over the block
+            ScaleLevels(this->OutputLevels, this->Volume, this->Gains);
+            if (this->Previous.size() != this->Gains.size()) this->Previous = this->Gains;
+
+            Dsp::MixMatrix(
+                output, this->OutputChannels,
+                target.Input.data(), target.InputChannels,
+                frames,
+                this->Previous.data(), this->Gains.data(),
+                this->Owner.Mono.data());
+
+            this->Previous.swap(this->Gains);
+        }
+
+        SoftwareEngine&                 Owner;
+        std::uint32_t                   InputChannels;
+        std::uint32_t                   OutputChannels;
+        std::shared_ptr<Dsp::Processor> Effect;
+        SoftwareBus*                    Target; // Null for the master
+        std::vector<float>              Input;
+        std::vector<float>              Output;
+        std::vector<float>              OutputLevels;
+        std::vector<float>              Gains;
+        std::vector<float>              Previous; // Gains the last block ended on
+        float                           Volume         = 1.0f;
+        float                           PreviousVolume = 1.0f;
+    };
+
+    class SoftwareVoice final : public Voice
+    {
+    public:
+        struct Send
+        {
+            SoftwareBus*       Target = nullptr;
+            std::vector<float> Levels;
+            std::vector<float> Previous; // Gains the last block ended on
+            bool               Silent    = false;
+            bool               WasSilent = true;
+        };
+
+        enum class Event
+            : std::uint8_t
+        {
+            BufferStart,
+            StreamEnd
+        };
+
+        struct PendingCallback
+        {
+            VoiceCallback* Callback;
+            Event          Type;
+        };
+
+        SoftwareVoice(
+            SoftwareEngine&     engine,
+            const VoiceFormat&  format,
+            VoiceCallback*      callback,
+            std::vector<Send>&& sends)
+            : Owner(engine),
+              Format(format),
+              Callback(callback),
+              Sends(std::move(sends)),
+              BaseStep(static_cast<double>(format.SampleRate) / static_cast<double>(engine.Format.SampleRate)),
+              Step(BaseStep),
+              Envelope(engine.Envelopes.Acquire())
+        {}
+
+        Status SetVolume(const float volume) override
+        {
+            std::lock_guard lock(this->Owner.Lock);
+            this->Volume = volume;
+            return STATUS_OK;
+        }
+
+        Status SetFrequencyRatio(const float ratio) override
+        {
+            if (!(ratio >= MIN_FREQUENCY_RATIO && ratio <= MAX_FREQUENCY_RATIO)) return STATUS_INVALID_ARG;
+
+            std::lock_guard lock(this->Owner.Lock);
+            this->Step = this->BaseStep * ratio;
+            return STATUS_OK;
+        }
+
+        Status SetOutputMatrix(
+            Bus*                destination,
+            const std::uint32_t sourceChannels,
+            const std::uint32_t destinationChannels,
+            const float*        levels) override
+        {
+            if (sourceChannels != this->Format.Channels || !levels) return STATUS_INVALID_ARG;
+
+            std::lock_guard lock(this->Owner.Lock);
+
+            Bus*  target = destination ? destination : this->Owner.Master;
+            auto* send   = this->FindSend(target);
+            if (!send || destinationChannels != send->Target->InputChannels) return STATUS_INVALID_ARG;
+
+            const std::size_t count = static_cast<std::size_t>(sourceChannels) * destinationChannels;
+            send->Levels.assign(levels, levels + count);
+            send->Silent = std::all_of(levels, levels + count, [](const float level) { return level == 0.0f; });
+            return STATUS_OK;
+        }
+
+        Status Submit(const VoiceBuffer& buffer) override
+        {
+            if (!buffer.Samples || buffer.Frames == 0) return STATUS_INVALID_ARG;
+
+            std::lock_guard lock(this->Owner.Lock);
+
+            // A new sound starts on its own gains instead of ramping from the last one's
+            if (this->Queue.empty()) this->Restarted = true;
+
+            this->Queue.push_back(buffer);
+            return STATUS_OK;
+        }
+
+        Status Start(
+            const std::uint64_t startFrame = 0,
+            const Dsp::Fade&    attack     = {}) override
+        {
+            std::lock_guard lock(this->Owner.Lock);
+            this->Playing    = true;
+            this->Releasing  = false;
+            this->StartFrame = startFrame;
+
+            // The attack begins with the sound, however far ahead that is
+            auto& envelopes = this->Owner.Envelopes;
+            envelopes.Jump(this->Envelope, attack.Seconds > 0.0f ? 0.0f : 1.0f);
+            envelopes.Ramp(this->Envelope, 1.0f, attack, this->Owner.Format.SampleRate);
+            return STATUS_OK;
+        }
+
+        Status Release(const Dsp::Fade& release = Dsp::STOP_FADE) override
+        {
+            std::lock_guard lock(this->Owner.Lock);
+            if (!this->Playing || this->Queue.empty()) return STATUS_FALSE;
+
+            // Ends in Render, on the rendering thread like any other stream end
+            this->Releasing = true;
+            this->Owner.Envelopes.Ramp(this->Envelope, 0.0f, release, this->Owner.Format.SampleRate);
+            return STATUS_OK;
+        }
+
+        Status Stop() override
+        {
+            std::lock_guard lock(this->Owner.Lock);
+            this->Playing = false;
+            return STATUS_OK;
+        }
+
+        Status Flush() override
+        {
+            std::lock_guard lock(this->Owner.Lock);
+            this->Queue.clear();
+            this->Position   = 0.0;
+            this->StartFrame = 0;
+            this->Started    = false;
+            this->Releasing  = false;
+            return STATUS_OK;
+        }
+
+        void Destroy() override
+        {
+            {
+                std::lock_guard lock(this->Owner.Lock);
+                std::erase(this->Owner.Voices, this);
+                this->Owner.Envelopes.Free(this->Envelope);
+            }
+            delete this;
+        }
+
+        void DropSend(const SoftwareBus* bus)
+        {
+            std::erase_if(this->Sends, [bus](const Send& send) { return send.Target == bus; });
+        }
+
+        // Fills frames of interleaved voice audio, false if there is nothing to play
+        bool Render(
+            const std::uint64_t           blockStart,
+            const std::uint32_t           frames,
+            float*                        output,
+            std::vector<PendingCallback>& pending)
+        {
+            if (!this->Playing || this->Queue.empty()) return false;
+
+            const std::uint32_t channels = this->Format.Channels;
+
+            // A scheduled start waits for its block, then begins at its frame within it
+            std::uint32_t frame = 0;
+            if (this->StartFrame > blockStart)
+            {
+                // Released before it was ever heard
+                if (this->Releasing)
+                {
+                    this->EndRelease(pending);
+                    return false;
+                }
+                if (this->StartFrame - blockStart >= frames) return false;
+
+                frame = static_cast<std::uint32_t>(this->StartFrame - blockStart);
+                std::fill_n(output, static_cast<std::size_t>(frame) * channels, 0.0f);
+            }
+            const std::uint32_t first = frame;
+            while (frame < frames && !this->Queue.empty())
+            {
+                const VoiceBuffer& buffer = this->Queue.front();
+                if (!this->Started)
+                {
+                    this->Started = true;
+                    if (this->Callback) pending.push_back({this->Callback, Event::BufferStart});
+                }
+
+                if (this->Step == 1.0)
+                {
+                    const auto          index = static_cast<std::uint32_t>(this->Position);
+                    const std::uint32_t count = std::min(frames - frame, buffer.Frames - index);
+
+                    std::memcpy(
+                        output + static_cast<std::size_t>(frame) * channels,
+                        buffer.Samples + static_cast<std::size_t>(index) * channels,
+                        sizeof(float) * count * channels);
+
+                    frame += count;
+                    this->Position += count;
+                }
+                else
+                {
+                    // Read in place, so voices sharing a sound can each play it at their own pitch
+                    frame += Dsp::ResampleLinear(
+                        buffer.Samples, buffer.Frames, channels,
+                        this->Position, this->Step,
+                        output + static_cast<std::size_t>(frame) * channels,
+                        frames - frame);
+                }
+
+                if (this->Position >= buffer.Frames)
+                {
+                    this->Position -= buffer.Frames;
+                    this->Started = false;
+                    this->Queue.pop_front();
+
+                    if (this->Queue.empty())
+                    {
+                        this->Position = 0.0;
+                        if (this->Callback) pending.push_back({this->Callback, Event::StreamEnd});
+                    }
+                }
+            }
+
+            std::fill(
+                output + static_cast<std::size_t>(frame) * channels,
+                output + static_cast<std::size_t>(frames) * channels,
+                0.0f);
+
+            // Nothing to do for the usual voice, steady at full gain
+            auto& envelopes = this->Owner.Envelopes;
+            if (!envelopes.IsUnity(this->Envelope))
+            {
+                envelopes.Apply(
+                    this->Envelope,
+                    output + static_cast<std::size_t>(first) * channels,
+                    channels,
+                    frames - first);
+
+                if (this->Releasing && envelopes.IsIdle(this->Envelope)) this->EndRelease(pending);
+            }
+            return true;
+        }
+
+        // A released voice has faded out; whatever it had left is dropped
+        void EndRelease(std::vector<PendingCallback>& pending)
+        {
+            if (!this->Queue.empty() && this->Callback) pending.push_back({this->Callback, Event::StreamEnd});
+
+            this->Queue.clear();
+            this->Position  = 0.0;
+            this->Started   = false;
+            this->Playing   = false;
+            this->Releasing = false;
+        }
+
+        void Mix(const std::uint32_t frames, const float* input)
+        {
+            const std::uint32_t channels = this->Format.Channels;
+
+            for (auto& send : this->Sends)
+            {
+                const bool audible = !send.Silent && ScaleLevels(send.Levels, this->Volume, this->Gains);
+                if (!audible && send.WasSilent) continue;
+
+                if (this->Restarted || send.Previous.size() != this->Gains.size())
+                {
+                    send.Previous = this->Gains;
+                }
+
+                // Matrix and volume changes ramp over the block
+                Dsp::MixMatrix(
+                    input, channels,
+                    send.Target->Input.data(), send.Target->InputChannels,
+                    frames,
+                    send.Previous.data(), this->Gains.data(),
+                    this->Owner.Mono.data());
+
+                send.Previous.swap(this->Gains);
+                send.WasSilent = !audible;
+            }
+
+            this->Restarted = false;
+        }
+
+        SoftwareEngine&                 Owner;
+        VoiceFormat                     Format;
+        VoiceCallback*                  Callback;
+        std::vector<Send>               Sends;
+        std::deque<VoiceBuffer>         Queue;
+        std::vector<float>              Gains;
+        double                          BaseStep; // Input frames per output frame, as recorded
+        double                          Step;
+        double                          Position   = 0.0;
+        std::uint64_t                   StartFrame = 0; // On the engine's sample clock
+        Dsp::EnvelopeTable::Slot        Envelope;
+        float                           Volume     = 1.0f;
+        bool                            Playing   = false;
+        bool                            Started   = false;
+        bool                            Restarted = true;
+        bool                            Releasing = false; // Fading out, to stop once silent
+
+    private:
+        Send* FindSend(const Bus* bus)
+        {
+            const auto it = std::find_if(
+                this->Sends.begin(), this->Sends.end(),
+                [bus](const Send& send) { return send.Target == bus; });
+
+            return it != this->Sends.end() ? &*it : nullptr;
+        }
+    };
+
+    void SoftwareBus::Destroy()
+    {
+        // The master lives as long as the engine
+        if (this == this->Owner.Master) return;
+
+        {
+            std::lock_guard lock(this->Owner.Lock);
+            std::erase(this->Owner.Buses, this);
+            for (auto* voice : this->Owner.Voices)
+            {
+                voice->DropSend(this);
+            }
+        }
+        delete this;
+    }
+
+    //-----------------------------------------------------------------------
+    // SoftwareEngine
+    //-----------------------------------------------------------------------
+
+    SoftwareEngine::SoftwareEngine(const DeviceFormat& format, std::unique_ptr<Sink> sink)
+        : Format(format),
+          OutputSink(std::move(sink))
+    {
+        this->Master = new SoftwareBus(*this, format.Channels, format.Channels, nullptr, nullptr);
+        this->Mono.resize(MAX_MIX_FRAMES);
+
+        if (this->OutputSink && Failed(this->OutputSink->Open(format))) this->OutputSink.reset();
+    }
+
+    SoftwareEngine::~SoftwareEngine()
+    {
+        for (const auto* voice : this->Voices)
+        {
+            delete voice;
+        }
+        for (const auto* bus : this->Buses)
+        {
+            delete bus;
+        }
+        delete this->Master;
+    }
+
+    Bus* SoftwareEngine::GetMaster()
+    {
+        return this->Master;
+    }
+
+    Status SoftwareEngine::CreateBus(
+        const std::uint32_t                    inputChannels,
+        const std::uint32_t                    outputChannels,
+        const std::shared_ptr<Dsp::Processor>& effect,
+        Bus**                                  outBus,
+        Bus*                                   output)
+    {
+        if (!outBus || inputChannels == 0 || outputChannels == 0) return STATUS_INVALID_ARG;
+        if (!effect && inputChannels != outputChannels) return STATUS_INVALID_ARG;
+        if (effect && effect->GetOutputChannels(inputChannels) != outputChannels) return STATUS_INVALID_ARG;
+
+        std::lock_guard lock(this->Lock);
+
+        auto* target = output && output != this->Master ? static_cast<SoftwareBus*>(output) : nullptr;
+        auto  it     = std::find(this->Buses.begin(), this->Buses.end(), target);
+        if (target && it == this->Buses.end()) return STATUS_INVALID_ARG;
+
+        auto* bus = new SoftwareBus(*this, inputChannels, outputChannels, effect, target);
+
+        // Buses render in order, so one that feeds another goes ahead of it
+        this->Buses.insert(target ? it : this->Buses.end(), bus);
+
+        *outBus = bus;
+        return STATUS_OK;
+    }
+
+    Status SoftwareEngine::SetMasterEffect(const std::shared_ptr<Dsp::Processor>& effect)
+    {
+        const std::uint32_t channels = this->Format.Channels;
+        if (effect && effect->GetOutputChannels(channels) != channels) return STATUS_INVALID_ARG;
+
+        if (effect) effect->Prepare(this->Format.SampleRate, channels, MAX_MIX_FRAMES);
+
+        std::lock_guard lock(this->Lock);
+        this->Master->Effect = effect;
+        return STATUS_OK;
+    }
+
+    Status SoftwareEngine::CreateVoice(
+        const VoiceFormat&  format,
+        VoiceCallback*      callback,
+        Bus* const*         sends,
+        const std::uint32_t sendCount,
+        Voice**             outVoice)
+    {
+        if (!outVoice || format.Channels == 0 || format.SampleRate == 0) return STATUS_INVALID_ARG;
+
+        std::lock_guard lock(this->Lock);
+
+        std::vector<SoftwareVoice::Send> voiceSends;
+        voiceSends.reserve(sendCount + 1);
+
+        auto addSend = [&](Bus* bus)
+        {
+            auto* target = bus ? static_cast<SoftwareBus*>(bus) : this->Master;
+            if (target != this->Master && std::find(this->Buses.begin(), this->Buses.end(), target) == this->Buses.end()) return false;
+
+            SoftwareVoice::Send send;
+            send.Target = target;
+            GetDefaultLevels(format.Channels, target->InputChannels, send.Levels);
+            voiceSends.push_back(std::move(send));
+            return true;
+        };
+
+        // No sends means straight to the master, as in XAudio2
+        if (!sends || sendCount == 0)
+        {
+            addSend(nullptr);
+        }
+        for (std::uint32_t i = 0; sends && i < sendCount; ++i)
+        {
+            if (!addSend(sends[i])) return STATUS_INVALID_ARG;
+        }
+
+        const std::size_t scratch = static_cast<std::size_t>(MAX_MIX_FRAMES) * format.Channels;
+        if (this->Scratch.size() < scratch) this->Scratch.resize(scratch);
+
+        auto* voice = new SoftwareVoice(*this, format, callback, std::move(voiceSends));
+        this->Voices.push_back(voice);
+
+        *outVoice = voice;
+        return STATUS_OK;
+    }
+
+    void SoftwareEngine::Render(std::uint32_t frames)
+    {
+        std::lock_guard lock(this->Lock);
+
+        while (frames > 0)
+        {
+            const std::uint32_t block = std::min(frames, MAX_MIX_FRAMES);
+            this->RenderBlock(block);
+            frames -= block;
+        }
+    }
+
+    std::size_t SoftwareEngine::GetVoiceCount() const
+    {
+        std::lock_guard lock(this->Lock);
+        return this->Voices.size();
+    }
+
+    void SoftwareEngine::RenderBlock(const std::uint32_t frames)
+    {
+        thread_local std::vector<SoftwareVoice::PendingCallback> pending;
+        pending.clear();
+
+        this->Master->Clear(frames);
+        for (auto* bus : this->Buses)
+        {
+            bus->Clear(frames);
+        }
+
+        const std::uint64_t blockStart = this->SampleClock.load(std::memory_order_relaxed);
+        for (auto* voice : this->Voices)
+        {
+            if (voice->Render(blockStart, frames, this->Scratch.data(), pending))
+            {
+                voice->Mix(frames, this->Scratch.data());
+            }
+        }
+
+        for (auto* bus : this->Buses)
+        {
+            bus->Render(frames);
+        }
+
+        auto&               output   = this->Master->Input;
+        const std::uint32_t channels = this->Format.Channels;
+
+        // The master's effect keeps the channel count, so it runs in place
+        if (this->Master->Effect)
+        {
+            this->Master->Effect->Process(output.data(), output.data(), frames);
+        }
+
+        // Master volume, ramped like every other gain
+        const float         from     = this->Master->PreviousVolume;
+        const float         to       = this->Master->Volume;
+        if (from != 1.0f || to != 1.0f)
+        {
+            const float step = (to - from) / static_cast<float>(frames);
+            for (std::uint32_t f = 0; f < frames; ++f)
+            {
+                const float gain = from + step * static_cast<float>(f);
+                for (std::uint32_t c = 0; c < channels; ++c)
+                {
+                    output[static_cast<std::size_t>(f) * channels + c] *= gain;
+                }
+            }
+        }
+        this->Master->PreviousVolume = to;
+
+        if (this->OutputSink) this->OutputSink->Write(output.data(), frames);
+        this->SampleClock.store(blockStart + frames, std::memory_order_release);
+
+        // After mixing, so callbacks may destroy voices; still under the lock, like XAudio2
+        for (const auto& [callback, type] : pending)
+        {
+            if (type == SoftwareVoice::Event::BufferStart)
+            {
+                callback->OnBufferStart();
+            }
+            else
+            {
+                callback->OnStreamEnd();
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------
+    // SimulatedDevice
+    //-----------------------------------------------------------------------
+
+    SimulatedDevice::SimulatedDevice(SoftwareEngine& engine, const std::uint32_t periodFrames)
+        : Engine(engine),
+          PeriodFrames(periodFrames),
+          Period(std::chrono::duration_cast<Clock::duration>(
+              std::chrono::duration<double>(static_cast<double>(periodFrames) / engine.GetDeviceFormat().SampleRate)))
+    {}
+
+    SimulatedDevice::~SimulatedDevice()
+    {
+        this->Stop();
+    }
+
+    void SimulatedDevice::Start()
+    {
+        if (this->Running.exchange(true)) return;
+
+        this->Thread = std::thread(&SimulatedDevice::Run, this);
+    }
+
+    void SimulatedDevice::Stop()
+    {
+        this->Running = false;
+        if (this->Thread.joinable()) this->Thread.join();
+    }
+
+    void SimulatedDevice::RunOffline(const std::uint32_t periods)
+    {
+        for (std::uint32_t i = 0; i < periods; ++i)
+        {
+            const auto start = Clock::now();
+            this->Engine.Render(this->PeriodFrames);
+            this->Record(start, start, Clock::now());
+        }
+    }
+
+    DeviceTiming SimulatedDevice::GetTiming() const
+    {
+        std::lock_guard lock(this->TimingLock);
+
+        DeviceTiming timing = this->Timing;
+        if (timing.Callbacks > 0) timing.MeanRenderMicros = this->TotalRenderMicros / static_cast<double>(timing.Callbacks);
+        return timing;
+    }
+
+    void SimulatedDevice::Run()
+    {
+        auto due = Clock::now();
+
+        while (this->Running.load(std::memory_order_relaxed))
+        {
+            std::this_thread::sleep_until(due);
+
+            const auto woken = Clock::now();
+            this->Engine.Render(this->PeriodFrames);
+            const auto done = Clock::now();
+
+            this->Record(due, woken, done);
+
+            // A device that fell behind glitches and carries on, it does not catch up
+            due += this->Period;
+            if (due < done) due = done;
+        }
+    }
+
+    void SimulatedDevice::Record(
+        const Clock::time_point due,
+        const Clock::time_point woken,
+        const Clock::time_point done)
+    {
+        using Micros = std::chrono::duration<double, std::micro>;
+
+        const double render = Micros(done - woken).count();
+        const double late   = Micros(woken - due).count();
+
+        std::lock_guard lock(this->TimingLock);
+
+        ++this->Timing.Callbacks;
+        if (done > due + this->Period) ++this->Timing.MissedDeadlines;
+
+        this->TotalRenderMicros += render;
+        this->Timing.MaxRenderMicros = std::max(this->Timing.MaxRenderMicros, render);
+        this->Timing.MaxLateMicros   = std::max(this->Timing.MaxLateMicros, late);
+    }
+}
@@ -0,0 +1,150 @@
+//=======================================================================
+/** SoftwareBackend.h
+ * Portable in-process mixer and a simulated audio device to drive it
+ */
+//=======================================================================
+
+#pragma once
+
+#include "SoundInterface/Backend/AudioBackend.h"
+#include "SoundInterface/Backend/AudioSinks.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SoundInterface::Backend
+{
+    constexpr std::uint32_t MAX_MIX_FRAMES = 2048; // Longer renders are split
+
+    class SoftwareBus;
+    class SoftwareVoice;
+
+    /*
+     * Mixes voices through buses into a sink. Render() is what a device
+     * callback would call, on whatever thread drives it. Like XAudio2,
+     * the API may be used from other threads meanwhile, and callbacks
+     * run on the rendering thread.
+     */
+    class SoftwareEngine final : public Engine
+    {
+    public:
+        SoftwareEngine(const DeviceFormat& format, std::unique_ptr<Sink> sink);
+        ~SoftwareEngine() override;
+
+        SoftwareEngine(const SoftwareEngine&)            = delete;
+        SoftwareEngine& operator=(const SoftwareEngine&) = delete;
+
+        [[nodiscard]] const DeviceFormat& GetDeviceFormat() const override
+        {
+            return this->Format;
+        }
+
+        [[nodiscard]] std::uint64_t GetSampleClock() const override
+        {
+            return this->SampleClock.load(std::memory_order_acquire);
+        }
+
+        Bus* GetMaster() override;
+
+        Status CreateBus(
+            std::uint32_t                          inputChannels,
+            std::uint32_t                          outputChannels,
+            const std::shared_ptr<Dsp::Processor>& effect,
+            Bus**                                  outBus,
+            Bus*                                   output = nullptr) override;
+
+        Status SetMasterEffect(const std::shared_ptr<Dsp::Processor>& effect) override;
+
+        // There are no portable versions of XAudio2's effects yet
+        Status CreateBuiltinBus(EffectBus, Bus**) override
+        {
+            return STATUS_NOT_IMPLEMENTED;
+        }
+
+        Status CreateVoice(
+            const VoiceFormat& format,
+            VoiceCallback*     callback,
+            Bus* const*        sends,
+            std::uint32_t      sendCount,
+            Voice**            outVoice) override;
+
+        // Mixes the next frames and hands them to the sink
+        void Render(std::uint32_t frames);
+
+        [[nodiscard]] std::size_t GetVoiceCount() const;
+
+    private:
+        friend class SoftwareBus;
+        friend class SoftwareVoice;
+
+        void RenderBlock(std::uint32_t frames);
+
+        DeviceFormat               Format;
+        std::unique_ptr<Sink>      OutputSink;
+        std::atomic<std::uint64_t> SampleClock = 0;
+
+        // Recursive so callbacks may use the API from the rendering thread
+        mutable std::recursive_mutex Lock;
+
+        SoftwareBus*                Master = nullptr;
+        std::vector<SoftwareBus*>   Buses;
+        std::vector<SoftwareVoice*> Voices;
+        Dsp::EnvelopeTable          Envelopes; // A slot per voice
+        std::vector<float>          Scratch; // One voice's audio
+        std::vector<float>          Mono;    // One channel of it
+    };
+
+    struct DeviceTiming
+    {
+        std::uint64_t Callbacks        = 0;
+        std::uint64_t MissedDeadlines  = 0; // Render finished after the period ran out
+        double        MeanRenderMicros = 0.0;
+        double        MaxRenderMicros  = 0.0;
+        double        MaxLateMicros    = 0.0; // Callback woken up after its due time
+    };
+
+    /*
+     * Calls SoftwareEngine::Render like a device would: one period at
+     * a time, either paced by the wall clock on its own thread, or back
+     * to back for deterministic offline runs.
+     */
+    class SimulatedDevice
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        SimulatedDevice(SoftwareEngine& engine, std::uint32_t periodFrames);
+        ~SimulatedDevice();
+
+        SimulatedDevice(const SimulatedDevice&)            = delete;
+        SimulatedDevice& operator=(const SimulatedDevice&) = delete;
+
+        void Start();
+        void Stop();
+
+        void RunOffline(std::uint32_t periods);
+
+        [[nodiscard]] DeviceTiming    GetTiming() const;
+        [[nodiscard]] Clock::duration GetPeriod() const
+        {
+            return this->Period;
+        }
+
+    private:
+        void Run();
+        void Record(Clock::time_point due, Clock::time_point woken, Clock::time_point done);
+
+        SoftwareEngine&   Engine; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+        std::uint32_t     PeriodFrames;
+        Clock::duration   Period;
+        std::thread       Thread;
+        std::atomic<bool> Running = false;
+
+        mutable std::mutex TimingLock;
+        DeviceTiming       Timing;
+        double             TotalRenderMicros = 0.0;
+    };
+}
@@ -0,0 +1,720 @@
+//=======================================================================
+/** XAudio2Backend.cpp
+ * The audio backend the plugin plays through on Windows
+ */
+//=======================================================================
+
+#include "pch.h"
+#include "SoundInterface/Backend/XAudio2Backend.h"
+#include "SoundInterface/ProcessorXapo.h"
+
+#include <xaudio2fx.h>
+#include <xapofx.h>
+
+namespace
+{
+    /*
+     * XAudio2 only lets a submix send to submixes of a later processing
+     * stage. Buses that feed the master run in the last stage, and each
+     * bus that feeds another bus runs a stage before it.
+     */
+    constexpr UINT32 MASTER_FEED_STAGE = 3;
+
+    // XAudio2 mixes in fixed 10 ms passes
+    constexpr UINT32 PASSES_PER_SECOND = 100;
+}
+
+namespace SoundInterface::Backend
+{
+    class XAudio2Bus final : public Bus
+    {
+    public:
+        XAudio2Bus(
+            IXAudio2Voice*      voice,
+            const std::uint32_t inputChannels,
+            const UINT32        stage,
+            const bool          owned)
+            : Handle(voice),
+              InputChannels(inputChannels),
+              Stage(stage),
+              Owned(owned)
+        {}
+
+        [[nodiscard]] std::uint32_t GetInputChannels() const override
+        {
+            return this->InputChannels;
+        }
+
+        Status SetVolume(const float volume) override
+        {
+            return this->Handle->SetVolume(volume);
+        }
+
+        void Destroy() override
+        {
+            // The mastering voice belongs to the engine
+            if (!this->Owned) return;
+
+            this->Handle->DestroyVoice();
+            delete this;
+        }
+
+        [[nodiscard]] IXAudio2Voice* GetHandle() const
+        {
+            return this->Handle;
+        }
+
+        [[nodiscard]] UINT32 GetStage() const
+        {
+            return this->Stage;
+        }
+
+        ~XAudio2Bus() override = default;
+
+    private:
+        IXAudio2Voice* Handle;
+        std::uint32_t  InputChannels;
+        UINT32         Stage;
+        bool           Owned;
+    };
+
+    /*
+     * XAudio2 can only start a voice at the start of a pass, so buffers
+     * are held here until the voice is started. A start time in a later
+     * pass is handed to the engine, which submits the buffers from the
+     * audio thread at the start of that pass, behind enough silence to
+     * land on the exact frame. Attacks and releases are volume changes
+     * made by the engine at the start of each pass, which XAudio2 ramps
+     * across the pass, so they move in 10 ms steps without clicking.
+     */
+    class XAudio2Voice final
+        : public Voice,
+          public IXAudio2VoiceCallback
+    {
+    public:
+        XAudio2Voice(
+            XAudio2Engine&      engine,
+            VoiceCallback*      callback,
+            const VoiceFormat&  format,
+            IXAudio2Voice*      master)
+            : Owner(engine),
+              Callback(callback),
+              Format(format),
+              Master(master)
+        {
+            std::lock_guard lock(engine.ScheduleLock);
+            this->Envelope = engine.Envelopes.Acquire();
+        }
+
+        Status SetVolume(const float volume) override
+        {
+            float gain;
+            {
+                std::lock_guard lock(this->Owner.ScheduleLock);
+                this->Volume = volume;
+                gain         = this->Owner.Envelopes.GetGain(this->Envelope);
+            }
+            return this->Source->SetVolume(volume * gain);
+        }
+
+        Status SetFrequencyRatio(const float ratio) override
+        {
+            if (!(ratio >= MIN_FREQUENCY_RATIO && ratio <= MAX_FREQUENCY_RATIO)) return STATUS_INVALID_ARG;
+
+            // XAudio2 resamples from the submitted buffer itself
+            return this->Source->SetFrequencyRatio(ratio);
+        }
+
+        Status SetOutputMatrix(
+            Bus*                destination,
+            const std::uint32_t sourceChannels,
+            const std::uint32_t destinationChannels,
+            const float*        levels) override
+        {
+            IXAudio2Voice* handle = destination
+                                        ? static_cast<XAudio2Bus*>(destination)->GetHandle()
+                                        : this->Master;
+
+            return this->Source->SetOutputMatrix(handle, sourceChannels, destinationChannels, levels);
+        }
+
+        Status Submit(const VoiceBuffer& buffer) override
+        {
+            if (!buffer.Samples || buffer.Frames == 0) return E_INVALIDARG;
+
+            std::lock_guard lock(this->Owner.ScheduleLock);
+            this->Held.push_back(buffer);
+            return S_OK;
+        }
+
+        Status Start(
+            const std::uint64_t startFrame = 0,
+            const Dsp::Fade&    attack     = {}) override
+        {
+            std::unique_lock lock(this->Owner.ScheduleLock);
+            this->Attack    = attack;
+            this->Releasing = false;
+
+            if (startFrame > this->Owner.GetSampleClock())
+            {
+                // Never longer than one pass, at the voice's rate
+                const std::size_t leadFrames = this->Format.SampleRate / PASSES_PER_SECOND + 2;
+                if (this->LeadIn.empty()) this->LeadIn.assign(leadFrames * this->Format.Channels, 0.0f);
+
+                this->Owner.Scheduled.push_back({this, startFrame});
+                return S_OK;
+            }
+
+            // No XAudio2 calls under the lock, the audio thread takes it too
+            this->Submitting.swap(this->Held);
+            const float volume = this->BeginAttack();
+            lock.unlock();
+
+            return this->Play(0, volume);
+        }
+
+        Status Release(const Dsp::Fade& release = Dsp::STOP_FADE) override
+        {
+            std::lock_guard lock(this->Owner.ScheduleLock);
+
+            // Not started yet; nothing was heard, so it can end at the next pass
+            const auto scheduled = std::ranges::find(this->Owner.Scheduled, this, &XAudio2Engine::ScheduledStart::Voice);
+            if (scheduled != this->Owner.Scheduled.end())
+            {
+                this->Owner.Scheduled.erase(scheduled);
+                this->Held.clear();
+                this->Owner.Envelopes.Jump(this->Envelope, 0.0f);
+            }
+            else if (!this->Active)
+            {
+                return S_FALSE;
+            }
+            else
+            {
+                this->Owner.Envelopes.Ramp(this->Envelope, 0.0f, release, this->Owner.Format.SampleRate);
+            }
+
+            this->Active    = true;
+            this->Releasing = true;
+            this->StartFading();
+            return S_OK;
+        }
+
+        Status Stop() override
+        {
+            this->Unschedule();
+            return this->Source->Stop(0);
+        }
+
+        Status Flush() override
+        {
+            this->Unschedule();
+            {
+                std::lock_guard lock(this->Owner.ScheduleLock);
+                this->Held.clear();
+            }
+            return this->Source->FlushSourceBuffers();
+        }
+
+        void Destroy() override
+        {
+            this->Unschedule();
+
+            // Blocks until the audio thread is done with the voice
+            if (this->Source) this->Source->DestroyVoice();
+
+            {
+                std::lock_guard lock(this->Owner.ScheduleLock);
+                this->Owner.Envelopes.Free(this->Envelope);
+            }
+            delete this;
+        }
+
+        // Under the schedule lock; returns the volume to start at
+        float BeginAttack()
+        {
+            auto& envelopes = this->Owner.Envelopes;
+            envelopes.Jump(this->Envelope, this->Attack.Seconds > 0.0f ? 0.0f : 1.0f);
+            envelopes.Ramp(this->Envelope, 1.0f, this->Attack, this->Owner.Format.SampleRate);
+
+            this->Active = true;
+            if (!envelopes.IsIdle(this->Envelope)) this->StartFading();
+
+            return this->Volume * envelopes.GetGain(this->Envelope);
+        }
+
+        // Under the schedule lock
+        void StartFading()
+        {
+            if (std::ranges::find(this->Owner.Fading, this) == this->Owner.Fading.end())
+            {
+                this->Owner.Fading.push_back(this);
+            }
+        }
+
+        // Submits the buffers taken from Held behind the lead-in, then starts
+        Status Play(const std::uint32_t offset, const float volume)
+        {
+            HRESULT hr = this->Source->SetVolume(volume);
+
+            const std::uint32_t deviceRate = this->Owner.Format.SampleRate;
+            const auto          leadFrames = std::min<std::uint64_t>(
+                (static_cast<std::uint64_t>(offset) * this->Format.SampleRate + deviceRate / 2) / deviceRate,
+                this->LeadIn.size() / this->Format.Channels);
+
+            if (leadFrames > 0)
+            {
+                XAUDIO2_BUFFER xBuffer = {};
+                xBuffer.AudioBytes     = static_cast<UINT32>(leadFrames * this->Format.Channels * sizeof(float));
+                xBuffer.pAudioData     = reinterpret_cast<const BYTE*>(this->LeadIn.data());
+                xBuffer.pContext       = this; // Not a buffer the callback cares about
+
+                hr = this->Source->SubmitSourceBuffer(&xBuffer);
+            }
+
+            for (const auto& buffer : this->Submitting)
+            {
+                if (FAILED(hr)) break;
+
+                XAUDIO2_BUFFER xBuffer = {};
+                xBuffer.AudioBytes     = buffer.Frames * this->Format.Channels * sizeof(float);
+                xBuffer.pAudioData     = reinterpret_cast<const BYTE*>(buffer.Samples);
+                xBuffer.Flags          = &buffer == &this->Submitting.back() ? XAUDIO2_END_OF_STREAM : 0;
+
+                hr = this->Source->SubmitSourceBuffer(&xBuffer);
+            }
+            this->Submitting.clear();
+
+            if (FAILED(hr)) return hr;
+            return this->Source->Start(0);
+        }
+
+        void Unschedule()
+        {
+            std::lock_guard lock(this->Owner.ScheduleLock);
+            std::erase_if(this->Owner.Scheduled, [this](const auto& start) { return start.Voice == this; });
+            std::erase(this->Owner.Fading, this);
+            this->Releasing = false;
+        }
+
+        // Inherited via IXAudio2VoiceCallback
+        void OnStreamEnd() override
+        {
+            // A release may have ended the stream already
+            bool active;
+            {
+                std::lock_guard lock(this->Owner.ScheduleLock);
+                active       = this->Active;
+                this->Active = false;
+            }
+            if (active && this->Callback) this->Callback->OnStreamEnd();
+        }
+
+        void OnBufferStart(void* pBufferContext) override
+        {
+            if (pBufferContext == this) return;
+            if (this->Callback) this->Callback->OnBufferStart();
+        }
+
+        void OnVoiceProcessingPassStart(UINT32 bytesRequired) override
+        {}
+
+        void OnVoiceProcessingPassEnd() override
+        {}
+
+        void OnBufferEnd(void* pBufferContext) override
+        {}
+
+        void OnLoopEnd(void* pBufferContext) override
+        {}
+
+        void OnVoiceError(void* pBufferContext, HRESULT error) override
+        {}
+
+        IXAudio2SourceVoice*     Source = nullptr;
+        std::vector<VoiceBuffer> Held;       // Submitted, not started yet
+        std::vector<VoiceBuffer> Submitting; // Taken from Held to hand to XAudio2
+
+        // Behind the schedule lock
+        Dsp::EnvelopeTable::Slot Envelope  = 0;
+        Dsp::Fade                Attack;
+        float                    Volume    = 1.0f; // Before the envelope
+        bool                     Active    = false; // Started, and the stream hasn't ended
+        bool                     Releasing = false;
+
+    private:
+        friend class XAudio2Engine;
+
+        ~XAudio2Voice() override = default;
+
+        XAudio2Engine&     Owner; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+        VoiceCallback*     Callback;
+        VoiceFormat        Format;
+        IXAudio2Voice*     Master;
+        std::vector<float> LeadIn; // Silence ahead of a start within a pass
+    };
+
+    Status XAudio2Engine::Create(
+        const LPCWSTR            deviceId,
+        std::unique_ptr<Engine>& outEngine)
+    {
+        std::unique_ptr<XAudio2Engine> engine(new XAudio2Engine());
+
+        HRESULT hr = XAudio2Create(&engine->XAudio2, 0, XAUDIO2_DEFAULT_PROCESSOR);
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO CREATE XAUDIO2 ENGINE. HRESULT: {}", hr);
+            return hr;
+        }
+
+        hr = engine->XAudio2->CreateMasteringVoice(
+            &engine->MasterVoice,
+            XAUDIO2_DEFAULT_CHANNELS,
+            XAUDIO2_DEFAULT_SAMPLERATE,
+            0, deviceId, nullptr,
+            AudioCategory_GameEffects);
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO CREATE MASTERING VOICE. HRESULT: {}", hr);
+            return hr;
+        }
+
+        XAUDIO2_VOICE_DETAILS details;
+        engine->MasterVoice->GetVoiceDetails(&details);
+
+        DWORD speakers;
+        hr = engine->MasterVoice->GetChannelMask(&speakers);
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO GET CHANNEL MASK. HRESULT: {}", hr);
+            return hr;
+        }
+
+        engine->Format.SampleRate  = details.InputSampleRate;
+        engine->Format.Channels    = details.InputChannels;
+        engine->Format.ChannelMask = speakers;
+        engine->Master             = new XAudio2Bus(engine->MasterVoice, details.InputChannels, 0, false);
+        engine->QuantumFrames      = details.InputSampleRate / PASSES_PER_SECOND;
+
+        // For the sample clock and scheduled starts
+        hr = engine->XAudio2->RegisterForCallbacks(engine.get());
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO REGISTER ENGINE CALLBACKS. HRESULT: {}", hr);
+            return hr;
+        }
+
+        outEngine = std::move(engine);
+        return S_OK;
+    }
+
+    XAudio2Engine::~XAudio2Engine()
+    {
+        if (this->XAudio2) this->XAudio2->UnregisterForCallbacks(this);
+
+        delete this->Master;
+
+        if (this->MasterVoice)
+        {
+            this->MasterVoice->DestroyVoice();
+            this->MasterVoice = nullptr;
+        }
+        if (this->XAudio2)
+        {
+            this->XAudio2->Release();
+            this->XAudio2 = nullptr;
+        }
+    }
+
+    Bus* XAudio2Engine::GetMaster()
+    {
+        return this->Master;
+    }
+
+    void XAudio2Engine::OnProcessingPassStart()
+    {
+        const std::uint64_t passStart = this->SampleClock.load(std::memory_order_relaxed);
+        const std::uint64_t passEnd   = passStart + this->QuantumFrames;
+
+        // Released streams are reported once the lock is let go, as the callbacks may use the API
+        thread_local std::vector<VoiceCallback*> ended;
+        ended.clear();
+
+        {
+            // Calls from here apply to the pass about to run; held under the lock so voices can't go away meanwhile
+            std::lock_guard lock(this->ScheduleLock);
+            std::erase_if(this->Scheduled, [passStart, passEnd](const ScheduledStart& start)
+            {
+                if (start.Frame >= passEnd) return false;
+
+                const auto offset = static_cast<std::uint32_t>(start.Frame > passStart ? start.Frame - passStart : 0);
+
+                start.Voice->Submitting.swap(start.Voice->Held);
+                const HRESULT hr = start.Voice->Play(offset, start.Voice->BeginAttack());
+                if (FAILED(hr))
+                {
+                    DEBUGLOG("FAILED TO START SCHEDULED VOICE. HRESULT: {}", hr);
+                }
+                return true;
+            });
+
+            // Each fading voice is set to where its envelope will be at the end of this pass
+            std::erase_if(this->Fading, [this](XAudio2Voice* voice)
+            {
+                // Faded out by the end of the last pass
+                if (voice->Releasing && this->Envelopes.IsIdle(voice->Envelope))
+                {
+                    voice->Source->Stop(0);
+                    voice->Source->FlushSourceBuffers();
+                    if (voice->Active && voice->Callback) ended.push_back(voice->Callback);
+
+                    voice->Active    = false;
+                    voice->Releasing = false;
+                    return true;
+                }
+
+                const float gain = this->Envelopes.Advance(voice->Envelope, this->QuantumFrames);
+                voice->Source->SetVolume(voice->Volume * gain);
+
+                return !voice->Releasing && this->Envelopes.IsIdle(voice->Envelope);
+            });
+        }
+
+        for (auto* callback : ended)
+        {
+            callback->OnStreamEnd();
+        }
+    }
+
+    void XAudio2Engine::OnProcessingPassEnd()
+    {
+        this->SampleClock.fetch_add(this->QuantumFrames, std::memory_order_release);
+    }
+
+    void XAudio2Engine::OnCriticalError(const HRESULT error)
+    {
+        DEBUGLOG("XAUDIO2 CRITICAL ERROR. HRESULT: {}", error);
+    }
+
+    Status XAudio2Engine::CreateSubmix(
+        const std::uint32_t   inputChannels,
+        const std::uint32_t   outputChannels,
+        IUnknown*             effect,
+        const XAudio2Bus*     output,
+        IXAudio2SubmixVoice** outVoice) const
+    {
+        XAUDIO2_SEND_DESCRIPTOR   sendDesc = {0, output ? output->GetHandle() : nullptr};
+        const XAUDIO2_VOICE_SENDS sendList = {1, &sendDesc};
+
+        XAUDIO2_EFFECT_DESCRIPTOR effectDesc;
+        effectDesc.InitialState   = TRUE;
+        effectDesc.OutputChannels = outputChannels;
+        effectDesc.pEffect        = effect;
+
+        const XAUDIO2_EFFECT_CHAIN effectChain = {1, &effectDesc};
+
+        const HRESULT hr = this->XAudio2->CreateSubmixVoice(
+            outVoice,
+            inputChannels,
+            this->Format.SampleRate,
+            0,
+            output ? output->GetStage() - 1 : MASTER_FEED_STAGE,
+            output ? &sendList : nullptr,
+            effect ? &effectChain : nullptr);
+
+        // The voice holds its own reference to the effect
+        if (effect) effect->Release();
+
+        return hr;
+    }
+
+    Status XAudio2Engine::CreateBus(
+        const std::uint32_t                    inputChannels,
+        const std::uint32_t                    outputChannels,
+        const std::shared_ptr<Dsp::Processor>& effect,
+        Bus**                                  outBus,
+        Bus*                                   output)
+    {
+        // The master is the default anyway
+        const auto* target = output != this->Master ? static_cast<XAudio2Bus*>(output) : nullptr;
+        if (target && target->GetStage() == 0)
+        {
+            DEBUGLOG("BUSES ARE NESTED TOO DEEPLY.");
+            return E_INVALIDARG;
+        }
+
+        IUnknown* xapo = effect ? ProcessorXapo::Create(effect, inputChannels != outputChannels) : nullptr;
+
+        IXAudio2SubmixVoice* voice = nullptr;
+        const HRESULT        hr    = this->CreateSubmix(inputChannels, outputChannels, xapo, target, &voice);
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO CREATE SUBMIX VOICE. HRESULT: {}", hr);
+            return hr;
+        }
+
+        *outBus = new XAudio2Bus(voice, inputChannels, target ? target->GetStage() - 1 : MASTER_FEED_STAGE, true);
+        return hr;
+    }
+
+    Status XAudio2Engine::SetMasterEffect(const std::shared_ptr<Dsp::Processor>& effect)
+    {
+        const UINT32 channels = this->Format.Channels;
+        if (effect && effect->GetOutputChannels(channels) != channels) return E_INVALIDARG;
+
+        IUnknown* xapo = effect ? ProcessorXapo::Create(effect) : nullptr;
+
+        XAUDIO2_EFFECT_DESCRIPTOR effectDesc;
+        effectDesc.InitialState   = TRUE;
+        effectDesc.OutputChannels = channels;
+        effectDesc.pEffect        = xapo;
+
+        const XAUDIO2_EFFECT_CHAIN effectChain = {1, &effectDesc};
+
+        const HRESULT hr = this->MasterVoice->SetEffectChain(xapo ? &effectChain : nullptr);
+
+        // The voice holds its own reference to the effect
+        if (xapo) xapo->Release();
+
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO SET MASTER EFFECT. HRESULT: {}", hr);
+        }
+        return hr;
+    }
+
+    Status XAudio2Engine::CreateBuiltinBus(
+        const EffectBus kind,
+        Bus**           outBus)
+    {
+        const UINT32 busChannels = this->Format.Channels >= 2 ? 2 : 1;
+
+        IUnknown* effect        = nullptr;
+        UINT32    inputChannels = busChannels;
+        HRESULT   hr;
+
+        switch (kind)
+        {
+        case EffectBus::Reverb:
+            hr            = XAudio2CreateReverb(&effect, 0);
+            inputChannels = 1; // The reverb spreads a mono send
+            break;
+        case EffectBus::Delay:
+            hr = CreateFX(__uuidof(FXEcho), &effect);
+            break;
+        case EffectBus::Eq:
+            hr = CreateFX(__uuidof(FXEQ), &effect);
+            break;
+        default:
+            return E_NOTIMPL;
+        }
+
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO CREATE {} EFFECT. HRESULT: {}", GetEffectBusLabel(kind), hr);
+            return hr;
+        }
+
+        IXAudio2SubmixVoice* voice = nullptr;
+        hr = this->CreateSubmix(inputChannels, busChannels, effect, nullptr, &voice);
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO CREATE {} VOICE. HRESULT: {}", GetEffectBusLabel(kind), hr);
+            return hr;
+        }
+
+        // Fully wet presets; the send level decides how much is heard
+        switch (kind)
+        {
+        case EffectBus::Reverb:
+        {
+            XAUDIO2FX_REVERB_I3DL2_PARAMETERS preset = XAUDIO2FX_I3DL2_PRESET_ARENA;
+            XAUDIO2FX_REVERB_PARAMETERS       params;
+            ReverbConvertI3DL2ToNative(&preset, &params);
+            params.WetDryMix = XAUDIO2FX_REVERB_MAX_WET_DRY_MIX;
+            hr = voice->SetEffectParameters(0, &params, sizeof(params));
+            break;
+        }
+        case EffectBus::Delay:
+        {
+            FXECHO_PARAMETERS params;
+            params.WetDryMix = FXECHO_MAX_WETDRYMIX;
+            params.Feedback  = 0.35f;
+            params.Delay     = 250.0f;
+            hr = voice->SetEffectParameters(0, &params, sizeof(params));
+            break;
+        }
+        case EffectBus::Eq:
+        {
+            // Thin, radio-like coloring
+            FXEQ_PARAMETERS params;
+            params.FrequencyCenter0 = 100.0f;
+            params.Gain0            = FXEQ_MIN_GAIN;
+            params.Bandwidth0       = FXEQ_DEFAULT_BANDWIDTH;
+            params.FrequencyCenter1 = 800.0f;
+            params.Gain1            = FXEQ_DEFAULT_GAIN;
+            params.Bandwidth1       = FXEQ_DEFAULT_BANDWIDTH;
+            params.FrequencyCenter2 = 2500.0f;
+            params.Gain2            = 2.0f;
+            params.Bandwidth2       = FXEQ_DEFAULT_BANDWIDTH;
+            params.FrequencyCenter3 = 8000.0f;
+            params.Gain3            = 0.5f;
+            params.Bandwidth3       = FXEQ_DEFAULT_BANDWIDTH;
+            hr = voice->SetEffectParameters(0, &params, sizeof(params));
+            break;
+        }
+        default:
+            break;
+        }
+
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO SET {} PARAMETERS. HRESULT: {}", GetEffectBusLabel(kind), hr);
+        }
+
+        *outBus = new XAudio2Bus(voice, inputChannels, MASTER_FEED_STAGE, true);
+        return S_OK;
+    }
+
+    Status XAudio2Engine::CreateVoice(
+        const VoiceFormat&  format,
+        VoiceCallback*      callback,
+        Bus* const*         sends,
+        const std::uint32_t sendCount,
+        Voice**             outVoice)
+    {
+        WAVEFORMATEX wfx    = {};
+        wfx.wFormatTag      = WAVE_FORMAT_IEEE_FLOAT;
+        wfx.nChannels       = static_cast<WORD>(format.Channels);
+        wfx.nSamplesPerSec  = format.SampleRate;
+        wfx.wBitsPerSample  = sizeof(float) * 8;
+        wfx.nBlockAlign     = (wfx.nChannels * wfx.wBitsPerSample) / 8;
+        wfx.nAvgBytesPerSec = wfx.nSamplesPerSec * wfx.nBlockAlign;
+
+        std::vector<XAUDIO2_SEND_DESCRIPTOR> descriptors(sendCount);
+        for (std::uint32_t i = 0; i < sendCount; ++i)
+        {
+            descriptors[i] = {0, static_cast<XAudio2Bus*>(sends[i])->GetHandle()};
+        }
+
+        const XAUDIO2_VOICE_SENDS sendList = {sendCount, descriptors.data()};
+
+        auto* voice = new XAudio2Voice(*this, callback, format, this->MasterVoice);
+
+        const HRESULT hr = this->XAudio2->CreateSourceVoice(
+            &voice->Source, &wfx, 0,
+            MAX_FREQUENCY_RATIO,
+            voice, sendCount > 0 ? &sendList : nullptr);
+
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO CREATE SOURCE VOICE. HRESULT: {}", hr);
+            voice->Source = nullptr;
+            voice->Destroy();
+            return hr;
+        }
+
+        *outVoice = voice;
+        return hr;
+    }
+}
@@ -0,0 +1,110 @@
+//=======================================================================
+/** XAudio2Backend.h
+ * The audio backend the plugin plays through on Windows
+ */
+//=======================================================================
+
+#pragma once
+
+#include <xaudio2.h>
+#pragma comment(lib, "XAUDIO2_8.lib")
+
+#include "SoundInterface/Backend/AudioBackend.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace SoundInterface::Backend
+{
+    class XAudio2Bus;
+    class XAudio2Voice;
+
+    class XAudio2Engine final
+        : public Engine,
+          IXAudio2EngineCallback
+    {
+    public:
+        // A null device id opens the default device
+        static Status Create(
+            LPCWSTR                  deviceId,
+            std::unique_ptr<Engine>& outEngine);
+
+        ~XAudio2Engine() override;
+
+        XAudio2Engine(const XAudio2Engine&)            = delete;
+        XAudio2Engine& operator=(const XAudio2Engine&) = delete;
+
+        [[nodiscard]] const DeviceFormat& GetDeviceFormat() const override
+        {
+            return this->Format;
+        }
+
+        // Counted in whole processing passes, which are 10 ms in XAudio2
+        [[nodiscard]] std::uint64_t GetSampleClock() const override
+        {
+            return this->SampleClock.load(std::memory_order_acquire);
+        }
+
+        Bus* GetMaster() override;
+
+        Status CreateBus(
+            std::uint32_t                          inputChannels,
+            std::uint32_t                          outputChannels,
+            const std::shared_ptr<Dsp::Processor>& effect,
+            Bus**                                  outBus,
+            Bus*                                   output = nullptr) override;
+
+        Status SetMasterEffect(const std::shared_ptr<Dsp::Processor>& effect) override;
+
+        // Reverb, delay and EQ; the convolution bus is a plain CreateBus
+        Status CreateBuiltinBus(
+            EffectBus kind,
+            Bus**     outBus) override;
+
+        Status CreateVoice(
+            const VoiceFormat& format,
+            VoiceCallback*     callback,
+            Bus* const*        sends,
+            std::uint32_t      sendCount,
+            Voice**            outVoice) override;
+
+    private:
+        friend class XAudio2Voice;
+
+        XAudio2Engine() = default;
+
+        // Inherited via IXAudio2EngineCallback, on the audio thread
+        void OnProcessingPassStart() override;
+        void OnProcessingPassEnd() override;
+        void OnCriticalError(HRESULT error) override;
+
+        Status CreateSubmix(
+            std::uint32_t         inputChannels,
+            std::uint32_t         outputChannels,
+            IUnknown*             effect,
+            const XAudio2Bus*     output, // Null for the master
+            IXAudio2SubmixVoice** outVoice) const;
+
+        IXAudio2*               XAudio2     = nullptr;
+        IXAudio2MasteringVoice* MasterVoice = nullptr;
+        XAudio2Bus*             Master      = nullptr;
+        DeviceFormat            Format;
+
+        struct ScheduledStart
+        {
+            XAudio2Voice* Voice;
+            std::uint64_t Frame;
+        };
+
+        // Voices waiting for their start, and their held buffers, behind one lock
+        std::mutex                  ScheduleLock;
+        std::vector<ScheduledStart> Scheduled;
+        std::atomic<std::uint64_t>  SampleClock   = 0;
+        std::uint32_t               QuantumFrames = 0;
+
+        // Envelopes step once a pass, and XAudio2 ramps each volume change over the pass; also behind the lock
+        Dsp::EnvelopeTable         Envelopes;
+        std::vector<XAudio2Voice*> Fading;
+    };
+}
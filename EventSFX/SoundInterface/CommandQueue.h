@@ -0,0 +1,211 @@
+//=======================================================================
+/** CommandQueue.h
+ * Bounded lock-free queue, and a thread that drains it
+ */
+//=======================================================================
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <type_traits>
+
+namespace SoundInterface
+{
+    // Keeps the producers' and the consumer's counters off each other's cache lines
+    constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    /*
+     * Any number of threads push, one thread pops. Every slot carries a
+     * sequence number that says whose turn it is: a producer claims the
+     * tail with one compare-exchange, copies its command in and bumps the
+     * slot's sequence to publish it; the consumer waits for that before
+     * reading, then hands the slot back a lap later. Nothing blocks and
+     * nothing allocates; a full queue refuses the push instead.
+     */
+    template <typename T, std::size_t Capacity>
+    class MpscQueue
+    {
+        static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+        static_assert(std::is_trivially_copyable_v<T>, "Commands are copied in and out of the slots");
+
+    public:
+        MpscQueue()
+        {
+            for (std::size_t i = 0; i < Capacity; ++i)
+            {
+                this->Cells[i].Sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpscQueue(const MpscQueue&)            = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        // Any thread; false when full
+        bool TryPush(const T& value)
+        {
+            std::size_t position = this->Tail.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell&             cell     = this->Cells[position & MASK];
+                const std::size_t sequence = cell.Sequence.load(std::memory_order_acquire);
+                const auto        lag      = static_cast<std::ptrdiff_t>(sequence - position);
+
+                if (lag == 0)
+                {
+                    if (this->Tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        cell.Value = value;
+                        cell.Sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (lag < 0)
+                {
+                    // The consumer hasn't freed this slot from the last lap
+                    return false;
+                }
+                else
+                {
+                    // Another producer got here first
+                    position = this->Tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Consumer thread only; false when empty
+        bool TryPop(T& outValue)
+        {
+            Cell&             cell     = this->Cells[this->Head & MASK];
+            const std::size_t sequence = cell.Sequence.load(std::memory_order_acquire);
+            if (sequence != this->Head + 1) return false;
+
+            outValue = cell.Value;
+            cell.Sequence.store(this->Head + Capacity, std::memory_order_release);
+            ++this->Head;
+            return true;
+        }
+
+    private:
+        static constexpr std::size_t MASK = Capacity - 1;
+
+        struct alignas(CACHE_LINE_SIZE) Cell
+        {
+            std::atomic<std::size_t> Sequence;
+            T                        Value;
+        };
+
+        Cell                                           Cells[Capacity];
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> Tail = 0;
+        alignas(CACHE_LINE_SIZE) std::size_t              Head = 0;
+    };
+
+    /*
+     * A dedicated thread that runs every posted command through one
+     * handler, in the order they were pushed. Posting costs a slot copy
+     * and a wake-up; when the queue is full the command is dropped and
+     * counted rather than making the caller wait.
+     */
+    template <typename Command, std::size_t Capacity>
+    class CommandThread
+    {
+    public:
+        using Handler = std::function<void(const Command&)>;
+
+        CommandThread() = default;
+
+        ~CommandThread()
+        {
+            this->Stop();
+        }
+
+        CommandThread(const CommandThread&)            = delete;
+        CommandThread& operator=(const CommandThread&) = delete;
+
+        void Start(Handler handler)
+        {
+            if (this->Worker.joinable()) return;
+
+            this->Process = std::move(handler);
+            this->Running.store(true, std::memory_order_release);
+            this->Worker = std::thread([this] { this->Run(); });
+        }
+
+        // Commands still queued are dropped
+        void Stop()
+        {
+            if (!this->Worker.joinable()) return;
+
+            this->Running.store(false, std::memory_order_release);
+            this->Wake();
+            this->Worker.join();
+
+            Command discarded;
+            while (this->Queue.TryPop(discarded)) {}
+        }
+
+        // Any thread, never blocks; false if the command was dropped
+        bool Post(const Command& command)
+        {
+            if (!this->Queue.TryPush(command))
+            {
+                this->Dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            this->Wake();
+            return true;
+        }
+
+        [[nodiscard]] std::uint64_t GetDropped() const
+        {
+            return this->Dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        // Only pays for the system call when the thread is actually asleep
+        void Wake()
+        {
+            this->Signal.fetch_add(1, std::memory_order_seq_cst);
+            if (this->Waiting.load(std::memory_order_seq_cst))
+            {
+                this->Signal.notify_one();
+            }
+        }
+
+        void Run()
+        {
+            Command command;
+            while (this->Running.load(std::memory_order_acquire))
+            {
+                // Anything posted after this load changes the signal, so the wait can't miss it
+                const std::uint32_t seen = this->Signal.load(std::memory_order_acquire);
+
+                while (this->Queue.TryPop(command))
+                {
+                    this->Process(command);
+                }
+
+                // Either a producer sees this flag, or this sees its signal
+                this->Waiting.store(true, std::memory_order_seq_cst);
+                if (this->Signal.load(std::memory_order_seq_cst) == seen)
+                {
+                    this->Signal.wait(seen, std::memory_order_acquire);
+                }
+                this->Waiting.store(false, std::memory_order_relaxed);
+            }
+        }
+
+        MpscQueue<Command, Capacity> Queue;
+        Handler                      Process;
+        std::thread                  Worker;
+        std::atomic<bool>            Running = false;
+        std::atomic<bool>            Waiting = false;
+        std::atomic<std::uint32_t>   Signal  = 0;
+        std::atomic<std::uint64_t>   Dropped = 0;
+    };
+}
@@ -0,0 +1,187 @@
+//=======================================================================
+/** DeviceRegistry.cpp
+ * The output devices, enumerated once and kept up to date by notifications
+ */
+//=======================================================================
+
+#include "SoundInterface/DeviceRegistry.h"
+
+#include <algorithm>
+
+namespace
+{
+    using namespace SoundInterface;
+
+    AudioDevice GetDefaultEntry()
+    {
+        return {LDEFAULT_OUTPUT_DEVICE_ID, LDEFAULT_OUTPUT_DEVICE_NAME};
+    }
+}
+
+namespace SoundInterface
+{
+    const AudioDevice* DeviceSnapshot::Find(const std::wstring& id) const
+    {
+        const auto it = std::ranges::find(this->Devices, id, &AudioDevice::Id);
+        return it != this->Devices.end() ? &*it : nullptr;
+    }
+
+    const std::wstring& DeviceSnapshot::Resolve(const std::wstring& id) const
+    {
+        if (id != LDEFAULT_OUTPUT_DEVICE_ID)
+        {
+            if (const AudioDevice* device = this->Find(id)) return device->Id;
+        }
+        return this->DefaultId;
+    }
+
+    Backend::Status ScriptedDeviceProvider::Enumerate(
+        std::vector<AudioDevice>& outDevices,
+        std::wstring&             outDefaultId)
+    {
+        const std::lock_guard lock(this->Lock);
+
+        ++this->Enumerations;
+        outDevices   = this->Devices;
+        outDefaultId = this->DefaultId;
+        return Backend::STATUS_OK;
+    }
+
+    Backend::Status ScriptedDeviceProvider::Watch(ChangeHandler onChange)
+    {
+        const std::lock_guard lock(this->Lock);
+
+        this->OnChange = std::move(onChange);
+        return Backend::STATUS_OK;
+    }
+
+    void ScriptedDeviceProvider::Unwatch()
+    {
+        const std::lock_guard lock(this->Lock);
+
+        this->OnChange = nullptr;
+    }
+
+    void ScriptedDeviceProvider::Add(const AudioDevice& device)
+    {
+        const std::lock_guard lock(this->Lock);
+
+        const auto it = std::ranges::find(this->Devices, device.Id, &AudioDevice::Id);
+        if (it != this->Devices.end())
+        {
+            *it = device;
+        }
+        else
+        {
+            this->Devices.push_back(device);
+        }
+        this->Notify();
+    }
+
+    void ScriptedDeviceProvider::Remove(const std::wstring& id)
+    {
+        const std::lock_guard lock(this->Lock);
+
+        std::erase_if(this->Devices, [&id](const AudioDevice& device) { return device.Id == id; });
+        if (this->DefaultId == id) this->DefaultId.clear();
+        this->Notify();
+    }
+
+    void ScriptedDeviceProvider::SetDefault(const std::wstring& id)
+    {
+        const std::lock_guard lock(this->Lock);
+
+        this->DefaultId = id;
+        this->Notify();
+    }
+
+    std::uint64_t ScriptedDeviceProvider::GetEnumerations() const
+    {
+        const std::lock_guard lock(this->Lock);
+
+        return this->Enumerations;
+    }
+
+    void ScriptedDeviceProvider::Notify() const
+    {
+        // Under the lock, so nothing is called once Unwatch returns
+        if (this->OnChange) this->OnChange();
+    }
+
+    DeviceRegistry::DeviceRegistry(std::unique_ptr<DeviceProvider> provider)
+        : Provider(std::move(provider))
+    {
+        auto snapshot = std::make_shared<DeviceSnapshot>();
+        snapshot->Devices.push_back(GetDefaultEntry());
+        this->Snapshot.store(std::move(snapshot), std::memory_order_release);
+    }
+
+    DeviceRegistry::~DeviceRegistry()
+    {
+        this->Stop();
+    }
+
+    Backend::Status DeviceRegistry::Start(std::function<void()> onChange)
+    {
+        if (this->IsStarted) return Backend::STATUS_FALSE;
+
+        this->OnChange  = std::move(onChange);
+        this->IsStarted = true;
+
+        // Watching first, so a change while enumerating isn't missed
+        const Backend::Status status = this->Provider->Watch(
+            [this]
+            {
+                this->IsStale.store(true, std::memory_order_release);
+                if (this->OnChange) this->OnChange();
+            });
+
+        // Without notifications, the first enumeration is all there'll be
+        this->IsStale.store(true, std::memory_order_release);
+        this->Refresh();
+
+        return status;
+    }
+
+    void DeviceRegistry::Stop()
+    {
+        if (!this->IsStarted) return;
+
+        this->Provider->Unwatch();
+        this->OnChange  = nullptr;
+        this->IsStarted = false;
+    }
+
+    bool DeviceRegistry::Refresh()
+    {
+        const std::lock_guard lock(this->RefreshLock);
+
+        if (!this->IsStale.exchange(false, std::memory_order_acq_rel)) return false;
+
+        return this->Publish();
+    }
+
+    bool DeviceRegistry::Publish()
+    {
+        std::vector<AudioDevice> devices;
+        std::wstring             defaultId;
+        if (Backend::Failed(this->Provider->Enumerate(devices, defaultId)))
+        {
+            // Keeps the last one, and tries again on the next refresh
+            this->IsStale.store(true, std::memory_order_release);
+            return false;
+        }
+
+        const DeviceSnapshotPtr previous = this->GetSnapshot();
+
+        auto snapshot = std::make_shared<DeviceSnapshot>();
+        snapshot->Devices.reserve(devices.size() + 1);
+        snapshot->Devices.push_back(GetDefaultEntry());
+        snapshot->Devices.insert(snapshot->Devices.end(), devices.begin(), devices.end());
+        snapshot->DefaultId = std::move(defaultId);
+        snapshot->Version   = previous->Version + 1;
+
+        this->Snapshot.store(std::move(snapshot), std::memory_order_release);
+        return true;
+    }
+}
@@ -0,0 +1,140 @@
+//=======================================================================
+/** DeviceRegistry.h
+ * The output devices, enumerated once and kept up to date by notifications
+ */
+//=======================================================================
+
+#pragma once
+
+#include "SoundInterface/Backend/AudioBackend.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define DEFAULT_OUTPUT_DEVICE_NAME     "Default"
+#define DEFAULT_OUTPUT_DEVICE_ID       "default"
+#define LDEFAULT_OUTPUT_DEVICE_NAME   L"Default"
+#define LDEFAULT_OUTPUT_DEVICE_ID     L"default"
+
+namespace SoundInterface
+{
+    struct AudioDevice
+    {
+        std::wstring Id;
+        std::wstring Name;
+    };
+
+    // The render endpoints at one point in time, never changed once published
+    struct DeviceSnapshot
+    {
+        std::vector<AudioDevice> Devices;   // The default entry first, then the active endpoints
+        std::wstring             DefaultId; // The endpoint the default entry stands for, empty if there's none
+        std::uint64_t            Version = 0;
+
+        // Null if it isn't there
+        [[nodiscard]] const AudioDevice* Find(const std::wstring& id) const;
+
+        // The endpoint to play on for the id: itself, or the default's for the default entry and for ones that are gone
+        [[nodiscard]] const std::wstring& Resolve(const std::wstring& id) const;
+    };
+
+    using DeviceSnapshotPtr = std::shared_ptr<const DeviceSnapshot>;
+
+    // Where the endpoints come from
+    class DeviceProvider
+    {
+    public:
+        using ChangeHandler = std::function<void()>;
+
+        virtual ~DeviceProvider() = default;
+
+        // The active render endpoints, and the default's id or empty
+        virtual Backend::Status Enumerate(
+            std::vector<AudioDevice>& outDevices,
+            std::wstring&             outDefaultId) = 0;
+
+        // The handler is called from any thread when endpoints come, go or the default changes, and mustn't block
+        virtual Backend::Status Watch(ChangeHandler onChange) = 0;
+        virtual void            Unwatch()                     = 0;
+    };
+
+    /*
+     * Endpoints that come and go when told to, notifying as the system
+     * would, for running the device handling off Windows.
+     */
+    class ScriptedDeviceProvider final : public DeviceProvider
+    {
+    public:
+        Backend::Status Enumerate(
+            std::vector<AudioDevice>& outDevices,
+            std::wstring&             outDefaultId) override;
+
+        Backend::Status Watch(ChangeHandler onChange) override;
+        void            Unwatch() override;
+
+        // Replaces the one with the same id
+        void Add(const AudioDevice& device);
+
+        // Along with being the default
+        void Remove(const std::wstring& id);
+
+        void SetDefault(const std::wstring& id);
+
+        // How often it's been enumerated, to check that it's cached
+        [[nodiscard]] std::uint64_t GetEnumerations() const;
+
+    private:
+        void Notify() const;
+
+        mutable std::mutex       Lock;
+        std::vector<AudioDevice> Devices;
+        std::wstring             DefaultId;
+        ChangeHandler            OnChange;
+        std::uint64_t            Enumerations = 0;
+    };
+
+    /*
+     * Enumerates once, and again only after the provider says something
+     * changed, publishing each result as an immutable snapshot. Readers
+     * take the latest with one atomic load and can hold on to it for as
+     * long as they like. Refreshing is left to whoever is told about the
+     * change, as it blocks on the system and notifications can't.
+     */
+    class DeviceRegistry
+    {
+    public:
+        explicit DeviceRegistry(std::unique_ptr<DeviceProvider> provider);
+        ~DeviceRegistry();
+
+        DeviceRegistry(const DeviceRegistry&)            = delete;
+        DeviceRegistry& operator=(const DeviceRegistry&) = delete;
+
+        // Enumerates and starts watching; onChange is called, from any thread, when a refresh is due
+        Backend::Status Start(std::function<void()> onChange);
+        void            Stop();
+
+        // Enumerates again if something changed since the last time; true if it published a new snapshot
+        bool Refresh();
+
+        // Never null; just the default entry until the first enumeration
+        [[nodiscard]] DeviceSnapshotPtr GetSnapshot() const
+        {
+            return this->Snapshot.load(std::memory_order_acquire);
+        }
+
+    private:
+        bool Publish();
+
+        std::unique_ptr<DeviceProvider> Provider;
+        std::atomic<DeviceSnapshotPtr>  Snapshot;
+        std::atomic<bool>               IsStale = true;
+        std::mutex                      RefreshLock; // Enumerations one at a time
+        std::function<void()>           OnChange;
+        bool                            IsStarted = false;
+    };
+}
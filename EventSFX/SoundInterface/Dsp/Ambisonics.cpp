@@ -0,0 +1,413 @@
+//=======================================================================
+/** Ambisonics.cpp
+ * B-format encoding of emitters and one shared decode per block
+ */
+//=======================================================================
+
+#include "SoundInterface/Dsp/Ambisonics.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr float PI          = 3.14159265f;
+    constexpr float HEAD_RADIUS = 0.0875f; // Meters
+    constexpr float SPEED       = 343.0f;  // Meters per second
+
+    // Degree of each ACN channel
+    constexpr std::array<std::uint32_t, SoundInterface::Dsp::MAX_AMBISONIC_CHANNELS> DEGREES = {
+        0,
+        1, 1, 1,
+        2, 2, 2, 2, 2,
+        3, 3, 3, 3, 3, 3, 3
+    };
+
+    // Channels with |m| == l, the only ones that vary around a horizontal ring
+    constexpr std::array<bool, SoundInterface::Dsp::MAX_AMBISONIC_CHANNELS> IS_SECTORAL = {
+        true,
+        true, false, true,
+        true, false, false, false, true,
+        true, false, false, false, false, false, true
+    };
+}
+
+namespace SoundInterface::Dsp
+{
+    void EncodeAmbisonics(
+        const float*        x,
+        const float*        y,
+        const float*        z,
+        const float*        gains,
+        const std::size_t   count,
+        const std::uint32_t order,
+        float*              outGains,
+        const std::size_t   stride)
+    {
+        auto channel = [&](const std::uint32_t n) { return outGains + n * stride; };
+
+        // Straight loops over the batch so the compiler can vectorize them
+        float* w  = channel(0);
+        float* ny = channel(1);
+        float* nz = channel(2);
+        float* nx = channel(3);
+        for (std::size_t e = 0; e < count; ++e)
+        {
+            const float length = std::sqrt(x[e] * x[e] + y[e] * y[e] + z[e] * z[e]);
+            const float scale  = length > 1e-6f ? 1.0f / length : 0.0f;
+
+            w[e]  = gains[e];
+            nx[e] = x[e] * scale;
+            ny[e] = y[e] * scale;
+            nz[e] = z[e] * scale;
+        }
+
+        // The first order channels hold the unit direction until scaled below
+        if (order >= 2)
+        {
+            constexpr float sqrt3    = 1.7320508f;
+            constexpr float sqrt15   = 3.8729833f;
+            constexpr float sqrt3_8  = 0.6123724f;
+            constexpr float sqrt5_8  = 0.7905694f;
+
+            float* c4  = channel(4);
+            float* c5  = channel(5);
+            float* c6  = channel(6);
+            float* c7  = channel(7);
+            float* c8  = channel(8);
+            for (std::size_t e = 0; e < count; ++e)
+            {
+                const float g = w[e];
+                c4[e]         = g * sqrt3 * nx[e] * ny[e];
+                c5[e]         = g * sqrt3 * ny[e] * nz[e];
+                c6[e]         = g * 0.5f * (3.0f * nz[e] * nz[e] - 1.0f);
+                c7[e]         = g * sqrt3 * nx[e] * nz[e];
+                c8[e]         = g * 0.5f * sqrt3 * (nx[e] * nx[e] - ny[e] * ny[e]);
+            }
+
+            if (order >= 3)
+            {
+                float* c9  = channel(9);
+                float* c10 = channel(10);
+                float* c11 = channel(11);
+                float* c12 = channel(12);
+                float* c13 = channel(13);
+                float* c14 = channel(14);
+                float* c15 = channel(15);
+                for (std::size_t e = 0; e < count; ++e)
+                {
+                    const float g  = w[e];
+                    const float xx = nx[e] * nx[e];
+                    const float yy = ny[e] * ny[e];
+                    const float zz = nz[e] * nz[e];
+
+                    c9[e]  = g * sqrt5_8 * ny[e] * (3.0f * xx - yy);
+                    c10[e] = g * sqrt15 * nx[e] * ny[e] * nz[e];
+                    c11[e] = g * sqrt3_8 * ny[e] * (5.0f * zz - 1.0f);
+                    c12[e] = g * 0.5f * nz[e] * (5.0f * zz - 3.0f);
+                    c13[e] = g * sqrt3_8 * nx[e] * (5.0f * zz - 1.0f);
+                    c14[e] = g * 0.5f * sqrt15 * nz[e] * (xx - yy);
+                    c15[e] = g * sqrt5_8 * nx[e] * (xx - 3.0f * yy);
+                }
+            }
+        }
+
+        for (std::size_t e = 0; e < count; ++e)
+        {
+            nx[e] *= w[e];
+            ny[e] *= w[e];
+            nz[e] *= w[e];
+        }
+
+        // Keep the unused channels silent
+        const std::uint32_t used = order >= 1 ? GetAmbisonicChannels(std::min(order, MAX_AMBISONIC_ORDER)) : 1;
+        for (std::uint32_t n = used; n < MAX_AMBISONIC_CHANNELS; ++n)
+        {
+            std::fill_n(channel(n), count, 0.0f);
+        }
+    }
+
+    void AmbisonicDecoder::BuildDecoder(
+        const float*        azimuths,
+        const std::uint32_t speakers,
+        const std::uint32_t order,
+        DecodeRow*          outRows)
+    {
+        // Speaker directions, and a source straight ahead for normalizing
+        std::array<float, VIRTUAL_SPEAKERS + 1> x{};
+        std::array<float, VIRTUAL_SPEAKERS + 1> y{};
+        std::array<float, VIRTUAL_SPEAKERS + 1> z{};
+        std::array<float, VIRTUAL_SPEAKERS + 1> g{};
+        for (std::uint32_t s = 0; s < speakers; ++s)
+        {
+            x[s] = std::cos(azimuths[s]);
+            y[s] = -std::sin(azimuths[s]); // Azimuths grow to the right, Y points left
+            g[s] = 1.0f;
+        }
+        x[speakers] = 1.0f;
+        g[speakers] = 1.0f;
+
+        constexpr std::size_t stride = VIRTUAL_SPEAKERS + 1;
+        std::array<float, MAX_AMBISONIC_CHANNELS * stride> sh{};
+        EncodeAmbisonics(x.data(), y.data(), z.data(), g.data(), speakers + 1, order, sh.data(), stride);
+
+        // Circular-harmonic sampling decoder with max-rE weights; the
+        // sectoral pair of degree l sums to k_l^2 cos(l * angle)
+        for (std::uint32_t s = 0; s < speakers; ++s)
+        {
+            outRows[s].fill(0.0f);
+            for (std::uint32_t n = 0; n < GetAmbisonicChannels(order); ++n)
+            {
+                if (!IS_SECTORAL[n]) continue;
+
+                const std::uint32_t l = DEGREES[n];
+                float weight = 1.0f;
+                if (l > 0)
+                {
+                    const float maxRe = std::cos(static_cast<float>(l) * PI / (2.0f * static_cast<float>(order) + 2.0f));
+                    const float front = sh[(l * l + 2 * l) * stride + speakers]; // Y(l, l) straight ahead
+                    weight            = 2.0f * maxRe / (front * front);
+                }
+
+                outRows[s][n] = weight * sh[n * stride + s] / static_cast<float>(speakers);
+            }
+        }
+    }
+
+    void AmbisonicDecoder::PanToLayout(
+        const SpeakerLayout& layout,
+        const float          azimuth,
+        float*               outGains)
+    {
+        std::fill_n(outGains, layout.Channels, 0.0f);
+
+        // Constant power panning between the two nearest speakers around
+        // the circle; this copes with any layout, including plain stereo
+        std::uint32_t before = MAX_OUTPUT_CHANNELS;
+        std::uint32_t after  = MAX_OUTPUT_CHANNELS;
+        float         toBefore = 2.0f * PI;
+        float         toAfter  = 2.0f * PI;
+        for (std::uint32_t s = 0; s < layout.Channels; ++s)
+        {
+            if (layout.IsLfe[s]) continue;
+
+            const float delta = std::remainder(layout.Azimuths[s] - azimuth, 2.0f * PI);
+            const float ahead = delta >= 0.0f ? delta : delta + 2.0f * PI;
+            const float back  = delta <= 0.0f ? -delta : 2.0f * PI - delta;
+            if (ahead < toAfter)
+            {
+                toAfter = ahead;
+                after   = s;
+            }
+            if (back < toBefore)
+            {
+                toBefore = back;
+                before   = s;
+            }
+        }
+
+        if (before == MAX_OUTPUT_CHANNELS) return;
+        if (before == after || toBefore + toAfter <= 1e-6f)
+        {
+            outGains[before] = 1.0f;
+            return;
+        }
+
+        const float t = toBefore / (toBefore + toAfter);
+        outGains[before] += std::cos(t * PI * 0.5f);
+        outGains[after] += std::sin(t * PI * 0.5f);
+    }
+
+    void AmbisonicDecoder::Configure()
+    {
+        const std::uint32_t order = std::clamp(this->Active.Order, 1u, MAX_AMBISONIC_ORDER);
+        this->Channels            = std::min(GetAmbisonicChannels(order), this->Stride);
+
+        std::array<float, VIRTUAL_SPEAKERS> azimuths{};
+        for (std::uint32_t v = 0; v < VIRTUAL_SPEAKERS; ++v)
+        {
+            azimuths[v] = 2.0f * PI * static_cast<float>(v) / VIRTUAL_SPEAKERS;
+        }
+
+        BuildDecoder(azimuths.data(), VIRTUAL_SPEAKERS, order, this->VirtualRows.data());
+
+        float front[MAX_AMBISONIC_CHANNELS];
+        const float one  = 1.0f;
+        const float zero = 0.0f;
+        EncodeAmbisonics(&one, &zero, &zero, &one, 1, order, front, 1);
+
+        // Fold the panning into the decode so each speaker is one dot product
+        for (auto& row : this->SpeakerRows) row.fill(0.0f);
+        for (std::uint32_t v = 0; v < VIRTUAL_SPEAKERS; ++v)
+        {
+            std::array<float, MAX_OUTPUT_CHANNELS> pan{};
+            PanToLayout(this->Layout, azimuths[v], pan.data());
+
+            for (std::uint32_t s = 0; s < this->Layout.Channels; ++s)
+            {
+                for (std::uint32_t n = 0; n < MAX_AMBISONIC_CHANNELS; ++n)
+                {
+                    this->SpeakerRows[s][n] += pan[s] * this->VirtualRows[v][n];
+                }
+            }
+        }
+
+        // Unit power on average around the listener; an irregular layout
+        // is louder where its speakers bunch up
+        constexpr std::uint32_t probes = 36;
+
+        float power = 0.0f;
+        for (std::uint32_t p = 0; p < probes; ++p)
+        {
+            const float azimuth = 2.0f * PI * static_cast<float>(p) / probes;
+            const float x       = std::cos(azimuth);
+            const float y       = -std::sin(azimuth);
+
+            float probe[MAX_AMBISONIC_CHANNELS];
+            EncodeAmbisonics(&x, &y, &zero, &one, 1, order, probe, 1);
+
+            for (std::uint32_t s = 0; s < this->Layout.Channels; ++s)
+            {
+                float gain = 0.0f;
+                for (std::uint32_t n = 0; n < MAX_AMBISONIC_CHANNELS; ++n) gain += this->SpeakerRows[s][n] * probe[n];
+                power += gain * gain / probes;
+            }
+        }
+
+        const float speakerScale = power > 0.0f ? 1.0f / std::sqrt(power) : 0.0f;
+        for (auto& row : this->SpeakerRows)
+        {
+            for (float& gain : row) gain *= speakerScale;
+        }
+
+        // Woodworth's interaural delay and a simple head shadow on the far ear
+        float level = 0.0f;
+        for (std::uint32_t v = 0; v < VIRTUAL_SPEAKERS; ++v)
+        {
+            const float lateral = std::sin(azimuths[v]); // +1 = right
+            const float angle   = std::asin(std::abs(lateral));
+            const float itd     = HEAD_RADIUS / SPEED * (angle + std::abs(lateral));
+            const auto  delay   = std::min(
+                static_cast<std::uint32_t>(itd * static_cast<float>(this->SampleRate) + 0.5f),
+                DELAY_LINE_MASK);
+
+            const float shadow = std::abs(lateral);
+            const int   far    = lateral >= 0.0f ? 0 : 1; // Sound from the right reaches the left ear last
+
+            for (int ear = 0; ear < 2; ++ear)
+            {
+                Ear& e        = this->Ears[v][ear];
+                e.Delay       = ear == far ? delay : 0;
+                e.Gain        = ear == far ? 1.0f - 0.6f * shadow : 1.0f;
+                e.Coefficient = ear == far ? 1.0f - 0.8f * shadow : 1.0f;
+            }
+
+            float feed = 0.0f;
+            for (std::uint32_t n = 0; n < MAX_AMBISONIC_CHANNELS; ++n) feed += this->VirtualRows[v][n] * front[n];
+            level += feed * this->Ears[v][0].Gain;
+        }
+
+        // Unit gain at each ear for a source straight ahead
+        const float earScale = std::abs(level) > 1e-6f ? 1.0f / level : 0.0f;
+        for (auto& ears : this->Ears)
+        {
+            for (auto& ear : ears) ear.Gain *= earScale;
+        }
+    }
+
+    void AmbisonicDecoder::Prepare(
+        const std::uint32_t sampleRate,
+        const std::uint32_t inputChannels,
+        std::uint32_t)
+    {
+        this->SampleRate = sampleRate;
+        this->Stride     = inputChannels;
+        this->Configure();
+        this->Reset();
+    }
+
+    void AmbisonicDecoder::Reset()
+    {
+        for (auto& line : this->Lines) line.fill(0.0f);
+        for (auto& ears : this->Ears)
+        {
+            for (auto& ear : ears) ear.State = 0.0f;
+        }
+        this->WritePos = 0;
+    }
+
+    void AmbisonicDecoder::Process(
+        const float*        input,
+        float*              output,
+        const std::uint32_t frames)
+    {
+        if (this->Params.Update())
+        {
+            this->Active = this->Params.Get();
+            this->Configure();
+        }
+
+        const std::uint32_t inStride  = this->Stride;
+        const std::uint32_t outStride = this->Layout.Channels;
+        const std::uint32_t channels  = this->Channels;
+
+        if (!this->Active.Binaural)
+        {
+            for (std::uint32_t f = 0; f < frames; ++f)
+            {
+                const float* in  = input + static_cast<std::size_t>(f) * inStride;
+                float*       out = output + static_cast<std::size_t>(f) * outStride;
+
+                for (std::uint32_t s = 0; s < outStride; ++s)
+                {
+                    const DecodeRow& row = this->SpeakerRows[s];
+
+                    float sum = 0.0f;
+                    for (std::uint32_t n = 0; n < channels; ++n)
+                    {
+                        sum += row[n] * in[n];
+                    }
+                    out[s] = sum;
+                }
+            }
+            return;
+        }
+
+        for (std::uint32_t f = 0; f < frames; ++f)
+        {
+            const float* in  = input + static_cast<std::size_t>(f) * inStride;
+            float*       out = output + static_cast<std::size_t>(f) * outStride;
+
+            std::array<float, 2> ears{};
+            for (std::uint32_t v = 0; v < VIRTUAL_SPEAKERS; ++v)
+            {
+                const DecodeRow& row = this->VirtualRows[v];
+
+                float feed = 0.0f;
+                for (std::uint32_t n = 0; n < channels; ++n)
+                {
+                    feed += row[n] * in[n];
+                }
+
+                auto& line                                 = this->Lines[v];
+                line[this->WritePos & DELAY_LINE_MASK]     = feed;
+
+                for (std::uint32_t e = 0; e < 2; ++e)
+                {
+                    Ear&        ear     = this->Ears[v][e];
+                    const float delayed = line[(this->WritePos - ear.Delay) & DELAY_LINE_MASK];
+
+                    ear.State += ear.Coefficient * (delayed - ear.State);
+                    ears[e] += ear.Gain * ear.State;
+                }
+            }
+            ++this->WritePos;
+
+            // Headphones only use the front pair
+            for (std::uint32_t s = 0; s < outStride; ++s)
+            {
+                out[s] = s < 2 ? ears[s] : 0.0f;
+            }
+        }
+    }
+}
@@ -0,0 +1,128 @@
+//=======================================================================
+/** Ambisonics.h
+ * B-format encoding of emitters and one shared decode per block
+ */
+//=======================================================================
+
+#pragma once
+
+#include "SoundInterface/Dsp/Processor.h"
+#include "SoundInterface/Dsp/SpeakerLayout.h"
+
+#include <cstddef>
+
+namespace SoundInterface::Dsp
+{
+    constexpr std::uint32_t MAX_AMBISONIC_ORDER    = 3;
+    constexpr std::uint32_t MAX_AMBISONIC_CHANNELS = (MAX_AMBISONIC_ORDER + 1) * (MAX_AMBISONIC_ORDER + 1);
+    constexpr std::uint32_t VIRTUAL_SPEAKERS       = 8; // Ring used for binaural rendering
+
+    constexpr std::uint32_t GetAmbisonicChannels(const std::uint32_t order)
+    {
+        return (order + 1) * (order + 1);
+    }
+
+    /*
+     * Encodes a batch of emitters into ACN/SN3D gains. Directions are
+     * relative to the listener with X to the front, Y to the left and
+     * Z up; they needn't be normalized. The output is channel-major:
+     * channel n of emitter e is outGains[n * stride + e]. Channels past
+     * the order are zeroed so the bus can stay at the maximum order.
+     */
+    void EncodeAmbisonics(
+        const float*  x,
+        const float*  y,
+        const float*  z,
+        const float*  gains,
+        std::size_t   count,
+        std::uint32_t order,
+        float*        outGains,
+        std::size_t   stride);
+
+    struct AmbisonicParams
+    {
+        std::uint32_t Order    = 1;
+        bool          Binaural = false;
+    };
+
+    /*
+     * Decodes the summed B-format bus once per block, either to the
+     * speaker layout or to headphones. Both start from a regular ring
+     * of virtual speakers, where a plain decoder behaves well. For
+     * speakers the ring is panned onto the real layout, which may be
+     * irregular; for headphones each virtual speaker goes through a
+     * spherical head model (interaural delay and head shadow) into the
+     * first two channels.
+     */
+    class AmbisonicDecoder final : public Processor
+    {
+    public:
+        explicit AmbisonicDecoder(const SpeakerLayout& layout)
+            : Layout(layout)
+        {}
+
+        void SetParams(const AmbisonicParams& params)
+        {
+            this->Params.Write(params);
+        }
+
+        void Prepare(
+            std::uint32_t sampleRate,
+            std::uint32_t inputChannels,
+            std::uint32_t maxFrames) override;
+
+        void Process(
+            const float*  input,
+            float*        output,
+            std::uint32_t frames) override;
+
+        void Reset() override;
+
+        [[nodiscard]] std::uint32_t GetOutputChannels(std::uint32_t) const override
+        {
+            return this->Layout.Channels;
+        }
+
+    private:
+        static constexpr std::uint32_t DELAY_LINE_SIZE = 128;
+        static constexpr std::uint32_t DELAY_LINE_MASK = DELAY_LINE_SIZE - 1;
+
+        using DecodeRow = std::array<float, MAX_AMBISONIC_CHANNELS>;
+
+        // One ear's view of a virtual speaker
+        struct Ear
+        {
+            std::uint32_t Delay       = 0;
+            float         Gain        = 1.0f;
+            float         Coefficient = 1.0f; // One-pole low-pass, 1 = open
+            float         State       = 0.0f;
+        };
+
+        void Configure();
+
+        static void BuildDecoder(
+            const float*  azimuths,
+            std::uint32_t speakers,
+            std::uint32_t order,
+            DecodeRow*    outRows);
+
+        static void PanToLayout(
+            const SpeakerLayout& layout,
+            float                azimuth,
+            float*               outGains);
+
+        SpeakerLayout                 Layout;
+        SharedParams<AmbisonicParams> Params;
+        AmbisonicParams               Active;
+        std::uint32_t                 Channels   = 0; // Active input channels
+        std::uint32_t                 Stride     = 0;
+        std::uint32_t                 SampleRate = 48000;
+
+        std::array<DecodeRow, MAX_OUTPUT_CHANNELS> SpeakerRows{};
+        std::array<DecodeRow, VIRTUAL_SPEAKERS>    VirtualRows{};
+
+        std::array<std::array<Ear, 2>, VIRTUAL_SPEAKERS>                  Ears{};
+        std::array<std::array<float, DELAY_LINE_SIZE>, VIRTUAL_SPEAKERS> Lines{};
+        std::uint32_t                                                    WritePos = 0;
+    };
+}
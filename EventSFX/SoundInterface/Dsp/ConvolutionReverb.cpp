@@ -0,0 +1,453 @@
+//=======================================================================
+/** ConvolutionReverb.cpp
+ * Non-uniform partitioned convolution with impulse response files
+ */
+//=======================================================================
+
+#include "SoundInterface/Dsp/ConvolutionReverb.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Linear interpolation is plenty for a diffuse tail
+    std::vector<float> Resample(
+        const std::vector<float>& input,
+        const std::uint32_t       fromRate,
+        const std::uint32_t       toRate,
+        const std::size_t         maxLength)
+    {
+        if (input.empty() || fromRate == 0) return {};
+
+        const double      ratio  = static_cast<double>(fromRate) / toRate;
+        const std::size_t length = std::min(
+            maxLength,
+            static_cast<std::size_t>(static_cast<double>(input.size()) / ratio));
+
+        std::vector<float> output(length);
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            const double      position = static_cast<double>(i) * ratio;
+            const std::size_t index    = static_cast<std::size_t>(position);
+            const auto        fraction = static_cast<float>(position - static_cast<double>(index));
+
+            const float a = input[index];
+            const float b = index + 1 < input.size() ? input[index + 1] : 0.0f;
+            output[i]     = a + (b - a) * fraction;
+        }
+
+        return output;
+    }
+}
+
+namespace SoundInterface::Dsp
+{
+    void UniformConvolver::Init(
+        const std::uint32_t blockSize,
+        const float*        ir,
+        const std::size_t   length)
+    {
+        this->BlockSize  = blockSize;
+        this->Bins       = blockSize + 1;
+        this->Partitions = static_cast<std::uint32_t>((length + blockSize - 1) / blockSize);
+        this->Current    = 0;
+        this->Fft.Init(2 * blockSize);
+
+        const std::size_t spectra = static_cast<std::size_t>(this->Partitions) * this->Bins;
+        this->Filters.assign(spectra, {});
+        this->History.assign(spectra, {});
+        this->Sum.assign(this->Bins, {});
+        this->Window.assign(2 * blockSize, 0.0f);
+        this->Result.assign(2 * blockSize, 0.0f);
+
+        // Each partition is zero-padded to twice its length
+        std::vector<float> padded(2 * blockSize);
+        for (std::uint32_t p = 0; p < this->Partitions; ++p)
+        {
+            const std::size_t begin = static_cast<std::size_t>(p) * blockSize;
+            const std::size_t count = std::min<std::size_t>(blockSize, length - begin);
+
+            std::ranges::fill(padded, 0.0f);
+            std::copy_n(ir + begin, count, padded.begin());
+
+            this->Fft.Forward(padded.data(), this->Filters.data() + static_cast<std::size_t>(p) * this->Bins);
+        }
+    }
+
+    void UniformConvolver::Reset()
+    {
+        std::ranges::fill(this->History, Complex{});
+        std::ranges::fill(this->Window, 0.0f);
+        this->Current = 0;
+    }
+
+    void UniformConvolver::Process(const float* input, float* output)
+    {
+        const std::uint32_t size = this->BlockSize;
+
+        if (this->Partitions == 0)
+        {
+            std::fill_n(output, size, 0.0f);
+            return;
+        }
+
+        // Slide the window by one block
+        std::copy_n(this->Window.begin() + size, size, this->Window.begin());
+        std::copy_n(input, size, this->Window.begin() + size);
+
+        // The newest spectrum goes in front of the delay line
+        this->Current = this->Current == 0 ? this->Partitions - 1 : this->Current - 1;
+        this->Fft.Forward(
+            this->Window.data(),
+            this->History.data() + static_cast<std::size_t>(this->Current) * this->Bins);
+
+        // Multiply-accumulate every partition against its slot in the delay line
+        std::ranges::fill(this->Sum, Complex{});
+        auto* sum = reinterpret_cast<float*>(this->Sum.data());
+
+        for (std::uint32_t p = 0; p < this->Partitions; ++p)
+        {
+            const std::uint32_t slot = (this->Current + p) % this->Partitions;
+
+            const auto* x = reinterpret_cast<const float*>(this->History.data() + static_cast<std::size_t>(slot) * this->Bins);
+            const auto* h = reinterpret_cast<const float*>(this->Filters.data() + static_cast<std::size_t>(p) * this->Bins);
+
+            for (std::uint32_t k = 0; k < 2 * this->Bins; k += 2)
+            {
+                sum[k]     += x[k] * h[k] - x[k + 1] * h[k + 1];
+                sum[k + 1] += x[k] * h[k + 1] + x[k + 1] * h[k];
+            }
+        }
+
+        // Overlap-save: only the second half is free of wrap-around
+        this->Fft.Inverse(this->Sum.data(), this->Result.data());
+        std::copy_n(this->Result.begin() + size, size, output);
+    }
+
+    ConvolutionReverb::ConvolutionReverb()
+        : Worker([this] { this->RunWorker(); })
+    {}
+
+    ConvolutionReverb::~ConvolutionReverb()
+    {
+        this->IsRunning.store(false, std::memory_order_release);
+        this->Wake.release();
+        this->Worker.join();
+
+        delete this->Active.exchange(nullptr);
+        delete this->Pending.exchange(nullptr);
+        delete this->Retired.exchange(nullptr);
+    }
+
+    void ConvolutionReverb::SetImpulseResponse(const ImpulseResponse& ir)
+    {
+        std::uint32_t sampleRate;
+        std::uint32_t channels;
+        {
+            std::lock_guard lock(this->ResponseLock);
+            this->Response = ir;
+            sampleRate     = this->BuildRate;
+            channels       = this->BuildChannels;
+        }
+
+        // Built here, off the audio thread; picked up on the next block
+        if (channels == 0) return;
+        delete this->Pending.exchange(BuildEngine(ir, sampleRate, channels).release(), std::memory_order_acq_rel);
+    }
+
+    void ConvolutionReverb::Prepare(
+        const std::uint32_t sampleRate,
+        const std::uint32_t inputChannels,
+        std::uint32_t)
+    {
+        this->Channels = inputChannels;
+        this->InFifo.assign(static_cast<std::size_t>(inputChannels) * HEAD_BLOCK_SIZE, 0.0f);
+        this->OutFifo.assign(static_cast<std::size_t>(inputChannels) * HEAD_BLOCK_SIZE, 0.0f);
+        this->FifoPos = 0;
+
+        // The layout may have changed, so rebuild for it, from a copy as the control thread may set another meanwhile
+        ImpulseResponse ir;
+        {
+            std::lock_guard lock(this->ResponseLock);
+            this->BuildRate     = sampleRate;
+            this->BuildChannels = inputChannels;
+            ir                  = this->Response;
+        }
+        delete this->Pending.exchange(BuildEngine(ir, sampleRate, inputChannels).release(), std::memory_order_acq_rel);
+    }
+
+    void ConvolutionReverb::Reset()
+    {
+        std::ranges::fill(this->InFifo, 0.0f);
+        std::ranges::fill(this->OutFifo, 0.0f);
+        this->FifoPos = 0;
+
+        // The tail still in the partitions would keep ringing; a pending engine starts out silent anyway
+        if (Engine* engine = this->Active.load(std::memory_order_relaxed))
+        {
+            for (UniformConvolver& convolver : engine->Head) convolver.Reset();
+
+            for (const auto& stage : engine->Stages)
+            {
+                // The worker only touches busy stages, so once it's done with this one it's ours
+                WaitForStage(*stage);
+
+                for (UniformConvolver& convolver : stage->Convolvers) convolver.Reset();
+                std::ranges::fill(stage->Gathered, 0.0f);
+                std::ranges::fill(stage->Playing, 0.0f);
+                std::ranges::fill(stage->JobInput, 0.0f);
+                std::ranges::fill(stage->JobOutput, 0.0f);
+                stage->Position = 0;
+            }
+        }
+    }
+
+    std::unique_ptr<ConvolutionReverb::Engine> ConvolutionReverb::BuildEngine(
+        const ImpulseResponse& ir,
+        const std::uint32_t    sampleRate,
+        const std::uint32_t    outputChannels)
+    {
+        auto engine = std::make_unique<Engine>();
+        if (ir.Channels.empty() || outputChannels == 0) return engine;
+
+        const auto maxLength = static_cast<std::size_t>(MAX_IMPULSE_SECONDS * static_cast<float>(sampleRate));
+
+        std::vector<std::vector<float>> channels;
+        std::size_t                     length = 0;
+        for (const auto& channel : ir.Channels)
+        {
+            channels.push_back(Resample(channel, ir.SampleRate, sampleRate, maxLength));
+            length = std::max(length, channels.back().size());
+        }
+
+        if (length == 0) return engine;
+
+        // Scale the loudest channel to unit energy so the bus level means something
+        double maxEnergy = 0.0;
+        for (const auto& channel : channels)
+        {
+            double energy = 0.0;
+            for (const float sample : channel) energy += static_cast<double>(sample) * sample;
+            maxEnergy = std::max(maxEnergy, energy);
+        }
+
+        const auto gain = static_cast<float>(maxEnergy > 0.0 ? 1.0 / std::sqrt(maxEnergy) : 0.0);
+        for (auto& channel : channels)
+        {
+            for (float& sample : channel) sample *= gain;
+        }
+
+        // Output channels past the IR's reuse its channels in turn
+        auto segment = [&](const std::uint32_t c, const std::size_t begin, const std::size_t end)
+        {
+            const auto&       channel = channels[c % channels.size()];
+            const std::size_t stop    = std::min(end, channel.size());
+            return std::make_pair(channel.data() + std::min(begin, stop), stop > begin ? stop - begin : 0);
+        };
+
+        engine->Channels = outputChannels;
+        engine->Head.resize(outputChannels);
+        for (std::uint32_t c = 0; c < outputChannels; ++c)
+        {
+            const auto [data, count] = segment(c, 0, 2 * MID_BLOCK_SIZE);
+            engine->Head[c].Init(HEAD_BLOCK_SIZE, data, count);
+        }
+
+        const std::array<std::uint32_t, 2> blockSizes = {MID_BLOCK_SIZE, TAIL_BLOCK_SIZE};
+        for (std::size_t s = 0; s < blockSizes.size(); ++s)
+        {
+            const std::uint32_t blockSize = blockSizes[s];
+            const std::size_t   begin     = 2 * static_cast<std::size_t>(blockSize);
+            const std::size_t   end       = s + 1 < blockSizes.size() ? 2 * static_cast<std::size_t>(blockSizes[s + 1]) : length;
+
+            if (length <= begin) break;
+
+            auto stage       = std::make_unique<Stage>();
+            stage->BlockSize = blockSize;
+            stage->Convolvers.resize(outputChannels);
+            for (std::uint32_t c = 0; c < outputChannels; ++c)
+            {
+                const auto [data, count] = segment(c, begin, end);
+                stage->Convolvers[c].Init(blockSize, data, count);
+            }
+
+            const std::size_t size = static_cast<std::size_t>(outputChannels) * blockSize;
+            stage->Gathered.assign(size, 0.0f);
+            stage->Playing.assign(size, 0.0f);
+            stage->JobInput.assign(size, 0.0f);
+            stage->JobOutput.assign(size, 0.0f);
+
+            engine->Stages.push_back(std::move(stage));
+        }
+
+        return engine;
+    }
+
+    void ConvolutionReverb::WaitForStage(const Stage& stage)
+    {
+        // Only spins if the worker missed its deadline of a whole block
+        while (stage.IsBusy.load(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void ConvolutionReverb::RunStage(Stage& stage, const std::uint32_t channels)
+    {
+        const std::uint32_t size = stage.BlockSize;
+        for (std::uint32_t c = 0; c < channels; ++c)
+        {
+            stage.Convolvers[c].Process(
+                stage.JobInput.data() + static_cast<std::size_t>(c) * size,
+                stage.JobOutput.data() + static_cast<std::size_t>(c) * size);
+        }
+    }
+
+    void ConvolutionReverb::RunWorker()
+    {
+        while (true)
+        {
+            this->Wake.acquire();
+            if (!this->IsRunning.load(std::memory_order_acquire)) break;
+
+            // Busy stages always belong to the active engine; it isn't swapped while they are
+            if (Engine* engine = this->Active.load(std::memory_order_acquire))
+            {
+                for (const auto& stage : engine->Stages)
+                {
+                    if (!stage->IsBusy.load(std::memory_order_acquire)) continue;
+
+                    RunStage(*stage, engine->Channels);
+                    stage->IsBusy.store(false, std::memory_order_release);
+                }
+            }
+
+            // Freeing is left to this thread so the audio thread never does it
+            delete this->Retired.exchange(nullptr, std::memory_order_acq_rel);
+        }
+    }
+
+    void ConvolutionReverb::TrySwapEngine()
+    {
+        if (!this->Pending.load(std::memory_order_relaxed)) return;
+
+        Engine* current = this->Active.load(std::memory_order_relaxed);
+        if (current)
+        {
+            // The worker hasn't freed the last one yet
+            if (this->Retired.load(std::memory_order_acquire)) return;
+
+            for (const auto& stage : current->Stages)
+            {
+                if (stage->IsBusy.load(std::memory_order_acquire)) return;
+            }
+        }
+
+        this->Active.store(this->Pending.exchange(nullptr, std::memory_order_acq_rel), std::memory_order_release);
+
+        if (current)
+        {
+            this->Retired.store(current, std::memory_order_release);
+            this->Wake.release();
+        }
+    }
+
+    void ConvolutionReverb::ProcessBlock(Engine& engine)
+    {
+        const std::uint32_t channels = std::min(engine.Channels, this->Channels);
+
+        for (std::uint32_t c = 0; c < channels; ++c)
+        {
+            float* in  = this->InFifo.data() + static_cast<std::size_t>(c) * HEAD_BLOCK_SIZE;
+            float* out = this->OutFifo.data() + static_cast<std::size_t>(c) * HEAD_BLOCK_SIZE;
+            engine.Head[c].Process(in, out);
+        }
+        for (std::uint32_t c = channels; c < this->Channels; ++c)
+        {
+            std::fill_n(this->OutFifo.data() + static_cast<std::size_t>(c) * HEAD_BLOCK_SIZE, HEAD_BLOCK_SIZE, 0.0f);
+        }
+
+        for (const auto& stage : engine.Stages)
+        {
+            const std::uint32_t size = stage->BlockSize;
+
+            for (std::uint32_t c = 0; c < channels; ++c)
+            {
+                const float* in      = this->InFifo.data() + static_cast<std::size_t>(c) * HEAD_BLOCK_SIZE;
+                float*       out     = this->OutFifo.data() + static_cast<std::size_t>(c) * HEAD_BLOCK_SIZE;
+                float*       gather  = stage->Gathered.data() + static_cast<std::size_t>(c) * size + stage->Position;
+                const float* playing = stage->Playing.data() + static_cast<std::size_t>(c) * size + stage->Position;
+
+                std::copy_n(in, HEAD_BLOCK_SIZE, gather);
+                for (std::uint32_t i = 0; i < HEAD_BLOCK_SIZE; ++i)
+                {
+                    out[i] += playing[i];
+                }
+            }
+
+            stage->Position += HEAD_BLOCK_SIZE;
+            if (stage->Position < size) continue;
+
+            // Block boundary: collect the last job and hand over the next one
+            WaitForStage(*stage);
+            std::swap(stage->Playing, stage->JobOutput);
+            std::swap(stage->Gathered, stage->JobInput);
+            stage->Position = 0;
+
+            stage->IsBusy.store(true, std::memory_order_release);
+            this->Wake.release();
+        }
+    }
+
+    void ConvolutionReverb::Process(
+        const float*        input,
+        float*              output,
+        const std::uint32_t frames)
+    {
+        this->TrySwapEngine();
+        Engine* engine = this->Active.load(std::memory_order_relaxed);
+
+        const std::uint32_t channels = this->Channels;
+
+        std::uint32_t done = 0;
+        while (done < frames)
+        {
+            const std::uint32_t count = std::min(frames - done, HEAD_BLOCK_SIZE - this->FifoPos);
+
+            // Read all input before writing, so processing in place works
+            for (std::uint32_t c = 0; c < channels; ++c)
+            {
+                float* in = this->InFifo.data() + static_cast<std::size_t>(c) * HEAD_BLOCK_SIZE + this->FifoPos;
+                for (std::uint32_t i = 0; i < count; ++i)
+                {
+                    in[i] = input[(done + i) * channels + c];
+                }
+            }
+
+            for (std::uint32_t c = 0; c < channels; ++c)
+            {
+                const float* out = this->OutFifo.data() + static_cast<std::size_t>(c) * HEAD_BLOCK_SIZE + this->FifoPos;
+                for (std::uint32_t i = 0; i < count; ++i)
+                {
+                    output[(done + i) * channels + c] = out[i];
+                }
+            }
+
+            this->FifoPos += count;
+            done += count;
+
+            if (this->FifoPos < HEAD_BLOCK_SIZE) continue;
+
+            if (engine)
+            {
+                this->ProcessBlock(*engine);
+            }
+            else
+            {
+                std::ranges::fill(this->OutFifo, 0.0f);
+            }
+            this->FifoPos = 0;
+        }
+    }
+}
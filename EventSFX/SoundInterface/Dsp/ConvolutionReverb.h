@@ -0,0 +1,142 @@
+//=======================================================================
+/** ConvolutionReverb.h
+ * Non-uniform partitioned convolution with impulse response files
+ */
+//=======================================================================
+
+#pragma once
+
+#include "SoundInterface/Dsp/Processor.h"
+#include "SoundInterface/Dsp/Fft.h"
+
+#include <memory>
+#include <mutex>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+namespace SoundInterface::Dsp
+{
+    constexpr std::uint32_t HEAD_BLOCK_SIZE     = 128;
+    constexpr std::uint32_t MID_BLOCK_SIZE      = 1024;
+    constexpr std::uint32_t TAIL_BLOCK_SIZE     = 8192;
+    constexpr float         MAX_IMPULSE_SECONDS = 10.0f;
+    constexpr std::uint32_t CONVOLUTION_LATENCY = HEAD_BLOCK_SIZE; // Frames
+
+    // Planar impulse response at its own sample rate
+    struct ImpulseResponse
+    {
+        std::uint32_t                   SampleRate = 48000;
+        std::vector<std::vector<float>> Channels;
+    };
+
+    /*
+     * Uniformly partitioned overlap-save convolution of one channel
+     * with one IR segment. Each call consumes and produces one block.
+     */
+    class UniformConvolver
+    {
+    public:
+        void Init(std::uint32_t blockSize, const float* ir, std::size_t length);
+        void Process(const float* input, float* output);
+        void Reset();
+
+        [[nodiscard]] bool IsEmpty() const
+        {
+            return this->Partitions == 0;
+        }
+
+    private:
+        RealFft              Fft;
+        std::uint32_t        BlockSize  = 0;
+        std::uint32_t        Bins       = 0;
+        std::uint32_t        Partitions = 0;
+        std::uint32_t        Current    = 0;
+        std::vector<Complex> Filters; // Partitions x Bins
+        std::vector<Complex> History; // Frequency-domain delay line, Partitions x Bins
+        std::vector<Complex> Sum;
+        std::vector<float>   Window; // Previous and current input block
+        std::vector<float>   Result;
+    };
+
+    /*
+     * Splits the IR into a short head, run on the audio thread with
+     * small partitions, and two longer stages run on a worker thread
+     * with large partitions. A stage with block size B covers the IR
+     * from 2B onwards, so its result is needed one block after its
+     * input is complete: the worker gets a full block of time per job.
+     * The head runs in blocks of its own, which adds HEAD_BLOCK_SIZE
+     * frames of latency that is heard as a little pre-delay.
+     */
+    class ConvolutionReverb final : public Processor
+    {
+    public:
+        ConvolutionReverb();
+        ~ConvolutionReverb() override;
+
+        ConvolutionReverb(const ConvolutionReverb&)            = delete;
+        ConvolutionReverb& operator=(const ConvolutionReverb&) = delete;
+
+        // Control thread. An empty response silences the output.
+        void SetImpulseResponse(const ImpulseResponse& ir);
+
+        void Prepare(
+            std::uint32_t sampleRate,
+            std::uint32_t inputChannels,
+            std::uint32_t maxFrames) override;
+
+        void Process(
+            const float*  input,
+            float*        output,
+            std::uint32_t frames) override;
+
+        void Reset() override;
+
+    private:
+        struct Stage
+        {
+            std::uint32_t                 BlockSize = 0;
+            std::vector<UniformConvolver> Convolvers; // Per channel
+            std::vector<float>            Gathered;   // Channels x BlockSize, audio thread
+            std::vector<float>            Playing;    // Channels x BlockSize, audio thread
+            std::vector<float>            JobInput;   // Channels x BlockSize, worker while busy
+            std::vector<float>            JobOutput;  // Channels x BlockSize, worker while busy
+            std::uint32_t                 Position = 0;
+            std::atomic<bool>             IsBusy   = false;
+        };
+
+        // Everything that depends on the IR, swapped as a whole
+        struct Engine
+        {
+            std::uint32_t                       Channels = 0;
+            std::vector<UniformConvolver>       Head;
+            std::vector<std::unique_ptr<Stage>> Stages;
+        };
+
+        static std::unique_ptr<Engine> BuildEngine(const ImpulseResponse& ir, std::uint32_t sampleRate, std::uint32_t outputChannels);
+        void                           RunWorker();
+        void                           ProcessBlock(Engine& engine);
+        void                           TrySwapEngine();
+        static void                    WaitForStage(const Stage& stage);
+        static void                    RunStage(Stage& stage, std::uint32_t channels);
+
+        // The control thread's copy, for rebuilding on Prepare, and the layout it was last prepared for
+        std::mutex      ResponseLock;
+        ImpulseResponse Response;
+        std::uint32_t   BuildRate     = 48000;
+        std::uint32_t   BuildChannels = 0;
+
+        std::atomic<Engine*> Active  = nullptr; // Audio thread
+        std::atomic<Engine*> Pending = nullptr; // Control thread to audio thread
+        std::atomic<Engine*> Retired = nullptr; // Audio thread to worker
+
+        std::counting_semaphore<> Wake{0};
+        std::atomic<bool>         IsRunning = true;
+        std::thread               Worker;
+
+        std::uint32_t      Channels = 0;
+        std::uint32_t      FifoPos  = 0;
+        std::vector<float> InFifo;  // Channels x HEAD_BLOCK_SIZE
+        std::vector<float> OutFifo; // Channels x HEAD_BLOCK_SIZE
+    };
+}
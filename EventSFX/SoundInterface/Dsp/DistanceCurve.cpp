@@ -0,0 +1,98 @@
+//=======================================================================
+/** DistanceCurve.cpp
+ * Distance attenuation curves, baked into lookup tables
+ */
+//=======================================================================
+
+#include "SoundInterface/Dsp/DistanceCurve.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    using namespace SoundInterface::Dsp;
+
+    float EvaluateCurve(const DistanceCurve& curve, const float range, const float distance)
+    {
+        switch (curve.Model)
+        {
+        case DistanceModel::Inverse:
+            return distance > curve.MinDistance ? curve.MinDistance / distance : 1.0f;
+        case DistanceModel::Linear:
+        {
+            if (distance <= curve.MinDistance) return 1.0f;
+            if (range <= curve.MinDistance) return 0.0f;
+            return std::max(0.0f, 1.0f - (distance - curve.MinDistance) / (range - curve.MinDistance));
+        }
+        case DistanceModel::Custom:
+        {
+            const auto& points = curve.Points;
+            if (points.empty()) return 1.0f;
+            if (distance <= points.front().Distance) return points.front().Gain;
+            if (distance >= points.back().Distance) return points.back().Gain;
+
+            const auto after = std::upper_bound(
+                points.begin(), points.end(), distance,
+                [](const float d, const DistancePoint& point) { return d < point.Distance; });
+            const auto before = after - 1;
+
+            const float span = after->Distance - before->Distance;
+            if (span <= 0.0f) return after->Gain;
+
+            const float t = (distance - before->Distance) / span;
+            return before->Gain + t * (after->Gain - before->Gain);
+        }
+        default:
+            return 1.0f;
+        }
+    }
+
+    // Past this the table holds its last entry
+    float GetRange(const DistanceCurve& curve)
+    {
+        return curve.MaxDistance > 0.0f ? curve.MaxDistance : MAX_CURVE_DISTANCE;
+    }
+}
+
+namespace SoundInterface::Dsp
+{
+    DistanceLut::DistanceLut(const DistanceCurve& curve)
+        : Table(0.0f, GetRange(curve),
+                [&curve, range = GetRange(curve)](const float distance)
+                {
+                    return std::clamp(EvaluateCurve(curve, range, distance), MIN_CURVE_GAIN, MAX_CURVE_GAIN);
+                }),
+          Cutoff(curve.MaxDistance > 0.0f ? curve.MaxDistance : std::numeric_limits<float>::infinity())
+    {}
+
+    void DistanceLut::Evaluate(
+        const float*      distances,
+        const std::size_t count,
+        float*            outGains) const
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            outGains[i] = this->Evaluate(distances[i]);
+        }
+    }
+
+    void SanitizeDistanceCurve(DistanceCurve& curve)
+    {
+        if (static_cast<std::size_t>(curve.Model) >= NUM_DISTANCE_MODELS) curve.Model = DistanceModel::Inverse;
+
+        curve.MinDistance = std::clamp(curve.MinDistance, MIN_FULL_DISTANCE, MAX_CURVE_DISTANCE);
+        curve.MaxDistance = std::clamp(curve.MaxDistance, MIN_CURVE_DISTANCE, MAX_CURVE_DISTANCE);
+        if (curve.MaxDistance > 0.0f && curve.MaxDistance < curve.MinDistance) curve.MaxDistance = curve.MinDistance;
+
+        for (auto& point : curve.Points)
+        {
+            point.Distance = std::clamp(point.Distance, MIN_CURVE_DISTANCE, MAX_CURVE_DISTANCE);
+            point.Gain     = std::clamp(point.Gain, MIN_CURVE_GAIN, MAX_CURVE_GAIN);
+        }
+
+        std::stable_sort(
+            curve.Points.begin(), curve.Points.end(),
+            [](const DistancePoint& a, const DistancePoint& b) { return a.Distance < b.Distance; });
+    }
+}
@@ -0,0 +1,102 @@
+//=======================================================================
+/** DistanceCurve.h
+ * Distance attenuation curves, baked into lookup tables
+ */
+//=======================================================================
+
+#pragma once
+
+#include "SoundInterface/Dsp/GainCurve.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace SoundInterface::Dsp
+{
+    constexpr float MIN_CURVE_DISTANCE = 0.0f;   // Meters
+    constexpr float MAX_CURVE_DISTANCE = 200.0f; // Well past the arena diagonal
+    constexpr float MIN_FULL_DISTANCE  = 0.1f;   // Keeps the inverse model finite
+    constexpr float MIN_CURVE_GAIN     = 0.0f;
+    constexpr float MAX_CURVE_GAIN     = 1.0f;
+
+    enum class DistanceModel : std::uint8_t
+    {
+        Inverse, // Full volume up to MinDistance, then MinDistance / distance
+        Linear,  // Full volume up to MinDistance, fading out at MaxDistance
+        Custom,  // Straight lines between Points
+        Count
+    };
+
+    constexpr std::size_t NUM_DISTANCE_MODELS = static_cast<std::size_t>(DistanceModel::Count);
+
+    constexpr const char* GetDistanceModelLabel(const DistanceModel model)
+    {
+        switch (model)
+        {
+        case DistanceModel::Inverse:
+            return "inverse";
+        case DistanceModel::Linear:
+            return "linear";
+        case DistanceModel::Custom:
+            return "custom";
+        default:
+            return "NA";
+        }
+    }
+
+    struct DistancePoint
+    {
+        float Distance;
+        float Gain;
+    };
+
+    /*
+     * How an event fades with distance. The defaults match X3DAudio's
+     * default curve with the plugin's old distance scaler of 4 m.
+     */
+    struct DistanceCurve
+    {
+        DistanceModel              Model       = DistanceModel::Inverse;
+        float                      MinDistance = 4.0f;
+        float                      MaxDistance = 0.0f; // Silent and culled past this, 0 for no limit
+        std::vector<DistancePoint> Points;             // Only for the custom model
+    };
+
+    /*
+     * A curve baked into a gain table over its range, so that evaluating
+     * it is one interpolated table read no matter the model, plus the
+     * cutoff. Tables are immutable once baked and shared between voices.
+     */
+    class DistanceLut
+    {
+    public:
+        explicit DistanceLut(const DistanceCurve& curve);
+
+        // Zero past the cutoff
+        [[nodiscard]] float Evaluate(const float distance) const
+        {
+            const float gain = this->Table.Evaluate(distance);
+            return distance < this->Cutoff ? gain : 0.0f;
+        }
+
+        void Evaluate(
+            const float* distances,
+            std::size_t  count,
+            float*       outGains) const;
+
+        [[nodiscard]] bool IsAudible(const float distance) const
+        {
+            return distance < this->Cutoff;
+        }
+
+    private:
+        GainLut Table;
+        float   Cutoff = 0.0f;
+    };
+
+    using DistanceLutPtr = std::shared_ptr<const DistanceLut>;
+
+    // Sorts and clamps the custom points, and fixes up the distances
+    void SanitizeDistanceCurve(DistanceCurve& curve);
+}
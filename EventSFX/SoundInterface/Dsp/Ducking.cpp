@@ -0,0 +1,143 @@
+//=======================================================================
+/** Ducking.cpp
+ * Sidechain ducking of one bus by the level of another
+ */
+//=======================================================================
+
+#include "SoundInterface/Dsp/Ducking.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    float DecibelsToGain(const float decibels)
+    {
+        return std::pow(10.0f, decibels / 20.0f);
+    }
+
+    // One-pole coefficient for a whole block, so the envelope moves once per block
+    float GetBlockCoefficient(const float milliseconds, const std::uint32_t frames, const std::uint32_t sampleRate)
+    {
+        const float seconds = static_cast<float>(frames) / static_cast<float>(sampleRate);
+        return std::exp(-seconds / (milliseconds / 1000.0f));
+    }
+}
+
+namespace SoundInterface::Dsp
+{
+    void SanitizeDuckingParams(DuckingParams& params)
+    {
+        params.Threshold = std::clamp(params.Threshold, MIN_DUCKING_THRESHOLD, MAX_DUCKING_THRESHOLD);
+        params.Depth     = std::clamp(params.Depth, MIN_DUCKING_DEPTH, MAX_DUCKING_DEPTH);
+        params.Attack    = std::clamp(params.Attack, MIN_DUCKING_ATTACK, MAX_DUCKING_ATTACK);
+        params.Release   = std::clamp(params.Release, MIN_DUCKING_RELEASE, MAX_DUCKING_RELEASE);
+    }
+
+    //-----------------------------------------------------------------------
+    // SidechainKey
+    //-----------------------------------------------------------------------
+
+    void SidechainKey::Prepare(
+        std::uint32_t,
+        const std::uint32_t inputChannels,
+        std::uint32_t)
+    {
+        this->Channels = inputChannels;
+        this->Reset();
+    }
+
+    void SidechainKey::Reset()
+    {
+        this->Chain->Level.store(0.0f, std::memory_order_relaxed);
+    }
+
+    void SidechainKey::Process(
+        const float*        input,
+        float*              output,
+        const std::uint32_t frames)
+    {
+        const std::size_t count = static_cast<std::size_t>(frames) * this->Channels;
+
+        float peak = 0.0f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            peak = std::max(peak, std::abs(input[i]));
+        }
+
+        if (output != input) std::memcpy(output, input, sizeof(float) * count);
+
+        this->Chain->Level.store(peak, std::memory_order_relaxed);
+    }
+
+    //-----------------------------------------------------------------------
+    // Ducker
+    //-----------------------------------------------------------------------
+
+    void Ducker::Prepare(
+        const std::uint32_t sampleRate,
+        const std::uint32_t inputChannels,
+        std::uint32_t)
+    {
+        this->SampleRate = sampleRate;
+        this->Channels   = inputChannels;
+        this->Reset();
+    }
+
+    void Ducker::Reset()
+    {
+        this->Envelope = 0.0f;
+        this->Gain     = 1.0f;
+        this->Reduction.store(0.0f, std::memory_order_relaxed);
+    }
+
+    void Ducker::Process(
+        const float*        input,
+        float*              output,
+        const std::uint32_t frames)
+    {
+        if (this->Params.Update())
+        {
+            this->Active = this->Params.Get();
+        }
+
+        // Full depth while the key is over the threshold, none otherwise
+        const float level  = this->Chain->Level.load(std::memory_order_relaxed);
+        const bool  keyed  = this->Active.Enabled && level > DecibelsToGain(this->Active.Threshold);
+        const float target = keyed ? this->Active.Depth : 0.0f;
+
+        const float time        = target > this->Envelope ? this->Active.Attack : this->Active.Release;
+        const float coefficient = GetBlockCoefficient(time, frames, this->SampleRate);
+
+        this->Envelope = target + coefficient * (this->Envelope - target);
+        if (this->Envelope < 0.001f) this->Envelope = 0.0f;
+
+        this->Reduction.store(this->Envelope, std::memory_order_relaxed);
+
+        const std::size_t count = static_cast<std::size_t>(frames) * this->Channels;
+        const float       from  = this->Gain;
+        const float       to    = DecibelsToGain(-this->Envelope);
+        this->Gain              = to;
+
+        if (from == 1.0f && to == 1.0f)
+        {
+            if (output != input) std::memcpy(output, input, sizeof(float) * count);
+            return;
+        }
+
+        // Ramp across the block so block-rate changes don't step
+        const float step = (to - from) / static_cast<float>(frames);
+        for (std::uint32_t f = 0; f < frames; ++f)
+        {
+            const float  gain = from + step * static_cast<float>(f);
+            const float* in   = input + static_cast<std::size_t>(f) * this->Channels;
+            float*       out  = output + static_cast<std::size_t>(f) * this->Channels;
+
+            for (std::uint32_t c = 0; c < this->Channels; ++c)
+            {
+                out[c] = in[c] * gain;
+            }
+        }
+    }
+}
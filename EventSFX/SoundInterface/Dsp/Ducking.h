@@ -0,0 +1,117 @@
+//=======================================================================
+/** Ducking.h
+ * Sidechain ducking of one bus by the level of another
+ */
+//=======================================================================
+
+#pragma once
+
+#include "SoundInterface/Dsp/Processor.h"
+
+#include <memory>
+
+namespace SoundInterface::Dsp
+{
+    constexpr float MIN_DUCKING_THRESHOLD = -60.0f; // dBFS
+    constexpr float MAX_DUCKING_THRESHOLD = 0.0f;
+    constexpr float MIN_DUCKING_DEPTH     = 0.0f;   // dB
+    constexpr float MAX_DUCKING_DEPTH     = 40.0f;
+    constexpr float MIN_DUCKING_ATTACK    = 1.0f;   // Milliseconds
+    constexpr float MAX_DUCKING_ATTACK    = 500.0f;
+    constexpr float MIN_DUCKING_RELEASE   = 10.0f;  // Milliseconds
+    constexpr float MAX_DUCKING_RELEASE   = 5000.0f;
+
+    struct DuckingParams
+    {
+        bool  Enabled   = true;
+        float Threshold = -40.0f; // Key peak that starts the ducking
+        float Depth     = 12.0f;  // How far the ducked bus goes down
+        float Attack    = 20.0f;
+        float Release   = 600.0f;
+    };
+
+    // Clamps everything into range
+    void SanitizeDuckingParams(DuckingParams& params);
+
+    // What the key bus measured in its last block
+    struct Sidechain
+    {
+        std::atomic<float> Level = 0.0f; // Linear peak
+    };
+
+    using SidechainPtr = std::shared_ptr<Sidechain>;
+
+    // Passes its bus through untouched and publishes the block peak
+    class SidechainKey final : public Processor
+    {
+    public:
+        explicit SidechainKey(SidechainPtr sidechain)
+            : Chain(std::move(sidechain))
+        {}
+
+        void Prepare(
+            std::uint32_t sampleRate,
+            std::uint32_t inputChannels,
+            std::uint32_t maxFrames) override;
+
+        void Process(
+            const float*  input,
+            float*        output,
+            std::uint32_t frames) override;
+
+        void Reset() override;
+
+    private:
+        SidechainPtr  Chain;
+        std::uint32_t Channels = 0;
+    };
+
+    /*
+     * Turns its bus down while the key is above the threshold. The
+     * envelope only moves once per block, with attack and release
+     * coefficients for that block's length; within the block the gain
+     * ramps linearly, which is the only per-sample work. The key is
+     * read as of its latest block, so when the buses run in the other
+     * order the ducking lags by a block at most.
+     */
+    class Ducker final : public Processor
+    {
+    public:
+        explicit Ducker(SidechainPtr sidechain)
+            : Chain(std::move(sidechain))
+        {}
+
+        void SetParams(const DuckingParams& params)
+        {
+            this->Params.Write(params);
+        }
+
+        // For metering, in dB; safe to call from any thread
+        [[nodiscard]] float GetGainReduction() const
+        {
+            return this->Reduction.load(std::memory_order_relaxed);
+        }
+
+        void Prepare(
+            std::uint32_t sampleRate,
+            std::uint32_t inputChannels,
+            std::uint32_t maxFrames) override;
+
+        void Process(
+            const float*  input,
+            float*        output,
+            std::uint32_t frames) override;
+
+        void Reset() override;
+
+    private:
+        SidechainPtr                Chain;
+        SharedParams<DuckingParams> Params;
+        DuckingParams               Active;
+        float                       Envelope   = 0.0f; // Current reduction in dB
+        float                       Gain       = 1.0f; // Where the last block ended
+        std::atomic<float>          Reduction  = 0.0f;
+        std::uint32_t               Channels   = 0;
+        std::uint32_t               SampleRate = 48000;
+    };
+}
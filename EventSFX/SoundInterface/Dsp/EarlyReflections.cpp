@@ -0,0 +1,296 @@
+//=======================================================================
+/** EarlyReflections.cpp
+ * Image-source early reflections off the arena box
+ */
+//=======================================================================
+
+#include "SoundInterface/Dsp/EarlyReflections.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    using SoundInterface::Dsp::Vec3;
+
+    float Dot(const Vec3& a, const Vec3& b)
+    {
+        return a.X * b.X + a.Y * b.Y + a.Z * b.Z;
+    }
+
+    Vec3 Cross(const Vec3& a, const Vec3& b)
+    {
+        return {
+            a.Y * b.Z - a.Z * b.Y,
+            a.Z * b.X - a.X * b.Z,
+            a.X * b.Y - a.Y * b.X
+        };
+    }
+
+    Vec3 Sub(const Vec3& a, const Vec3& b)
+    {
+        return {a.X - b.X, a.Y - b.Y, a.Z - b.Z};
+    }
+
+    float& Axis(Vec3& v, const int axis)
+    {
+        return axis == 0 ? v.X : axis == 1 ? v.Y : v.Z;
+    }
+
+    // A surface of the box: the plane Axis == Value
+    struct Plane
+    {
+        int   Axis;
+        float Value;
+        float Reflectance;
+    };
+
+    Vec3 Mirror(Vec3 point, const Plane& plane)
+    {
+        float& coordinate = Axis(point, plane.Axis);
+        coordinate        = 2.0f * plane.Value - coordinate;
+        return point;
+    }
+
+    using TapArray = std::array<
+        SoundInterface::Dsp::ReflectionTap,
+        SoundInterface::Dsp::MAX_REFLECTION_TAPS>;
+
+    // Keeps the strongest taps; replaces the weakest when full
+    void InsertTap(
+        std::uint32_t& count,
+        TapArray&      taps,
+        const float    delay,
+        const float    gain)
+    {
+        if (count < taps.size())
+        {
+            taps[count++] = {delay, gain};
+            return;
+        }
+
+        std::size_t weakest = 0;
+        for (std::size_t i = 1; i < taps.size(); ++i)
+        {
+            if (taps[i].Gain < taps[weakest].Gain) weakest = i;
+        }
+
+        if (gain > taps[weakest].Gain)
+        {
+            taps[weakest] = {delay, gain};
+        }
+    }
+}
+
+namespace SoundInterface::Dsp
+{
+    void ImageSourceModel::Compute(
+        const Vec3*       emitters,
+        const std::size_t count,
+        const Listener&   listener,
+        const bool        secondOrder,
+        ReflectionTaps&   outTaps) const
+    {
+        outTaps.Channels = this->Layout.Channels;
+        outTaps.Counts.fill(0);
+
+        const std::array<Plane, 6> planes = {{
+            {0, this->Box.Min.X, this->Box.WallReflectance},
+            {0, this->Box.Max.X, this->Box.WallReflectance},
+            {1, this->Box.Min.Y, this->Box.FloorReflectance},
+            {1, this->Box.Max.Y, this->Box.CeilingReflectance},
+            {2, this->Box.Min.Z, this->Box.WallReflectance},
+            {2, this->Box.Max.Z, this->Box.WallReflectance},
+        }};
+
+        const Vec3 right = Cross(listener.Top, listener.Front);
+
+        auto addImage = [&](const Vec3& image, const float reflectance, const float directDistance)
+        {
+            const Vec3  toImage  = Sub(image, listener.Position);
+            const float distance = std::sqrt(Dot(toImage, toImage));
+            const float delay    = (distance - directDistance) / SPEED_OF_SOUND;
+
+            if (delay <= 0.0f || delay >= MAX_REFLECTION_DELAY) return;
+
+            const float attenuation = reflectance * std::min(1.0f, this->DistanceScaler / distance);
+            const float azimuth     = std::atan2(Dot(toImage, right), Dot(toImage, listener.Front));
+
+            // Cardioid-squared lobes per speaker, normalized to unit power
+            std::array<float, MAX_OUTPUT_CHANNELS> weights{};
+            float                                  power = 0.0f;
+            for (std::uint32_t c = 0; c < this->Layout.Channels; ++c)
+            {
+                if (this->Layout.IsLfe[c]) continue;
+
+                const float lobe = 0.5f + 0.5f * std::cos(azimuth - this->Layout.Azimuths[c]);
+                weights[c]       = lobe * lobe;
+                power += weights[c] * weights[c];
+            }
+
+            if (power <= 0.0f) return;
+            const float norm = attenuation / std::sqrt(power);
+
+            for (std::uint32_t c = 0; c < this->Layout.Channels; ++c)
+            {
+                const float gain = weights[c] * norm;
+                if (gain < 1e-4f) continue;
+
+                InsertTap(outTaps.Counts[c], outTaps.Taps[c], delay, gain);
+            }
+        };
+
+        for (std::size_t e = 0; e < count; ++e)
+        {
+            const Vec3& emitter        = emitters[e];
+            const Vec3  toEmitter      = Sub(emitter, listener.Position);
+            const float directDistance = std::sqrt(Dot(toEmitter, toEmitter));
+
+            for (std::size_t i = 0; i < planes.size(); ++i)
+            {
+                const Vec3 first = Mirror(emitter, planes[i]);
+                addImage(first, planes[i].Reflectance, directDistance);
+
+                if (!secondOrder) continue;
+
+                for (std::size_t j = 0; j < planes.size(); ++j)
+                {
+                    if (j == i) continue;
+
+                    // Reflections off perpendicular planes commute; only count them once
+                    if (planes[j].Axis != planes[i].Axis && j < i) continue;
+
+                    const Vec3 second = Mirror(first, planes[j]);
+                    addImage(second, planes[i].Reflectance * planes[j].Reflectance, directDistance);
+                }
+            }
+        }
+    }
+
+    void EarlyReflections::Prepare(
+        const std::uint32_t sampleRate,
+        const std::uint32_t inputChannels,
+        const std::uint32_t maxFrames)
+    {
+        this->SampleRate = sampleRate;
+        this->Stride     = inputChannels;
+        this->Channels   = std::min(inputChannels, MAX_OUTPUT_CHANNELS);
+        this->MaxDelay   = static_cast<std::uint32_t>(MAX_REFLECTION_DELAY * static_cast<float>(sampleRate));
+
+        // Room for the longest tap plus one block that is written before it's read
+        std::uint32_t size = 1;
+        while (size < this->MaxDelay + maxFrames) size <<= 1;
+
+        this->LineSize = size;
+        this->LineMask = size - 1;
+        this->Lines.assign(static_cast<std::size_t>(size) * inputChannels, 0.0f);
+
+        this->Reset();
+    }
+
+    void EarlyReflections::Reset()
+    {
+        std::ranges::fill(this->Lines, 0.0f);
+        this->WritePos = 0;
+        this->IsFading = false;
+    }
+
+    void EarlyReflections::ConvertTaps(const ReflectionTaps& taps, SampleTaps& outTaps) const
+    {
+        outTaps.Counts.fill(0);
+
+        const std::uint32_t channels = std::min(taps.Channels, this->Channels);
+        for (std::uint32_t c = 0; c < channels; ++c)
+        {
+            for (std::uint32_t t = 0; t < taps.Counts[c]; ++t)
+            {
+                const auto& [delay, gain] = taps.Taps[c][t];
+
+                auto samples = static_cast<std::uint32_t>(delay * static_cast<float>(this->SampleRate) + 0.5f);
+                samples      = std::clamp(samples, 1u, this->MaxDelay);
+
+                outTaps.Taps[c][outTaps.Counts[c]++] = {samples, gain};
+            }
+        }
+    }
+
+    void EarlyReflections::Process(
+        const float*        input,
+        float*              output,
+        const std::uint32_t frames)
+    {
+        // New taps fade in over one block while the old ones fade out
+        if (this->Params.Update())
+        {
+            this->Previous = this->Active;
+            this->ConvertTaps(this->Params.Get(), this->Active);
+            this->IsFading = true;
+        }
+
+        const std::uint32_t stride = this->Stride;
+        const float         ramp   = frames > 0 ? 1.0f / static_cast<float>(frames) : 0.0f;
+
+        for (std::uint32_t c = 0; c < this->Channels; ++c)
+        {
+            float* line = this->Lines.data() + static_cast<std::size_t>(c) * this->LineSize;
+
+            for (std::uint32_t i = 0; i < frames; ++i)
+            {
+                line[(this->WritePos + i) & this->LineMask] = input[i * stride + c];
+            }
+
+            for (std::uint32_t i = 0; i < frames; ++i)
+            {
+                output[i * stride + c] = 0.0f;
+            }
+
+            for (std::uint32_t t = 0; t < this->Active.Counts[c]; ++t)
+            {
+                const auto [delay, gain] = this->Active.Taps[c][t];
+                const std::uint32_t start = this->WritePos - delay;
+
+                if (this->IsFading)
+                {
+                    for (std::uint32_t i = 0; i < frames; ++i)
+                    {
+                        const float fade = static_cast<float>(i) * ramp;
+                        output[i * stride + c] += gain * fade * line[(start + i) & this->LineMask];
+                    }
+                }
+                else
+                {
+                    for (std::uint32_t i = 0; i < frames; ++i)
+                    {
+                        output[i * stride + c] += gain * line[(start + i) & this->LineMask];
+                    }
+                }
+            }
+
+            if (!this->IsFading) continue;
+
+            for (std::uint32_t t = 0; t < this->Previous.Counts[c]; ++t)
+            {
+                const auto [delay, gain] = this->Previous.Taps[c][t];
+                const std::uint32_t start = this->WritePos - delay;
+
+                for (std::uint32_t i = 0; i < frames; ++i)
+                {
+                    const float fade = 1.0f - static_cast<float>(i) * ramp;
+                    output[i * stride + c] += gain * fade * line[(start + i) & this->LineMask];
+                }
+            }
+        }
+
+        // Channels past the supported layout carry no reflections
+        for (std::uint32_t c = this->Channels; c < stride; ++c)
+        {
+            for (std::uint32_t i = 0; i < frames; ++i)
+            {
+                output[i * stride + c] = 0.0f;
+            }
+        }
+
+        this->WritePos += frames;
+        this->IsFading = false;
+    }
+}
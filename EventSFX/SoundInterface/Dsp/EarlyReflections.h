@@ -0,0 +1,146 @@
+//=======================================================================
+/** EarlyReflections.h
+ * Image-source early reflections off the arena box
+ */
+//=======================================================================
+
+#pragma once
+
+#include "SoundInterface/Dsp/Processor.h"
+#include "SoundInterface/Dsp/SpeakerLayout.h"
+
+#include <vector>
+
+namespace SoundInterface::Dsp
+{
+    constexpr std::uint32_t MAX_REFLECTION_TAPS  = 16;
+    constexpr float         MAX_REFLECTION_DELAY = 0.25f; // Seconds
+    constexpr float         SPEED_OF_SOUND       = 343.0f; // Meters per second
+
+    // Same frame as X3DAudio: X right, Y up, Z forward, in meters
+    struct Vec3
+    {
+        float X = 0.0f;
+        float Y = 0.0f;
+        float Z = 0.0f;
+    };
+
+    struct Listener
+    {
+        Vec3 Position;
+        Vec3 Front;
+        Vec3 Top;
+    };
+
+    // Axis-aligned box with per-surface reflectance
+    struct Room
+    {
+        Vec3  Min;
+        Vec3  Max;
+        float WallReflectance    = 0.7f;
+        float FloorReflectance   = 0.5f;
+        float CeilingReflectance = 0.6f;
+    };
+
+    struct ReflectionTap
+    {
+        float Delay; // Seconds, relative to the direct sound
+        float Gain;
+    };
+
+    struct ReflectionTaps
+    {
+        std::uint32_t                                                                    Channels = 0;
+        std::array<std::uint32_t, MAX_OUTPUT_CHANNELS>                                   Counts{};
+        std::array<std::array<ReflectionTap, MAX_REFLECTION_TAPS>, MAX_OUTPUT_CHANNELS> Taps{};
+    };
+
+    /*
+     * Mirrors each emitter across the room surfaces (first order, and
+     * optionally second order) and pans the images onto the speaker
+     * layout. All emitters share one tap set: only the strongest taps
+     * per output channel are kept, so the delay line cost is fixed no
+     * matter how many voices are ringing.
+     */
+    class ImageSourceModel
+    {
+    public:
+        void SetRoom(const Room& room)
+        {
+            this->Box = room;
+        }
+
+        void SetLayout(const SpeakerLayout& layout)
+        {
+            this->Layout = layout;
+        }
+
+        // Distance at which the direct sound starts to attenuate
+        void SetDistanceScaler(const float scaler)
+        {
+            this->DistanceScaler = scaler;
+        }
+
+        void Compute(
+            const Vec3*     emitters,
+            std::size_t     count,
+            const Listener& listener,
+            bool            secondOrder,
+            ReflectionTaps& outTaps) const;
+
+    private:
+        Room          Box;
+        SpeakerLayout Layout;
+        float         DistanceScaler = 1.0f;
+    };
+
+    // Shared multi-tap delay line per output channel
+    class EarlyReflections final : public Processor
+    {
+    public:
+        void SetTaps(const ReflectionTaps& taps)
+        {
+            this->Params.Write(taps);
+        }
+
+        void Prepare(
+            std::uint32_t sampleRate,
+            std::uint32_t inputChannels,
+            std::uint32_t maxFrames) override;
+
+        void Process(
+            const float*  input,
+            float*        output,
+            std::uint32_t frames) override;
+
+        void Reset() override;
+
+    private:
+        struct SampleTap
+        {
+            std::uint32_t Delay;
+            float         Gain;
+        };
+
+        struct SampleTaps
+        {
+            std::array<std::uint32_t, MAX_OUTPUT_CHANNELS>                               Counts{};
+            std::array<std::array<SampleTap, MAX_REFLECTION_TAPS>, MAX_OUTPUT_CHANNELS> Taps{};
+        };
+
+        void ConvertTaps(const ReflectionTaps& taps, SampleTaps& outTaps) const;
+
+        SharedParams<ReflectionTaps> Params;
+        SampleTaps                   Active;
+        SampleTaps                   Previous;
+        bool                         IsFading   = false;
+        std::vector<float>           Lines;
+        std::uint32_t                LineSize   = 0;
+        std::uint32_t                LineMask   = 0;
+        std::uint32_t                WritePos   = 0;
+        std::uint32_t                Stride     = 0;
+        std::uint32_t                Channels   = 0;
+        std::uint32_t                MaxDelay   = 0;
+        std::uint32_t                SampleRate = 48000;
+    };
+}
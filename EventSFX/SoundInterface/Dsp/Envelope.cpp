@@ -0,0 +1,141 @@
+//=======================================================================
+/** Envelope.cpp
+ * Attack and release gain envelopes for many voices at once
+ */
+//=======================================================================
+
+#include "SoundInterface/Dsp/Envelope.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // What's left of the distance once an exponential ramp is over, -60 dB
+    constexpr float EXPONENTIAL_RESIDUE = 0.001f;
+}
+
+namespace SoundInterface::Dsp
+{
+    EnvelopeTable::Slot EnvelopeTable::Acquire()
+    {
+        Slot slot;
+        if (!this->FreeSlots.empty())
+        {
+            slot = this->FreeSlots.back();
+            this->FreeSlots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<Slot>(this->Gains.size());
+            this->Gains.push_back(1.0f);
+            this->Targets.push_back(1.0f);
+            this->Steps.push_back(0.0f);
+            this->Remaining.push_back(0);
+            this->Shapes.push_back(EnvelopeShape::Linear);
+        }
+
+        this->Jump(slot, 1.0f);
+        return slot;
+    }
+
+    void EnvelopeTable::Free(const Slot slot)
+    {
+        this->FreeSlots.push_back(slot);
+    }
+
+    void EnvelopeTable::Jump(const Slot slot, const float gain)
+    {
+        this->Gains[slot]     = gain;
+        this->Targets[slot]   = gain;
+        this->Remaining[slot] = 0;
+    }
+
+    void EnvelopeTable::Ramp(
+        const Slot          slot,
+        const float         target,
+        const Fade&         fade,
+        const std::uint32_t sampleRate)
+    {
+        const auto frames = static_cast<std::uint32_t>(std::lround(std::max(fade.Seconds, 0.0f) * static_cast<float>(sampleRate)));
+        if (frames == 0 || this->Gains[slot] == target)
+        {
+            this->Jump(slot, target);
+            return;
+        }
+
+        this->Targets[slot]   = target;
+        this->Remaining[slot] = frames;
+        this->Shapes[slot]    = fade.Shape;
+        this->Steps[slot]     = fade.Shape == EnvelopeShape::Linear
+                                    ? (target - this->Gains[slot]) / static_cast<float>(frames)
+                                    : std::pow(EXPONENTIAL_RESIDUE, 1.0f / static_cast<float>(frames));
+    }
+
+    void EnvelopeTable::Apply(
+        const Slot          slot,
+        float*              samples,
+        const std::uint32_t channels,
+        const std::uint32_t frames)
+    {
+        const std::uint32_t ramped = std::min(frames, this->Remaining[slot]);
+        const float         target = this->Targets[slot];
+        const float         step   = this->Steps[slot];
+        float               gain   = this->Gains[slot];
+
+        std::uint32_t f = 0;
+        if (this->Shapes[slot] == EnvelopeShape::Linear)
+        {
+            for (; f < ramped; ++f)
+            {
+                gain += step;
+                for (std::uint32_t c = 0; c < channels; ++c) *samples++ *= gain;
+            }
+        }
+        else
+        {
+            float distance = gain - target;
+            for (; f < ramped; ++f)
+            {
+                distance *= step;
+                for (std::uint32_t c = 0; c < channels; ++c) *samples++ *= target + distance;
+            }
+            gain = target + distance;
+        }
+
+        this->Remaining[slot] -= ramped;
+        if (this->Remaining[slot] == 0) gain = target;
+        this->Gains[slot] = gain;
+
+        // Whatever's left of the block holds the target
+        if (f < frames && gain != 1.0f)
+        {
+            const std::size_t rest = static_cast<std::size_t>(frames - f) * channels;
+            for (std::size_t i = 0; i < rest; ++i) samples[i] *= gain;
+        }
+    }
+
+    float EnvelopeTable::Advance(const Slot slot, const std::uint32_t frames)
+    {
+        const std::uint32_t ramped = std::min(frames, this->Remaining[slot]);
+        if (ramped == 0) return this->Gains[slot];
+
+        const float target = this->Targets[slot];
+        float&      gain   = this->Gains[slot];
+
+        this->Remaining[slot] -= ramped;
+        if (this->Remaining[slot] == 0)
+        {
+            gain = target;
+        }
+        else if (this->Shapes[slot] == EnvelopeShape::Linear)
+        {
+            gain += this->Steps[slot] * static_cast<float>(ramped);
+        }
+        else
+        {
+            gain = target + (gain - target) * std::pow(this->Steps[slot], static_cast<float>(ramped));
+        }
+        return gain;
+    }
+}
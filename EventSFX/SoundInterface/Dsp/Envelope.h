@@ -0,0 +1,88 @@
+//=======================================================================
+/** Envelope.h
+ * Attack and release gain envelopes for many voices at once
+ */
+//=======================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace SoundInterface::Dsp
+{
+    enum class EnvelopeShape
+        : std::uint8_t
+    {
+        Linear,
+        Exponential // Covers all but -60 dB of the distance, then snaps
+    };
+
+    struct Fade
+    {
+        float         Seconds = 0.0f; // Zero jumps straight to the target
+        EnvelopeShape Shape   = EnvelopeShape::Linear;
+    };
+
+    // Long enough to hide a cut mid-waveform, short enough not to be heard as a fade
+    constexpr Fade STOP_FADE  = {0.010f, EnvelopeShape::Exponential};
+    constexpr Fade STEAL_FADE = {0.005f, EnvelopeShape::Linear};
+
+    /*
+     * One gain envelope per voice, kept as parallel arrays so a mixer
+     * walking its voices only touches the few it needs. A slot that
+     * has reached its target is idle, and one idle at unity gain costs
+     * a single compare. Ramps are worked out per sample, so they're the
+     * same whatever the block size; backends that can only set a volume
+     * per pass step them with Advance instead.
+     */
+    class EnvelopeTable
+    {
+    public:
+        using Slot = std::uint32_t;
+
+        // A slot at unity gain, reusing freed ones first
+        Slot Acquire();
+        void Free(Slot slot);
+
+        void Jump(Slot slot, float gain);
+        void Ramp(
+            Slot          slot,
+            float         target,
+            const Fade&   fade,
+            std::uint32_t sampleRate);
+
+        [[nodiscard]] bool IsIdle(const Slot slot) const
+        {
+            return this->Remaining[slot] == 0;
+        }
+
+        [[nodiscard]] bool IsUnity(const Slot slot) const
+        {
+            return this->Remaining[slot] == 0 && this->Gains[slot] == 1.0f;
+        }
+
+        [[nodiscard]] float GetGain(const Slot slot) const
+        {
+            return this->Gains[slot];
+        }
+
+        // Multiplies interleaved audio by the envelope, sample by sample
+        void Apply(
+            Slot          slot,
+            float*        samples,
+            std::uint32_t channels,
+            std::uint32_t frames);
+
+        // Moves the envelope on without audio; returns the gain it ends on
+        float Advance(Slot slot, std::uint32_t frames);
+
+    private:
+        std::vector<float>         Gains;
+        std::vector<float>         Targets;
+        std::vector<float>         Steps;     // Added per frame when linear, multiplied into the distance when exponential
+        std::vector<std::uint32_t> Remaining; // Frames until the target
+        std::vector<EnvelopeShape> Shapes;
+        std::vector<Slot>          FreeSlots;
+    };
+}
@@ -0,0 +1,148 @@
+//=======================================================================
+/** Fft.cpp
+ * Radix-2 FFT for real signals
+ */
+//=======================================================================
+
+#include "SoundInterface/Dsp/Fft.h"
+
+#include <cmath>
+
+namespace SoundInterface::Dsp
+{
+    void RealFft::Init(const std::uint32_t size)
+    {
+        constexpr double twoPi = 6.283185307179586;
+
+        this->Size = size;
+        this->Half = size / 2;
+
+        this->Twiddles.resize(this->Half / 2 + 1);
+        for (std::uint32_t k = 0; k < this->Twiddles.size(); ++k)
+        {
+            const double angle = -twoPi * k / this->Half;
+            this->Twiddles[k]  = {static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle))};
+        }
+
+        this->RealTwiddles.resize(this->Half + 1);
+        for (std::uint32_t k = 0; k <= this->Half; ++k)
+        {
+            const double angle    = -twoPi * k / size;
+            this->RealTwiddles[k] = {static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle))};
+        }
+
+        std::uint32_t bits = 0;
+        while ((1u << bits) < this->Half) ++bits;
+
+        this->BitReverse.resize(this->Half);
+        for (std::uint32_t i = 0; i < this->Half; ++i)
+        {
+            std::uint32_t reversed = 0;
+            for (std::uint32_t b = 0; b < bits; ++b)
+            {
+                reversed |= ((i >> b) & 1u) << (bits - 1 - b);
+            }
+            this->BitReverse[i] = reversed;
+        }
+
+        this->Work.assign(this->Half, {});
+    }
+
+    void RealFft::Transform(Complex* data, const bool inverse) const
+    {
+        const std::uint32_t n = this->Half;
+
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            const std::uint32_t j = this->BitReverse[i];
+            if (i < j) std::swap(data[i], data[j]);
+        }
+
+        for (std::uint32_t length = 2; length <= n; length <<= 1)
+        {
+            const std::uint32_t half = length / 2;
+            const std::uint32_t step = n / length;
+
+            for (std::uint32_t start = 0; start < n; start += length)
+            {
+                for (std::uint32_t k = 0; k < half; ++k)
+                {
+                    const Complex& w  = this->Twiddles[k * step];
+                    const float    wr = w.real();
+                    const float    wi = inverse ? -w.imag() : w.imag();
+
+                    Complex&    a  = data[start + k];
+                    Complex&    b  = data[start + k + half];
+                    const float br = b.real() * wr - b.imag() * wi;
+                    const float bi = b.real() * wi + b.imag() * wr;
+
+                    b = {a.real() - br, a.imag() - bi};
+                    a = {a.real() + br, a.imag() + bi};
+                }
+            }
+        }
+    }
+
+    void RealFft::Forward(const float* input, Complex* output)
+    {
+        const std::uint32_t n = this->Half;
+
+        // Even samples in the real part, odd samples in the imaginary part
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            this->Work[i] = {input[2 * i], input[2 * i + 1]};
+        }
+
+        this->Transform(this->Work.data(), false);
+
+        // Untangle the two interleaved half-size spectra
+        for (std::uint32_t k = 0; k <= n; ++k)
+        {
+            const Complex z  = this->Work[k == n ? 0 : k];
+            const Complex zc = std::conj(this->Work[k == 0 ? 0 : n - k]);
+
+            const Complex even = 0.5f * (z + zc);
+            const Complex diff = 0.5f * (z - zc);
+            const Complex odd  = {diff.imag(), -diff.real()}; // diff / i
+
+            const Complex& w = this->RealTwiddles[k];
+            output[k]        = {
+                even.real() + w.real() * odd.real() - w.imag() * odd.imag(),
+                even.imag() + w.real() * odd.imag() + w.imag() * odd.real()
+            };
+        }
+    }
+
+    void RealFft::Inverse(const Complex* input, float* output)
+    {
+        const std::uint32_t n = this->Half;
+
+        for (std::uint32_t k = 0; k < n; ++k)
+        {
+            const Complex x  = input[k];
+            const Complex xc = std::conj(input[n - k]);
+
+            const Complex  even = 0.5f * (x + xc);
+            const Complex  diff = 0.5f * (x - xc);
+            const Complex& w    = this->RealTwiddles[k];
+
+            // odd = diff * conj(w)
+            const Complex odd = {
+                diff.real() * w.real() + diff.imag() * w.imag(),
+                diff.imag() * w.real() - diff.real() * w.imag()
+            };
+
+            // even + i * odd
+            this->Work[k] = {even.real() - odd.imag(), even.imag() + odd.real()};
+        }
+
+        this->Transform(this->Work.data(), true);
+
+        const float scale = 1.0f / static_cast<float>(n);
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            output[2 * i]     = this->Work[i].real() * scale;
+            output[2 * i + 1] = this->Work[i].imag() * scale;
+        }
+    }
+}
@@ -0,0 +1,57 @@
+//=======================================================================
+/** Fft.h
+ * Radix-2 FFT for real signals
+ */
+//=======================================================================
+
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace SoundInterface::Dsp
+{
+    using Complex = std::complex<float>;
+
+    /*
+     * Transforms Size real samples into Size / 2 + 1 bins by packing
+     * them into a half-size complex transform. Size must be a power of
+     * two. The inverse is scaled, so Inverse(Forward(x)) == x.
+     */
+    class RealFft
+    {
+    public:
+        RealFft() = default;
+
+        explicit RealFft(const std::uint32_t size)
+        {
+            this->Init(size);
+        }
+
+        void Init(std::uint32_t size);
+
+        [[nodiscard]] std::uint32_t GetSize() const
+        {
+            return this->Size;
+        }
+
+        [[nodiscard]] std::uint32_t GetBins() const
+        {
+            return this->Half + 1;
+        }
+
+        void Forward(const float* input, Complex* output);
+        void Inverse(const Complex* input, float* output);
+
+    private:
+        void Transform(Complex* data, bool inverse) const;
+
+        std::uint32_t              Size = 0;
+        std::uint32_t              Half = 0;
+        std::vector<Complex>       Twiddles;     // e^(-2 pi i k / Half)
+        std::vector<Complex>       RealTwiddles; // e^(-2 pi i k / Size)
+        std::vector<std::uint32_t> BitReverse;
+        std::vector<Complex>       Work;
+    };
+}
@@ -0,0 +1,82 @@
+//=======================================================================
+/** GainCurve.cpp
+ * Gain as a function of any input, baked into lookup tables
+ */
+//=======================================================================
+
+#include "SoundInterface/Dsp/GainCurve.h"
+
+namespace
+{
+    using namespace SoundInterface::Dsp;
+
+    // Zero to one over the segment, bent by its shape
+    float Shape(const CurveShape shape, const float t)
+    {
+        switch (shape)
+        {
+        case CurveShape::EaseIn:
+            return t * t;
+        case CurveShape::EaseOut:
+            return 1.0f - (1.0f - t) * (1.0f - t);
+        case CurveShape::Smooth:
+            return t * t * (3.0f - 2.0f * t);
+        case CurveShape::Step:
+            return 0.0f;
+        case CurveShape::Linear:
+        default:
+            return t;
+        }
+    }
+}
+
+namespace SoundInterface::Dsp
+{
+    float EvaluateGainCurve(const GainCurve& curve, const float input)
+    {
+        const auto& points = curve.Points;
+        if (points.empty()) return 1.0f;
+        if (input <= points.front().Input) return points.front().Gain;
+        if (input >= points.back().Input) return points.back().Gain;
+
+        const auto after = std::upper_bound(
+            points.begin(), points.end(), input,
+            [](const float value, const CurvePoint& point) { return value < point.Input; });
+        const auto before = after - 1;
+
+        const float span = after->Input - before->Input;
+        if (span <= 0.0f) return after->Gain;
+
+        const float t = Shape(before->Shape, (input - before->Input) / span);
+        return before->Gain + t * (after->Gain - before->Gain);
+    }
+
+    GainLut::GainLut(const GainCurve& curve, const float minInput, const float maxInput)
+        : GainLut(minInput, maxInput, [&curve](const float input) { return EvaluateGainCurve(curve, input); })
+    {}
+
+    void GainLut::Evaluate(
+        const float*      inputs,
+        const std::size_t count,
+        float*            outGains) const
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            outGains[i] = this->Evaluate(inputs[i]);
+        }
+    }
+
+    void SanitizeGainCurve(GainCurve& curve, const float minInput, const float maxInput)
+    {
+        for (auto& point : curve.Points)
+        {
+            point.Input = std::clamp(point.Input, minInput, maxInput);
+            point.Gain  = std::clamp(point.Gain, MIN_CURVE_MULTIPLIER, MAX_CURVE_MULTIPLIER);
+            if (static_cast<std::size_t>(point.Shape) >= NUM_CURVE_SHAPES) point.Shape = CurveShape::Linear;
+        }
+
+        std::stable_sort(
+            curve.Points.begin(), curve.Points.end(),
+            [](const CurvePoint& a, const CurvePoint& b) { return a.Input < b.Input; });
+    }
+}
@@ -0,0 +1,122 @@
+//=======================================================================
+/** GainCurve.h
+ * Gain as a function of any input, baked into lookup tables
+ */
+//=======================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace SoundInterface::Dsp
+{
+    constexpr float MIN_CURVE_MULTIPLIER = 0.0f;
+    constexpr float MAX_CURVE_MULTIPLIER = 2.0f;
+
+    enum class CurveShape : std::uint8_t
+    {
+        Linear,  // Straight to the next point
+        EaseIn,  // Slow to leave, quadratic
+        EaseOut, // Quick to leave, quadratic
+        Smooth,  // Eased at both ends, smoothstep
+        Step,    // Holds, then jumps at the next point
+        Count
+    };
+
+    constexpr std::size_t NUM_CURVE_SHAPES = static_cast<std::size_t>(CurveShape::Count);
+
+    constexpr const char* GetCurveShapeLabel(const CurveShape shape)
+    {
+        switch (shape)
+        {
+        case CurveShape::Linear:
+            return "linear";
+        case CurveShape::EaseIn:
+            return "ease-in";
+        case CurveShape::EaseOut:
+            return "ease-out";
+        case CurveShape::Smooth:
+            return "smooth";
+        case CurveShape::Step:
+            return "step";
+        default:
+            return "NA";
+        }
+    }
+
+    struct CurvePoint
+    {
+        float      Input;
+        float      Gain;
+        CurveShape Shape = CurveShape::Linear; // Of the segment from here to the next point
+    };
+
+    /*
+     * Points joined by shaped segments; the gain holds before the first
+     * and after the last, and with no points it's a flat 1.
+     */
+    struct GainCurve
+    {
+        std::vector<CurvePoint> Points;
+    };
+
+    // Straight from the points, for baking and drawing; sorted points only
+    [[nodiscard]] float EvaluateGainCurve(const GainCurve& curve, float input);
+
+    /*
+     * Any function of an input sampled at regular steps over a range, so
+     * that evaluating it is a clamp and one interpolated table read with
+     * no branches, whatever it was baked from. Inputs outside the range
+     * read its ends, and NaN reads the start. Tables are immutable once
+     * baked and shared.
+     */
+    class GainLut
+    {
+    public:
+        static constexpr std::uint32_t SIZE = 256;
+
+        template <typename Sample>
+        GainLut(const float minInput, const float maxInput, Sample&& sample)
+            : MinInput(minInput),
+              Scale(maxInput > minInput ? static_cast<float>(SIZE) / (maxInput - minInput) : 0.0f)
+        {
+            const float span = maxInput - minInput;
+            for (std::uint32_t i = 0; i <= SIZE; ++i)
+            {
+                this->Table[i] = sample(minInput + span * static_cast<float>(i) / static_cast<float>(SIZE));
+            }
+            this->Table[SIZE + 1] = this->Table[SIZE];
+        }
+
+        GainLut(const GainCurve& curve, float minInput, float maxInput);
+
+        [[nodiscard]] float Evaluate(const float input) const
+        {
+            // Written so NaN falls out as 0; both compile to single min/max instructions
+            const float position = std::min(std::max(0.0f, (input - this->MinInput) * this->Scale), static_cast<float>(SIZE));
+            const auto  index    = static_cast<std::int32_t>(position); // Signed converts in one instruction
+            const float fraction = position - static_cast<float>(index);
+
+            return this->Table[index] + fraction * (this->Table[index + 1] - this->Table[index]);
+        }
+
+        void Evaluate(
+            const float* inputs,
+            std::size_t  count,
+            float*       outGains) const;
+
+    private:
+        std::array<float, SIZE + 2> Table{}; // Guard entry for the last interpolation
+        float                       MinInput = 0.0f;
+        float                       Scale    = 0.0f;
+    };
+
+    using GainLutPtr = std::shared_ptr<const GainLut>;
+
+    // Sorts the points and clamps them into the input range and to the multiplier limits
+    void SanitizeGainCurve(GainCurve& curve, float minInput, float maxInput);
+}
@@ -0,0 +1,313 @@
+//=======================================================================
+/** Limiter.cpp
+ * Lookahead true-peak limiter for the master bus
+ */
+//=======================================================================
+
+#include "SoundInterface/Dsp/Limiter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define DSP_LIMITER_SSE2 1
+#include <emmintrin.h>
+#else
+#define DSP_LIMITER_SSE2 0
+#endif
+
+namespace
+{
+    constexpr double PI = 3.14159265358979323846;
+
+    constexpr std::uint32_t PHASES = SoundInterface::Dsp::TRUE_PEAK_OVERSAMPLING;
+    constexpr std::uint32_t TAPS   = SoundInterface::Dsp::TRUE_PEAK_TAPS;
+
+#if DSP_LIMITER_SSE2
+    static_assert(PHASES == 4, "The detector keeps one phase per SSE lane");
+#endif
+
+    // Phase 0 is the input itself, this many frames late
+    constexpr std::uint32_t DETECTOR_DELAY = TAPS / 2;
+
+    // Frequencies the headroom is worked out at, across the band
+    constexpr std::uint32_t HEADROOM_STEPS = 256;
+
+    float DecibelsToGain(const float decibels)
+    {
+        return std::pow(10.0f, decibels / 20.0f);
+    }
+
+    std::uint32_t NextPowerOfTwo(const std::uint32_t value)
+    {
+        std::uint32_t result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+}
+
+namespace SoundInterface::Dsp
+{
+    void SanitizeLimiterParams(LimiterParams& params)
+    {
+        params.Ceiling = std::clamp(params.Ceiling, MIN_LIMITER_CEILING, MAX_LIMITER_CEILING);
+        params.Release = std::clamp(params.Release, MIN_LIMITER_RELEASE, MAX_LIMITER_RELEASE);
+    }
+
+    void Limiter::Prepare(
+        const std::uint32_t sampleRate,
+        const std::uint32_t inputChannels,
+        const std::uint32_t maxFrames)
+    {
+        this->SampleRate = sampleRate;
+        this->Channels   = inputChannels;
+        this->MaxFrames  = std::max<std::uint32_t>(maxFrames, 1);
+
+        this->Lookahead = std::max<std::uint32_t>(
+            static_cast<std::uint32_t>(std::lround(LIMITER_LOOKAHEAD / 1000.0f * static_cast<float>(sampleRate))), 1);
+        this->Latency = this->Lookahead - 1 + DETECTOR_DELAY;
+
+        // Windowed sinc at the input Nyquist, each phase normalized to unity gain
+        constexpr std::uint32_t length = TAPS * PHASES;
+        for (std::uint32_t k = 0; k < PHASES; ++k)
+        {
+            double sum = 0.0;
+            for (std::uint32_t j = 0; j < TAPS; ++j)
+            {
+                const std::uint32_t m = j * PHASES + k;
+                const double        x = (static_cast<double>(m) - length / 2.0) / PHASES;
+                const double        sinc   = x == 0.0 ? 1.0 : std::sin(PI * x) / (PI * x);
+                const double        window = 0.42 - 0.5 * std::cos(2.0 * PI * m / length) + 0.08 * std::cos(4.0 * PI * m / length);
+
+                this->Coefficients[m] = static_cast<float>(sinc * window);
+                sum += sinc * window;
+            }
+            for (std::uint32_t j = 0; j < TAPS; ++j)
+            {
+                this->Coefficients[j * PHASES + k] = static_cast<float>(this->Coefficients[j * PHASES + k] / sum);
+            }
+        }
+
+        /*
+         * A sine's peak is read low by the quietest phase's response at
+         * its frequency, and by up to half the step between phases, for
+         * whichever frequency in the band is worst
+         */
+        const double band   = std::min(static_cast<double>(TRUE_PEAK_BAND), 0.45 * sampleRate);
+        double       lowest = 1.0;
+        for (std::uint32_t i = 1; i <= HEADROOM_STEPS; ++i)
+        {
+            const double omega = 2.0 * PI * band * i / HEADROOM_STEPS / sampleRate;
+
+            double response = 2.0;
+            for (std::uint32_t k = 0; k < PHASES; ++k)
+            {
+                double re = 0.0;
+                double im = 0.0;
+                for (std::uint32_t j = 0; j < TAPS; ++j)
+                {
+                    re += this->Coefficients[j * PHASES + k] * std::cos(omega * j);
+                    im -= this->Coefficients[j * PHASES + k] * std::sin(omega * j);
+                }
+                response = std::min(response, std::sqrt(re * re + im * im));
+            }
+
+            lowest = std::min(lowest, response * std::cos(omega / (2.0 * PHASES)));
+        }
+        this->Headroom = static_cast<float>(1.0 / lowest);
+        this->Ceiling  = DecibelsToGain(this->Active.Ceiling) / this->Headroom;
+
+        this->HistoryStride = TAPS - 1 + this->MaxFrames;
+        this->History.assign(static_cast<std::size_t>(this->HistoryStride) * inputChannels, 0.0f);
+        this->Peaks.assign(this->MaxFrames, 0.0f);
+
+        const std::uint32_t delayFrames = NextPowerOfTwo(this->Latency + 1);
+        this->Delay.assign(static_cast<std::size_t>(delayFrames) * inputChannels, 0.0f);
+        this->DelayMask = delayFrames - 1;
+
+        this->HoldValues.assign(this->Lookahead + 1, 1.0f);
+        this->HoldTimes.assign(this->Lookahead + 1, 0);
+        this->Average.assign(this->Lookahead, 1.0f);
+
+        this->Reset();
+    }
+
+    void Limiter::Reset()
+    {
+        std::fill(this->History.begin(), this->History.end(), 0.0f);
+        std::fill(this->Delay.begin(), this->Delay.end(), 0.0f);
+        std::fill(this->Average.begin(), this->Average.end(), 1.0f);
+
+        this->DelayPos   = 0;
+        this->HoldHead   = 0;
+        this->HoldCount  = 0;
+        this->Time       = 0;
+        this->Envelope   = 1.0f;
+        this->AveragePos = 0;
+        this->AverageSum = static_cast<double>(this->Average.size());
+        this->Reduction.store(0.0f, std::memory_order_relaxed);
+    }
+
+    void Limiter::Process(
+        const float*        input,
+        float*              output,
+        const std::uint32_t frames)
+    {
+        if (this->Params.Update())
+        {
+            this->Active      = this->Params.Get();
+            this->Ceiling     = DecibelsToGain(this->Active.Ceiling) / this->Headroom;
+            this->ReleaseCoef = std::exp(-1000.0f / (this->Active.Release * static_cast<float>(this->SampleRate)));
+        }
+
+        float lowest = 1.0f;
+        for (std::uint32_t done = 0; done < frames;)
+        {
+            const std::uint32_t chunk  = std::min(frames - done, this->MaxFrames);
+            const std::size_t   offset = static_cast<std::size_t>(done) * this->Channels;
+
+            this->ProcessChunk(input + offset, output + offset, chunk);
+            lowest = std::min(lowest, *std::min_element(this->Peaks.begin(), this->Peaks.begin() + chunk));
+            done += chunk;
+        }
+
+        this->Reduction.store(lowest < 1.0f ? -20.0f * std::log10(lowest) : 0.0f, std::memory_order_relaxed);
+    }
+
+    // Leaves the gain of each frame in Peaks
+    void Limiter::ProcessChunk(
+        const float*        input,
+        float*              output,
+        const std::uint32_t frames)
+    {
+        this->DetectPeaks(input, frames);
+
+        const std::uint32_t channels = this->Channels;
+        for (std::uint32_t f = 0; f < frames; ++f)
+        {
+            const float gain = this->NextGain(this->Peaks[f]);
+            this->Peaks[f]   = gain;
+
+            const std::uint32_t readPos  = (this->DelayPos - this->Latency) & this->DelayMask;
+            const std::uint32_t writePos = this->DelayPos & this->DelayMask;
+
+            const float* in      = input + static_cast<std::size_t>(f) * channels;
+            float*       out     = output + static_cast<std::size_t>(f) * channels;
+            const float* delayed = this->Delay.data() + static_cast<std::size_t>(readPos) * channels;
+            float*       slot    = this->Delay.data() + static_cast<std::size_t>(writePos) * channels;
+
+            // Read before write, in case input and output are the same buffer
+            for (std::uint32_t c = 0; c < channels; ++c)
+            {
+                const float sample = in[c];
+                out[c]             = delayed[c] * gain;
+                slot[c]            = sample;
+            }
+
+            ++this->DelayPos;
+        }
+    }
+
+    void Limiter::DetectPeaks(const float* input, const std::uint32_t frames)
+    {
+        const std::uint32_t channels = this->Channels;
+        std::fill_n(this->Peaks.begin(), frames, 0.0f);
+
+        for (std::uint32_t c = 0; c < channels; ++c)
+        {
+            float* history = this->History.data() + static_cast<std::size_t>(c) * this->HistoryStride;
+
+            // The last taps of the previous block are already at the front
+            for (std::uint32_t f = 0; f < frames; ++f)
+            {
+                history[TAPS - 1 + f] = input[static_cast<std::size_t>(f) * channels + c];
+            }
+
+            // Every phase of a frame at once: one vector per tap
+#if DSP_LIMITER_SSE2
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+            __m128 taps[TAPS];
+            for (std::uint32_t j = 0; j < TAPS; ++j)
+            {
+                taps[j] = _mm_loadu_ps(this->Coefficients.data() + j * PHASES);
+            }
+
+            for (std::uint32_t f = 0; f < frames; ++f)
+            {
+                const float* newest = history + TAPS - 1 + f;
+
+                __m128 sum = _mm_mul_ps(taps[0], _mm_set1_ps(newest[0]));
+                for (std::uint32_t j = 1; j < TAPS; ++j)
+                {
+                    sum = _mm_add_ps(sum, _mm_mul_ps(taps[j], _mm_set1_ps(newest[-static_cast<std::ptrdiff_t>(j)])));
+                }
+
+                __m128 peak = _mm_and_ps(sum, absMask);
+                peak        = _mm_max_ps(peak, _mm_shuffle_ps(peak, peak, _MM_SHUFFLE(1, 0, 3, 2)));
+                peak        = _mm_max_ps(peak, _mm_shuffle_ps(peak, peak, _MM_SHUFFLE(2, 3, 0, 1)));
+
+                this->Peaks[f] = std::max(this->Peaks[f], _mm_cvtss_f32(peak));
+            }
+#else
+            for (std::uint32_t f = 0; f < frames; ++f)
+            {
+                const float* newest = history + TAPS - 1 + f;
+
+                float peak = 0.0f;
+                for (std::uint32_t k = 0; k < PHASES; ++k)
+                {
+                    float sum = 0.0f;
+                    for (std::uint32_t j = 0; j < TAPS; ++j)
+                    {
+                        sum += this->Coefficients[j * PHASES + k] * newest[-static_cast<std::ptrdiff_t>(j)];
+                    }
+                    peak = std::max(peak, std::abs(sum));
+                }
+
+                this->Peaks[f] = std::max(this->Peaks[f], peak);
+            }
+#endif
+
+            // Keep the newest taps for the next block
+            std::copy_n(history + frames, TAPS - 1, history);
+        }
+    }
+
+    float Limiter::NextGain(const float peak)
+    {
+        const float required = this->Active.Enabled && peak > this->Ceiling ? this->Ceiling / peak : 1.0f;
+        const auto  capacity = static_cast<std::uint32_t>(this->HoldValues.size());
+
+        // Running minimum over the lookahead, as a monotonic queue
+        while (this->HoldCount > 0)
+        {
+            const std::uint32_t back = (this->HoldHead + this->HoldCount - 1) % capacity;
+            if (this->HoldValues[back] < required) break;
+            --this->HoldCount;
+        }
+        const std::uint32_t tail = (this->HoldHead + this->HoldCount) % capacity;
+        this->HoldValues[tail]   = required;
+        this->HoldTimes[tail]    = this->Time;
+        ++this->HoldCount;
+
+        if (this->Time - this->HoldTimes[this->HoldHead] >= this->Lookahead)
+        {
+            this->HoldHead = (this->HoldHead + 1) % capacity;
+            --this->HoldCount;
+        }
+        ++this->Time;
+
+        const float held = this->HoldValues[this->HoldHead];
+
+        // Down at once, back up exponentially
+        this->Envelope = held < this->Envelope ? held : held + this->ReleaseCoef * (this->Envelope - held);
+
+        // Spread the drop over the lookahead
+        this->AverageSum += this->Envelope - this->Average[this->AveragePos];
+        this->Average[this->AveragePos] = this->Envelope;
+        this->AveragePos                = this->AveragePos + 1 < this->Average.size() ? this->AveragePos + 1 : 0;
+
+        return std::min(1.0f, static_cast<float>(this->AverageSum / static_cast<double>(this->Average.size())));
+    }
+}
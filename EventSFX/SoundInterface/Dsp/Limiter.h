@@ -0,0 +1,131 @@
+//=======================================================================
+/** Limiter.h
+ * Lookahead true-peak limiter for the master bus
+ */
+//=======================================================================
+
+#pragma once
+
+#include "SoundInterface/Dsp/Processor.h"
+
+#include <cmath>
+#include <vector>
+
+namespace SoundInterface::Dsp
+{
+    constexpr float MIN_LIMITER_CEILING = -12.0f; // dBTP
+    constexpr float MAX_LIMITER_CEILING = 0.0f;
+    constexpr float MIN_LIMITER_RELEASE = 10.0f;  // Milliseconds
+    constexpr float MAX_LIMITER_RELEASE = 1000.0f;
+    constexpr float LIMITER_LOOKAHEAD   = 3.0f;   // Milliseconds, fixed so the latency is too
+
+    constexpr std::uint32_t TRUE_PEAK_OVERSAMPLING = 4;
+    constexpr std::uint32_t TRUE_PEAK_TAPS         = 32;       // Per phase, at the input rate
+    constexpr float         TRUE_PEAK_BAND         = 20000.0f; // Hz; the ceiling holds for anything up to here
+
+    struct LimiterParams
+    {
+        bool  Enabled = true;
+        float Ceiling = -1.0f;
+        float Release = 80.0f;
+    };
+
+    // Clamps everything into range
+    void SanitizeLimiterParams(LimiterParams& params);
+
+    /*
+     * Keeps the output under the ceiling, including the peaks between
+     * samples that a DAC would reconstruct. Peaks are found on a 4x
+     * oversampled copy of the input, then the gain is worked out ahead
+     * of the audio: the lowest gain needed within the lookahead is held,
+     * released exponentially, and smoothed by a moving average as long
+     * as the lookahead, so it has reached its target by the time the
+     * peak comes out of the delay line. Four points a sample can still
+     * miss a peak between them, and the interpolator rolls off towards
+     * Nyquist, so the ceiling is lowered by the most the detector can
+     * under-read a sine within TRUE_PEAK_BAND. Channels share one gain
+     * so the image doesn't shift. When disabled the audio still goes through
+     * the delay, so the latency doesn't change with the setting.
+     */
+    class Limiter final : public Processor
+    {
+    public:
+        void SetParams(const LimiterParams& params)
+        {
+            this->Params.Write(params);
+        }
+
+        // How far the output lags the input, valid after Prepare
+        [[nodiscard]] std::uint32_t GetLatency() const
+        {
+            return this->Latency;
+        }
+
+        // How far the ceiling is lowered for what the detector can miss, in dB, valid after Prepare
+        [[nodiscard]] float GetHeadroom() const
+        {
+            return 20.0f * std::log10(this->Headroom);
+        }
+
+        // Deepest reduction during the last block, in dB; safe to call from any thread
+        [[nodiscard]] float GetGainReduction() const
+        {
+            return this->Reduction.load(std::memory_order_relaxed);
+        }
+
+        void Prepare(
+            std::uint32_t sampleRate,
+            std::uint32_t inputChannels,
+            std::uint32_t maxFrames) override;
+
+        void Process(
+            const float*  input,
+            float*        output,
+            std::uint32_t frames) override;
+
+        void Reset() override;
+
+    private:
+        void  ProcessChunk(const float* input, float* output, std::uint32_t frames);
+        void  DetectPeaks(const float* input, std::uint32_t frames);
+        float NextGain(float peak);
+
+        SharedParams<LimiterParams> Params;
+        LimiterParams               Active;
+        float                       Ceiling        = 1.0f; // Linear, less the headroom
+        float                       Headroom       = 1.0f; // Linear, the detector's worst under-read
+        float                       ReleaseCoef    = 0.0f;
+        std::uint32_t               Channels       = 0;
+        std::uint32_t               SampleRate     = 48000;
+        std::uint32_t               MaxFrames      = 0;
+        std::uint32_t               Lookahead      = 0;    // Frames
+        std::uint32_t               Latency        = 0;    // Frames
+        std::atomic<float>          Reduction      = 0.0f;
+
+        // Polyphase interpolator, tap-major so one tap covers every phase
+        std::array<float, TRUE_PEAK_TAPS * TRUE_PEAK_OVERSAMPLING> Coefficients{};
+
+        // Per channel: the previous block's last taps, then the current block
+        std::vector<float> History;
+        std::uint32_t      HistoryStride = 0;
+        std::vector<float> Peaks; // Per frame, across channels
+
+        // Audio delay line, interleaved
+        std::vector<float> Delay;
+        std::uint32_t      DelayMask = 0;
+        std::uint32_t      DelayPos  = 0;
+
+        // Running minimum of the required gain over the lookahead
+        std::vector<float>         HoldValues;
+        std::vector<std::uint32_t> HoldTimes;
+        std::uint32_t              HoldHead  = 0;
+        std::uint32_t              HoldCount = 0;
+        std::uint32_t              Time      = 0;
+
+        // Release, then a moving average over the lookahead
+        float              Envelope = 1.0f;
+        std::vector<float> Average;
+        std::uint32_t      AveragePos = 0;
+        double             AverageSum = 0.0;
+    };
+}
@@ -0,0 +1,484 @@
+//=======================================================================
+/** MixKernels.cpp
+ * Mono-into-interleaved mix-accumulate kernels with ramped gains
+ */
+//=======================================================================
+
+#include "SoundInterface/Dsp/MixKernels.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <utility>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define DSP_MIX_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#else
+#define DSP_MIX_X86 0
+#endif
+
+// MSVC compiles any intrinsic anywhere; GCC and Clang want the target spelled out
+#if defined(_MSC_VER) && !defined(__clang__)
+#define DSP_TARGET(isa)
+#else
+#define DSP_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace
+{
+    using namespace SoundInterface::Dsp;
+
+    constexpr std::uint32_t MAX_MIX_CHANNELS = 64;
+
+    // Finishes a block from frame start, continuing the same ramp
+    void MixTail(
+        const float*        input,
+        float*              output,
+        const std::uint32_t channels,
+        const std::uint32_t start,
+        const std::uint32_t frames,
+        const float*        from,
+        const float*        to)
+    {
+        const float scale = 1.0f / static_cast<float>(frames);
+
+        for (std::uint32_t f = start; f < frames; ++f)
+        {
+            const float t   = static_cast<float>(f) * scale;
+            float*      out = output + static_cast<std::size_t>(f) * channels;
+
+            for (std::uint32_t c = 0; c < channels; ++c)
+            {
+                out[c] += input[f] * (from[c] + t * (to[c] - from[c]));
+            }
+        }
+    }
+
+    void MixGeneric(
+        const float*        input,
+        float*              output,
+        const std::uint32_t channels,
+        const std::uint32_t frames,
+        const float*        from,
+        const float*        to)
+    {
+        MixTail(input, output, channels, 0, frames, from, to);
+    }
+
+    // A fixed channel count lets the compiler unroll and vectorize this on its own
+    template <std::uint32_t Channels>
+    void MixScalar(
+        const float*        input,
+        float*              output,
+        std::uint32_t,
+        const std::uint32_t frames,
+        const float*        from,
+        const float*        to)
+    {
+        std::array<float, Channels> gains;
+        std::array<float, Channels> steps;
+        for (std::uint32_t c = 0; c < Channels; ++c)
+        {
+            gains[c] = from[c];
+            steps[c] = (to[c] - from[c]) / static_cast<float>(frames);
+        }
+
+        for (std::uint32_t f = 0; f < frames; ++f)
+        {
+            float* out = output + static_cast<std::size_t>(f) * Channels;
+            for (std::uint32_t c = 0; c < Channels; ++c)
+            {
+                out[c] += input[f] * gains[c];
+                gains[c] += steps[c];
+            }
+        }
+    }
+
+    /*
+     * The SIMD kernels walk the output in periods of lcm(channels, width)
+     * floats, which always start on a frame boundary. Within a period the
+     * input sample and the gain of each lane are fixed patterns, so they
+     * are worked out once per block: the inputs for a period are loaded
+     * in one go and spread across lanes by a permute, and the gains step
+     * by a whole period's ramp per iteration.
+     */
+    template <std::uint32_t Channels, std::uint32_t Width>
+    struct Period
+    {
+        static constexpr std::uint32_t Floats  = std::lcm(Channels, Width);
+        static constexpr std::uint32_t Frames  = Floats / Channels;
+        static constexpr std::uint32_t Vectors = Floats / Width;
+
+        // Gains for the first period, and how much they move per period
+        static void Setup(
+            const float*        from,
+            const float*        to,
+            const std::uint32_t frames,
+            float*              outGains,
+            float*              outSteps,
+            std::int32_t*       outLanes)
+        {
+            for (std::uint32_t k = 0; k < Floats; ++k)
+            {
+                const std::uint32_t c     = k % Channels;
+                const std::uint32_t frame = k / Channels;
+                const float         step  = (to[c] - from[c]) / static_cast<float>(frames);
+
+                outGains[k] = from[c] + step * static_cast<float>(frame);
+                outSteps[k] = step * static_cast<float>(Frames);
+                outLanes[k] = static_cast<std::int32_t>(frame);
+            }
+        }
+    };
+
+#if DSP_MIX_X86
+    //-----------------------------------------------------------------------
+    // SSE2, part of every x64 CPU
+    //-----------------------------------------------------------------------
+
+    // Shuffle immediate that spreads the period's inputs over vector v
+    template <std::uint32_t Channels, std::uint32_t V>
+    constexpr int SSE_SPREAD =
+        static_cast<int>(((V * 4 + 0) / Channels)
+            | (((V * 4 + 1) / Channels) << 2)
+            | (((V * 4 + 2) / Channels) << 4)
+            | (((V * 4 + 3) / Channels) << 6));
+
+    template <std::uint32_t Frames>
+    __m128 LoadSse2(const float* input)
+    {
+        if constexpr (Frames == 1) return _mm_load1_ps(input);
+        else if constexpr (Frames == 2) return _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(input)));
+        else return _mm_loadu_ps(input);
+    }
+
+    template <std::uint32_t Channels>
+    void MixSse2(
+        const float*        input,
+        float*              output,
+        std::uint32_t,
+        const std::uint32_t frames,
+        const float*        from,
+        const float*        to)
+    {
+        using P = Period<Channels, 4>;
+
+        alignas(16) std::array<float, P::Floats>        gainInit;
+        alignas(16) std::array<float, P::Floats>        stepInit;
+        alignas(16) std::array<std::int32_t, P::Floats> lanes;
+        P::Setup(from, to, frames, gainInit.data(), stepInit.data(), lanes.data());
+
+        __m128 gains[P::Vectors];
+        __m128 steps[P::Vectors];
+        for (std::uint32_t v = 0; v < P::Vectors; ++v)
+        {
+            gains[v] = _mm_load_ps(gainInit.data() + v * 4);
+            steps[v] = _mm_load_ps(stepInit.data() + v * 4);
+        }
+
+        std::uint32_t f = 0;
+        for (; f + P::Frames <= frames; f += P::Frames)
+        {
+            const __m128 x   = LoadSse2<P::Frames>(input + f);
+            float*       out = output + static_cast<std::size_t>(f) * Channels;
+
+            [&]<std::uint32_t... V>(std::integer_sequence<std::uint32_t, V...>)
+            {
+                ((_mm_storeu_ps(
+                      out + V * 4,
+                      _mm_add_ps(
+                          _mm_loadu_ps(out + V * 4),
+                          _mm_mul_ps(_mm_shuffle_ps(x, x, SSE_SPREAD<Channels, V>), gains[V]))),
+                  gains[V] = _mm_add_ps(gains[V], steps[V])),
+                 ...);
+            }(std::make_integer_sequence<std::uint32_t, P::Vectors>{});
+        }
+
+        MixTail(input, output, Channels, f, frames, from, to);
+    }
+
+    //-----------------------------------------------------------------------
+    // AVX2
+    //-----------------------------------------------------------------------
+
+    template <std::uint32_t Frames>
+    DSP_TARGET("avx2") __m256 LoadAvx2(const float* input)
+    {
+        if constexpr (Frames == 1) return _mm256_broadcast_ss(input);
+        else if constexpr (Frames == 2) return _mm256_castps128_ps256(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(input))));
+        else if constexpr (Frames == 4) return _mm256_castps128_ps256(_mm_loadu_ps(input));
+        else return _mm256_loadu_ps(input);
+    }
+
+    template <std::uint32_t Channels>
+    DSP_TARGET("avx2") void MixAvx2(
+        const float*        input,
+        float*              output,
+        std::uint32_t,
+        const std::uint32_t frames,
+        const float*        from,
+        const float*        to)
+    {
+        using P = Period<Channels, 8>;
+
+        alignas(32) std::array<float, P::Floats>        gainInit;
+        alignas(32) std::array<float, P::Floats>        stepInit;
+        alignas(32) std::array<std::int32_t, P::Floats> lanes;
+        P::Setup(from, to, frames, gainInit.data(), stepInit.data(), lanes.data());
+
+        __m256  gains[P::Vectors];
+        __m256  steps[P::Vectors];
+        __m256i spread[P::Vectors];
+        for (std::uint32_t v = 0; v < P::Vectors; ++v)
+        {
+            gains[v]  = _mm256_load_ps(gainInit.data() + v * 8);
+            steps[v]  = _mm256_load_ps(stepInit.data() + v * 8);
+            spread[v] = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes.data() + v * 8));
+        }
+
+        std::uint32_t f = 0;
+        for (; f + P::Frames <= frames; f += P::Frames)
+        {
+            const __m256 x   = LoadAvx2<P::Frames>(input + f);
+            float*       out = output + static_cast<std::size_t>(f) * Channels;
+
+            for (std::uint32_t v = 0; v < P::Vectors; ++v)
+            {
+                __m256 lane = x;
+                if constexpr (P::Frames > 1) lane = _mm256_permutevar8x32_ps(x, spread[v]);
+                _mm256_storeu_ps(out + v * 8, _mm256_add_ps(_mm256_loadu_ps(out + v * 8), _mm256_mul_ps(lane, gains[v])));
+                gains[v] = _mm256_add_ps(gains[v], steps[v]);
+            }
+        }
+
+        MixTail(input, output, Channels, f, frames, from, to);
+    }
+
+    //-----------------------------------------------------------------------
+    // AVX-512
+    //-----------------------------------------------------------------------
+
+    template <std::uint32_t Frames>
+    DSP_TARGET("avx512f") __m512 LoadAvx512(const float* input)
+    {
+        if constexpr (Frames == 1) return _mm512_set1_ps(*input);
+        else if constexpr (Frames < 16) return _mm512_maskz_loadu_ps(static_cast<__mmask16>((1u << Frames) - 1), input);
+        else return _mm512_loadu_ps(input);
+    }
+
+    template <std::uint32_t Channels>
+    DSP_TARGET("avx512f") void MixAvx512(
+        const float*        input,
+        float*              output,
+        std::uint32_t,
+        const std::uint32_t frames,
+        const float*        from,
+        const float*        to)
+    {
+        using P = Period<Channels, 16>;
+
+        alignas(64) std::array<float, P::Floats>        gainInit;
+        alignas(64) std::array<float, P::Floats>        stepInit;
+        alignas(64) std::array<std::int32_t, P::Floats> lanes;
+        P::Setup(from, to, frames, gainInit.data(), stepInit.data(), lanes.data());
+
+        __m512  gains[P::Vectors];
+        __m512  steps[P::Vectors];
+        __m512i spread[P::Vectors];
+        for (std::uint32_t v = 0; v < P::Vectors; ++v)
+        {
+            gains[v]  = _mm512_load_ps(gainInit.data() + v * 16);
+            steps[v]  = _mm512_load_ps(stepInit.data() + v * 16);
+            spread[v] = _mm512_load_si512(lanes.data() + v * 16);
+        }
+
+        std::uint32_t f = 0;
+        for (; f + P::Frames <= frames; f += P::Frames)
+        {
+            const __m512 x   = LoadAvx512<P::Frames>(input + f);
+            float*       out = output + static_cast<std::size_t>(f) * Channels;
+
+            for (std::uint32_t v = 0; v < P::Vectors; ++v)
+            {
+                __m512 lane = x;
+                if constexpr (P::Frames > 1) lane = _mm512_permutexvar_ps(spread[v], x);
+                _mm512_storeu_ps(out + v * 16, _mm512_add_ps(_mm512_loadu_ps(out + v * 16), _mm512_mul_ps(lane, gains[v])));
+                gains[v] = _mm512_add_ps(gains[v], steps[v]);
+            }
+        }
+
+        MixTail(input, output, Channels, f, frames, from, to);
+    }
+
+    SimdLevel DetectSimdLevel()
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+        if (maxLeaf < 7) return SimdLevel::Sse2;
+
+        // The OS has to save the wide registers too
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        if (!osxsave) return SimdLevel::Sse2;
+
+        const unsigned long long xcr0 = _xgetbv(0);
+
+        __cpuidex(info, 7, 0);
+        const bool avx2   = (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+        const bool avx512 = (info[1] & (1 << 16)) != 0 && (xcr0 & 0xe6) == 0xe6;
+#else
+        __builtin_cpu_init();
+        const bool avx2   = __builtin_cpu_supports("avx2");
+        const bool avx512 = __builtin_cpu_supports("avx512f");
+#endif
+        if (avx512) return SimdLevel::Avx512;
+        if (avx2) return SimdLevel::Avx2;
+        return SimdLevel::Sse2;
+    }
+#else
+    SimdLevel DetectSimdLevel()
+    {
+        return SimdLevel::Scalar;
+    }
+#endif
+
+    // One kernel per specialized channel count, for a given instruction set
+    template <std::uint32_t Channels>
+    struct ScalarKernel
+    {
+        static constexpr MixKernel Get = MixScalar<Channels>;
+    };
+
+#if DSP_MIX_X86
+    template <std::uint32_t Channels>
+    struct Sse2Kernel
+    {
+        static constexpr MixKernel Get = MixSse2<Channels>;
+    };
+
+    template <std::uint32_t Channels>
+    struct Avx2Kernel
+    {
+        static constexpr MixKernel Get = MixAvx2<Channels>;
+    };
+
+    template <std::uint32_t Channels>
+    struct Avx512Kernel
+    {
+        static constexpr MixKernel Get = MixAvx512<Channels>;
+    };
+#endif
+
+    template <template <std::uint32_t> class Kernel>
+    MixKernel SelectKernel(const std::uint32_t channels)
+    {
+        switch (channels)
+        {
+        case 1:
+            return Kernel<1>::Get;
+        case 2:
+            return Kernel<2>::Get;
+        case 6:
+            return Kernel<6>::Get;
+        case 8:
+            return Kernel<8>::Get;
+        case 16:
+            return Kernel<16>::Get;
+        default:
+            return MixGeneric;
+        }
+    }
+}
+
+namespace SoundInterface::Dsp
+{
+    std::string GetSimdLevelLabel(const SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::Scalar:
+            return "scalar";
+        case SimdLevel::Sse2:
+            return "SSE2";
+        case SimdLevel::Avx2:
+            return "AVX2";
+        case SimdLevel::Avx512:
+            return "AVX-512";
+        default:
+            return "NA";
+        }
+    }
+
+    SimdLevel GetSupportedSimdLevel()
+    {
+        static const SimdLevel level = DetectSimdLevel();
+        return level;
+    }
+
+    MixKernel GetMixKernel(const std::uint32_t channels, SimdLevel level)
+    {
+        level = std::min(level, GetSupportedSimdLevel());
+
+        switch (level)
+        {
+#if DSP_MIX_X86
+        case SimdLevel::Avx512:
+            return SelectKernel<Avx512Kernel>(channels);
+        case SimdLevel::Avx2:
+            return SelectKernel<Avx2Kernel>(channels);
+        case SimdLevel::Sse2:
+            return SelectKernel<Sse2Kernel>(channels);
+#endif
+        default:
+            return SelectKernel<ScalarKernel>(channels);
+        }
+    }
+
+    void MixMatrix(
+        const float*        input,
+        const std::uint32_t sourceChannels,
+        float*              output,
+        const std::uint32_t destinationChannels,
+        const std::uint32_t frames,
+        const float*        fromLevels,
+        const float*        toLevels,
+        float*              scratch)
+    {
+        if (frames == 0 || destinationChannels > MAX_MIX_CHANNELS) return;
+
+        const MixKernel kernel = GetMixKernel(destinationChannels);
+
+        std::array<float, MAX_MIX_CHANNELS> from;
+        std::array<float, MAX_MIX_CHANNELS> to;
+
+        for (std::uint32_t s = 0; s < sourceChannels; ++s)
+        {
+            bool silent = true;
+            for (std::uint32_t d = 0; d < destinationChannels; ++d)
+            {
+                from[d] = fromLevels[d * sourceChannels + s];
+                to[d]   = toLevels[d * sourceChannels + s];
+                silent  = silent && from[d] == 0.0f && to[d] == 0.0f;
+            }
+            if (silent) continue;
+
+            const float* mono = input;
+            if (sourceChannels > 1)
+            {
+                for (std::uint32_t f = 0; f < frames; ++f)
+                {
+                    scratch[f] = input[static_cast<std::size_t>(f) * sourceChannels + s];
+                }
+                mono = scratch;
+            }
+
+            kernel(mono, output, destinationChannels, frames, from.data(), to.data());
+        }
+    }
+}
@@ -0,0 +1,70 @@
+//=======================================================================
+/** MixKernels.h
+ * Mono-into-interleaved mix-accumulate kernels with ramped gains
+ */
+//=======================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace SoundInterface::Dsp
+{
+    enum class SimdLevel
+        : std::uint8_t
+    {
+        Scalar = 0,
+        Sse2,
+        Avx2,
+        Avx512,
+        Count
+    };
+
+    std::string GetSimdLevelLabel(SimdLevel level);
+
+    // The best level this CPU runs, detected once
+    SimdLevel GetSupportedSimdLevel();
+
+    /*
+     * output[f * channels + c] += input[f] * gain(c, f), where the gain
+     * ramps linearly from from[c] at the first frame towards to[c],
+     * reaching it where the next block starts. Ramping every block keeps
+     * matrix and volume changes from clicking.
+     */
+    using MixKernel = void (*)(
+        const float*  input,
+        float*        output,
+        std::uint32_t channels,
+        std::uint32_t frames,
+        const float*  from,
+        const float*  to);
+
+    /*
+     * Kernels are specialized for 1, 2, 6, 8 and 16 output channels;
+     * other counts get a generic scalar loop. Asking for more than the
+     * CPU supports gets the best it does support.
+     */
+    MixKernel GetMixKernel(std::uint32_t channels, SimdLevel level);
+
+    inline MixKernel GetMixKernel(const std::uint32_t channels)
+    {
+        return GetMixKernel(channels, GetSupportedSimdLevel());
+    }
+
+    /*
+     * Mixes interleaved audio through a level matrix, ramping from one
+     * matrix to another. Levels are destination-major as in
+     * SetOutputMatrix: levels[d * sourceChannels + s]. Multichannel
+     * sources are split into scratch, which holds at least frames floats.
+     */
+    void MixMatrix(
+        const float*  input,
+        std::uint32_t sourceChannels,
+        float*        output,
+        std::uint32_t destinationChannels,
+        std::uint32_t frames,
+        const float*  fromLevels,
+        const float*  toLevels,
+        float*        scratch);
+}
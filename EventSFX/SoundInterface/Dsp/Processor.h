@@ -0,0 +1,94 @@
+//=======================================================================
+/** Processor.h
+ * Portable block processors hosted on shared buses
+ */
+//=======================================================================
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace SoundInterface::Dsp
+{
+    /*
+     * A processor runs once per block on a bus, never per voice.
+     * Audio is interleaved 32-bit float. Processors that keep the
+     * channel count may be run in place (input == output).
+     */
+    class Processor
+    {
+    public:
+        virtual ~Processor() = default;
+
+        virtual void Prepare(
+            std::uint32_t sampleRate,
+            std::uint32_t inputChannels,
+            std::uint32_t maxFrames) = 0;
+
+        virtual void Process(
+            const float*  input,
+            float*        output,
+            std::uint32_t frames) = 0;
+
+        virtual void Reset()
+        {}
+
+        [[nodiscard]] virtual std::uint32_t GetOutputChannels(const std::uint32_t inputChannels) const
+        {
+            return inputChannels;
+        }
+    };
+
+    /*
+     * Triple buffer for handing parameters from the game thread to the
+     * audio thread without locks. The writer never blocks the reader and
+     * the reader always sees the most recently completed write.
+     */
+    template <class T>
+    class SharedParams
+    {
+    public:
+        void Write(const T& value)
+        {
+            this->Slots[this->WriteIndex] = value;
+
+            const std::uint8_t previous = this->Middle.exchange(
+                static_cast<std::uint8_t>(this->WriteIndex | DIRTY_BIT),
+                std::memory_order_acq_rel);
+
+            this->WriteIndex = previous & INDEX_MASK;
+        }
+
+        // Reader side: picks up the latest write, returns true if there was one
+        bool Update()
+        {
+            if (!(this->Middle.load(std::memory_order_relaxed) & DIRTY_BIT))
+            {
+                return false;
+            }
+
+            const std::uint8_t previous = this->Middle.exchange(
+                this->ReadIndex,
+                std::memory_order_acq_rel);
+
+            this->ReadIndex = previous & INDEX_MASK;
+            return true;
+        }
+
+        [[nodiscard]] const T& Get() const
+        {
+            return this->Slots[this->ReadIndex];
+        }
+
+    private:
+        static constexpr std::uint8_t DIRTY_BIT  = 0x4;
+        static constexpr std::uint8_t INDEX_MASK = 0x3;
+
+        std::array<T, 3>          Slots{};
+        std::uint8_t              WriteIndex = 0;
+        std::uint8_t              ReadIndex  = 1;
+        std::atomic<std::uint8_t> Middle     = 2;
+    };
+}
@@ -0,0 +1,152 @@
+//=======================================================================
+/** Resampler.cpp
+ * Fractional-rate linear resampling straight out of a shared buffer
+ */
+//=======================================================================
+
+#include "SoundInterface/Dsp/Resampler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define DSP_RESAMPLE_X86 1
+#include <immintrin.h>
+#else
+#define DSP_RESAMPLE_X86 0
+#endif
+
+// MSVC compiles any intrinsic anywhere; GCC and Clang want the target spelled out
+#if defined(_MSC_VER) && !defined(__clang__)
+#define DSP_TARGET(isa)
+#else
+#define DSP_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace
+{
+    using namespace SoundInterface::Dsp;
+
+    /*
+     * Positions are worked out from where the call started rather than
+     * stepped frame by frame, so rounding doesn't build up over a long
+     * sound and every kernel lands on the same frames.
+     */
+    std::uint32_t ResampleFrom(
+        const float*        input,
+        const std::uint32_t inputFrames,
+        const std::uint32_t channels,
+        const double        start,
+        const double        step,
+        float*              output,
+        std::uint32_t       frame,
+        const std::uint32_t outputFrames)
+    {
+        for (; frame < outputFrames; ++frame)
+        {
+            const double position = start + static_cast<double>(frame) * step;
+            const auto   index    = static_cast<std::uint32_t>(position);
+            if (index >= inputFrames) break;
+
+            const float  t   = static_cast<float>(position - index);
+            const float* a   = input + static_cast<std::size_t>(index) * channels;
+            const float* b   = index + 1 < inputFrames ? a + channels : a;
+            float*       out = output + static_cast<std::size_t>(frame) * channels;
+
+            for (std::uint32_t c = 0; c < channels; ++c)
+            {
+                out[c] = a[c] + t * (b[c] - a[c]);
+            }
+        }
+
+        return frame;
+    }
+
+    std::uint32_t ResampleScalar(
+        const float*        input,
+        const std::uint32_t inputFrames,
+        const std::uint32_t channels,
+        double&             position,
+        const double        step,
+        float*              output,
+        const std::uint32_t outputFrames)
+    {
+        const double        start   = position;
+        const std::uint32_t written = ResampleFrom(input, inputFrames, channels, start, step, output, 0, outputFrames);
+
+        position = start + static_cast<double>(written) * step;
+        return written;
+    }
+
+#if DSP_RESAMPLE_X86
+    /*
+     * Eight frames at a time: positions in doubles, split into indices
+     * and fractions, then both neighbours gathered and blended. Only
+     * frames whose right neighbour is inside the input go through here;
+     * the held last frame and anything short of a vector go through
+     * the scalar loop.
+     */
+    DSP_TARGET("avx2")
+    std::uint32_t ResampleMonoAvx2(
+        const float*        input,
+        const std::uint32_t inputFrames,
+        const std::uint32_t channels,
+        double&             position,
+        const double        step,
+        float*              output,
+        const std::uint32_t outputFrames)
+    {
+        if (channels != 1) return ResampleScalar(input, inputFrames, channels, position, step, output, outputFrames);
+
+        const double start = position;
+
+        // Frames before this have both neighbours, give or take a frame of rounding
+        const double  inside = (static_cast<double>(inputFrames) - 1.0 - start) / step;
+        std::uint32_t safe   = 0;
+        if (inside > 1.0)
+        {
+            safe = static_cast<std::uint32_t>(std::min(inside - 1.0, static_cast<double>(outputFrames)));
+        }
+
+        const __m256d lanesLow  = _mm256_mul_pd(_mm256_set_pd(3.0, 2.0, 1.0, 0.0), _mm256_set1_pd(step));
+        const __m256d lanesHigh = _mm256_mul_pd(_mm256_set_pd(7.0, 6.0, 5.0, 4.0), _mm256_set1_pd(step));
+
+        std::uint32_t frame = 0;
+        for (; frame + 8 <= safe; frame += 8)
+        {
+            const __m256d base = _mm256_set1_pd(start + static_cast<double>(frame) * step);
+            const __m256d low  = _mm256_add_pd(base, lanesLow);
+            const __m256d high = _mm256_add_pd(base, lanesHigh);
+
+            const __m256d lowFloor  = _mm256_floor_pd(low);
+            const __m256d highFloor = _mm256_floor_pd(high);
+
+            const __m256i index = _mm256_set_m128i(_mm256_cvttpd_epi32(highFloor), _mm256_cvttpd_epi32(lowFloor));
+            const __m256  t     = _mm256_set_m128(
+                _mm256_cvtpd_ps(_mm256_sub_pd(high, highFloor)),
+                _mm256_cvtpd_ps(_mm256_sub_pd(low, lowFloor)));
+
+            const __m256 a = _mm256_i32gather_ps(input, index, 4);
+            const __m256 b = _mm256_i32gather_ps(input + 1, index, 4);
+
+            _mm256_storeu_ps(output + frame, _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a))));
+        }
+
+        const std::uint32_t written = ResampleFrom(input, inputFrames, 1, start, step, output, frame, outputFrames);
+
+        position = start + static_cast<double>(written) * step;
+        return written;
+    }
+#endif
+}
+
+namespace SoundInterface::Dsp
+{
+    ResampleKernel GetResampleKernel([[maybe_unused]] const SimdLevel level)
+    {
+#if DSP_RESAMPLE_X86
+        if (level >= SimdLevel::Avx2 && GetSupportedSimdLevel() >= SimdLevel::Avx2) return ResampleMonoAvx2;
+#endif
+        return ResampleScalar;
+    }
+}
@@ -0,0 +1,48 @@
+//=======================================================================
+/** Resampler.h
+ * Fractional-rate linear resampling straight out of a shared buffer
+ */
+//=======================================================================
+
+#pragma once
+
+#include "SoundInterface/Dsp/MixKernels.h"
+
+#include <cstdint>
+
+namespace SoundInterface::Dsp
+{
+    /*
+     * Reads interleaved input from position onwards, stepping step input
+     * frames per output frame and interpolating linearly between them;
+     * the last frame is held rather than read past. Stops when output is
+     * full or the input runs out, returning the frames written, and
+     * leaves position where the next call should carry on. The input is
+     * only read, so any number of voices can play one buffer at
+     * different rates.
+     */
+    using ResampleKernel = std::uint32_t (*)(
+        const float*  input,
+        std::uint32_t inputFrames,
+        std::uint32_t channels,
+        double&       position,
+        double        step,
+        float*        output,
+        std::uint32_t outputFrames);
+
+    // Mono input is vectorized from AVX2 up; everything else runs the scalar loop
+    ResampleKernel GetResampleKernel(SimdLevel level);
+
+    inline std::uint32_t ResampleLinear(
+        const float*        input,
+        const std::uint32_t inputFrames,
+        const std::uint32_t channels,
+        double&             position,
+        const double        step,
+        float*              output,
+        const std::uint32_t outputFrames)
+    {
+        static const ResampleKernel kernel = GetResampleKernel(GetSupportedSimdLevel());
+        return kernel(input, inputFrames, channels, position, step, output, outputFrames);
+    }
+}
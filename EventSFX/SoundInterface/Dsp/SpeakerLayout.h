@@ -0,0 +1,75 @@
+//=======================================================================
+/** SpeakerLayout.h
+ * Speaker directions derived from a WAVEFORMATEXTENSIBLE channel mask
+ */
+//=======================================================================
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace SoundInterface::Dsp
+{
+    constexpr std::uint32_t MAX_OUTPUT_CHANNELS = 8;
+
+    struct SpeakerLayout
+    {
+        std::uint32_t                          Channels = 0;
+        std::array<float, MAX_OUTPUT_CHANNELS> Azimuths{}; // Radians, 0 = front, positive = right
+        std::array<bool, MAX_OUTPUT_CHANNELS>  IsLfe{};
+    };
+
+    /*
+     * Mirrors the SPEAKER_* bits from the Windows headers so the
+     * layout can be computed without them. Channels appear in the
+     * output in ascending bit order.
+     */
+    inline SpeakerLayout MakeSpeakerLayout(const std::uint32_t channelMask, const std::uint32_t channels)
+    {
+        constexpr float deg = 3.14159265f / 180.0f;
+
+        struct Bit
+        {
+            std::uint32_t Mask;
+            float         Azimuth;
+            bool          IsLfe;
+        };
+
+        constexpr std::array<Bit, 11> bits = {{
+            {0x001, -30.0f * deg, false},       // Front left
+            {0x002, 30.0f * deg, false},        // Front right
+            {0x004, 0.0f, false},               // Front center
+            {0x008, 0.0f, true},                // Low frequency
+            {0x010, -135.0f * deg, false},      // Back left
+            {0x020, 135.0f * deg, false},       // Back right
+            {0x040, -15.0f * deg, false},       // Front left of center
+            {0x080, 15.0f * deg, false},        // Front right of center
+            {0x100, 180.0f * deg, false},       // Back center
+            {0x200, -90.0f * deg, false},       // Side left
+            {0x400, 90.0f * deg, false},        // Side right
+        }};
+
+        SpeakerLayout layout;
+
+        for (const auto& bit : bits)
+        {
+            if (layout.Channels >= channels || layout.Channels >= MAX_OUTPUT_CHANNELS) break;
+            if (!(channelMask & bit.Mask)) continue;
+
+            layout.Azimuths[layout.Channels] = bit.Azimuth;
+            layout.IsLfe[layout.Channels]    = bit.IsLfe;
+            ++layout.Channels;
+        }
+
+        // Unknown mask; assume a plain stereo pair and ignore the rest
+        if (layout.Channels == 0)
+        {
+            layout.Channels    = channels < MAX_OUTPUT_CHANNELS ? channels : MAX_OUTPUT_CHANNELS;
+            layout.Azimuths[0] = -30.0f * deg;
+            if (layout.Channels > 1) layout.Azimuths[1] = 30.0f * deg;
+        }
+
+        return layout;
+    }
+}
@@ -0,0 +1,49 @@
+//=======================================================================
+/** EffectBuses.h
+ * Named send/return effect buses shared by all voices
+ */
+//=======================================================================
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+constexpr float MIN_SEND_LEVEL = 0.0f;
+constexpr float MAX_SEND_LEVEL = 1.0f;
+
+namespace SoundInterface
+{
+    enum class EffectBus
+        : std::uint8_t
+    {
+        Reverb = 0,
+        Delay,
+        Eq,
+        Convolution,
+        Count
+    };
+
+    constexpr std::size_t NUM_EFFECT_BUSES = static_cast<std::size_t>(EffectBus::Count);
+
+    // Per-voice send level into each effect bus
+    using SendLevels = std::array<float, NUM_EFFECT_BUSES>;
+
+    inline std::string GetEffectBusLabel(const EffectBus bus)
+    {
+        switch (bus)
+        {
+        case EffectBus::Reverb:
+            return "reverb";
+        case EffectBus::Delay:
+            return "delay";
+        case EffectBus::Eq:
+            return "eq";
+        case EffectBus::Convolution:
+            return "convolution";
+        default:
+            return "NA";
+        }
+    }
+}
@@ -0,0 +1,106 @@
+//=======================================================================
+/** GainCurves.h
+ * What an event's gain curves can follow
+ */
+//=======================================================================
+
+#pragma once
+
+#include "SoundInterface/Dsp/DistanceCurve.h"
+#include "SoundInterface/Dsp/GainCurve.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace SoundInterface
+{
+    enum class CurveInput : std::uint8_t
+    {
+        BallSpeed = 0, // Unreal units per second
+        ImpactSpeed,   // What the event was hooked with; the ball's for crossbar hits, closing speed for bumps
+        CarSpeed,      // The player's car
+        Boost,         // The player's, 0 to 100
+        Distance,      // From the listener in meters, 3D events only
+        Count
+    };
+
+    constexpr std::size_t NUM_CURVE_INPUTS = static_cast<std::size_t>(CurveInput::Count);
+
+    constexpr const char* GetCurveInputLabel(const CurveInput input)
+    {
+        switch (input)
+        {
+        case CurveInput::BallSpeed:
+            return "ball-speed";
+        case CurveInput::ImpactSpeed:
+            return "impact-speed";
+        case CurveInput::CarSpeed:
+            return "car-speed";
+        case CurveInput::Boost:
+            return "boost";
+        case CurveInput::Distance:
+            return "distance";
+        default:
+            return "NA";
+        }
+    }
+
+    // The top of each input's table; the bottom is always zero
+    constexpr float GetCurveInputRange(const CurveInput input)
+    {
+        switch (input)
+        {
+        case CurveInput::BallSpeed:
+        case CurveInput::ImpactSpeed:
+            return 6000.0f;
+        case CurveInput::CarSpeed:
+            return 2300.0f;
+        case CurveInput::Boost:
+            return 100.0f;
+        case CurveInput::Distance:
+            return Dsp::MAX_CURVE_DISTANCE;
+        default:
+            return 1.0f;
+        }
+    }
+
+    // Their values for one play, indexed by CurveInput
+    using CurveInputs = std::array<float, NUM_CURVE_INPUTS>;
+
+    constexpr std::size_t MAX_EVENT_CURVES = 4;
+
+    // One curve of an event's; all of them multiply together into its volume
+    struct EventCurve
+    {
+        CurveInput      Input = CurveInput::BallSpeed;
+        Dsp::GainCurve  Curve;
+        Dsp::GainLutPtr Lut; // Baked from Curve over the input's range
+
+        void Bake()
+        {
+            Dsp::GainCurve curve = this->Curve;
+            Dsp::SanitizeGainCurve(curve, 0.0f, GetCurveInputRange(this->Input));
+
+            this->Lut = std::make_shared<const Dsp::GainLut>(curve, 0.0f, GetCurveInputRange(this->Input));
+        }
+    };
+
+    // The crossbar's volume by ball speed, as it was fixed in code before curves
+    inline EventCurve GetCrossbarSpeedCurve()
+    {
+        using Dsp::CurveShape;
+
+        EventCurve curve;
+        curve.Input        = CurveInput::ImpactSpeed;
+        curve.Curve.Points = {
+            {0.0f, 0.0f, CurveShape::Linear},
+            {100.0f, 0.0f, CurveShape::EaseIn},
+            {800.0f, 0.25f, CurveShape::Linear},
+            {2500.0f, 0.85f, CurveShape::EaseOut},
+            {6000.0f, 1.2f, CurveShape::Linear}
+        };
+        return curve;
+    }
+}
@@ -0,0 +1,62 @@
+//=======================================================================
+/** InstanceLimits.h
+ * How many of one event's sounds may play at once
+ */
+//=======================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr std::uint32_t MIN_MAX_INSTANCES = 0; // No limit
+constexpr std::uint32_t MAX_MAX_INSTANCES = 16;
+
+namespace SoundInterface
+{
+    // What happens to a sound played while its event is at its limit
+    enum class LimitPolicy
+        : std::uint8_t
+    {
+        KillOldest = 0, // The oldest fades out quickly, the new one starts as usual
+        RefuseNew,      // The new one isn't played
+        Retrigger,      // The newest is restarted: it fades out as the new one fades in
+        StealQuietest,  // The quietest fades out, unless the new one would be quieter still
+        Count
+    };
+
+    constexpr std::size_t NUM_LIMIT_POLICIES = static_cast<std::size_t>(LimitPolicy::Count);
+
+    constexpr const char* GetLimitPolicyLabel(const LimitPolicy policy)
+    {
+        switch (policy)
+        {
+        case LimitPolicy::KillOldest:
+            return "oldest";
+        case LimitPolicy::RefuseNew:
+            return "refuse";
+        case LimitPolicy::Retrigger:
+            return "retrigger";
+        case LimitPolicy::StealQuietest:
+            return "quietest";
+        default:
+            return "NA";
+        }
+    }
+
+    struct InstanceLimit
+    {
+        std::uint32_t MaxInstances = MIN_MAX_INSTANCES;
+        LimitPolicy   Policy       = LimitPolicy::KillOldest;
+    };
+
+    // Events are groups; sounds outside any event, like console plays, have no limit
+    constexpr std::uint8_t NO_VOICE_GROUP  = 0xFF;
+    constexpr std::size_t  MAX_VOICE_GROUPS = 32;
+
+    struct VoiceGroup
+    {
+        std::uint8_t  Id = NO_VOICE_GROUP;
+        InstanceLimit Limit;
+    };
+}
@@ -0,0 +1,158 @@
+//=======================================================================
+/** LatencyStats.cpp
+ * How long events take from their hook to their sound's first block
+ */
+//=======================================================================
+
+#include "SoundInterface/LatencyStats.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace
+{
+    using namespace SoundInterface;
+
+    std::uint64_t ToMicros(const LatencyProbe::Clock::duration latency)
+    {
+        const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+        return micros > 0 ? static_cast<std::uint64_t>(micros) : 0;
+    }
+}
+
+namespace SoundInterface
+{
+    void LatencyHistogram::Record(const std::uint64_t micros)
+    {
+        const std::uint64_t value = std::min(micros, MAX_VALUE);
+
+        this->Counts[GetBucket(value)].fetch_add(1, std::memory_order_relaxed);
+        this->Count.fetch_add(1, std::memory_order_relaxed);
+        this->Sum.fetch_add(value, std::memory_order_relaxed);
+
+        // Rarely loops more than once, as the extremes rarely move
+        std::uint64_t min = this->Min.load(std::memory_order_relaxed);
+        while (value < min && !this->Min.compare_exchange_weak(min, value, std::memory_order_relaxed)) {}
+
+        std::uint64_t max = this->Max.load(std::memory_order_relaxed);
+        while (value > max && !this->Max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+    }
+
+    void LatencyHistogram::Reset()
+    {
+        for (auto& count : this->Counts)
+        {
+            count.store(0, std::memory_order_relaxed);
+        }
+        this->Count.store(0, std::memory_order_relaxed);
+        this->Sum.store(0, std::memory_order_relaxed);
+        this->Min.store(MAX_VALUE, std::memory_order_relaxed);
+        this->Max.store(0, std::memory_order_relaxed);
+    }
+
+    LatencyHistogram::Summary LatencyHistogram::Summarize() const
+    {
+        // Counted from the buckets, so the percentiles agree with each other
+        std::array<std::uint32_t, NUM_BUCKETS> counts;
+        std::uint64_t                          total = 0;
+        for (std::uint32_t i = 0; i < NUM_BUCKETS; ++i)
+        {
+            counts[i]  = this->Counts[i].load(std::memory_order_relaxed);
+            total     += counts[i];
+        }
+
+        Summary summary;
+        if (total == 0) return summary;
+
+        summary.Count = total;
+        summary.Min   = this->Min.load(std::memory_order_relaxed);
+        summary.Max   = this->Max.load(std::memory_order_relaxed);
+        summary.Mean  = this->Sum.load(std::memory_order_relaxed) / std::max<std::uint64_t>(this->Count.load(std::memory_order_relaxed), 1);
+
+        const auto getPercentile = [&counts, total](const std::uint64_t percent)
+        {
+            // The rank of the value, rounded up, so the 99th of 10 is the last
+            const std::uint64_t rank = std::max<std::uint64_t>((total * percent + 99) / 100, 1);
+
+            std::uint64_t seen = 0;
+            for (std::uint32_t i = 0; i < NUM_BUCKETS; ++i)
+            {
+                seen += counts[i];
+                if (seen >= rank) return GetBucketHigh(i);
+            }
+            return MAX_VALUE;
+        };
+
+        // Within a bucket of the extremes, which are kept exactly
+        summary.P50 = std::clamp(getPercentile(50), summary.Min, summary.Max);
+        summary.P90 = std::clamp(getPercentile(90), summary.Min, summary.Max);
+        summary.P99 = std::clamp(getPercentile(99), summary.Min, summary.Max);
+
+        return summary;
+    }
+
+    std::uint32_t LatencyHistogram::GetBucket(const std::uint64_t micros)
+    {
+        const std::uint64_t value = std::min(micros, MAX_VALUE);
+        if (value < SUB_BUCKETS) return static_cast<std::uint32_t>(value);
+
+        // The power of two, then which of its parts
+        const auto magnitude = static_cast<std::uint32_t>(std::bit_width(value)) - 1;
+        const auto part      = static_cast<std::uint32_t>(value >> (magnitude - SUB_BUCKET_BITS));
+
+        return SUB_BUCKETS * (magnitude - SUB_BUCKET_BITS) + part;
+    }
+
+    std::uint64_t LatencyHistogram::GetBucketLow(const std::uint32_t bucket)
+    {
+        if (bucket < 2 * SUB_BUCKETS) return bucket;
+
+        const std::uint32_t shift = bucket / SUB_BUCKETS - 1;
+        const std::uint64_t part  = bucket % SUB_BUCKETS + SUB_BUCKETS;
+
+        return part << shift;
+    }
+
+    std::uint64_t LatencyHistogram::GetBucketHigh(const std::uint32_t bucket)
+    {
+        if (bucket < 2 * SUB_BUCKETS) return bucket;
+
+        const std::uint32_t shift = bucket / SUB_BUCKETS - 1;
+
+        return GetBucketLow(bucket) + (1ull << shift) - 1;
+    }
+
+    void LatencyStats::Finish(const LatencyProbe& probe, const LatencyProbe::Clock::time_point renderedAt)
+    {
+        if (!this->IsEnabled()) return;
+
+        const bool                            isHooked = probe.HookedAt != LatencyProbe::Clock::time_point{};
+        const LatencyProbe::Clock::time_point origin   = isHooked ? probe.HookedAt : probe.PostedAt;
+
+        if (isHooked) this->Record(probe.Event, LatencyStage::Hook, probe.PostedAt - probe.HookedAt);
+        this->Record(probe.Event, LatencyStage::Queue, probe.StartedAt - probe.PostedAt);
+        this->Record(probe.Event, LatencyStage::Render, renderedAt - probe.StartedAt - probe.Scheduled);
+        this->Record(probe.Event, LatencyStage::Total, renderedAt - origin - probe.Scheduled);
+    }
+
+    void LatencyStats::Record(
+        const std::size_t                   event,
+        const LatencyStage                  stage,
+        const LatencyProbe::Clock::duration latency)
+    {
+        if (event >= MAX_LATENCY_EVENTS || stage >= LatencyStage::Count) return;
+
+        this->Histograms[event][static_cast<std::size_t>(stage)].Record(ToMicros(latency));
+    }
+
+    void LatencyStats::Reset()
+    {
+        for (auto& histograms : this->Histograms)
+        {
+            for (auto& histogram : histograms)
+            {
+                histogram.Reset();
+            }
+        }
+    }
+}
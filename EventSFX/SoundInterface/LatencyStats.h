@@ -0,0 +1,143 @@
+//=======================================================================
+/** LatencyStats.h
+ * How long events take from their hook to their sound's first block
+ */
+//=======================================================================
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace SoundInterface
+{
+    // The legs of a play's way to the mixer
+    enum class LatencyStage
+        : std::uint8_t
+    {
+        Hook = 0, // Hook entry to the command being queued, on the game thread
+        Queue,    // Queued to the voice being started, on the command thread
+        Render,   // Started to its first block being mixed, past the delay it was scheduled with
+        Total,    // Hook entry to the first block, past that delay; from the queueing for plays without a hook
+        Count
+    };
+
+    constexpr std::size_t NUM_LATENCY_STAGES = static_cast<std::size_t>(LatencyStage::Count);
+
+    constexpr const char* GetLatencyStageLabel(const LatencyStage stage)
+    {
+        switch (stage)
+        {
+        case LatencyStage::Hook:
+            return "hook";
+        case LatencyStage::Queue:
+            return "queue";
+        case LatencyStage::Render:
+            return "render";
+        case LatencyStage::Total:
+            return "total";
+        default:
+            return "NA";
+        }
+    }
+
+    // Events beyond this aren't measured
+    constexpr std::size_t MAX_LATENCY_EVENTS = 32;
+
+    /*
+     * Log-linear buckets, as in HdrHistogram: every power of two of
+     * microseconds is split into SUB_BUCKETS even parts, so a value is
+     * never off by more than 1/SUB_BUCKETS of itself, from a microsecond
+     * to some sixteen seconds, in a fixed few KB. Recording is a handful
+     * of relaxed atomics from any thread; reading while it's recorded to
+     * sees each count whole, if not all of them from the same moment.
+     */
+    class LatencyHistogram
+    {
+    public:
+        static constexpr std::uint32_t SUB_BUCKET_BITS = 4;
+        static constexpr std::uint32_t SUB_BUCKETS     = 1u << SUB_BUCKET_BITS;
+        static constexpr std::uint32_t MAX_VALUE_BITS  = 24; // Longer is clamped
+        static constexpr std::uint64_t MAX_VALUE       = (1ull << MAX_VALUE_BITS) - 1;
+        static constexpr std::uint32_t NUM_BUCKETS     = SUB_BUCKETS * (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1);
+
+        struct Summary
+        {
+            std::uint64_t Count = 0;
+            std::uint64_t Min   = 0; // Microseconds, as are the rest
+            std::uint64_t Mean  = 0;
+            std::uint64_t P50   = 0;
+            std::uint64_t P90   = 0;
+            std::uint64_t P99   = 0;
+            std::uint64_t Max   = 0;
+        };
+
+        void Record(std::uint64_t micros);
+        void Reset();
+
+        // The percentiles are their buckets' highest values, so never under the real ones
+        [[nodiscard]] Summary Summarize() const;
+
+        [[nodiscard]] static std::uint32_t GetBucket(std::uint64_t micros);
+        [[nodiscard]] static std::uint64_t GetBucketLow(std::uint32_t bucket);
+        [[nodiscard]] static std::uint64_t GetBucketHigh(std::uint32_t bucket);
+
+    private:
+        std::array<std::atomic<std::uint32_t>, NUM_BUCKETS> Counts{};
+        std::atomic<std::uint64_t>                          Count = 0;
+        std::atomic<std::uint64_t>                          Sum   = 0;
+        std::atomic<std::uint64_t>                          Min   = MAX_VALUE;
+        std::atomic<std::uint64_t>                          Max   = 0;
+    };
+
+    /*
+     * A play's timings, from its hook to its voice; its first block
+     * finishes it. Default time points are stages it didn't go through.
+     */
+    struct LatencyProbe
+    {
+        using Clock = std::chrono::steady_clock;
+
+        Clock::time_point HookedAt;
+        Clock::time_point PostedAt;
+        Clock::time_point StartedAt;
+        Clock::duration   Scheduled{}; // How long after starting it was meant to be heard, which isn't latency
+        std::size_t       Event = 0;
+    };
+
+    /*
+     * A histogram for each stage of each event. Off, it's one relaxed
+     * load per play, and nothing reads the clock for it.
+     */
+    class LatencyStats
+    {
+    public:
+        [[nodiscard]] bool IsEnabled() const
+        {
+            return this->Enabled.load(std::memory_order_relaxed);
+        }
+
+        void SetEnabled(const bool enabled)
+        {
+            this->Enabled.store(enabled, std::memory_order_relaxed);
+        }
+
+        // With the time its first block was mixed at, from the audio thread
+        void Finish(const LatencyProbe& probe, LatencyProbe::Clock::time_point renderedAt);
+
+        void Record(std::size_t event, LatencyStage stage, LatencyProbe::Clock::duration latency);
+        void Reset();
+
+        [[nodiscard]] const LatencyHistogram& Get(std::size_t event, LatencyStage stage) const
+        {
+            return this->Histograms[event][static_cast<std::size_t>(stage)];
+        }
+
+    private:
+        std::array<std::array<LatencyHistogram, NUM_LATENCY_STAGES>, MAX_LATENCY_EVENTS> Histograms;
+        std::atomic<bool>                                                                Enabled = false;
+    };
+}
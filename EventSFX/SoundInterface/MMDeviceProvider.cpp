@@ -0,0 +1,231 @@
+//=======================================================================
+/** MMDeviceProvider.cpp
+ * The system's output devices, through the MMDevice API
+ */
+//=======================================================================
+
+#include "pch.h"
+#include "SoundInterface/MMDeviceProvider.h"
+
+#include <Functiondiscoverykeys_devpkey.h>
+
+namespace
+{
+    Microsoft::WRL::ComPtr<IMMDeviceEnumerator> CreateEnumerator()
+    {
+        Microsoft::WRL::ComPtr<IMMDeviceEnumerator> enumerator;
+
+        const HRESULT hr = CoCreateInstance(
+            __uuidof(MMDeviceEnumerator),
+            nullptr,
+            CLSCTX_ALL,
+            IID_PPV_ARGS(&enumerator));
+        if (FAILED(hr))
+        {
+            DEBUGLOG("COULDN'T CREATE DEVICE ENUMERATOR. HRESULT: {}", hr);
+            return nullptr;
+        }
+
+        return enumerator;
+    }
+}
+
+namespace SoundInterface
+{
+    // Called on the system's threads, so it only passes the news on
+    class MMDeviceProvider::NotificationClient final
+        : public Microsoft::WRL::RuntimeClass<
+            Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::ClassicCom>,
+            IMMNotificationClient>
+    {
+    public:
+        explicit NotificationClient(ChangeHandler onChange)
+            : OnChange(std::move(onChange))
+        {}
+
+        // Nothing is called once this returns
+        void Detach()
+        {
+            const std::lock_guard lock(this->Lock);
+            this->OnChange = nullptr;
+        }
+
+        STDMETHOD(OnDeviceStateChanged)(LPCWSTR, DWORD) override
+        {
+            this->Notify();
+            return S_OK;
+        }
+
+        STDMETHOD(OnDeviceAdded)(LPCWSTR) override
+        {
+            this->Notify();
+            return S_OK;
+        }
+
+        STDMETHOD(OnDeviceRemoved)(LPCWSTR) override
+        {
+            this->Notify();
+            return S_OK;
+        }
+
+        STDMETHOD(OnDefaultDeviceChanged)(const EDataFlow flow, const ERole role, LPCWSTR) override
+        {
+            if (flow == eRender && role == eConsole) this->Notify();
+            return S_OK;
+        }
+
+        STDMETHOD(OnPropertyValueChanged)(LPCWSTR, const PROPERTYKEY key) override
+        {
+            // Only renames show; the rest change all the time
+            if (key.fmtid == PKEY_Device_FriendlyName.fmtid && key.pid == PKEY_Device_FriendlyName.pid)
+            {
+                this->Notify();
+            }
+            return S_OK;
+        }
+
+    private:
+        void Notify()
+        {
+            const std::lock_guard lock(this->Lock);
+            if (this->OnChange) this->OnChange();
+        }
+
+        std::mutex    Lock;
+        ChangeHandler OnChange;
+    };
+
+    // Out here, where the client is complete
+    MMDeviceProvider::MMDeviceProvider() = default;
+
+    MMDeviceProvider::~MMDeviceProvider()
+    {
+        this->Unwatch();
+    }
+
+    Backend::Status MMDeviceProvider::Enumerate(
+        std::vector<AudioDevice>& outDevices,
+        std::wstring&             outDefaultId)
+    {
+        outDevices.clear();
+        outDefaultId.clear();
+
+        const auto enumerator = CreateEnumerator();
+        if (!enumerator) return E_FAIL;
+
+        Microsoft::WRL::ComPtr<IMMDeviceCollection> collection;
+        HRESULT hr = enumerator->EnumAudioEndpoints(eRender, DEVICE_STATE_ACTIVE, &collection);
+        if (FAILED(hr))
+        {
+            DEBUGLOG("COULDN'T ENUMERATE AUDIO ENDPOINTS. HRESULT: {}", hr);
+            return hr;
+        }
+
+        UINT count;
+        hr = collection->GetCount(&count);
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO GET COLLECTION COUNT. HRESULT: {}", hr);
+            return hr;
+        }
+
+        for (UINT i = 0; i < count; ++i)
+        {
+            Microsoft::WRL::ComPtr<IMMDevice> endpoint;
+            hr = collection->Item(i, &endpoint);
+            if (FAILED(hr))
+            {
+                DEBUGLOG("FAILED TO GET COLLECTION ITEM. HRESULT: {}", hr);
+                continue;
+            }
+
+            LPWSTR wstrID = nullptr;
+            hr            = endpoint->GetId(&wstrID);
+            if (FAILED(hr))
+            {
+                DEBUGLOG("FAILED TO GET DEVICE ID. HRESULT: {}", hr);
+                continue;
+            }
+            std::wstring deviceId(wstrID);
+            CoTaskMemFree(wstrID);
+
+            Microsoft::WRL::ComPtr<IPropertyStore> props;
+            hr = endpoint->OpenPropertyStore(STGM_READ, &props);
+            if (FAILED(hr))
+            {
+                DEBUGLOG("FAILED TO OPEN PROPERTY STORE. HRESULT: {}", hr);
+                continue;
+            }
+
+            PROPVARIANT varName;
+            PropVariantInit(&varName);
+            hr = props->GetValue(PKEY_Device_FriendlyName, &varName);
+            if (FAILED(hr))
+            {
+                DEBUGLOG("FAILED TO GET PROP VALUE. HRESULT: {}", hr);
+                continue;
+            }
+
+            AudioDevice device;
+            device.Id   = deviceId;
+            device.Name = varName.pwszVal;
+            outDevices.push_back(device);
+
+            hr = PropVariantClear(&varName);
+            if (FAILED(hr))
+            {
+                DEBUGLOG("FAILED TO CLEAR PROP VARIANT. HRESULT: {}", hr);
+            }
+        }
+
+        // No default just means there's nothing to play on
+        Microsoft::WRL::ComPtr<IMMDevice> defaultEndpoint;
+        if (SUCCEEDED(enumerator->GetDefaultAudioEndpoint(eRender, eConsole, &defaultEndpoint)))
+        {
+            LPWSTR wstrID = nullptr;
+            if (SUCCEEDED(defaultEndpoint->GetId(&wstrID)))
+            {
+                outDefaultId = wstrID;
+                CoTaskMemFree(wstrID);
+            }
+        }
+
+        return S_OK;
+    }
+
+    Backend::Status MMDeviceProvider::Watch(ChangeHandler onChange)
+    {
+        this->Unwatch();
+
+        this->Enumerator = CreateEnumerator();
+        if (!this->Enumerator) return E_FAIL;
+
+        this->Client = Microsoft::WRL::Make<NotificationClient>(std::move(onChange));
+
+        const HRESULT hr = this->Enumerator->RegisterEndpointNotificationCallback(this->Client.Get());
+        if (FAILED(hr))
+        {
+            DEBUGLOG("COULDN'T REGISTER FOR DEVICE NOTIFICATIONS. HRESULT: {}", hr);
+            this->Client.Reset();
+            this->Enumerator.Reset();
+        }
+
+        return hr;
+    }
+
+    void MMDeviceProvider::Unwatch()
+    {
+        if (!this->Client) return;
+
+        const HRESULT hr = this->Enumerator->UnregisterEndpointNotificationCallback(this->Client.Get());
+        if (FAILED(hr))
+        {
+            DEBUGLOG("COULDN'T UNREGISTER FROM DEVICE NOTIFICATIONS. HRESULT: {}", hr);
+        }
+
+        // Waits out a notification already under way
+        this->Client->Detach();
+        this->Client.Reset();
+        this->Enumerator.Reset();
+    }
+}
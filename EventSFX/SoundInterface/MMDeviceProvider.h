@@ -0,0 +1,41 @@
+//=======================================================================
+/** MMDeviceProvider.h
+ * The system's output devices, through the MMDevice API
+ */
+//=======================================================================
+
+#pragma once
+
+#include "SoundInterface/DeviceRegistry.h"
+
+#include <wrl.h>
+#include <mmdeviceapi.h>
+
+namespace SoundInterface
+{
+    /*
+     * Enumerates with a fresh enumerator each time, so it works from
+     * whichever thread refreshes, and keeps one around only to hold the
+     * notification registration. The default is the console role's,
+     * which is what XAudio2 plays on when it isn't given a device.
+     */
+    class MMDeviceProvider final : public DeviceProvider
+    {
+    public:
+        MMDeviceProvider();
+        ~MMDeviceProvider() override;
+
+        Backend::Status Enumerate(
+            std::vector<AudioDevice>& outDevices,
+            std::wstring&             outDefaultId) override;
+
+        Backend::Status Watch(ChangeHandler onChange) override;
+        void            Unwatch() override;
+
+    private:
+        class NotificationClient;
+
+        Microsoft::WRL::ComPtr<IMMDeviceEnumerator> Enumerator;
+        Microsoft::WRL::ComPtr<NotificationClient>  Client;
+    };
+}
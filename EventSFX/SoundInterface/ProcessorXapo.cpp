@@ -0,0 +1,148 @@
+//=======================================================================
+/** ProcessorXapo.cpp
+ * Hosts a portable Dsp::Processor as an XAudio2 effect
+ */
+//=======================================================================
+
+#include "pch.h"
+#include "SoundInterface/ProcessorXapo.h"
+
+namespace
+{
+    constexpr UINT32 COMMON_FLAGS =
+        XAPO_FLAG_FRAMERATE_MUST_MATCH
+        | XAPO_FLAG_BITSPERSAMPLE_MUST_MATCH
+        | XAPO_FLAG_BUFFERCOUNT_MUST_MATCH;
+
+    // Processors that keep the channel count run in place
+    XAPO_REGISTRATION_PROPERTIES InPlaceProperties = {
+        __uuidof(SoundInterface::ProcessorXapo),
+        L"EventSFX Processor",
+        L"",
+        1, 0,
+        COMMON_FLAGS | XAPO_FLAG_CHANNELS_MUST_MATCH | XAPO_FLAG_INPLACE_SUPPORTED,
+        1, 1, 1, 1
+    };
+
+    XAPO_REGISTRATION_PROPERTIES ConvertingProperties = {
+        __uuidof(SoundInterface::ProcessorXapo),
+        L"EventSFX Processor",
+        L"",
+        1, 0,
+        COMMON_FLAGS,
+        1, 1, 1, 1
+    };
+}
+
+namespace SoundInterface
+{
+    ProcessorXapo::ProcessorXapo(
+        const std::shared_ptr<Dsp::Processor>& processor,
+        XAPO_REGISTRATION_PROPERTIES*          properties)
+        : CXAPOBase(properties),
+          Processor(processor)
+    {}
+
+    IUnknown* ProcessorXapo::Create(
+        const std::shared_ptr<Dsp::Processor>& processor,
+        const bool                             changesChannels)
+    {
+        XAPO_REGISTRATION_PROPERTIES* properties = changesChannels
+                                                       ? &ConvertingProperties
+                                                       : &InPlaceProperties;
+
+        // CXAPOBase starts with a reference count of one
+        return static_cast<IXAPO*>(new ProcessorXapo(processor, properties));
+    }
+
+    HRESULT ProcessorXapo::IsOutputFormatSupported(
+        const WAVEFORMATEX* pInputFormat,
+        const WAVEFORMATEX* pRequestedOutputFormat,
+        WAVEFORMATEX**      ppSupportedOutputFormat)
+    {
+        HRESULT hr = CXAPOBase::IsOutputFormatSupported(
+            pInputFormat,
+            pRequestedOutputFormat,
+            ppSupportedOutputFormat);
+        if (FAILED(hr) || hr == XAPO_E_FORMAT_UNSUPPORTED)
+        {
+            return hr;
+        }
+
+        const UINT32 expected = this->Processor->GetOutputChannels(pInputFormat->nChannels);
+        if (pRequestedOutputFormat->nChannels != expected)
+        {
+            if (ppSupportedOutputFormat && *ppSupportedOutputFormat)
+            {
+                (*ppSupportedOutputFormat)->nChannels = static_cast<WORD>(expected);
+            }
+            return XAPO_E_FORMAT_UNSUPPORTED;
+        }
+
+        return hr;
+    }
+
+    HRESULT ProcessorXapo::LockForProcess(
+        const UINT32                                 inputLockedParameterCount,
+        const XAPO_LOCKFORPROCESS_BUFFER_PARAMETERS* pInputLockedParameters,
+        const UINT32                                 outputLockedParameterCount,
+        const XAPO_LOCKFORPROCESS_BUFFER_PARAMETERS* pOutputLockedParameters)
+    {
+        HRESULT hr = CXAPOBase::LockForProcess(
+            inputLockedParameterCount,
+            pInputLockedParameters,
+            outputLockedParameterCount,
+            pOutputLockedParameters);
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO LOCK XAPO FOR PROCESSING. HRESULT: {}", hr);
+            return hr;
+        }
+
+        const WAVEFORMATEX* inputFormat  = pInputLockedParameters[0].pFormat;
+        const WAVEFORMATEX* outputFormat = pOutputLockedParameters[0].pFormat;
+
+        this->InputChannels  = inputFormat->nChannels;
+        this->OutputChannels = outputFormat->nChannels;
+
+        this->Processor->Prepare(
+            inputFormat->nSamplesPerSec,
+            this->InputChannels,
+            pInputLockedParameters[0].MaxFrameCount);
+
+        return hr;
+    }
+
+    void ProcessorXapo::Process(
+        UINT32                                inputProcessParameterCount,
+        const XAPO_PROCESS_BUFFER_PARAMETERS* pInputProcessParameters,
+        UINT32                                outputProcessParameterCount,
+        XAPO_PROCESS_BUFFER_PARAMETERS*       pOutputProcessParameters,
+        const BOOL                            isEnabled)
+    {
+        const auto& input  = pInputProcessParameters[0];
+        auto&       output = pOutputProcessParameters[0];
+
+        const UINT32 frames = input.ValidFrameCount;
+        auto         in     = static_cast<float*>(input.pBuffer);
+        auto         out    = static_cast<float*>(output.pBuffer);
+
+        // Tails (delay lines, reverbs) keep ringing on silent input, so feed them zeros
+        if (input.BufferFlags == XAPO_BUFFER_SILENT)
+        {
+            std::fill_n(in, static_cast<size_t>(frames) * this->InputChannels, 0.0f);
+        }
+
+        if (isEnabled)
+        {
+            this->Processor->Process(in, out, frames);
+        }
+        else if (in != out)
+        {
+            std::fill_n(out, static_cast<size_t>(frames) * this->OutputChannels, 0.0f);
+        }
+
+        output.ValidFrameCount = frames;
+        output.BufferFlags     = XAPO_BUFFER_VALID;
+    }
+}
@@ -0,0 +1,50 @@
+//=======================================================================
+/** ProcessorXapo.h
+ * Hosts a portable Dsp::Processor as an XAudio2 effect
+ */
+//=======================================================================
+
+#pragma once
+
+#include <xapobase.h>
+#pragma comment(lib, "xapobase.lib")
+
+#include "SoundInterface/Dsp/Processor.h"
+
+namespace SoundInterface
+{
+    class __declspec(uuid("6b1f7e8e-3c52-4a0a-9d4e-1f0c2b7a5e31")) ProcessorXapo final
+        : public CXAPOBase
+    {
+    public:
+        // Returns the effect with a reference count of one
+        static IUnknown* Create(const std::shared_ptr<Dsp::Processor>& processor, bool changesChannels = false);
+
+        STDMETHOD(IsOutputFormatSupported)(
+            const WAVEFORMATEX* pInputFormat,
+            const WAVEFORMATEX* pRequestedOutputFormat,
+            WAVEFORMATEX**      ppSupportedOutputFormat) override;
+
+        STDMETHOD(LockForProcess)(
+            UINT32                                       inputLockedParameterCount,
+            const XAPO_LOCKFORPROCESS_BUFFER_PARAMETERS* pInputLockedParameters,
+            UINT32                                       outputLockedParameterCount,
+            const XAPO_LOCKFORPROCESS_BUFFER_PARAMETERS* pOutputLockedParameters) override;
+
+        STDMETHOD_(void, Process)(
+            UINT32                                inputProcessParameterCount,
+            const XAPO_PROCESS_BUFFER_PARAMETERS* pInputProcessParameters,
+            UINT32                                outputProcessParameterCount,
+            XAPO_PROCESS_BUFFER_PARAMETERS*       pOutputProcessParameters,
+            BOOL                                  isEnabled) override;
+
+    private:
+        ProcessorXapo(
+            const std::shared_ptr<Dsp::Processor>& processor,
+            XAPO_REGISTRATION_PROPERTIES*          properties);
+
+        std::shared_ptr<Dsp::Processor> Processor;
+        UINT32                          InputChannels  = 0;
+        UINT32                          OutputChannels = 0;
+    };
+}
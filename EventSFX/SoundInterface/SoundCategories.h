@@ -0,0 +1,45 @@
+//=======================================================================
+/** SoundCategories.h
+ * Submix buses that event sounds are grouped into
+ */
+//=======================================================================
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+constexpr float MIN_CATEGORY_VOLUME = 0.0f;
+constexpr float MAX_CATEGORY_VOLUME = 1.0f;
+
+namespace SoundInterface
+{
+    enum class SoundCategory
+        : std::uint8_t
+    {
+        Impacts = 0,  // Bumps, demos and crossbar hits; ducked by match results
+        PlayerEvents, // Saves and assists
+        MatchResults, // Goals, wins and losses; the ducking key
+        Count
+    };
+
+    constexpr std::size_t NUM_SOUND_CATEGORIES = static_cast<std::size_t>(SoundCategory::Count);
+
+    using CategoryVolumes = std::array<float, NUM_SOUND_CATEGORIES>;
+
+    inline std::string GetSoundCategoryLabel(const SoundCategory category)
+    {
+        switch (category)
+        {
+        case SoundCategory::Impacts:
+            return "impacts";
+        case SoundCategory::PlayerEvents:
+            return "player events";
+        case SoundCategory::MatchResults:
+            return "match results";
+        default:
+            return "NA";
+        }
+    }
+}
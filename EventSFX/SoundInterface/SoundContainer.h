@@ -0,0 +1,134 @@
+//=======================================================================
+/** SoundContainer.h
+ * Picking one of an event's sounds each time it plays
+ */
+//=======================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace SoundInterface
+{
+    enum class SelectionMode
+        : std::uint8_t
+    {
+        Random = 0, // Any of them, repeats and all
+        NoRepeat,   // Any but the last one played
+        RoundRobin, // In the order they were added
+        Shuffle,    // All of them in a random order, then again in another
+        Count
+    };
+
+    constexpr std::size_t NUM_SELECTION_MODES = static_cast<std::size_t>(SelectionMode::Count);
+
+    constexpr const char* GetSelectionModeLabel(const SelectionMode mode)
+    {
+        switch (mode)
+        {
+        case SelectionMode::Random:
+            return "random";
+        case SelectionMode::NoRepeat:
+            return "no-repeat";
+        case SelectionMode::RoundRobin:
+            return "round-robin";
+        case SelectionMode::Shuffle:
+            return "shuffle";
+        default:
+            return "NA";
+        }
+    }
+
+    // One container per event; sounds played outside any event don't pick
+    constexpr std::size_t MAX_SOUND_CONTAINERS = 32;
+
+    /*
+     * Chooses indices into a container of count sounds, in constant time
+     * for every mode. The shuffle bag deals one card per pick, swapping
+     * a random one of those left into place, so it never reshuffles all
+     * at once; its first card is never the one the last bag ended on.
+     * Randomness is passed in, so the caller decides whose generator.
+     */
+    class SoundPicker
+    {
+    public:
+        SoundPicker() = default;
+
+        SoundPicker(const std::size_t count, const SelectionMode mode)
+            : Mode(mode),
+              Order(count)
+        {
+            std::iota(this->Order.begin(), this->Order.end(), 0u);
+        }
+
+        [[nodiscard]] std::size_t GetCount() const
+        {
+            return this->Order.size();
+        }
+
+        // Zero when empty
+        std::size_t Next(const std::uint32_t random)
+        {
+            const auto count = static_cast<std::uint32_t>(this->Order.size());
+            if (count <= 1) return 0;
+
+            std::uint32_t picked = 0;
+            switch (this->Mode)
+            {
+            case SelectionMode::NoRepeat:
+                // One of the others, shifted past the last
+                picked = Below(random, count - 1);
+                if (picked >= this->Last) ++picked;
+                break;
+            case SelectionMode::RoundRobin:
+                picked = this->Last + 1 < count ? this->Last + 1 : 0;
+                if (this->First) picked = 0;
+                break;
+            case SelectionMode::Shuffle:
+            {
+                // A new bag keeps the last card dealt at its front, out of reach of the first deal
+                std::uint32_t card;
+                if (this->Remaining == 0)
+                {
+                    this->Remaining = count;
+                    card            = this->First ? Below(random, count) : 1 + Below(random, count - 1);
+                }
+                else
+                {
+                    card = Below(random, this->Remaining);
+                }
+
+                --this->Remaining;
+                std::swap(this->Order[card], this->Order[this->Remaining]);
+                picked = this->Order[this->Remaining];
+                break;
+            }
+            case SelectionMode::Random:
+            default:
+                picked = Below(random, count);
+                break;
+            }
+
+            this->Last  = picked;
+            this->First = false;
+            return picked;
+        }
+
+    private:
+        // A random number below bound, by multiplying rather than dividing
+        static std::uint32_t Below(const std::uint32_t random, const std::uint32_t bound)
+        {
+            return static_cast<std::uint32_t>((static_cast<std::uint64_t>(random) * bound) >> 32);
+        }
+
+        SelectionMode              Mode = SelectionMode::Random;
+        std::vector<std::uint32_t> Order;         // The shuffle bag, dealt from the back
+        std::uint32_t              Remaining = 0; // Cards left in the bag
+        std::uint32_t              Last      = 0;
+        bool                       First     = true;
+    };
+}
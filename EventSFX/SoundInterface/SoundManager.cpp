@@ -6,12 +6,10 @@
 
 #include "pch.h"
 #include "SoundInterface/SoundManager.h"
+#include "SoundInterface/MMDeviceProvider.h"
+#include "SoundInterface/Backend/XAudio2Backend.h"
 
-#include <xaudio2.h>
-
-#include <wrl.h>
-#include <mmdeviceapi.h>
-#include <Functiondiscoverykeys_devpkey.h>
+#include <bit>
 
 // Converts a sound to mono for easier 3D playback
 template <class T>
@@ -43,82 +41,436 @@ void ConvertAudioFileToMono (std::shared_ptr<AudioFile<T>> audioFile) {
 namespace SoundInterface
 {
     SoundManager::SoundManager()
-        : VoiceManager(*this)
+        : VoiceManager(*this),
+          Devices(std::make_unique<MMDeviceProvider>())
     {}
 
     SoundManager::~SoundManager()
     {
-        if (this->XAudio2)
-        {
-            this->XAudio2->Release();
-            this->XAudio2 = nullptr;
-        }
+        // No more checks from notifications, then nothing left on the worker
+        this->Devices.Stop();
+        this->StopOutputWorker();
+        this->DestroyEngine();
     }
 
-    HRESULT SoundManager::Initialize(std::wstring& outputId, const float volume)
+    HRESULT SoundManager::Initialize(const std::wstring& outputId, const float volume)
     {
+        const std::lock_guard lock(this->StateLock);
+
         // Set output ID
         this->OutputId = outputId;
 
-        // Initialize XAudio2
-        HRESULT hr = XAudio2Create(&this->XAudio2, 0, XAUDIO2_DEFAULT_PROCESSOR);
-        if (FAILED(hr))
+        // From the first engine on, so the default is followed and lost devices fall back
+        if (FAILED(this->Devices.Start([this] { this->RequestDeviceCheck(); })))
         {
-            DEBUGLOG("FAILED TO CREATE XAUDIO2 ENGINE. HRESULT: {}", hr);
-            return hr;
+            DEBUGLOG("NOT WATCHING FOR DEVICE CHANGES.");
         }
 
-        // Consolidate audio device
-        AudioDevice device;
-        this->ConsolidateAudioDevices(device);
-        outputId = device.Id;
+        // Held while the id is in use, so a refresh can't pull it away
+        const DeviceSnapshotPtr devices  = this->Devices.GetSnapshot();
+        const std::wstring&     endpoint = devices->Resolve(this->OutputId);
 
-        const LPCWSTR deviceId = device.Id == LDEFAULT_OUTPUT_DEVICE_ID
-                                     ? nullptr
-                                     : device.Id.c_str();
-
-        // Create the mastering voice
-        hr = XAudio2->CreateMasteringVoice(
-            &this->MasterVoice,
-            XAUDIO2_DEFAULT_CHANNELS,
-            XAUDIO2_DEFAULT_SAMPLERATE,
-            0, deviceId, nullptr,
-            AudioCategory_GameEffects);
+        // Create the engine and its master bus
+        HRESULT hr = Backend::XAudio2Engine::Create(endpoint.empty() ? nullptr : endpoint.c_str(), this->Engine);
         if (FAILED(hr))
         {
-            DEBUGLOG("FAILED TO CREATE MASTERING VOICE. HRESULT: {}", hr);
+            DEBUGLOG("FAILED TO CREATE AUDIO ENGINE. HRESULT: {}", hr);
             return hr;
         }
+        this->ActiveDeviceId = endpoint;
+
+        return this->SetUpEngine(volume);
+    }
 
+    HRESULT SoundManager::SetUpEngine(const float volume)
+    {
         // Set the volume
-        hr = this->MasterVoice->SetVolume(volume);
+        HRESULT hr = this->Engine->GetMaster()->SetVolume(volume);
         if (FAILED(hr))
         {
             DEBUGLOG("FAILED TO SET MASTER VOLUME. HRESULT: {}", hr);
         }
 
         // Initialize 3D Audio
-        DWORD speakers;
-        hr = this->MasterVoice->GetChannelMask(&speakers);
+        const Backend::DeviceFormat& format = this->Engine->GetDeviceFormat();
+        hr = X3DAudioInitialize(format.ChannelMask, X3DAUDIO_SPEED_OF_SOUND, this->X3DAudioHandle);
         if (FAILED(hr))
         {
-            DEBUGLOG("FAILED TO GET CHANNEL MASK. HRESULT: {}", hr);
+            DEBUGLOG("FAILED TO INITIALIZE X3DAUDIO. HRESULT: {}", hr);
             return hr;
         }
-        hr = X3DAudioInitialize(speakers, X3DAUDIO_SPEED_OF_SOUND, this->X3DAudioHandle);
+
+        // Without the limiter, loud moments can clip the device
+        if (FAILED(this->CreateLimiter()))
+        {
+            DEBUGLOG("PLAYING WITHOUT THE LIMITER.");
+        }
+
+        // Without category buses, everything goes straight to the master
+        if (FAILED(this->CreateCategoryBuses()))
+        {
+            DEBUGLOG("PLAYING WITHOUT SOME CATEGORY BUSES.");
+        }
+
+        // Reflections are optional; 3D sounds just play dry without them
+        if (FAILED(this->CreateReflectionsBus()))
+        {
+            DEBUGLOG("PLAYING WITHOUT EARLY REFLECTIONS.");
+        }
+
+        // Same for the effect buses
+        if (FAILED(this->CreateEffectBuses()))
+        {
+            DEBUGLOG("PLAYING WITHOUT SOME EFFECT BUSES.");
+        }
+
+        // Without the ambisonic bus, 3D sounds stay on X3DAudio
+        if (FAILED(this->CreateAmbisonicBus()))
+        {
+            DEBUGLOG("PLAYING WITHOUT AMBISONICS.");
+        }
+
+        return S_OK;
+    }
+
+    HRESULT SoundManager::CreateLimiter()
+    {
+        this->Limiter = std::make_shared<Dsp::Limiter>();
+        this->Limiter->SetParams(globalPluginSettings->Limiter);
+
+        const HRESULT hr = this->Engine->SetMasterEffect(this->Limiter);
         if (FAILED(hr))
         {
-            DEBUGLOG("FAILED TO INITIALIZE X3DAUDIO. HRESULT: {}", hr);
+            DEBUGLOG("FAILED TO SET UP LIMITER. HRESULT: {}", hr);
+            this->Limiter.reset();
+        }
+
+        return hr;
+    }
+
+    HRESULT SoundManager::CreateCategoryBuses()
+    {
+        const Backend::DeviceFormat& format = this->Engine->GetDeviceFormat();
+
+        // The match results bus measures itself for the impacts bus to duck by
+        const auto sidechain = std::make_shared<Dsp::Sidechain>();
+
+        // Key first, so the software mixer runs it before the bus it ducks
+        constexpr std::array order = {
+            SoundCategory::MatchResults,
+            SoundCategory::Impacts,
+            SoundCategory::PlayerEvents
+        };
+
+        HRESULT result = S_OK;
+        for (const SoundCategory category : order)
+        {
+            std::shared_ptr<Dsp::Processor> effect;
+            if (category == SoundCategory::MatchResults)
+            {
+                effect = std::make_shared<Dsp::SidechainKey>(sidechain);
+            }
+            else if (category == SoundCategory::Impacts)
+            {
+                this->Ducker = std::make_shared<Dsp::Ducker>(sidechain);
+                effect       = this->Ducker;
+            }
+
+            const auto    index = static_cast<std::size_t>(category);
+            Backend::Bus* bus   = nullptr;
+
+            HRESULT hr = this->Engine->CreateBus(format.Channels, format.Channels, effect, &bus);
+            if (FAILED(hr))
+            {
+                DEBUGLOG("FAILED TO CREATE {} BUS. HRESULT: {}", GetSoundCategoryLabel(category), hr);
+                if (category == SoundCategory::Impacts) this->Ducker.reset();
+                result = hr;
+                continue;
+            }
+
+            hr = bus->SetVolume(globalPluginSettings->CategoryVolumes[index]);
+            if (FAILED(hr))
+            {
+                DEBUGLOG("FAILED TO SET {} VOLUME. HRESULT: {}", GetSoundCategoryLabel(category), hr);
+            }
+
+            this->CategoryBuses[index] = bus;
+        }
+
+        this->SetDucking(globalPluginSettings->Ducking);
+
+        return result;
+    }
+
+    void SoundManager::DestroyCategoryBuses()
+    {
+        for (auto& bus : this->CategoryBuses)
+        {
+            if (bus)
+            {
+                bus->Destroy();
+                bus = nullptr;
+            }
+        }
+        this->Ducker.reset();
+    }
+
+    Backend::Bus* SoundManager::GetCategoryBus(const SoundCategory category) const
+    {
+        Backend::Bus* bus = this->CategoryBuses[static_cast<std::size_t>(category)];
+        return bus ? bus : this->Engine->GetMaster();
+    }
+
+    HRESULT SoundManager::SetCategoryVolume(const SoundCategory category, const float volume) const
+    {
+        const std::lock_guard lock(this->StateLock);
+
+        Backend::Bus* bus = this->CategoryBuses[static_cast<std::size_t>(category)];
+        if (!bus) return E_FAIL;
+
+        return bus->SetVolume(volume);
+    }
+
+    void SoundManager::SetDucking(const Dsp::DuckingParams& params) const
+    {
+        const std::lock_guard lock(this->StateLock);
+
+        if (this->Ducker) this->Ducker->SetParams(params);
+    }
+
+    float SoundManager::GetDuckingReduction() const
+    {
+        const std::lock_guard lock(this->StateLock);
+
+        return this->Ducker ? this->Ducker->GetGainReduction() : 0.0f;
+    }
+
+    void SoundManager::SetLimiter(const Dsp::LimiterParams& params) const
+    {
+        const std::lock_guard lock(this->StateLock);
+
+        if (this->Limiter) this->Limiter->SetParams(params);
+    }
+
+    float SoundManager::GetLimiterReduction() const
+    {
+        const std::lock_guard lock(this->StateLock);
+
+        return this->Limiter ? this->Limiter->GetGainReduction() : 0.0f;
+    }
+
+    float SoundManager::GetLimiterLatency() const
+    {
+        const std::lock_guard lock(this->StateLock);
+
+        if (!this->Limiter || !this->Engine) return 0.0f;
+
+        const auto sampleRate = static_cast<float>(this->Engine->GetDeviceFormat().SampleRate);
+        return static_cast<float>(this->Limiter->GetLatency()) * 1000.0f / sampleRate;
+    }
+
+    HRESULT SoundManager::CreateEffectBuses()
+    {
+        const Backend::DeviceFormat& format      = this->Engine->GetDeviceFormat();
+        const std::uint32_t          busChannels = format.Channels >= 2 ? 2 : 1;
+
+        HRESULT result = S_OK;
+        for (std::size_t i = 0; i < NUM_EFFECT_BUSES; ++i)
+        {
+            const auto bus = static_cast<EffectBus>(i);
+
+            Backend::Bus* effectBus = nullptr;
+            HRESULT       hr;
+
+            // The convolution reverb is ours; the rest come with the engine
+            if (bus == EffectBus::Convolution)
+            {
+                this->Convolution = std::make_shared<Dsp::ConvolutionReverb>();
+                hr = this->Engine->CreateBus(busChannels, busChannels, this->Convolution, &effectBus);
+            }
+            else
+            {
+                hr = this->Engine->CreateBuiltinBus(bus, &effectBus);
+            }
+
+            if (FAILED(hr))
+            {
+                DEBUGLOG("FAILED TO CREATE {} BUS. HRESULT: {}", GetEffectBusLabel(bus), hr);
+                if (bus == EffectBus::Convolution) this->Convolution.reset();
+                result = hr;
+                continue;
+            }
+
+            this->EffectBuses[i] = effectBus;
+        }
+
+        if (this->Convolution)
+        {
+            const HRESULT hr = this->SetImpulseResponse(globalPluginSettings->ImpulseResponseId);
+            if (FAILED(hr))
+            {
+                DEBUGLOG("FAILED TO SET CONVOLUTION PARAMETERS. HRESULT: {}", hr);
+            }
+        }
+
+        return result;
+    }
+
+    void SoundManager::DestroyEffectBuses()
+    {
+        for (auto& bus : this->EffectBuses)
+        {
+            if (bus)
+            {
+                bus->Destroy();
+                bus = nullptr;
+            }
+        }
+        this->Convolution.reset();
+    }
+
+    HRESULT SoundManager::SetImpulseResponse(const std::string& irId)
+    {
+        const std::lock_guard lock(this->StateLock);
+
+        if (!this->Convolution) return E_FAIL;
+
+        Dsp::ImpulseResponse ir;
+        if (irId.empty())
+        {
+            this->Convolution->SetImpulseResponse(ir);
+            return S_OK;
+        }
+
+        const std::string filePath = Utils::WStringToString(GetSoundFilePath(irId));
+
+        // Keep every channel; the bus maps them onto its own
+        AudioFile irFile;
+        if (!irFile.load(filePath))
+        {
+            DEBUGLOG("FAILED TO LOAD IMPULSE RESPONSE: {}", irId);
+            this->Convolution->SetImpulseResponse(ir);
+            return E_FAIL;
+        }
+
+        ir.SampleRate = irFile.getSampleRate();
+        ir.Channels   = std::move(irFile.samples);
+
+        this->Convolution->SetImpulseResponse(ir);
+        return S_OK;
+    }
+
+    HRESULT SoundManager::CreateReflectionsBus()
+    {
+        const Backend::DeviceFormat& format = this->Engine->GetDeviceFormat();
+
+        // The arena box in X3DAudio space (meters)
+        constexpr float toMeters = 1.0f / 100.0f;
+
+        Dsp::Room room;
+        room.Min = {
+            -Utils::RlValues::MAP_WIDTH / 2.0f * toMeters,
+            0.0f,
+            -Utils::RlValues::MAP_HEIGHT / 2.0f * toMeters
+        };
+        room.Max = {
+            Utils::RlValues::MAP_WIDTH / 2.0f * toMeters,
+            Utils::RlValues::MAP_CEILING * toMeters,
+            Utils::RlValues::MAP_HEIGHT / 2.0f * toMeters
+        };
+
+        this->ImageSources.SetRoom(room);
+        this->ImageSources.SetLayout(Dsp::MakeSpeakerLayout(format.ChannelMask, format.Channels));
+        this->ImageSources.SetDistanceScaler(CURVE_DISTANCE_SCALER);
+
+        this->Reflections = std::make_shared<Dsp::EarlyReflections>();
+
+        // Only 3D sounds are reflected, and those are all impacts
+        const HRESULT hr = this->Engine->CreateBus(
+            format.Channels,
+            format.Channels,
+            this->Reflections,
+            &this->ReflectionsBus,
+            this->CategoryBuses[static_cast<std::size_t>(SoundCategory::Impacts)]);
+
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO CREATE REFLECTIONS BUS. HRESULT: {}", hr);
+            this->ReflectionsBus = nullptr;
+            this->Reflections.reset();
             return hr;
         }
 
         return hr;
     }
 
+    void SoundManager::DestroyReflectionsBus()
+    {
+        if (this->ReflectionsBus)
+        {
+            this->ReflectionsBus->Destroy();
+            this->ReflectionsBus = nullptr;
+        }
+        this->Reflections.reset();
+    }
+
+    HRESULT SoundManager::CreateAmbisonicBus()
+    {
+        const Backend::DeviceFormat& format = this->Engine->GetDeviceFormat();
+
+        this->Ambisonics = std::make_shared<Dsp::AmbisonicDecoder>(
+            Dsp::MakeSpeakerLayout(format.ChannelMask, format.Channels));
+
+        // The bus always carries third order; lower orders leave channels silent
+        const HRESULT hr = this->Engine->CreateBus(
+            Dsp::MAX_AMBISONIC_CHANNELS,
+            format.Channels,
+            this->Ambisonics,
+            &this->AmbisonicBus,
+            this->CategoryBuses[static_cast<std::size_t>(SoundCategory::Impacts)]);
+
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO CREATE AMBISONIC BUS. HRESULT: {}", hr);
+            this->AmbisonicBus = nullptr;
+            this->Ambisonics.reset();
+            return hr;
+        }
+
+        return hr;
+    }
+
+    void SoundManager::DestroyAmbisonicBus()
+    {
+        if (this->AmbisonicBus)
+        {
+            this->AmbisonicBus->Destroy();
+            this->AmbisonicBus = nullptr;
+        }
+        this->Ambisonics.reset();
+    }
+
+    void SoundManager::DestroyEngine()
+    {
+        const std::lock_guard lock(this->StateLock);
+
+        // Voices first, then the buses they send to, then the engine itself
+        this->VoiceManager.Unload();
+        this->DestroyAmbisonicBus();
+        this->DestroyEffectBuses();
+        this->DestroyReflectionsBus();
+        this->DestroyCategoryBuses();
+        this->Engine.reset();
+        this->Limiter.reset();
+    }
+
     void SoundManager::Unload()
     {
-        this->UnloadSounds();
+        const std::lock_guard lock(this->StateLock);
+
+        // Voices read the sounds until they've faded out
         this->VoiceManager.Unload();
+        this->UnloadSounds();
     }
 
     std::vector<std::string> SoundManager::ListSoundFiles()
@@ -144,163 +496,236 @@ namespace SoundInterface
         return soundFiles;
     }
 
-    std::vector<AudioDevice> SoundManager::EnumerateAudioDevices()
+    DeviceSnapshotPtr SoundManager::GetAudioDevices(AudioDevice& outDevice) const
     {
-        std::vector<AudioDevice> devices;
+        const std::lock_guard lock(this->StateLock);
 
-        AudioDevice defaultDevice;
-        defaultDevice.Id   = LDEFAULT_OUTPUT_DEVICE_ID;
-        defaultDevice.Name = LDEFAULT_OUTPUT_DEVICE_NAME;
-        devices.push_back(defaultDevice);
+        DeviceSnapshotPtr  devices = this->Devices.GetSnapshot();
+        const AudioDevice* device  = devices->Find(this->OutputId);
 
-        Microsoft::WRL::ComPtr<IMMDeviceEnumerator> deviceEnumerator;
-        HRESULT                                     hr = CoCreateInstance(
-            __uuidof(MMDeviceEnumerator),
-            nullptr,
-            CLSCTX_ALL,
-            IID_PPV_ARGS(&deviceEnumerator));
-        if (FAILED(hr))
+        outDevice = device ? *device : devices->Devices.front();
+        return devices;
+    }
+
+    HRESULT SoundManager::SetOutputId(const std::wstring& newId)
+    {
         {
-            DEBUGLOG("COULDN'T CREATE DEVICE ENUMERATOR. HRESULT: {}", hr);
-            return devices;
+            const std::lock_guard lock(this->StateLock);
+
+            this->OutputId = newId;
+
+            // Nothing to keep playing, so bring it up here as at startup
+            if (!this->Engine)
+            {
+                return this->Initialize(this->OutputId, this->Volume);
+            }
         }
 
-        Microsoft::WRL::ComPtr<IMMDeviceCollection> collection;
-        hr = deviceEnumerator->EnumAudioEndpoints(eRender, DEVICE_STATE_ACTIVE, &collection);
-        if (FAILED(hr))
         {
-            DEBUGLOG("COULDN'T ENUMERATE AUDIO ENDPOINTS. HRESULT: {}", hr);
-            return devices;
+            const std::lock_guard lock(this->OutputLock);
+
+            this->PendingOutputId = newId;
+            this->StartOutputWorker();
         }
+        this->OutputWake.notify_one();
 
-        UINT count;
-        hr = collection->GetCount(&count);
-        if (FAILED(hr))
+        return S_OK;
+    }
+
+    void SoundManager::RequestDeviceCheck()
+    {
         {
-            DEBUGLOG("FAILED TO GET COLLECTION COUNT. HRESULT: {}", hr);
-            return devices;
+            const std::lock_guard lock(this->OutputLock);
+
+            this->IsDeviceCheckPending = true;
+            this->StartOutputWorker();
         }
+        this->OutputWake.notify_one();
+    }
+
+    void SoundManager::StartOutputWorker()
+    {
+        if (this->IsOutputWorkerRunning) return;
 
-        for (UINT i = 0; i < count; ++i)
+        this->IsOutputWorkerRunning = true;
+        this->OutputWorker          = std::thread([this] { this->RunOutputWorker(); });
+    }
+
+    void SoundManager::RunOutputWorker()
+    {
+        // For enumerating the devices
+        const HRESULT comHr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+        std::unique_lock lock(this->OutputLock);
+        while (true)
         {
-            Microsoft::WRL::ComPtr<IMMDevice> endpoint;
-            hr = collection->Item(i, &endpoint);
-            if (FAILED(hr))
-            {
-                DEBUGLOG("FAILED TO GET COLLECTION ITEM. HRESULT: {}", hr);
-                continue;
-            }
+            this->OutputWake.wait(
+                lock,
+                [this]
+                {
+                    return !this->IsOutputWorkerRunning
+                        || this->PendingOutputId.has_value()
+                        || this->IsDeviceCheckPending;
+                });
+            if (!this->IsOutputWorkerRunning) break;
 
-            LPWSTR wstrID = nullptr;
-            hr            = endpoint->GetId(&wstrID);
-            if (FAILED(hr))
-            {
-                DEBUGLOG("FAILED TO GET DEVICE ID. HRESULT: {}", hr);
-                continue;
-            }
-            std::wstring deviceId(wstrID);
-            CoTaskMemFree(wstrID);
+            const std::optional<std::wstring> outputId     = std::exchange(this->PendingOutputId, std::nullopt);
+            const bool                        checkDevices = std::exchange(this->IsDeviceCheckPending, false);
 
-            Microsoft::WRL::ComPtr<IPropertyStore> props;
-            hr = endpoint->OpenPropertyStore(STGM_READ, &props);
-            if (FAILED(hr))
+            lock.unlock();
+
+            // Before switching, so a switch sees the devices as they are now
+            if (checkDevices) this->Devices.Refresh();
+
+            HRESULT hr = S_OK;
+            if (outputId.has_value())
             {
-                DEBUGLOG("FAILED TO OPEN PROPERTY STORE. HRESULT: {}", hr);
-                continue;
+                hr = this->SwitchOutput(outputId.value());
             }
-
-            PROPVARIANT varName;
-            PropVariantInit(&varName);
-            hr = props->GetValue(PKEY_Device_FriendlyName, &varName);
-            if (FAILED(hr))
+            else if (checkDevices)
             {
-                DEBUGLOG("FAILED TO GET PROP VALUE. HRESULT: {}", hr);
-                continue;
+                hr = this->FollowDevices();
             }
-
-            AudioDevice device;
-            device.Id   = deviceId;
-            device.Name = varName.pwszVal;
-            devices.push_back(device);
-
-            hr = PropVariantClear(&varName);
             if (FAILED(hr))
             {
-                DEBUGLOG("FAILED TO CLEAR PROP VARIANT. HRESULT: {}", hr);
+                DEBUGLOG("FAILED TO SWITCH OUTPUT DEVICE. HRESULT: {}", hr);
             }
+
+            lock.lock();
         }
 
-        return devices;
+        if (SUCCEEDED(comHr)) CoUninitialize();
     }
 
-    std::vector<AudioDevice> SoundManager::ConsolidateAudioDevices(
-        AudioDevice& outDevice,
-        const bool   shouldSetOutput)
+    void SoundManager::StopOutputWorker()
     {
-        std::vector<AudioDevice> devices = this->EnumerateAudioDevices();
+        {
+            const std::lock_guard lock(this->OutputLock);
 
-        const auto it = std::ranges::find_if(
-            devices,
-            [this](const AudioDevice& device)
-            {
-                return device.Id == this->OutputId;
-            });
+            // A switch in progress finishes first
+            this->IsOutputWorkerRunning = false;
+            this->PendingOutputId.reset();
+            this->IsDeviceCheckPending = false;
+        }
+        this->OutputWake.notify_one();
+
+        if (this->OutputWorker.joinable()) this->OutputWorker.join();
+    }
 
-        std::wstring deviceId   = LDEFAULT_OUTPUT_DEVICE_ID;
-        std::wstring deviceName = LDEFAULT_OUTPUT_DEVICE_NAME;
+    HRESULT SoundManager::SwitchOutput(const std::wstring& outputId)
+    {
+        const DeviceSnapshotPtr devices  = this->Devices.GetSnapshot();
+        const std::wstring&     endpoint = devices->Resolve(outputId);
 
-        if (it != devices.end())
+        // Opening the device is the slow part, so the old one plays on meanwhile
+        std::unique_ptr<Backend::Engine> engine;
+        HRESULT hr = Backend::XAudio2Engine::Create(endpoint.empty() ? nullptr : endpoint.c_str(), engine);
+        if (FAILED(hr))
         {
-            deviceId   = it->Id;
-            deviceName = it->Name;
+            DEBUGLOG("FAILED TO CREATE AUDIO ENGINE. HRESULT: {}", hr);
+            return hr;
         }
-        else
+
         {
-            this->OutputId = deviceId;
+            // Another device was picked meanwhile, which is switched to next instead
+            const std::lock_guard lock(this->OutputLock);
+            if (this->PendingOutputId.has_value()) return S_FALSE;
+        }
 
-            if (shouldSetOutput)
+        RetiredOutput retired;
+        {
+            const std::lock_guard lock(this->StateLock);
+
+            // Dropped in the meantime, by unloading
+            if (!this->Engine) return S_FALSE;
+
+            // Starts fading out what's playing on the old device, from its next pass
+            const PoolShape shape = this->VoiceManager.GetPoolShape();
+            retired.Voices        = this->VoiceManager.Retire();
+
+            // Carries the clock on from where the old engine's is now
+            const std::uint64_t oldClock = this->ClockOffset + this->Engine->GetSampleClock();
+            const std::uint64_t newClock = engine->GetSampleClock();
+            this->ClockOffset            = oldClock > newClock ? oldClock - newClock : 0;
+
+            retired.Engine         = std::exchange(this->Engine, std::move(engine));
+            retired.CategoryBuses  = std::exchange(this->CategoryBuses, {});
+            retired.ReflectionsBus = std::exchange(this->ReflectionsBus, nullptr);
+            retired.EffectBuses    = std::exchange(this->EffectBuses, {});
+            retired.AmbisonicBus   = std::exchange(this->AmbisonicBus, nullptr);
+            retired.Ducker         = std::move(this->Ducker);
+            retired.Limiter        = std::move(this->Limiter);
+            retired.Reflections    = std::move(this->Reflections);
+            retired.Convolution    = std::move(this->Convolution);
+            retired.Ambisonics     = std::move(this->Ambisonics);
+
+            this->ActiveDeviceId = endpoint;
+
+            hr = this->SetUpEngine(this->Volume);
+            if (FAILED(hr))
             {
-                DEBUGLOG("STORED OUTPUT DEVICE NOT FOUND. RESETTING..");
-                HRESULT hr = this->SetOutputId(LDEFAULT_OUTPUT_DEVICE_ID);
-                if (FAILED(hr))
-                {
-                    DEBUGLOG("FAILED TO SET OUTPUT DEVICE. HRESULT: {}", hr);
-                }
+                DEBUGLOG("FAILED TO SET UP AUDIO ENGINE. HRESULT: {}", hr);
             }
+
+            // As many voices as there were, so the first plays don't have to create them
+            this->VoiceManager.Prewarm(shape);
         }
 
-        outDevice.Id   = deviceId;
-        outDevice.Name = deviceName;
+        // The old voices fade out on the old device as new plays start on this one
+        if (retired.Voices.IsReleasing)
+        {
+            const auto fade = std::chrono::duration<float>(Dsp::STOP_FADE.Seconds + UNLOAD_FADE_MARGIN);
+            std::this_thread::sleep_for(fade);
+        }
 
-        return devices;
+        return hr;
     }
 
-    HRESULT SoundManager::SetOutputId(const std::wstring& newId)
+    SoundManager::RetiredOutput::~RetiredOutput()
     {
-        this->OutputId = newId;
+        // Voices first, then the buses they send to, then the engine itself
+        this->Voices.Destroy();
 
-        // Destroy previous stuff, if any
-        // this->Unload();
-        this->VoiceManager.Unload();
-        if (this->MasterVoice)
+        const auto destroy = [](Backend::Bus*& bus)
         {
-            this->MasterVoice->DestroyVoice();
-            this->MasterVoice = nullptr;
-        }
-        if (this->XAudio2)
+            if (bus)
+            {
+                bus->Destroy();
+                bus = nullptr;
+            }
+        };
+
+        destroy(this->AmbisonicBus);
+        std::ranges::for_each(this->EffectBuses, destroy);
+        destroy(this->ReflectionsBus);
+        std::ranges::for_each(this->CategoryBuses, destroy);
+        this->Engine.reset();
+    }
+
+    HRESULT SoundManager::FollowDevices()
+    {
+        std::wstring outputId;
         {
-            this->XAudio2->Release();
-            this->XAudio2 = nullptr;
+            const std::lock_guard lock(this->StateLock);
+
+            if (!this->Engine) return S_FALSE;
+
+            const DeviceSnapshotPtr devices = this->Devices.GetSnapshot();
+            if (devices->Resolve(this->OutputId) == this->ActiveDeviceId) return S_FALSE;
+
+            outputId = this->OutputId;
         }
 
-        // Re-initialize
-        return this->Initialize(this->OutputId, this->Volume);
+        DEBUGLOG("OUTPUT DEVICE CHANGED. SWITCHING..");
+        return this->SwitchOutput(outputId);
     }
 
     HRESULT SoundManager::LoadSound(
         const std::string& soundId,
         const bool         force)
     {
+        const std::lock_guard lock(this->StateLock);
+
         constexpr HRESULT hr = S_OK;
 
         if (!force && this->LoadedSounds.contains(soundId))
@@ -328,34 +753,205 @@ namespace SoundInterface
         return hr;
     }
 
-    HRESULT SoundManager::PlaySound(
-        const std::string&    soundId,
-        const PlaybackParams& params,
-        const float           volume)
+    AudioFilePtr SoundManager::GetSound(const std::string& soundId)
     {
-        HRESULT hr = this->LoadSound(soundId);
+        const std::lock_guard lock(this->StateLock);
+
+        const HRESULT hr = this->LoadSound(soundId);
         if (FAILED(hr))
         {
             DEBUGLOG("FAILED TO LOAD SOUND: HRESULT: {}", hr);
+            return nullptr;
+        }
+
+        return this->LoadedSounds[soundId];
+    }
+
+    HRESULT SoundManager::LoadContainer(
+        const std::size_t                 containerId,
+        const std::vector<VelocityLayer>& layers,
+        const SelectionMode               mode,
+        const float                       crossfade)
+    {
+        const std::lock_guard lock(this->StateLock);
+
+        if (containerId >= MAX_SOUND_CONTAINERS) return E_INVALIDARG;
+
+        // Sorted here so the layers line up with the map's thresholds
+        std::vector<const VelocityLayer*> sorted;
+        for (const VelocityLayer& layer : layers)
+        {
+            if (sorted.size() == MAX_VELOCITY_LAYERS) break;
+            sorted.push_back(&layer);
+        }
+        std::ranges::stable_sort(sorted, {}, &VelocityLayer::MinSpeed);
+
+        HRESULT            result = S_OK;
+        LoadedContainer    container;
+        std::vector<float> thresholds;
+        for (const VelocityLayer* layer : sorted)
+        {
+            LoadedLayer loaded;
+            for (const std::string& soundId : layer->SoundIds)
+            {
+                const HRESULT hr = this->LoadSound(soundId);
+                if (FAILED(hr))
+                {
+                    DEBUGLOG("FAILED TO LOAD CONTAINER SOUND ({}). HRESULT: {}", soundId, hr);
+                    result = hr;
+                    continue;
+                }
+
+                loaded.Sounds.push_back(this->LoadedSounds[soundId]);
+            }
+
+            loaded.Picker = SoundPicker(loaded.Sounds.size(), mode);
+            container.Layers.push_back(std::move(loaded));
+            thresholds.push_back(layer->MinSpeed);
+        }
+
+        container.Map                 = VelocityLayerMap(thresholds, crossfade);
+        this->Containers[containerId] = std::move(container);
+        return result;
+    }
+
+    PickedSounds SoundManager::PickSounds(const std::size_t containerId, const float speed, const std::uint32_t random)
+    {
+        const std::lock_guard lock(this->StateLock);
+
+        PickedSounds picked;
+        if (containerId >= MAX_SOUND_CONTAINERS) return picked;
+
+        LoadedContainer& container = this->Containers[containerId];
+        if (container.Layers.empty()) return picked;
+
+        const LayerBlend blend = container.Map.Find(speed);
+        for (std::size_t i = 0; i < picked.size(); ++i)
+        {
+            if (blend.Gains[i] <= 0.0f) continue;
+
+            // The halves of one number, so the two layers don't pick in lockstep
+            LoadedLayer& layer = container.Layers[blend.Layers[i]];
+            if (layer.Sounds.empty()) continue;
+
+            picked[i] = {layer.Sounds[layer.Picker.Next(std::rotl(random, static_cast<int>(i) * 16))], blend.Gains[i]};
+        }
+
+        return picked;
+    }
+
+    HRESULT SoundManager::PlaySound(
+        const AudioFilePtr&        sound,
+        const PlaybackParams&      params,
+        const float                volume,
+        const SendLevels&          sends,
+        const Dsp::DistanceLutPtr& distance,
+        const SoundCategory        category,
+        const std::uint64_t        startFrame,
+        const X3DAUDIO_VEC_ROT*    listener,
+        const VoiceGroup&          group,
+        const float                pitch,
+        const LatencyProbe*        probe)
+    {
+        if (!sound) return E_INVALIDARG;
+
+        return this->PlaySounds({PickedSound{sound, 1.0f}}, params, volume, sends, distance, category, startFrame, listener, group, pitch, probe);
+    }
+
+    HRESULT SoundManager::PlaySounds(
+        const PickedSounds&        picked,
+        const PlaybackParams&      params,
+        const float                volume,
+        const SendLevels&          sends,
+        const Dsp::DistanceLutPtr& distance,
+        const SoundCategory        category,
+        const std::uint64_t        startFrame,
+        const X3DAUDIO_VEC_ROT*    listener,
+        const VoiceGroup&          group,
+        const float                pitch,
+        const LatencyProbe*        probe)
+    {
+        const std::lock_guard lock(this->StateLock);
+
+        // The louder layer is what the play sounds like, for weighing it against the group's others
+        float gain = 0.0f;
+        for (const auto& [sound, layerGain] : picked)
+        {
+            if (sound) gain = std::max(gain, layerGain);
+        }
+        if (gain <= 0.0f) return E_INVALIDARG;
+
+        // Cull far sounds before taking a voice
+        if (params.has_value() && distance)
+        {
+            const auto& [location, fromMenu] = params.value();
+            if (!SourceVoiceManager::IsAudible(location, fromMenu, *distance, listener))
+            {
+                return S_FALSE;
+            }
+        }
+
+        // How loud it'll be where it's heard
+        float loudness = volume * gain;
+        if (params.has_value() && distance && group.Id < MAX_VOICE_GROUPS)
+        {
+            const auto& [location, fromMenu] = params.value();
+            loudness *= SourceVoiceManager::GetDistanceGain(location, fromMenu, *distance, listener);
+        }
+
+        // Make way for it within its group's limit, or don't play it; once for both layers, which are one instance
+        Dsp::Fade attack;
+        HRESULT   hr = this->VoiceManager.MakeRoom(group, loudness, attack);
+        if (hr != S_OK)
+        {
+            if (FAILED(hr))
+            {
+                DEBUGLOG("FAILED TO MAKE ROOM IN VOICE GROUP. HRESULT: {}", hr);
+            }
             return hr;
         }
 
-        const AudioFilePtr audioFile = this->LoadedSounds[soundId];
+        // The first voice that starts is the one counted, and the other layer goes along with it
+        VoiceIndex counted = NO_VOICE;
+        for (const auto& [sound, layerGain] : picked)
+        {
+            if (!sound) continue;
+
+            VoiceIndex sourceVoiceIndex = NO_VOICE;
+            hr = this->StartVoice(sound, params, volume * layerGain, sends, distance, category, startFrame, listener, pitch, probe, attack, sourceVoiceIndex);
+            if (FAILED(hr)) continue;
+
+            this->VoiceManager.Track(sourceVoiceIndex, group, volume * layerGain, loudness, counted);
+            if (counted == NO_VOICE) counted = sourceVoiceIndex;
+            probe = nullptr;
+        }
+
+        return counted != NO_VOICE ? S_OK : hr;
+    }
 
-        WAVEFORMATEX wfx    = {};
-        wfx.wFormatTag      = WAVE_FORMAT_IEEE_FLOAT;
-        wfx.nChannels       = audioFile->getNumChannels();
-        wfx.nSamplesPerSec  = audioFile->getSampleRate();
-        wfx.wBitsPerSample  = sizeof(float) * 8;
-        wfx.nBlockAlign     = (wfx.nChannels * wfx.wBitsPerSample) / 8;
-        wfx.nAvgBytesPerSec = wfx.nSamplesPerSec * wfx.nBlockAlign;
+    HRESULT SoundManager::StartVoice(
+        const AudioFilePtr&        sound,
+        const PlaybackParams&      params,
+        const float                volume,
+        const SendLevels&          sends,
+        const Dsp::DistanceLutPtr& distance,
+        const SoundCategory        category,
+        const std::uint64_t        startFrame,
+        const X3DAUDIO_VEC_ROT*    listener,
+        const float                pitch,
+        const LatencyProbe*        probe,
+        const Dsp::Fade&           attack,
+        VoiceIndex&                outIndex)
+    {
+        Backend::VoiceFormat format;
+        format.SampleRate = sound->getSampleRate();
+        format.Channels   = sound->getNumChannels();
 
-        XAUDIO2_BUFFER buffer = {};
-        buffer.AudioBytes     = audioFile->getNumSamplesPerChannel() * wfx.nBlockAlign;
-        buffer.pAudioData     = reinterpret_cast<const BYTE*>(audioFile->samples[0].data());
-        buffer.Flags          = XAUDIO2_END_OF_STREAM;
+        Backend::VoiceBuffer buffer;
+        buffer.Samples = sound->samples[0].data();
+        buffer.Frames  = sound->getNumSamplesPerChannel();
 
-        IXAudio2SourceVoice* sourceVoice;
+        Backend::Voice* sourceVoice;
         try
         {
             if (params.has_value())
@@ -363,11 +959,11 @@ namespace SoundInterface
                 auto& location = params.value().first;
                 auto& fromMenu = params.value().second;
 
-                sourceVoice    = VoiceManager.GetReadySourceVoice(&wfx, location, fromMenu);
+                sourceVoice    = VoiceManager.GetReadySourceVoice(format, category, location, distance, fromMenu, listener, &outIndex);
             }
             else
             {
-                sourceVoice = VoiceManager.GetReadySourceVoice(&wfx);
+                sourceVoice = VoiceManager.GetReadySourceVoice(format, category, &outIndex);
             }
         }
         catch (HRESULT thrownHr)
@@ -377,53 +973,105 @@ namespace SoundInterface
         }
 
         // Set the volume of source voice
-        hr = sourceVoice->SetVolume(2 * volume);
+        HRESULT hr = sourceVoice->SetVolume(2 * volume);
 
         if (FAILED(hr))
         {
             DEBUGLOG("FAILED TO SET SOURCE VOICE VOLUME. HRESULT: {}", hr);
         }
 
+        // Same for the pitch
+        hr = sourceVoice->SetFrequencyRatio(pitch);
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO SET SOURCE VOICE PITCH. HRESULT: {}", hr);
+        }
+
+        // Set the effect sends, as reused voices keep the previous ones
+        hr = this->VoiceManager.SetEffectSends(sourceVoice, sends);
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO SET EFFECT SENDS. HRESULT: {}", hr);
+        }
+
         // Submit the buffer
-        hr = sourceVoice->SubmitSourceBuffer(&buffer);
+        hr = sourceVoice->Submit(buffer);
         if (FAILED(hr))
         {
             DEBUGLOG("FAILED TO SUBMIT SOURCE BUFFER. HRESULT: {}", hr);
             return hr;
         }
 
-        // Play the sound
-        hr = sourceVoice->Start(0);
+        // Play the sound, at the exact frame when it's scheduled, on the current engine's clock
+        const std::uint64_t engineFrame = startFrame > this->ClockOffset ? startFrame - this->ClockOffset : 0;
+
+        // How far ahead it's scheduled is the event's delay, not latency
+        if (probe)
+        {
+            const std::uint64_t clock      = this->Engine->GetSampleClock();
+            const auto          sampleRate = static_cast<double>(this->Engine->GetDeviceFormat().SampleRate);
+
+            LatencyProbe started = *probe;
+            started.StartedAt    = LatencyProbe::Clock::now();
+            started.Scheduled    = std::chrono::duration_cast<LatencyProbe::Clock::duration>(
+                std::chrono::duration<double>(engineFrame > clock ? static_cast<double>(engineFrame - clock) / sampleRate : 0.0));
+            this->VoiceManager.Probe(outIndex, started);
+        }
+
+        hr = sourceVoice->Start(engineFrame, attack);
         if (FAILED(hr))
         {
             DEBUGLOG("FAILED TO START SOURCE VOICE. HRESULT: {}", hr);
-            return hr;
         }
 
         return hr;
     }
 
+    std::uint64_t SoundManager::GetStartFrame(const float delaySeconds) const
+    {
+        const std::lock_guard lock(this->StateLock);
+
+        if (!this->Engine) return 0;
+
+        const auto sampleRate = static_cast<float>(this->Engine->GetDeviceFormat().SampleRate);
+        const auto delay      = static_cast<std::uint64_t>(std::lround(std::max(delaySeconds, 0.0f) * sampleRate));
+
+        return this->ClockOffset + this->Engine->GetSampleClock() + delay;
+    }
+
     void SoundManager::PreloadSounds()
     {
-        // Unload previous sounds
-        this->UnloadSounds();
+        const std::lock_guard lock(this->StateLock);
+
+        // Containers let go of their sounds; those still used are taken again rather than read back in
+        this->Containers.fill({});
 
-        // Load all current sounds
-        for (auto& sound : globalPluginSettings->Sounds)
+        // Load every event's sounds as a group
+        for (std::size_t i = 0; i < globalPluginSettings->Sounds.size(); ++i)
         {
-            const std::string& soundId = sound.SoundId;
+            const SoundSettings& sound = globalPluginSettings->Sounds[i];
 
-            HRESULT hr = this->LoadSound(soundId, true);
+            HRESULT hr = this->LoadContainer(i, sound.GetLayers(), sound.Selection, sound.LayerCrossfade);
             if (FAILED(hr))
             {
-                DEBUGLOG("FAILED TO PRELOAD SOUND ({}). HRESULT: {}", soundId, hr);
+                DEBUGLOG("FAILED TO PRELOAD SOUNDS FOR EVENT {}. HRESULT: {}", i, hr);
             }
         }
+
+        // And whatever no event uses anymore goes
+        std::erase_if(
+            this->LoadedSounds,
+            [](const auto& entry)
+            {
+                return entry.second.use_count() == 1;
+            });
     }
 
     HRESULT SoundManager::SetVolume(const float newVolume)
     {
-        HRESULT hr = this->MasterVoice->SetVolume(newVolume);
+        const std::lock_guard lock(this->StateLock);
+
+        HRESULT hr = this->Engine->GetMaster()->SetVolume(newVolume);
         if (FAILED(hr))
         {
             DEBUGLOG("COULDN'T SET THE VOLUME. {}", hr);
@@ -438,6 +1086,9 @@ namespace SoundInterface
 
     inline void SoundManager::UnloadSounds()
     {
+        const std::lock_guard lock(this->StateLock);
+
         this->LoadedSounds.clear();
+        this->Containers.fill({});
     }
 }
@@ -7,21 +7,26 @@
 #pragma once
 
 #include "SoundInterface/SourceVoiceManager.h"
+#include "SoundInterface/DeviceRegistry.h"
+#include "SoundInterface/Backend/AudioBackend.h"
+#include "SoundInterface/EffectBuses.h"
+#include "SoundInterface/SoundCategories.h"
+#include "SoundInterface/SoundContainer.h"
+#include "SoundInterface/VelocityLayers.h"
+#include "SoundInterface/Dsp/EarlyReflections.h"
+#include "SoundInterface/Dsp/ConvolutionReverb.h"
+#include "SoundInterface/Dsp/Ambisonics.h"
+#include "SoundInterface/Dsp/Ducking.h"
+#include "SoundInterface/Dsp/Limiter.h"
 #include "AudioFile/AudioFile.h"
 
-#define DEFAULT_OUTPUT_DEVICE_NAME     "Default"
-#define DEFAULT_OUTPUT_DEVICE_ID       "default"
-#define LDEFAULT_OUTPUT_DEVICE_NAME   L"Default"
-#define LDEFAULT_OUTPUT_DEVICE_ID     L"default"
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
 
 namespace SoundInterface
 {
-    struct AudioDevice
-    {
-        std::wstring Id;
-        std::wstring Name;
-    };
-
     static inline LPCWSTR GetSoundsFolder()
     {
         return (globalGameWrapper->GetDataFolder() / "EventSFX").c_str();
@@ -38,6 +43,15 @@ namespace SoundInterface
     using SoundMap       = std::unordered_map<std::string, AudioFilePtr>;
     using PlaybackParams = std::optional<std::pair<Vector, bool>>;
 
+    // What a container gave for one play; the second sound is null unless it's between two layers
+    struct PickedSound
+    {
+        AudioFilePtr Sound;
+        float        Gain = 1.0f;
+    };
+
+    using PickedSounds = std::array<PickedSound, 2>;
+
     class SoundManager
     {
         friend class SourceVoiceManager;
@@ -46,24 +60,75 @@ namespace SoundInterface
         SoundManager();
         ~SoundManager();
 
-        HRESULT Initialize(std::wstring& outputId, float volume);
+        // A chosen device that's gone plays on the default until it's back
+        HRESULT Initialize(const std::wstring& outputId, float volume);
 
         HRESULT LoadSound(
             const std::string& soundId,
             bool               force = false);
 
+        // Loads the sound if it isn't yet; null if it can't be
+        [[nodiscard]] AudioFilePtr GetSound(const std::string& soundId);
+
+        // Loads all of the layers' sounds up front, replacing what the container held; those that fail are left out
+        HRESULT LoadContainer(
+            std::size_t                       containerId,
+            const std::vector<VelocityLayer>& layers,
+            SelectionMode                     mode,
+            float                             crossfade = 0.0f);
+
+        // The next sound of the layer for the speed, by its mode, without loading or looking up anything
+        [[nodiscard]] PickedSounds PickSounds(std::size_t containerId, float speed, std::uint32_t random);
+
+        // Returns S_FALSE without playing when a 3D sound is past its curve's cutoff
         HRESULT PlaySound(
-            const std::string&    soundId,
-            const PlaybackParams& params = std::nullopt, // For 3D playback
-            float                 volume = 1.0f);
+            const AudioFilePtr&        sound,
+            const PlaybackParams&      params     = std::nullopt, // For 3D playback
+            float                      volume     = 1.0f,
+            const SendLevels&          sends      = {},
+            const Dsp::DistanceLutPtr& distance   = nullptr,
+            SoundCategory              category   = SoundCategory::PlayerEvents,
+            std::uint64_t              startFrame = 0,        // From GetStartFrame, 0 for now
+            const X3DAUDIO_VEC_ROT*    listener   = nullptr,  // Where it was heard from; null reads the camera
+            const VoiceGroup&          group      = {},       // Also S_FALSE when its group is full and won't give way
+            float                      pitch      = 1.0f,     // As a frequency ratio
+            const LatencyProbe*        probe      = nullptr); // Finished on the sound's first block
+
+        // Both sounds of a play between two velocity layers, at their gains, as one instance of the group
+        HRESULT PlaySounds(
+            const PickedSounds&        picked,
+            const PlaybackParams&      params     = std::nullopt,
+            float                      volume     = 1.0f,
+            const SendLevels&          sends      = {},
+            const Dsp::DistanceLutPtr& distance   = nullptr,
+            SoundCategory              category   = SoundCategory::PlayerEvents,
+            std::uint64_t              startFrame = 0,
+            const X3DAUDIO_VEC_ROT*    listener   = nullptr,
+            const VoiceGroup&          group      = {},
+            float                      pitch      = 1.0f,
+            const LatencyProbe*        probe      = nullptr); // Finished on the first sound's first block
+
+        // Timings from the hooks to the first blocks, while they're enabled
+        [[nodiscard]] LatencyStats& GetLatencyStats()
+        {
+            return this->Latency;
+        }
+
+        // The sample clock time the given delay from now, for PlaySound; it carries on across device switches
+        [[nodiscard]] std::uint64_t GetStartFrame(float delaySeconds) const;
+
+        // Empty id or a missing file silences the convolution bus
+        HRESULT SetImpulseResponse(const std::string& irId);
 
         double GetSoundDuration(const std::string& soundId)
         {
+            const std::lock_guard lock(this->StateLock);
             return this->LoadedSounds[soundId]->getLengthInSeconds();
         }
 
-        void Update3D() const
+        void Update3D()
         {
+            const std::lock_guard lock(this->StateLock);
             this->VoiceManager.Update3D();
         }
 
@@ -73,22 +138,155 @@ namespace SoundInterface
         void Unload();
 
         HRESULT SetVolume(float newVolume);
+        HRESULT SetCategoryVolume(SoundCategory category, float volume) const;
+
+        // Of the impacts bus, by the match results bus
+        void                SetDucking(const Dsp::DuckingParams& params) const;
+        [[nodiscard]] float GetDuckingReduction() const;
+
+        // True-peak limiter on the master
+        void                SetLimiter(const Dsp::LimiterParams& params) const;
+        [[nodiscard]] float GetLimiterReduction() const;
+        [[nodiscard]] float GetLimiterLatency() const; // Milliseconds
 
         static std::vector<std::string> ListSoundFiles();
-        static std::vector<AudioDevice> EnumerateAudioDevices();
-        std::vector<AudioDevice>        ConsolidateAudioDevices(
-            AudioDevice& outDevice,
-            bool         shouldSetOutput = false);
+        // The devices as last seen, and the one played on: the chosen one, or the default while it's gone
+        [[nodiscard]] DeviceSnapshotPtr GetAudioDevices(AudioDevice& outDevice) const;
 
+        /*
+         * Switches devices in the background, keeping the loaded sounds.
+         * The old device plays on until the new one is up, and what was
+         * playing on it fades out as new plays start on the new one. Only
+         * fails when there's no engine yet and bringing one up does.
+         */
         HRESULT SetOutputId(const std::wstring& newId);
 
     private:
-        std::wstring            OutputId = LDEFAULT_OUTPUT_DEVICE_ID;
-        float                   Volume   = 1.0;
-        SourceVoiceManager      VoiceManager;
-        IXAudio2*               XAudio2     = nullptr;
-        IXAudio2MasteringVoice* MasterVoice = nullptr;
-        X3DAUDIO_HANDLE         X3DAudioHandle;
-        SoundMap                LoadedSounds;
+        // Everything of a device that's been switched away from, destroyed voices first
+        struct RetiredOutput
+        {
+            RetiredVoices                                   Voices;
+            std::unique_ptr<Backend::Engine>                Engine;
+            std::array<Backend::Bus*, NUM_SOUND_CATEGORIES> CategoryBuses{};
+            Backend::Bus*                                   ReflectionsBus = nullptr;
+            std::array<Backend::Bus*, NUM_EFFECT_BUSES>     EffectBuses{};
+            Backend::Bus*                                   AmbisonicBus = nullptr;
+
+            // The buses' effects, which their XAPOs don't outlive
+            std::shared_ptr<Dsp::Ducker>            Ducker;
+            std::shared_ptr<Dsp::Limiter>           Limiter;
+            std::shared_ptr<Dsp::EarlyReflections>  Reflections;
+            std::shared_ptr<Dsp::ConvolutionReverb> Convolution;
+            std::shared_ptr<Dsp::AmbisonicDecoder>  Ambisonics;
+
+            ~RetiredOutput();
+        };
+
+        // Sets up and starts a voice for the sound, with the group's room already made; under StateLock
+        HRESULT StartVoice(
+            const AudioFilePtr&        sound,
+            const PlaybackParams&      params,
+            float                      volume,
+            const SendLevels&          sends,
+            const Dsp::DistanceLutPtr& distance,
+            SoundCategory              category,
+            std::uint64_t              startFrame,
+            const X3DAUDIO_VEC_ROT*    listener,
+            float                      pitch,
+            const LatencyProbe*        probe,
+            const Dsp::Fade&           attack,
+            VoiceIndex&                outIndex);
+
+        // The shared buses and 3D setup on a just created engine
+        HRESULT SetUpEngine(float volume);
+
+        // On the output worker; the old device stays as is when the new one can't be opened
+        HRESULT SwitchOutput(const std::wstring& outputId);
+        void    RunOutputWorker();
+        void    StartOutputWorker(); // With OutputLock held
+        void    StopOutputWorker();
+
+        // From device notifications, which can't wait on the refresh
+        void RequestDeviceCheck();
+
+        // Follows the default, falls back to it when the chosen device goes, and back when it returns
+        HRESULT FollowDevices();
+
+        HRESULT CreateLimiter();
+        HRESULT CreateCategoryBuses();
+        void    DestroyCategoryBuses();
+        HRESULT CreateReflectionsBus();
+        void    DestroyReflectionsBus();
+        HRESULT CreateEffectBuses();
+        void    DestroyEffectBuses();
+        HRESULT CreateAmbisonicBus();
+        void    DestroyAmbisonicBus();
+        void    DestroyEngine();
+
+        // The bus a category's direct sound goes to, the master if it has none
+        [[nodiscard]] Backend::Bus* GetCategoryBus(SoundCategory category) const;
+
+        // Sounds, voices and the engine's lifetime; plays come from the command thread
+        mutable std::recursive_mutex StateLock;
+
+        // Finished from the voices' callbacks, so it's there for as long as they are
+        LatencyStats Latency;
+
+        std::wstring                     OutputId = LDEFAULT_OUTPUT_DEVICE_ID; // As chosen
+        std::wstring                     ActiveDeviceId;                       // The endpoint the engine is on
+        float                            Volume   = 1.0;
+        SourceVoiceManager               VoiceManager;
+        std::unique_ptr<Backend::Engine> Engine;
+        X3DAUDIO_HANDLE                  X3DAudioHandle;
+        SoundMap                         LoadedSounds;
+
+        // GetStartFrame's clock at the current engine's zero, so scheduled plays survive a switch
+        std::uint64_t ClockOffset = 0;
+
+        // Opens new devices off every other thread; only the latest request is acted on
+        std::thread                 OutputWorker;
+        std::mutex                  OutputLock;
+        std::condition_variable     OutputWake;
+        std::optional<std::wstring> PendingOutputId;
+        bool                        IsDeviceCheckPending  = false;
+        bool                        IsOutputWorkerRunning = false;
+
+        // Enumerated once, then again on the worker when the system says something changed
+        DeviceRegistry Devices;
+
+        struct LoadedLayer
+        {
+            std::vector<AudioFilePtr> Sounds;
+            SoundPicker               Picker;
+        };
+
+        struct LoadedContainer
+        {
+            std::vector<LoadedLayer> Layers; // Softest first, matching Map
+            VelocityLayerMap         Map;
+        };
+
+        // One per event, holding on to its sounds so plays never look them up by name
+        std::array<LoadedContainer, MAX_SOUND_CONTAINERS> Containers;
+
+        // Submixes that the direct sound goes through, by event category
+        std::array<Backend::Bus*, NUM_SOUND_CATEGORIES> CategoryBuses{};
+        std::shared_ptr<Dsp::Ducker>                    Ducker;
+
+        // Last thing before the device, always in the path
+        std::shared_ptr<Dsp::Limiter> Limiter;
+
+        // Early reflections, shared by all 3D voices and returned through the impacts bus
+        Backend::Bus*                          ReflectionsBus = nullptr;
+        std::shared_ptr<Dsp::EarlyReflections> Reflections;
+        Dsp::ImageSourceModel                  ImageSources;
+
+        // Send/return effects, one instance each
+        std::array<Backend::Bus*, NUM_EFFECT_BUSES> EffectBuses{};
+        std::shared_ptr<Dsp::ConvolutionReverb>     Convolution;
+
+        // B-format bus that 3D voices are encoded into when ambisonics is on, also returned through the impacts bus
+        Backend::Bus*                          AmbisonicBus = nullptr;
+        std::shared_ptr<Dsp::AmbisonicDecoder> Ambisonics;
     };
 }
@@ -8,6 +8,7 @@
 #include "SoundInterface/SourceVoiceManager.h"
 
 #include <ranges>
+#include <thread>
 
 #include "SoundInterface/SoundManager.h"
 
@@ -44,6 +45,18 @@ namespace
         return {result.X, result.Y, result.Z};
     }
 
+    float GetDistance(const X3DAUDIO_VECTOR& from, const X3DAUDIO_VECTOR& to)
+    {
+        const float dx = to.x - from.x;
+        const float dy = to.y - from.y;
+        const float dz = to.z - from.z;
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    // Attenuation comes from the event's own curve, so X3DAudio only pans
+    X3DAUDIO_DISTANCE_CURVE_POINT FlatCurvePoints[] = {{0.0f, 1.0f}, {1.0f, 1.0f}};
+    X3DAUDIO_DISTANCE_CURVE       FlatCurve         = {FlatCurvePoints, 2};
+
     X3DAUDIO_ROTATION
     RotatorToX3DAudioRotation(const Rotator& rotation)
     {
@@ -66,76 +79,73 @@ namespace
 namespace SoundInterface
 {
     class SourceVoiceCallback final
-        : public IXAudio2VoiceCallback
+        : public Backend::VoiceCallback
     {
     public:
         SourceVoiceCallback(
-            const VoiceIndex    index,
-            const ReadyQuePtr&  readyIndices,
-            const ActiveMapPtr& activeIndices)
+            const VoiceIndex index,
+            EndedQue&        endedVoices,
+            LatencyStats&    latency)
             : Index(index),
-              ReadyIndices(readyIndices),
-              ActiveIndices(activeIndices)
+              EndedVoices(endedVoices),
+              Latency(latency)
         {}
 
-        void OnStreamEnd() override
+        // Before the voice starts; a probe left over from a voice stopped before its first block is replaced
+        void Arm(const LatencyProbe& probe)
         {
-            this->ReadyIndices->push_back(this->Index);
-            this->ActiveIndices->erase(this->Index);
+            this->IsArmed.store(false, std::memory_order_relaxed);
+            this->Probe = probe;
+            this->IsArmed.store(true, std::memory_order_release);
         }
 
-        // Inherited via IXAudio2VoiceCallback
-        void OnVoiceProcessingPassStart(UINT32 bytesRequired) override
-        {}
-
-        void OnVoiceProcessingPassEnd() override
-        {}
-
-        void OnBufferStart(void* pBufferContext) override
-        {}
-
-        void OnBufferEnd(void* pBufferContext) override
-        {}
+        // The first block of a measured play finishes its probe; the rest cost a load
+        void OnBufferStart() override
+        {
+            if (!this->IsArmed.load(std::memory_order_relaxed)) return;
+            if (!this->IsArmed.exchange(false, std::memory_order_acquire)) return;
 
-        void OnLoopEnd(void* pBufferContext) override
-        {}
+            this->Latency.Finish(this->Probe, LatencyProbe::Clock::now());
+        }
 
-        void OnVoiceError(void* pBufferContext, HRESULT error) override
-        {}
+        // On the audio thread, so only posts; the manager does the bookkeeping
+        void OnStreamEnd() override
+        {
+            this->EndedVoices.TryPush(this->Index);
+        }
 
     private:
-        VoiceIndex   Index;
-        ReadyQuePtr  ReadyIndices;
-        ActiveMapPtr ActiveIndices;
+        VoiceIndex        Index;
+        EndedQue&         EndedVoices; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+        LatencyStats&     Latency;     // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+        LatencyProbe      Probe;
+        std::atomic<bool> IsArmed = false;
     };
 
     SourceVoiceManager::SourceVoiceManager(SoundManager& soundManager)
         : Manager(soundManager),
-          ActiveIndices(std::make_shared<ActiveMap>())
+          ActiveIndices(std::make_shared<ActiveMap>()),
+          EndedVoices(std::make_unique<EndedQue>()),
+          DefaultDistance(std::make_shared<const Dsp::DistanceLut>(Dsp::DistanceCurve{}))
     {}
 
     VoiceIndex SourceVoiceManager::GetReadySourceVoiceIndex(
-        const WAVEFORMATEX* wfx)
+        const Backend::VoiceFormat& format)
     {
         HRESULT hr = S_OK;
 
-        // Construct the key from the provided WAVEFORMATEX
-        const AudioFormatKey key = {
-            wfx->nChannels,
-            wfx->nSamplesPerSec,
-            wfx->wBitsPerSample
-        };
+        this->CollectEndedVoices();
 
         // Check if there's already a deque for this format, if not, create one
-        if (!this->ReadyIndexQues.contains(key))
+        if (!this->ReadyIndexQues.contains(format))
         {
-            this->ReadyIndexQues[key] = std::make_shared<ReadyQue>();
+            this->ReadyIndexQues[format] = std::make_shared<ReadyQue>();
         }
 
         VoiceIndex sourceVoiceIndex;
 
         // Check the deque to see if there's a voice ready to be reused
-        if (const auto& readyIndices = this->ReadyIndexQues[key]; readyIndices->empty())
+        if (const auto& readyIndices = this->ReadyIndexQues[format]; readyIndices->empty())
         {
             // Need to create a new source voice
             sourceVoiceIndex = static_cast<VoiceIndex>(this->SourceVoices.size());
@@ -144,61 +154,58 @@ namespace SoundInterface
             auto callback =
                 new SourceVoiceCallback(
                     sourceVoiceIndex,
-                    readyIndices,
-                    this->ActiveIndices);
-
-            /*
-            // Setup reverb effect
-            XAUDIO2_EFFECT_CHAIN effects;
-            IUnknown* pReverbEffect = nullptr;
-
-            // Create the reverb effect
-            HRESULT hr = XAudio2CreateReverb(&pReverbEffect, 0);
-            if (FAILED(hr)) {
-                DEBUGLOG("COULD NOT CREATE REVERB EFFECT. HRESULT: {}", hr);
-                return hr;
-            }
+                    *this->EndedVoices,
+                    this->Manager.Latency);
 
-            // Prepare the effect descriptor
-            XAUDIO2_EFFECT_DESCRIPTOR effectDesc;
-            effectDesc.InitialState = true;
-            effectDesc.OutputChannels = wfx->Channels;  // Match the channel layout of the source
-            effectDesc.pEffect = pReverbEffect;
+            // Send to the master bus and whichever shared buses exist
+            Backend::Engine& engine = *this->Manager.Engine;
 
-            // Prepare the effect chain
-            XAUDIO2_EFFECT_CHAIN effectChain;
-            effectChain.EffectCount = 1;
-            effectChain.pEffectDescriptors = &effectDesc;
-            */
+            std::array<Backend::Bus*, 3 + NUM_SOUND_CATEGORIES + NUM_EFFECT_BUSES> sends;
+            std::uint32_t                                                          sendCount = 0;
+
+            sends[sendCount++] = engine.GetMaster();
+            for (const auto categoryBus : this->Manager.CategoryBuses)
+            {
+                if (categoryBus) sends[sendCount++] = categoryBus;
+            }
+            if (this->Manager.ReflectionsBus)
+            {
+                sends[sendCount++] = this->Manager.ReflectionsBus;
+            }
+            for (const auto effectBus : this->Manager.EffectBuses)
+            {
+                if (effectBus) sends[sendCount++] = effectBus;
+            }
+            if (this->Manager.AmbisonicBus)
+            {
+                sends[sendCount++] = this->Manager.AmbisonicBus;
+            }
 
             // Create the new voice
-            IXAudio2SourceVoice* sourceVoice;
-            hr = this->Manager.XAudio2->CreateSourceVoice(
-                &sourceVoice, wfx, 0,
-                XAUDIO2_DEFAULT_FREQ_RATIO,
-                callback); // , nullptr, & effectChain);
+            Backend::Voice* sourceVoice;
+            hr = engine.CreateVoice(format, callback, sends.data(), sendCount, &sourceVoice);
 
             if (FAILED(hr))
             {
                 DEBUGLOG("FAILED TO CREATE SOURCE VOICE. HRESULT: {}", hr);
-                // pReverbEffect->Release();
                 delete callback;
                 throw hr;
             }
 
             // Define new output matrix
-            XAUDIO2_VOICE_DETAILS details;
-            this->Manager.MasterVoice->GetVoiceDetails(&details);
-
             OutputMatrix outputMatrix;
-            outputMatrix.Size = details.InputChannels * XAUDIO2_NUM_SRC_CHANNELS;
-            outputMatrix.Data = new FLOAT32[outputMatrix.Size];
+            outputMatrix.Size = engine.GetDeviceFormat().Channels * XAUDIO2_NUM_SRC_CHANNELS;
+            outputMatrix.Data = new float[outputMatrix.Size];
+
+            // Set on first play; until then every send has its default levels
+            outputMatrix.Destination = nullptr;
 
             // Store the new source voice and callback
             this->SourceVoiceCallbacks.emplace_back(callback);
             this->SourceVoices.push_back(sourceVoice);
             this->OutputMatrices.push_back(outputMatrix);
-            // this->voiceEffects.push_back(pReverbEffect);
+            this->VoiceReadyQues.push_back(readyIndices);
+            this->Links.emplace_back();
         }
         else
         {
@@ -210,37 +217,70 @@ namespace SoundInterface
         return sourceVoiceIndex;
     }
 
-    IXAudio2SourceVoice* SourceVoiceManager::GetReadySourceVoice(
-        const WAVEFORMATEX* wfx,
-        const Vector&       location,
-        const bool          fromMenu)
+    Backend::Voice* SourceVoiceManager::GetReadySourceVoice(
+        const Backend::VoiceFormat& format,
+        const SoundCategory         category,
+        const Vector&               location,
+        const Dsp::DistanceLutPtr&  distance,
+        const bool                  fromMenu,
+        const X3DAUDIO_VEC_ROT*     listener,
+        VoiceIndex*                 outIndex)
     {
-        const auto  readyIndex   = this->GetReadySourceVoiceIndex(wfx);
+        const auto  readyIndex   = this->GetReadySourceVoiceIndex(format);
+        if (outIndex) *outIndex  = readyIndex;
         const auto  sourceVoice  = this->SourceVoices[readyIndex];
         const auto& outputMatrix = this->OutputMatrices[readyIndex];
 
+        HRESULT hr = this->SetCategory(readyIndex, category);
+        if (FAILED(hr))
+        {
+            DEBUGLOG("COULD NOT SET CATEGORY. HRESULT: {}", hr);
+        }
+
         // Set initial 3D stuff?
         const auto emitterLocation = VectorToX3DAudioVector(location);
-        const auto listenerInfo    = GetListenerInfo(fromMenu);
+        const auto listenerInfo    = listener ? *listener : GetListenerInfo(fromMenu);
 
-        HRESULT hr = this->Apply3D(sourceVoice, outputMatrix, emitterLocation, listenerInfo);
+        this->UpdateDecoder();
+
+        const Dsp::DistanceLutPtr& curve        = distance ? distance : this->DefaultDistance;
+        const float                distanceGain = curve->Evaluate(GetDistance(listenerInfo.first, emitterLocation));
+
+        hr = this->Apply3D(sourceVoice, outputMatrix, emitterLocation, listenerInfo, distanceGain);
         if (FAILED(hr))
         {
             DEBUGLOG("COULD NOT APPLY 3D. HRESULT: {}", hr);
         }
 
+        // Feed the shared reflections bus
+        const bool reflectionsEnabled = globalPluginSettings->ReflectionsEnabled;
+        hr = SetSendLevel(
+            sourceVoice,
+            this->Manager.ReflectionsBus,
+            reflectionsEnabled ? 1.0f : 0.0f);
+        if (FAILED(hr))
+        {
+            DEBUGLOG("COULD NOT SET REFLECTIONS SEND. HRESULT: {}", hr);
+        }
+
         if (!fromMenu)
         {
-            (*this->ActiveIndices)[readyIndex] = emitterLocation;
+            (*this->ActiveIndices)[readyIndex] = {emitterLocation, curve};
+            this->UpdateReflections(listenerInfo);
+        }
+        else
+        {
+            // Previews use a stationary listener, so only this emitter counts
+            this->UpdateReflections(listenerInfo, &emitterLocation);
         }
 
 #if DEBUG_LOG
         voice_index readies = 0;
         for (const auto& entry : this->readyIndexQues) {
-            const AudioFormatKey& key = entry.first;
+            const Backend::VoiceFormat& key = entry.first;
             const std::shared_ptr<std::deque<voice_index>>& readyIndices = entry.second;
 
-            DEBUGLOG("{} {} {} <- Audio format key", key.Channels, key.SamplesPerSec, key.BitsPerSample);
+            DEBUGLOG("{} {} <- Audio format key", key.Channels, key.SampleRate);
             DEBUGLOG("{} <- Num ready source voices at key", readyIndices->size());
             readies += readyIndices->size();
         }
@@ -260,10 +300,40 @@ namespace SoundInterface
         return sourceVoice;
     }
 
+    HRESULT SourceVoiceManager::SetCategory(
+        const VoiceIndex    sourceVoiceIndex,
+        const SoundCategory category)
+    {
+        const auto    sourceVoice  = this->SourceVoices[sourceVoiceIndex];
+        auto&         outputMatrix = this->OutputMatrices[sourceVoiceIndex];
+        Backend::Bus* destination  = this->Manager.GetCategoryBus(category);
+
+        if (outputMatrix.Destination == destination) return S_OK;
+        outputMatrix.Destination = destination;
+
+        // Silence the direct path everywhere else; the caller sets this one
+        HRESULT result = S_OK;
+        auto    silence = [&](Backend::Bus* bus)
+        {
+            if (bus == destination) return;
+
+            const HRESULT hr = SetSendLevel(sourceVoice, bus, 0.0f);
+            if (FAILED(hr)) result = hr;
+        };
+
+        silence(this->Manager.Engine->GetMaster());
+        for (const auto categoryBus : this->Manager.CategoryBuses)
+        {
+            silence(categoryBus);
+        }
+
+        return result;
+    }
+
     HRESULT SourceVoiceManager::ResetOutputMatrix(const VoiceIndex sourceVoiceIndex) const
     {
-        const auto  sourceVoice  = this->SourceVoices[sourceVoiceIndex];
-        const auto& [size, data] = this->OutputMatrices[sourceVoiceIndex];
+        const auto  sourceVoice               = this->SourceVoices[sourceVoiceIndex];
+        const auto& [size, data, destination] = this->OutputMatrices[sourceVoiceIndex];
 
         for (int i = 0; i < size; i++)
         {
@@ -271,7 +341,7 @@ namespace SoundInterface
         }
 
         HRESULT hr = sourceVoice->SetOutputMatrix(
-            this->Manager.MasterVoice,
+            destination,
             XAUDIO2_NUM_SRC_CHANNELS,
             size,
             data
@@ -280,11 +350,88 @@ namespace SoundInterface
         if (FAILED(hr))
         {
             DEBUGLOG("FAILED TO RESET OUTPUT MATRIX. HRESULT: {}", hr);
+            return hr;
+        }
+
+        // 2D sounds get no early reflections and skip the ambisonic bus
+        hr = SetSendLevel(sourceVoice, this->Manager.AmbisonicBus, 0.0f);
+        if (FAILED(hr)) return hr;
+
+        return SetSendLevel(sourceVoice, this->Manager.ReflectionsBus, 0.0f);
+    }
+
+    HRESULT SourceVoiceManager::SetEffectSends(
+        Backend::Voice*   sourceVoice,
+        const SendLevels& sends) const
+    {
+        HRESULT result = S_OK;
+        for (std::size_t i = 0; i < NUM_EFFECT_BUSES; ++i)
+        {
+            const float   level = std::clamp(sends[i], MIN_SEND_LEVEL, MAX_SEND_LEVEL);
+            const HRESULT hr    = SetSendLevel(sourceVoice, this->Manager.EffectBuses[i], level);
+            if (FAILED(hr)) result = hr;
+        }
+
+        return result;
+    }
+
+    HRESULT SourceVoiceManager::SetSendLevel(
+        Backend::Voice* sourceVoice,
+        Backend::Bus*   destination,
+        const float     level)
+    {
+        if (!destination) return S_OK;
+
+        // The mono source feeds every input channel of the bus equally
+        std::array<float, Backend::MAX_BUS_CHANNELS> levels;
+        levels.fill(level);
+
+        HRESULT hr = sourceVoice->SetOutputMatrix(
+            destination,
+            XAUDIO2_NUM_SRC_CHANNELS,
+            destination->GetInputChannels(),
+            levels.data()
+        );
+
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO SET SEND LEVEL. HRESULT: {}", hr);
         }
 
         return hr;
     }
 
+    bool SourceVoiceManager::IsAudible(
+        const Vector&           location,
+        const bool              fromMenu,
+        const Dsp::DistanceLut& distance,
+        const X3DAUDIO_VEC_ROT* listener)
+    {
+        const X3DAUDIO_VECTOR  emitterLocation = VectorToX3DAudioVector(location);
+        const X3DAUDIO_VEC_ROT listenerInfo    = listener ? *listener : GetListenerInfo(fromMenu);
+
+        return distance.IsAudible(GetDistance(listenerInfo.first, emitterLocation));
+    }
+
+    float SourceVoiceManager::GetListenerDistance(
+        const Vector&           location,
+        const X3DAUDIO_VEC_ROT& listener)
+    {
+        return GetDistance(listener.first, VectorToX3DAudioVector(location));
+    }
+
+    float SourceVoiceManager::GetDistanceGain(
+        const Vector&           location,
+        const bool              fromMenu,
+        const Dsp::DistanceLut& distance,
+        const X3DAUDIO_VEC_ROT* listener)
+    {
+        const X3DAUDIO_VECTOR  emitterLocation = VectorToX3DAudioVector(location);
+        const X3DAUDIO_VEC_ROT listenerInfo    = listener ? *listener : GetListenerInfo(fromMenu);
+
+        return distance.Evaluate(GetDistance(listenerInfo.first, emitterLocation));
+    }
+
     X3DAUDIO_VEC_ROT SourceVoiceManager::GetListenerInfo(const bool isStationary)
     {
         Vector  listenerLocation = {0, 0, globalCameraInfo->Height};
@@ -308,15 +455,25 @@ namespace SoundInterface
     }
 
     HRESULT SourceVoiceManager::Apply3D(
-        IXAudio2SourceVoice*    sourceVoice,
+        Backend::Voice*         sourceVoice,
         const OutputMatrix&     outputMatrix,
         const X3DAUDIO_VECTOR&  emitterLocation,
-        const X3DAUDIO_VEC_ROT& listenerInfo) const
+        const X3DAUDIO_VEC_ROT& listenerInfo,
+        const float             distanceGain) const
     {
+        if (this->IsAmbisonic())
+        {
+            std::array<float, Dsp::MAX_AMBISONIC_CHANNELS> gains;
+            EncodeEmitters(&emitterLocation, &distanceGain, 1, listenerInfo, gains.data());
+
+            return this->SetAmbisonicGains(sourceVoice, outputMatrix, gains.data(), 1);
+        }
+
         X3DAUDIO_EMITTER emitter    = {};
         emitter.Position            = emitterLocation;
         emitter.ChannelCount        = XAUDIO2_NUM_SRC_CHANNELS;
-        emitter.CurveDistanceScaler = 4.0f;
+        emitter.CurveDistanceScaler = CURVE_DISTANCE_SCALER;
+        emitter.pVolumeCurve        = &FlatCurve;
 
         X3DAUDIO_LISTENER listener = {};
         listener.Position          = listenerInfo.first;
@@ -345,8 +502,13 @@ namespace SoundInterface
             &dspSettings
         );
 
+        for (UINT32 i = 0; i < dspSettings.DstChannelCount; ++i)
+        {
+            dspSettings.pMatrixCoefficients[i] *= distanceGain;
+        }
+
         HRESULT hr = sourceVoice->SetOutputMatrix(
-            this->Manager.MasterVoice,
+            outputMatrix.Destination,
             dspSettings.SrcChannelCount,
             dspSettings.DstChannelCount,
             dspSettings.pMatrixCoefficients
@@ -355,42 +517,484 @@ namespace SoundInterface
         if (FAILED(hr))
         {
             DEBUGLOG("FAILED TO SET OUTPUT MATRIX. HRESULT: {}", hr);
+            return hr;
         }
 
-        return hr;
+        // In case the voice was last played through the ambisonic bus
+        return SetSendLevel(sourceVoice, this->Manager.AmbisonicBus, 0.0f);
     }
 
-    void SourceVoiceManager::Update3D() const
+    void SourceVoiceManager::Update3D()
     {
+        this->CollectEndedVoices();
+
         if (this->ActiveIndices->empty()) return;
 
         const X3DAUDIO_VEC_ROT listenerInfo = GetListenerInfo();
 
+        this->UpdateDecoder();
+
+        // Gather the emitters, then attenuate them all by table lookups
+        const std::size_t count = this->ActiveIndices->size();
+
+        std::vector<VoiceIndex>              indices;
+        std::vector<X3DAUDIO_VECTOR>         locations;
+        std::vector<const Dsp::DistanceLut*> curves;
+        indices.reserve(count);
+        locations.reserve(count);
+        curves.reserve(count);
+        for (const auto& [index, voice] : *this->ActiveIndices)
+        {
+            indices.push_back(index);
+            locations.push_back(voice.Location);
+            curves.push_back(voice.Distance.get());
+        }
+
+        std::vector<float> distanceGains(count);
+        for (std::size_t e = 0; e < count; ++e)
+        {
+            distanceGains[e] = GetDistance(listenerInfo.first, locations[e]);
+        }
+        for (std::size_t e = 0; e < count; ++e)
+        {
+            distanceGains[e] = curves[e]->Evaluate(distanceGains[e]);
+        }
+
+        // So stealing the quietest goes by how loud they are now
+        for (std::size_t e = 0; e < count; ++e)
+        {
+            VoiceLink& link = this->Links[indices[e]];
+            link.Loudness   = link.Volume * distanceGains[e];
+        }
+
         HRESULT hr = S_OK;
-        for (const auto& [index, location] : *this->ActiveIndices)
+        if (this->IsAmbisonic())
+        {
+            // Encode every active emitter in one pass, channel-major
+            std::vector<float> gains(Dsp::MAX_AMBISONIC_CHANNELS * count);
+            EncodeEmitters(locations.data(), distanceGains.data(), count, listenerInfo, gains.data());
+
+            for (std::size_t e = 0; e < count; ++e)
+            {
+                hr = this->SetAmbisonicGains(
+                    this->SourceVoices[indices[e]],
+                    this->OutputMatrices[indices[e]],
+                    gains.data() + e,
+                    count);
+                if (FAILED(hr))
+                {
+                    DEBUGLOG("FAILED TO APPLY AMBISONICS. HRESULT: {}", hr);
+                }
+            }
+
+            this->UpdateReflections(listenerInfo);
+            return;
+        }
+
+        for (std::size_t e = 0; e < count; ++e)
         {
-            IXAudio2SourceVoice* sourceVoice  = this->SourceVoices[index];
-            OutputMatrix         outputMatrix = this->OutputMatrices[index];
+            Backend::Voice* sourceVoice  = this->SourceVoices[indices[e]];
+            OutputMatrix    outputMatrix = this->OutputMatrices[indices[e]];
 
-            hr = this->Apply3D(sourceVoice, outputMatrix, location, listenerInfo);
+            hr = this->Apply3D(sourceVoice, outputMatrix, locations[e], listenerInfo, distanceGains[e]);
             if (FAILED(hr))
             {
                 DEBUGLOG("FAILED TO APPLY 3D. HRESULT: {}", hr);
             }
         }
+
+        this->UpdateReflections(listenerInfo);
+    }
+
+    bool SourceVoiceManager::IsAmbisonic() const
+    {
+        return this->Manager.AmbisonicBus && globalPluginSettings->AmbisonicOrder > 0;
+    }
+
+    void SourceVoiceManager::EncodeEmitters(
+        const X3DAUDIO_VECTOR*  locations,
+        const float*            distanceGains,
+        const std::size_t       count,
+        const X3DAUDIO_VEC_ROT& listenerInfo,
+        float*                  outGains)
+    {
+        const auto& [position, rotation] = listenerInfo;
+        const auto& [front, top]         = rotation;
+
+        // Right-pointing axis of the listener, in X3DAudio's left-handed space
+        const X3DAUDIO_VECTOR right = {
+            top.y * front.z - top.z * front.y,
+            top.z * front.x - top.x * front.z,
+            top.x * front.y - top.y * front.x
+        };
+
+        std::vector<float> x(count);
+        std::vector<float> y(count);
+        std::vector<float> z(count);
+        for (std::size_t e = 0; e < count; ++e)
+        {
+            const float dx = locations[e].x - position.x;
+            const float dy = locations[e].y - position.y;
+            const float dz = locations[e].z - position.z;
+
+            // Ambisonic axes: X to the front, Y to the left, Z up
+            x[e] = dx * front.x + dy * front.y + dz * front.z;
+            y[e] = -(dx * right.x + dy * right.y + dz * right.z);
+            z[e] = dx * top.x + dy * top.y + dz * top.z;
+        }
+
+        Dsp::EncodeAmbisonics(
+            x.data(), y.data(), z.data(), distanceGains,
+            count,
+            std::min<std::uint32_t>(globalPluginSettings->AmbisonicOrder, Dsp::MAX_AMBISONIC_ORDER),
+            outGains,
+            count);
+    }
+
+    HRESULT SourceVoiceManager::SetAmbisonicGains(
+        Backend::Voice*     sourceVoice,
+        const OutputMatrix& outputMatrix,
+        const float*        gains,
+        const std::size_t   stride) const
+    {
+        std::array<float, Dsp::MAX_AMBISONIC_CHANNELS> levels;
+        for (std::size_t n = 0; n < levels.size(); ++n)
+        {
+            levels[n] = gains[n * stride];
+        }
+
+        HRESULT hr = sourceVoice->SetOutputMatrix(
+            this->Manager.AmbisonicBus,
+            XAUDIO2_NUM_SRC_CHANNELS,
+            Dsp::MAX_AMBISONIC_CHANNELS,
+            levels.data()
+        );
+
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO SET AMBISONIC GAINS. HRESULT: {}", hr);
+            return hr;
+        }
+
+        // The decoder does the panning, so the direct path stays silent
+        std::fill_n(outputMatrix.Data, outputMatrix.Size, 0.0f);
+
+        hr = sourceVoice->SetOutputMatrix(
+            outputMatrix.Destination,
+            XAUDIO2_NUM_SRC_CHANNELS,
+            outputMatrix.Size,
+            outputMatrix.Data
+        );
+
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO SET OUTPUT MATRIX. HRESULT: {}", hr);
+        }
+
+        return hr;
+    }
+
+    void SourceVoiceManager::UpdateDecoder() const
+    {
+        if (!this->Manager.Ambisonics) return;
+
+        Dsp::AmbisonicParams params;
+        params.Order    = std::clamp<std::uint32_t>(globalPluginSettings->AmbisonicOrder, 1, Dsp::MAX_AMBISONIC_ORDER);
+        params.Binaural = globalPluginSettings->BinauralEnabled;
+
+        this->Manager.Ambisonics->SetParams(params);
+    }
+
+    void SourceVoiceManager::UpdateReflections(
+        const X3DAUDIO_VEC_ROT& listenerInfo,
+        const X3DAUDIO_VECTOR*  extraEmitter) const
+    {
+        if (!this->Manager.Reflections) return;
+
+        auto toVec3 = [](const X3DAUDIO_VECTOR& vector) -> Dsp::Vec3
+        {
+            return {vector.x, vector.y, vector.z};
+        };
+
+        // Silence the taps when disabled so the tail dies out
+        Dsp::ReflectionTaps taps;
+        if (globalPluginSettings->ReflectionsEnabled)
+        {
+            std::array<Dsp::Vec3, MAX_REFLECTION_EMITTERS> emitters;
+            std::size_t                                    count = 0;
+
+            if (extraEmitter)
+            {
+                emitters[count++] = toVec3(*extraEmitter);
+            }
+
+            for (const auto& voice : *this->ActiveIndices | std::views::values)
+            {
+                if (count == emitters.size()) break;
+                emitters[count++] = toVec3(voice.Location);
+            }
+
+            const auto& [position, rotation] = listenerInfo;
+            const Dsp::Listener listener     = {
+                toVec3(position),
+                toVec3(rotation.first),
+                toVec3(rotation.second)
+            };
+
+            this->Manager.ImageSources.Compute(
+                emitters.data(), count,
+                listener,
+                globalPluginSettings->SecondOrderReflections,
+                taps);
+        }
+
+        this->Manager.Reflections->SetTaps(taps);
+    }
+
+    HRESULT SourceVoiceManager::MakeRoom(
+        const VoiceGroup& group,
+        const float       loudness,
+        Dsp::Fade&        outAttack)
+    {
+        outAttack = {};
+
+        const auto& [maxInstances, policy] = group.Limit;
+        if (group.Id >= MAX_VOICE_GROUPS || maxInstances == 0) return S_OK;
+
+        this->CollectEndedVoices();
+
+        // More than one goes when the limit was lowered while they played
+        const GroupList& list = this->Groups[group.Id];
+        while (list.Count >= maxInstances)
+        {
+            VoiceIndex victim = NO_VOICE;
+
+            switch (policy)
+            {
+            case LimitPolicy::RefuseNew:
+                return S_FALSE;
+            case LimitPolicy::KillOldest:
+                victim = list.Head;
+                break;
+            case LimitPolicy::Retrigger:
+                // Crossfade from the newest into the new one
+                victim    = list.Tail;
+                outAttack = Dsp::STEAL_FADE;
+                break;
+            case LimitPolicy::StealQuietest:
+                victim = list.Head;
+                for (VoiceIndex i = list.Head; i != NO_VOICE; i = this->Links[i].Next)
+                {
+                    if (this->Links[i].Loudness < this->Links[victim].Loudness) victim = i;
+                }
+                if (loudness < this->Links[victim].Loudness) return S_FALSE;
+                break;
+            default:
+                return S_OK;
+            }
+
+            // Whether or not it was still playing, it no longer counts, and the other layer of its play goes with it
+            const VoiceIndex layer = this->Links[victim].Layer;
+            this->Unpair(victim);
+            this->Unlink(victim);
+            HRESULT hr = this->ReleaseVoice(victim, Dsp::STEAL_FADE);
+            if (SUCCEEDED(hr) && layer != NO_VOICE) hr = this->ReleaseVoice(layer, Dsp::STEAL_FADE);
+            if (FAILED(hr)) return hr;
+        }
+
+        return S_OK;
+    }
+
+    void SourceVoiceManager::Track(
+        const VoiceIndex  sourceVoiceIndex,
+        const VoiceGroup& group,
+        const float       volume,
+        const float       loudness,
+        const VoiceIndex  layerOf)
+    {
+        if (group.Id < MAX_VOICE_GROUPS)
+        {
+            if (layerOf != NO_VOICE)
+            {
+                this->Links[layerOf].Layer          = sourceVoiceIndex;
+                this->Links[sourceVoiceIndex].Layer = layerOf;
+            }
+            else
+            {
+                this->Link(sourceVoiceIndex, group.Id);
+            }
+        }
+
+        VoiceLink& link = this->Links[sourceVoiceIndex];
+        link.Volume     = volume;
+        link.Loudness   = loudness;
+    }
+
+    void SourceVoiceManager::CollectEndedVoices()
+    {
+        VoiceIndex index;
+        while (this->EndedVoices->TryPop(index))
+        {
+            this->Unpair(index);
+            this->Unlink(index);
+            this->ActiveIndices->erase(index);
+            this->VoiceReadyQues[index]->push_back(index);
+        }
+    }
+
+    void SourceVoiceManager::Link(const VoiceIndex sourceVoiceIndex, const std::uint8_t group)
+    {
+        this->Unlink(sourceVoiceIndex);
+
+        GroupList& list = this->Groups[group];
+        VoiceLink& link = this->Links[sourceVoiceIndex];
+        link.Group      = group;
+        link.Prev       = list.Tail;
+        link.Next       = NO_VOICE;
+
+        if (list.Tail != NO_VOICE)
+        {
+            this->Links[list.Tail].Next = sourceVoiceIndex;
+        }
+        else
+        {
+            list.Head = sourceVoiceIndex;
+        }
+        list.Tail = sourceVoiceIndex;
+        ++list.Count;
+    }
+
+    void SourceVoiceManager::Unlink(const VoiceIndex sourceVoiceIndex)
+    {
+        VoiceLink& link = this->Links[sourceVoiceIndex];
+        if (link.Group == NO_VOICE_GROUP) return;
+
+        GroupList& list = this->Groups[link.Group];
+        if (link.Prev != NO_VOICE)
+        {
+            this->Links[link.Prev].Next = link.Next;
+        }
+        else
+        {
+            list.Head = link.Next;
+        }
+        if (link.Next != NO_VOICE)
+        {
+            this->Links[link.Next].Prev = link.Prev;
+        }
+        else
+        {
+            list.Tail = link.Prev;
+        }
+        --list.Count;
+
+        link = {};
+    }
+
+    void SourceVoiceManager::Unpair(const VoiceIndex sourceVoiceIndex)
+    {
+        VoiceLink& link = this->Links[sourceVoiceIndex];
+        if (link.Layer == NO_VOICE) return;
+
+        this->Links[link.Layer].Layer = NO_VOICE;
+        link.Layer                    = NO_VOICE;
+    }
+
+    HRESULT SourceVoiceManager::ReleaseVoice(const VoiceIndex sourceVoiceIndex, const Dsp::Fade& release) const
+    {
+        // Back in its ready queue once it's faded out, through its callback
+        const HRESULT hr = this->SourceVoices[sourceVoiceIndex]->Release(release);
+        if (FAILED(hr))
+        {
+            DEBUGLOG("FAILED TO RELEASE VOICE. HRESULT: {}", hr);
+        }
+        return hr;
+    }
+
+    void SourceVoiceManager::Probe(const VoiceIndex sourceVoiceIndex, const LatencyProbe& probe) const
+    {
+        this->SourceVoiceCallbacks[sourceVoiceIndex]->Arm(probe);
     }
 
     void SourceVoiceManager::Unload()
     {
-        this->ActiveIndices->clear();
+        // Fade out whatever's playing rather than cutting it off
+        RetiredVoices retired = this->Retire();
+        if (retired.IsReleasing)
+        {
+            // Plus a pass, for a backend that steps its envelopes once per pass
+            const auto fade = std::chrono::duration<float>(Dsp::STOP_FADE.Seconds + UNLOAD_FADE_MARGIN);
+            std::this_thread::sleep_for(fade);
+        }
+    }
 
-        for (const auto& val : this->ReadyIndexQues | std::views::values)
+    RetiredVoices SourceVoiceManager::Retire()
+    {
+        RetiredVoices retired;
+        for (VoiceIndex i = 0; i < this->SourceVoices.size(); ++i)
         {
-            val->clear();
+            retired.IsReleasing = this->ReleaseVoice(i, Dsp::STOP_FADE) == S_OK || retired.IsReleasing;
         }
+
+        retired.Voices      = std::move(this->SourceVoices);
+        retired.Callbacks   = std::move(this->SourceVoiceCallbacks);
+        retired.Matrices    = std::move(this->OutputMatrices);
+        retired.EndedVoices = std::exchange(this->EndedVoices, std::make_unique<EndedQue>());
+
+        this->SourceVoices.clear();
+        this->SourceVoiceCallbacks.clear();
+        this->OutputMatrices.clear();
+        this->VoiceReadyQues.clear();
         this->ReadyIndexQues.clear();
+        this->ActiveIndices->clear();
+        this->Links.clear();
+        this->Groups.fill({});
+
+        return retired;
+    }
 
-        for (auto& voice : this->SourceVoices)
+    PoolShape SourceVoiceManager::GetPoolShape() const
+    {
+        PoolShape shape;
+        for (const auto& [format, readyIndices] : this->ReadyIndexQues)
+        {
+            shape[format] = static_cast<std::size_t>(std::ranges::count(this->VoiceReadyQues, readyIndices));
+        }
+        return shape;
+    }
+
+    void SourceVoiceManager::Prewarm(const PoolShape& shape)
+    {
+        const PoolShape current = this->GetPoolShape();
+        for (const auto& [format, count] : shape)
+        {
+            const auto  it       = current.find(format);
+            std::size_t existing = it != current.end() ? it->second : 0;
+            for (; existing < count; ++existing)
+            {
+                try
+                {
+                    // Straight back to its ready queue, as if it had played
+                    const VoiceIndex index = this->GetReadySourceVoiceIndex(format);
+                    this->VoiceReadyQues[index]->push_back(index);
+                }
+                catch (HRESULT hr)
+                {
+                    DEBUGLOG("FAILED TO PREWARM SOURCE VOICE. HRESULT: {}", hr);
+                    return;
+                }
+            }
+        }
+    }
+
+    RetiredVoices::~RetiredVoices()
+    {
+        this->Destroy();
+    }
+
+    void RetiredVoices::Destroy()
+    {
+        for (auto& voice : this->Voices)
         {
             if (voice != nullptr)
             {
@@ -399,36 +1003,30 @@ namespace SoundInterface
                 {
                     DEBUGLOG("FAILED TO STOP VOICE. HRESULT: {}", hr);
                 }
-                hr = voice->FlushSourceBuffers();
+                hr = voice->Flush();
                 if (FAILED(hr))
                 {
                     DEBUGLOG("FAILED TO FLUSH SOURCE VOICE BUFFERS. HRESULT: {}", hr);
                 }
-                voice->DestroyVoice();
+                voice->Destroy();
                 voice = nullptr;
             }
         }
-        this->SourceVoices.clear();
+        this->Voices.clear();
 
-        for (const auto& [_, data] : this->OutputMatrices)
+        for (const auto& outputMatrix : this->Matrices)
         {
-            delete[] data;
+            delete[] outputMatrix.Data;
         }
-        this->OutputMatrices.clear();
+        this->Matrices.clear();
 
-        for (auto& callback : this->SourceVoiceCallbacks)
+        // Destroyed voices don't call back anymore, so these can go
+        for (auto& callback : this->Callbacks)
         {
             delete callback;
             callback = nullptr;
         }
-        this->SourceVoiceCallbacks.clear();
-
-        /*
-        for (auto& effect : this->voiceEffects) {
-            effect->Release();
-            effect = nullptr;
-        }
-        this->voiceEffects.clear();
-        */
+        this->Callbacks.clear();
+        this->EndedVoices.reset();
     }
 }
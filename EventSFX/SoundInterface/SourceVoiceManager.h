@@ -6,13 +6,22 @@
 
 #pragma once
 
-#include <xaudio2.h>
-// #include <XAudio2fx.h>
-// #include <xapofx.h>
 #include <x3daudio.h>
 #pragma comment(lib, "XAUDIO2_8.lib")
 
+#include "SoundInterface/CommandQueue.h"
+#include "SoundInterface/EffectBuses.h"
+#include "SoundInterface/InstanceLimits.h"
+#include "SoundInterface/LatencyStats.h"
+#include "SoundInterface/SoundCategories.h"
+#include "SoundInterface/Backend/AudioBackend.h"
+#include "SoundInterface/Dsp/DistanceCurve.h"
+
 #define XAUDIO2_NUM_SRC_CHANNELS 1
+#define CURVE_DISTANCE_SCALER    4.0f
+#define MAX_REFLECTION_EMITTERS  32
+#define UNLOAD_FADE_MARGIN       0.02f // Seconds
+#define ENDED_VOICE_CAPACITY     1024  // A voice has at most one end in flight, so this only fills past as many voices
 
 using X3DAUDIO_ROTATION = std::pair<X3DAUDIO_VECTOR, X3DAUDIO_VECTOR>;
 using X3DAUDIO_VEC_ROT  = std::pair<X3DAUDIO_VECTOR, X3DAUDIO_ROTATION>;
@@ -21,72 +30,183 @@ namespace SoundInterface
 {
     struct OutputMatrix
     {
-        unsigned int Size;
-        FLOAT32*     Data;
-    };
-
-    struct AudioFormatKey
-    {
-        WORD  Channels;
-        DWORD SamplesPerSec;
-        WORD  BitsPerSample;
-
-        bool operator<(const AudioFormatKey& other) const
-        {
-            return std::tie(Channels, SamplesPerSec, BitsPerSample) <
-                std::tie(other.Channels, other.SamplesPerSec, other.BitsPerSample);
-        }
+        unsigned int  Size;
+        float*        Data;
+        Backend::Bus* Destination; // The category bus, null until first played
     };
 
     class SoundManager;
     class SourceVoiceCallback;
 
+    struct ActiveVoice
+    {
+        X3DAUDIO_VECTOR     Location;
+        Dsp::DistanceLutPtr Distance;
+    };
+
     using VoiceIndex   = short unsigned int;
-    using VoiceVec     = std::vector<IXAudio2SourceVoice*>;
+    using VoiceVec     = std::vector<Backend::Voice*>;
     using ReadyQue     = std::deque<VoiceIndex>;
     using ReadyQuePtr  = std::shared_ptr<ReadyQue>;
-    using FmtQueMap    = std::map<AudioFormatKey, std::shared_ptr<ReadyQue>>;
-    using ActiveMap    = std::map<VoiceIndex, X3DAUDIO_VECTOR>;
+    using FmtQueMap    = std::map<Backend::VoiceFormat, std::shared_ptr<ReadyQue>>;
+    using ActiveMap    = std::map<VoiceIndex, ActiveVoice>;
     using MatrixVec    = std::vector<OutputMatrix>;
     using ActiveMapPtr = std::shared_ptr<ActiveMap>;
     using CallbackVec  = std::vector<SourceVoiceCallback*>;
-    // using effect_vec     = std::vector<IUnknown*>;
+    using ReadyQueVec  = std::vector<ReadyQuePtr>;
+    using EndedQue     = MpscQueue<VoiceIndex, ENDED_VOICE_CAPACITY>;
+    using PoolShape    = std::map<Backend::VoiceFormat, std::size_t>; // How many voices of each format
+
+    constexpr VoiceIndex NO_VOICE = 0xFFFF;
+
+    // A voice's place in its group's list, oldest first
+    struct VoiceLink
+    {
+        VoiceIndex   Prev     = NO_VOICE;
+        VoiceIndex   Next     = NO_VOICE;
+        std::uint8_t Group    = NO_VOICE_GROUP;
+        float        Volume   = 0.0f; // As played
+        float        Loudness = 0.0f; // Volume after distance, kept up to date for 3D sounds
+        VoiceIndex   Layer    = NO_VOICE; // The other voice of a play between two velocity layers; only one of them is counted
+    };
+
+    struct GroupList
+    {
+        VoiceIndex    Head  = NO_VOICE; // Oldest
+        VoiceIndex    Tail  = NO_VOICE; // Newest
+        std::uint32_t Count = 0;
+    };
+
+    /*
+     * A voice table taken off its engine, still fading out on it. Its
+     * callbacks post to their own queue, so nothing reaches the table
+     * that replaced it, and everything is destroyed with it.
+     */
+    struct RetiredVoices
+    {
+        VoiceVec                  Voices;
+        CallbackVec               Callbacks;
+        MatrixVec                 Matrices;
+        std::unique_ptr<EndedQue> EndedVoices;
+        bool                      IsReleasing = false; // Whether any were still playing
+
+        RetiredVoices() = default;
+        ~RetiredVoices();
+
+        RetiredVoices(RetiredVoices&&)                 = default;
+        RetiredVoices& operator=(RetiredVoices&&)      = delete;
+        RetiredVoices(const RetiredVoices&)            = delete;
+        RetiredVoices& operator=(const RetiredVoices&) = delete;
+
+        // Stops and destroys the voices, before the buses they send to
+        void Destroy();
+    };
 
     class SourceVoiceManager
     {
     public:
         explicit SourceVoiceManager(SoundManager& soundManager);
 
-        VoiceIndex GetReadySourceVoiceIndex(const WAVEFORMATEX* wfx);
+        VoiceIndex GetReadySourceVoiceIndex(const Backend::VoiceFormat& format);
 
         // For 3D playback
-        IXAudio2SourceVoice* GetReadySourceVoice(
-            const WAVEFORMATEX* wfx,
-            const Vector&       location,
-            bool                fromMenu = false);
+        Backend::Voice* GetReadySourceVoice(
+            const Backend::VoiceFormat& format,
+            SoundCategory               category,
+            const Vector&               location,
+            const Dsp::DistanceLutPtr&  distance,
+            bool                        fromMenu = false,
+            const X3DAUDIO_VEC_ROT*     listener = nullptr,  // Null reads the camera
+            VoiceIndex*                 outIndex = nullptr);
 
         // For 2D playback
-        IXAudio2SourceVoice* GetReadySourceVoice(
-            const WAVEFORMATEX* pWfx)
+        Backend::Voice* GetReadySourceVoice(
+            const Backend::VoiceFormat& format,
+            const SoundCategory         category,
+            VoiceIndex*                 outIndex = nullptr)
         {
-            const auto readyIndex   = this->GetReadySourceVoiceIndex(pWfx);
+            const auto readyIndex   = this->GetReadySourceVoiceIndex(format);
+            if (outIndex) *outIndex = readyIndex;
             const auto pSourceVoice = this->SourceVoices[readyIndex];
             // ReSharper disable once CppExpressionWithoutSideEffects
+            this->SetCategory(readyIndex, category);
+            // ReSharper disable once CppExpressionWithoutSideEffects
             this->ResetOutputMatrix(readyIndex);
             return pSourceVoice;
         }
 
+        /*
+         * Makes space in a full group for a sound of the given loudness,
+         * fading out whichever voice its policy gives up. S_FALSE means
+         * the new sound shouldn't play; outAttack is the fade it should
+         * start with. Constant time, but for stealing the quietest,
+         * which looks through the group's few voices.
+         */
+        HRESULT MakeRoom(
+            const VoiceGroup& group,
+            float             loudness,
+            Dsp::Fade&        outAttack);
+
+        // Counts a just started voice against its group, or, given the counted voice of the same play, goes along with that one
+        void Track(
+            VoiceIndex        sourceVoiceIndex,
+            const VoiceGroup& group,
+            float             volume,
+            float             loudness,
+            VoiceIndex        layerOf = NO_VOICE);
+
+        // Fades the voice out, for stops, steals and retriggers
+        HRESULT ReleaseVoice(
+            VoiceIndex       sourceVoiceIndex,
+            const Dsp::Fade& release = Dsp::STOP_FADE) const;
+
+        // Has the voice finish the probe on its first block, so before it's started
+        void Probe(VoiceIndex sourceVoiceIndex, const LatencyProbe& probe) const;
+
+        HRESULT SetCategory(VoiceIndex sourceVoiceIndex, SoundCategory category);
         HRESULT ResetOutputMatrix(VoiceIndex sourceVoiceIndex) const;
-
+        HRESULT SetEffectSends(Backend::Voice* sourceVoice, const SendLevels& sends) const;
+
+        // Whether a 3D sound would be past its curve's cutoff right now
+        [[nodiscard]] static bool IsAudible(
+            const Vector&           location,
+            bool                    fromMenu,
+            const Dsp::DistanceLut& distance,
+            const X3DAUDIO_VEC_ROT* listener = nullptr);
+
+        // From the listener in meters, as distance curves see it
+        [[nodiscard]] static float GetListenerDistance(
+            const Vector&           location,
+            const X3DAUDIO_VEC_ROT& listener);
+
+        // The curve's gain at the sound's distance
+        [[nodiscard]] static float GetDistanceGain(
+            const Vector&           location,
+            bool                    fromMenu,
+            const Dsp::DistanceLut& distance,
+            const X3DAUDIO_VEC_ROT* listener = nullptr);
+
+        // Reads the camera, so only from the game thread
         static X3DAUDIO_VEC_ROT GetListenerInfo(bool isStationary = false);
         HRESULT                 Apply3D(
-            IXAudio2SourceVoice*    sourceVoice,
+            Backend::Voice*         sourceVoice,
             const OutputMatrix&     outputMatrix,
             const X3DAUDIO_VECTOR&  emitterLocation,
-            const X3DAUDIO_VEC_ROT& listenerInfo) const;
-        void Update3D() const;
+            const X3DAUDIO_VEC_ROT& listenerInfo,
+            float                   distanceGain) const;
+        void Update3D();
+        void UpdateReflections(
+            const X3DAUDIO_VEC_ROT& listenerInfo,
+            const X3DAUDIO_VECTOR*  extraEmitter = nullptr) const;
         void Unload();
 
+        // Fades out and hands over every voice without waiting, leaving an empty table for a new engine
+        [[nodiscard]] RetiredVoices Retire();
+
+        // What the table holds, to bring it back up on a new engine
+        [[nodiscard]] PoolShape GetPoolShape() const;
+        void                    Prewarm(const PoolShape& shape);
+
     private:
         SoundManager& Manager; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
         VoiceVec      SourceVoices;
@@ -94,6 +214,42 @@ namespace SoundInterface
         FmtQueMap     ReadyIndexQues;
         CallbackVec   SourceVoiceCallbacks;
         MatrixVec     OutputMatrices;
-        // effect_vec     voiceEffects;
+        ReadyQueVec   VoiceReadyQues; // The ready queue each voice goes back to
+
+        // Voices that finished, posted from the audio thread and collected under the manager's lock
+        std::unique_ptr<EndedQue> EndedVoices; // Moves with the voices when they're retired
+
+        // Intrusive lists of the playing voices of each group
+        std::vector<VoiceLink>                  Links;
+        std::array<GroupList, MAX_VOICE_GROUPS> Groups{};
+
+        // For 3D sounds played without a curve of their own
+        Dsp::DistanceLutPtr DefaultDistance;
+
+        static HRESULT SetSendLevel(
+            Backend::Voice* sourceVoice,
+            Backend::Bus*   destination,
+            float           level);
+
+        // Returns finished voices to their ready queues
+        void CollectEndedVoices();
+
+        void Link(VoiceIndex sourceVoiceIndex, std::uint8_t group);
+        void Unlink(VoiceIndex sourceVoiceIndex);
+        void Unpair(VoiceIndex sourceVoiceIndex);
+
+        [[nodiscard]] bool IsAmbisonic() const;
+        static void        EncodeEmitters(
+            const X3DAUDIO_VECTOR*  locations,
+            const float*            distanceGains,
+            std::size_t             count,
+            const X3DAUDIO_VEC_ROT& listenerInfo,
+            float*                  outGains);
+        HRESULT SetAmbisonicGains(
+            Backend::Voice*     sourceVoice,
+            const OutputMatrix& outputMatrix,
+            const float*        gains,
+            std::size_t         stride) const;
+        void UpdateDecoder() const;
     };
 }
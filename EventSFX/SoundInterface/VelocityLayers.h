@@ -0,0 +1,110 @@
+//=======================================================================
+/** VelocityLayers.h
+ * Choosing between sets of an event's sounds by how hard the impact was
+ */
+//=======================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <string>
+#include <vector>
+
+namespace SoundInterface
+{
+    // Counting the event's own sounds, which are the softest layer
+    constexpr std::size_t MAX_VELOCITY_LAYERS = 8;
+
+    // Unreal units per second; the ball tops out at 6000, cars at 2300 each
+    constexpr float MIN_LAYER_SPEED     = 0.0f;
+    constexpr float MAX_LAYER_SPEED     = 6000.0f;
+    constexpr float MIN_LAYER_CROSSFADE = 0.0f;
+    constexpr float MAX_LAYER_CROSSFADE = 2000.0f;
+
+    struct VelocityLayer
+    {
+        float                    MinSpeed = 0.0f; // Plays from this speed up, until the next layer's
+        std::vector<std::string> SoundIds;
+    };
+
+    // One layer, or two being faded between; Gains[1] is zero for one
+    struct LayerBlend
+    {
+        std::array<std::uint32_t, 2> Layers{};
+        std::array<float, 2>         Gains{1.0f, 0.0f};
+    };
+
+    /*
+     * Maps a speed to its layer by binary search over the thresholds,
+     * which are kept sorted with the first at zero. With a crossfade,
+     * each threshold gets a band that wide centered on it, in which the
+     * layers on either side play together at equal power; the samples
+     * aren't correlated, so equal gain would dip in the middle.
+     */
+    class VelocityLayerMap
+    {
+    public:
+        VelocityLayerMap() = default;
+
+        VelocityLayerMap(const std::vector<float>& thresholds, const float crossfade)
+            : Count(static_cast<std::uint32_t>(std::min(thresholds.size(), MAX_VELOCITY_LAYERS))),
+              Crossfade(std::clamp(crossfade, MIN_LAYER_CROSSFADE, MAX_LAYER_CROSSFADE))
+        {
+            std::copy_n(thresholds.begin(), this->Count, this->Thresholds.begin());
+            std::sort(this->Thresholds.begin(), this->Thresholds.begin() + this->Count);
+            if (this->Count > 0) this->Thresholds[0] = 0.0f;
+        }
+
+        [[nodiscard]] std::uint32_t GetCount() const
+        {
+            return this->Count;
+        }
+
+        [[nodiscard]] LayerBlend Find(const float speed) const
+        {
+            LayerBlend blend;
+            if (this->Count <= 1) return blend;
+
+            // The last threshold at or below the speed
+            const float*        first = this->Thresholds.data();
+            const float*        upper = std::upper_bound(first + 1, first + this->Count, speed);
+            const std::uint32_t layer = static_cast<std::uint32_t>(upper - first) - 1;
+
+            blend.Layers = {layer, layer};
+            if (this->Crossfade <= 0.0f) return blend;
+
+            // Within half a band of the threshold below or the one above
+            const float half  = this->Crossfade * 0.5f;
+            std::uint32_t low = layer;
+            if (layer > 0 && speed < this->Thresholds[layer] + half)
+            {
+                low = layer - 1;
+            }
+            else if (layer + 1 < this->Count && speed >= this->Thresholds[layer + 1] - half)
+            {
+                low = layer;
+            }
+            else
+            {
+                return blend;
+            }
+
+            const float t     = std::clamp((speed - (this->Thresholds[low + 1] - half)) / this->Crossfade, 0.0f, 1.0f);
+            const float angle = t * std::numbers::pi_v<float> * 0.5f;
+
+            blend.Layers = {low, low + 1};
+            blend.Gains  = {std::cos(angle), std::sin(angle)};
+            return blend;
+        }
+
+    private:
+        std::array<float, MAX_VELOCITY_LAYERS> Thresholds{};
+        std::uint32_t                          Count     = 0;
+        float                                  Crossfade = 0.0f;
+    };
+}
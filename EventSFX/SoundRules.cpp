@@ -0,0 +1,158 @@
+//=======================================================================
+/** SoundRules.cpp
+ * Which event sound, if any, a game event makes
+ */
+//=======================================================================
+
+#include "pch.h"
+#include "SoundRules.h"
+
+namespace RlEvents
+{
+    bool IsCooldownGainUsed(const Kind eventId, const PluginSettings& settings)
+    {
+        const SoundSettings& sound = settings.Sounds[static_cast<int>(eventId)];
+        return sound.Cooldown.BreakThrough > 0.0f && (eventId != Kind::Crossbar || !settings.FixedCrossbarVolume);
+    }
+
+    float GetCooldownGain(const GameEvent& event, const Kind eventId, const PluginSettings& settings)
+    {
+        if (!IsCooldownGainUsed(eventId, settings)) return 1.0f;
+
+        return settings.Sounds[static_cast<int>(eventId)].EvaluateCurves(event.Inputs);
+    }
+
+    std::optional<Kind> SoundRules::Match(const GameEvent& event, const PluginSettings& settings)
+    {
+        const std::optional<Kind> eventId = this->MatchType(event, settings);
+        if (!eventId.has_value() || event.Type == GameEventType::Request) return eventId;
+        if (GetContactEvent(event.Type).has_value()) return eventId; // Past the ContactFilter already
+        if (IsEvent3D(eventId.value())) return this->Admit(event, eventId.value(), settings) ? eventId : std::nullopt;
+
+        // A moment is only moved on by a play that gets through its cooldown too
+        const std::int32_t priority = GetEventRegistry().Get(eventId.value()).Priority;
+        const bool         isMoment = event.PostedAt - this->LastMoment < MOMENT;
+        if (isMoment && priority < this->LastPriority) return std::nullopt;
+        if (!this->Admit(event, eventId.value(), settings)) return std::nullopt;
+
+        if (!isMoment) this->LastMoment = event.PostedAt;
+        this->LastPriority = priority;
+        return eventId;
+    }
+
+    bool SoundRules::Admit(const GameEvent& event, const Kind eventId, const PluginSettings& settings)
+    {
+        const SoundSettings& sound = settings.Sounds[static_cast<int>(eventId)];
+        const float          gain  = GetCooldownGain(event, eventId, settings);
+
+        return this->Cooldowns.Admit(static_cast<int>(eventId), event.Actor, event.Other, sound.Cooldown, gain, event.PostedAt);
+    }
+
+    std::optional<Kind> SoundRules::MatchType(const GameEvent& event, const PluginSettings& settings)
+    {
+        const auto isEnabled = [&settings](const Kind eventId)
+        {
+            return settings.Sounds[static_cast<int>(eventId)].IsEnabled;
+        };
+
+        switch (event.Type)
+        {
+        case GameEventType::Request:
+            return event.Event;
+
+        case GameEventType::Bump:
+            if (isEnabled(Kind::Bump)) return Kind::Bump;
+            break;
+
+        case GameEventType::Crossbar:
+            if (isEnabled(Kind::Crossbar)) return Kind::Crossbar;
+            break;
+
+        // Anyone's
+        case GameEventType::Demolish:
+            if (isEnabled(Kind::Demo)) return Kind::Demo;
+            break;
+
+        // The player's before their team's, which the player is on
+        case GameEventType::Goal:
+            if (event.IsPlayer && isEnabled(Kind::PlayerGoal)) return Kind::PlayerGoal;
+            if (event.IsPlayerTeam)
+            {
+                if (isEnabled(Kind::TeamGoal)) return Kind::TeamGoal;
+            }
+            else if (isEnabled(Kind::Concede))
+            {
+                return Kind::Concede;
+            }
+            break;
+
+        case GameEventType::OwnGoal:
+            if (event.IsPlayer && isEnabled(Kind::Concede)) return Kind::Concede;
+            break;
+
+        case GameEventType::Save:
+            if (event.IsPlayer && isEnabled(Kind::Save)) return Kind::Save;
+            break;
+
+        case GameEventType::Win:
+            if (event.IsPlayer && isEnabled(Kind::Win)) return Kind::Win;
+            // Announced for each of the other team's players at once; one loss is enough, whatever its cooldown
+            if (!event.IsPlayerTeam && isEnabled(Kind::Loss))
+            {
+                if (event.PostedAt - this->LastLoss < MOMENT) break;
+
+                this->LastLoss = event.PostedAt;
+                return Kind::Loss;
+            }
+            break;
+
+        // The team goal sound covers it when there is one
+        case GameEventType::Assist:
+            if (event.IsPlayer && isEnabled(Kind::Assist) && !isEnabled(Kind::TeamGoal)) return Kind::Assist;
+            break;
+
+        // Epic saves, aerial goals, hat tricks and the like, by what the registry says they play
+        case GameEventType::Stat:
+            if (event.IsPlayer)
+            {
+                const std::optional<Kind> eventId = GetEventRegistry().FindByStat(event.Stat);
+                if (eventId.has_value() && isEnabled(eventId.value())) return eventId;
+            }
+            break;
+
+        case GameEventType::Overtime:
+            if (isEnabled(Kind::Overtime)) return Kind::Overtime;
+            break;
+
+        case GameEventType::Kickoff:
+            if (isEnabled(Kind::Kickoff)) return Kind::Kickoff;
+            break;
+
+        case GameEventType::BallHit:
+            if (isEnabled(Kind::BallHit)) return Kind::BallHit;
+            break;
+
+        default:
+            break;
+        }
+
+        return std::nullopt;
+    }
+
+    bool ContactFilter::IsGainUsed(const GameEvent& event, const PluginSettings& settings)
+    {
+        const std::optional<Kind> eventId = GetContactEvent(event.Type);
+        return eventId.has_value() && IsCooldownGainUsed(eventId.value(), settings);
+    }
+
+    bool ContactFilter::Admit(const GameEvent& event, const PluginSettings& settings)
+    {
+        const std::optional<Kind> eventId = GetContactEvent(event.Type);
+        if (!eventId.has_value()) return true;
+
+        const SoundSettings& sound = settings.Sounds[static_cast<int>(eventId.value())];
+        const float          gain  = GetCooldownGain(event, eventId.value(), settings);
+
+        return this->Cooldowns.Admit(static_cast<int>(eventId.value()), event.Actor, event.Other, sound.Cooldown, gain, event.PostedAt);
+    }
+}
@@ -0,0 +1,88 @@
+//=======================================================================
+/** SoundRules.h
+ * Which event sound, if any, a game event makes
+ */
+//=======================================================================
+
+#pragma once
+
+#include "Cooldowns.h"
+#include "GameEvents.h"
+
+#include <optional>
+
+namespace RlEvents
+{
+    // Whether a play's cooldown compares how loud it would be, for breaking through
+    [[nodiscard]] bool IsCooldownGainUsed(Kind eventId, const PluginSettings& settings);
+
+    // How loud a play would be, as its cooldown compares them; the crossbar's fixed volume setting turns its curves off
+    [[nodiscard]] float GetCooldownGain(const GameEvent& event, Kind eventId, const PluginSettings& settings);
+
+    // The events that fire on every frame of a contact, whose cooldowns are the ContactFilter's
+    constexpr std::optional<Kind> GetContactEvent(const GameEventType type)
+    {
+        switch (type)
+        {
+        case GameEventType::Bump:
+            return Kind::Bump;
+        case GameEventType::Crossbar:
+            return Kind::Crossbar;
+        case GameEventType::BallHit:
+            return Kind::BallHit;
+        default:
+            return std::nullopt;
+        }
+    }
+
+    /*
+     * The player's and their team's view of what happened, against what
+     * is enabled: a goal is the player's, their team's or a concede, a
+     * win is one loss when it's the other team's, however many of them
+     * it's announced for, and so on. Of 2D events that land together,
+     * like a goal and the hat trick it makes, those below the priority
+     * of one that just played are skipped. Then each event's cooldown
+     * policy, from its settings, has its say. Subscribed to the bus, so
+     * it only ever runs on its thread.
+     */
+    class SoundRules
+    {
+    public:
+        // The game announces a moment's stats in the same frame or so
+        static constexpr std::chrono::milliseconds MOMENT = std::chrono::milliseconds(250);
+
+        // By a published copy of the settings, never the ones the game thread and the GUI write to
+        [[nodiscard]] std::optional<Kind> Match(const GameEvent& event, const PluginSettings& settings);
+
+    private:
+        [[nodiscard]] std::optional<Kind> MatchType(const GameEvent& event, const PluginSettings& settings);
+
+        // Of a play that made it past the priorities
+        [[nodiscard]] bool Admit(const GameEvent& event, Kind eventId, const PluginSettings& settings);
+
+        CooldownTable                         Cooldowns;
+        std::chrono::steady_clock::time_point LastLoss;
+        std::chrono::steady_clock::time_point LastMoment;
+        std::int32_t                          LastPriority = 0;
+    };
+
+    /*
+     * The cooldowns of the events that fire on every frame of a contact,
+     * bumps, ball hits and the crossbar, checked on the game thread
+     * before they're published, so a scrum doesn't fill the bus ahead of
+     * a goal. The only place they're kept; the sound rules take what
+     * gets through as it is. Only from the game thread.
+     */
+    class ContactFilter
+    {
+    public:
+        // Whether the event's cooldown is up to how loud it would be, so it can only be checked once the game's been read
+        [[nodiscard]] static bool IsGainUsed(const GameEvent& event, const PluginSettings& settings);
+
+        // Anything but a contact always is
+        [[nodiscard]] bool Admit(const GameEvent& event, const PluginSettings& settings);
+
+    private:
+        CooldownTable Cooldowns;
+    };
+}
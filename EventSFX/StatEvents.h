@@ -0,0 +1,208 @@
+//=======================================================================
+/** StatEvents.h
+ * Stat ticker event names, resolved once to an enum
+ */
+//=======================================================================
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace RlEvents
+{
+    // As the stat ticker names them
+    enum class StatEvent
+        : std::uint8_t
+    {
+        Unknown = 0,
+        Goal,
+        OwnGoal,
+        AerialGoal,
+        BackwardsGoal,
+        BicycleGoal,
+        LongGoal,
+        TurtleGoal,
+        PoolShot,
+        OvertimeGoal,
+        HatTrick,
+        Assist,
+        Playmaker,
+        Save,
+        EpicSave,
+        Savior,
+        Shot,
+        Center,
+        Clear,
+        FirstTouch,
+        Demolish,
+        Win,
+        MVP,
+        Count
+    };
+
+    constexpr std::size_t NUM_STAT_EVENTS = static_cast<std::size_t>(StatEvent::Count);
+
+    // Indexed by StatEvent; Unknown's is empty so it never matches a name
+    constexpr std::array<std::string_view, NUM_STAT_EVENTS> STAT_EVENT_NAMES = {
+        "",
+        "Goal",
+        "OwnGoal",
+        "AerialGoal",
+        "BackwardsGoal",
+        "BicycleGoal",
+        "LongGoal",
+        "TurtleGoal",
+        "PoolShot",
+        "OvertimeGoal",
+        "HatTrick",
+        "Assist",
+        "Playmaker",
+        "Save",
+        "EpicSave",
+        "Savior",
+        "Shot",
+        "Center",
+        "Clear",
+        "FirstTouch",
+        "Demolish",
+        "Win",
+        "MVP",
+    };
+
+    constexpr std::string_view GetStatEventName(const StatEvent stat)
+    {
+        return stat < StatEvent::Count ? STAT_EVENT_NAMES[static_cast<std::size_t>(stat)] : "NA";
+    }
+
+    namespace Detail
+    {
+        constexpr std::size_t STAT_EVENT_SLOTS = 64; // A power of two, a few times the names so a seed is quick to find
+
+        // FNV-1a, from a seed
+        constexpr std::uint32_t HashStatEventName(const std::string_view name, const std::uint32_t seed)
+        {
+            std::uint32_t hash = 2166136261u ^ seed;
+            for (const char c : name)
+            {
+                hash ^= static_cast<std::uint8_t>(c);
+                hash *= 16777619u;
+            }
+            return hash ^ (hash >> 16);
+        }
+
+        constexpr std::size_t GetStatEventSlot(const std::string_view name, const std::uint32_t seed)
+        {
+            return HashStatEventName(name, seed) & (STAT_EVENT_SLOTS - 1);
+        }
+
+        // The first seed that puts every name in a slot of its own
+        constexpr std::uint32_t FindStatEventSeed()
+        {
+            for (std::uint32_t seed = 0; seed < 100000; ++seed)
+            {
+                std::array<bool, STAT_EVENT_SLOTS> isTaken{};
+                bool                               isPerfect = true;
+                for (std::size_t i = 1; i < NUM_STAT_EVENTS && isPerfect; ++i)
+                {
+                    const std::size_t slot = GetStatEventSlot(STAT_EVENT_NAMES[i], seed);
+                    isPerfect              = !isTaken[slot];
+                    isTaken[slot]          = true;
+                }
+                if (isPerfect) return seed;
+            }
+            return 0xFFFFFFFF;
+        }
+
+        constexpr std::uint32_t STAT_EVENT_SEED = FindStatEventSeed();
+        static_assert(STAT_EVENT_SEED != 0xFFFFFFFF, "No seed hashes the stat event names apart; make the table bigger");
+
+        constexpr std::array<StatEvent, STAT_EVENT_SLOTS> BuildStatEventTable()
+        {
+            std::array<StatEvent, STAT_EVENT_SLOTS> table{};
+            for (std::size_t i = 1; i < NUM_STAT_EVENTS; ++i)
+            {
+                table[GetStatEventSlot(STAT_EVENT_NAMES[i], STAT_EVENT_SEED)] = static_cast<StatEvent>(i);
+            }
+            return table;
+        }
+
+        constexpr std::array<StatEvent, STAT_EVENT_SLOTS> STAT_EVENT_TABLE = BuildStatEventTable();
+    }
+
+    // A hash, a table read and one compare to rule out names it doesn't know
+    constexpr StatEvent GetStatEvent(const std::string_view name)
+    {
+        const StatEvent candidate = Detail::STAT_EVENT_TABLE[Detail::GetStatEventSlot(name, Detail::STAT_EVENT_SEED)];
+        return STAT_EVENT_NAMES[static_cast<std::size_t>(candidate)] == name ? candidate : StatEvent::Unknown;
+    }
+
+    static_assert(GetStatEvent("Demolish") == StatEvent::Demolish);
+    static_assert(GetStatEvent("Goals") == StatEvent::Unknown);
+
+    /*
+     * Stat event objects are made once and live on for the match, so
+     * each address only has its name read and hashed the first time it
+     * comes by; after that it's one probe, usually, into a table that
+     * never allocates. Clear it when the match goes, as the next one's
+     * may be made at the same addresses. A full table still answers,
+     * just without remembering. Only from the game thread.
+     */
+    class StatEventCache
+    {
+    public:
+        static constexpr std::size_t CAPACITY = 64; // A power of two, well over the stat events a game has
+
+        template <typename GetName>
+        StatEvent Resolve(const std::uintptr_t address, GetName&& getName)
+        {
+            if (address == 0) return StatEvent::Unknown;
+
+            std::size_t slot = GetSlot(address);
+            for (std::size_t probes = 0; probes < CAPACITY; ++probes)
+            {
+                if (this->Addresses[slot] == address) return this->Stats[slot];
+                if (this->Addresses[slot] == 0) break;
+                slot = (slot + 1) & (CAPACITY - 1);
+            }
+
+            const StatEvent stat = GetStatEvent(getName());
+
+            // Keeps a quarter free, so misses stay short
+            if (this->Size < CAPACITY * 3 / 4 && this->Addresses[slot] == 0)
+            {
+                this->Addresses[slot] = address;
+                this->Stats[slot]     = stat;
+                ++this->Size;
+            }
+
+            return stat;
+        }
+
+        void Clear()
+        {
+            this->Addresses.fill(0);
+            this->Size = 0;
+        }
+
+        [[nodiscard]] std::size_t GetSize() const
+        {
+            return this->Size;
+        }
+
+    private:
+        // Objects are aligned, so the low bits say nothing
+        static std::size_t GetSlot(const std::uintptr_t address)
+        {
+            const std::uint64_t mixed = static_cast<std::uint64_t>(address >> 3) * 0x9E3779B97F4A7C15ull;
+            return static_cast<std::size_t>(mixed >> (64 - std::countr_zero(CAPACITY)));
+        }
+
+        std::array<std::uintptr_t, CAPACITY> Addresses{}; // 0 for an empty slot
+        std::array<StatEvent, CAPACITY>      Stats{};
+        std::size_t                          Size = 0;
+    };
+}
@@ -0,0 +1,178 @@
+//=======================================================================
+/** TimerWheel.h
+ * When each of a fixed set of things is due, in constant time
+ */
+//=======================================================================
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace RlEvents
+{
+    /*
+     * A hierarchical timing wheel over handles 0 to Capacity - 1, whose
+     * links live in arrays of their own, so handles never move and
+     * nothing allocates. Each level has SLOTS slots, each the whole of
+     * the level below: the first is a tick per slot, the next a lap of
+     * the first per slot, and so on. A timer goes on the coarsest level
+     * it needs and drops down a level each time its slot comes up, so
+     * scheduling, cancelling and each tick are constant time, and a timer
+     * is only ever touched LEVELS times. Times past the last level are
+     * pulled in to it.
+     */
+    template <std::size_t Capacity>
+    class TimerWheel
+    {
+    public:
+        static constexpr std::uint32_t SLOT_BITS = 6;
+        static constexpr std::size_t   SLOTS     = std::size_t(1) << SLOT_BITS;
+        static constexpr std::size_t   LEVELS    = 3;
+        static constexpr std::uint64_t HORIZON   = std::uint64_t(1) << (SLOT_BITS * LEVELS); // In ticks
+
+        static_assert(Capacity < 0xFFFF);
+
+        TimerWheel()
+        {
+            this->Clear();
+        }
+
+        [[nodiscard]] std::uint64_t GetNow() const
+        {
+            return this->Now;
+        }
+
+        // At least the next tick; a handle already scheduled is moved
+        void Schedule(const std::size_t handle, std::uint64_t dueAt)
+        {
+            if (this->IsScheduled(handle)) this->Cancel(handle);
+
+            if (dueAt <= this->Now) dueAt = this->Now + 1;
+            if (dueAt - this->Now >= HORIZON) dueAt = this->Now + HORIZON - 1;
+
+            this->DueAt[handle] = dueAt;
+            this->Link(handle);
+        }
+
+        void Cancel(const std::size_t handle)
+        {
+            if (!this->IsScheduled(handle)) return;
+
+            const std::uint16_t prev = this->Prev[handle];
+            const std::uint16_t next = this->Next[handle];
+
+            if (prev != NONE) this->Next[prev] = next;
+            else this->Heads[this->Places[handle]] = next;
+            if (next != NONE) this->Prev[next] = prev;
+
+            this->Places[handle] = UNSCHEDULED;
+            --this->Count;
+        }
+
+        [[nodiscard]] bool IsScheduled(const std::size_t handle) const
+        {
+            return this->Places[handle] != UNSCHEDULED;
+        }
+
+        // Calls onDue with each handle that comes due on the way, unscheduled first so it may schedule it again
+        template <typename OnDue>
+        void Advance(const std::uint64_t tick, OnDue&& onDue)
+        {
+            // Nothing to step through while idle, however long for
+            if (this->Count == 0)
+            {
+                this->Now = tick;
+                return;
+            }
+
+            // Past the horizon, everything is due, whichever way round
+            if (tick - this->Now >= HORIZON)
+            {
+                for (std::size_t handle = 0; handle < Capacity; ++handle)
+                {
+                    if (!this->IsScheduled(handle)) continue;
+
+                    this->Cancel(handle);
+                    onDue(handle);
+                }
+                this->Now = tick;
+                return;
+            }
+
+            while (this->Now < tick)
+            {
+                if (this->Count == 0)
+                {
+                    this->Now = tick;
+                    return;
+                }
+
+                ++this->Now;
+
+                // Coarser slots coming up drop their timers a level, from the top so they fall all the way
+                for (std::size_t level = LEVELS - 1; level > 0; --level)
+                {
+                    const std::uint32_t shift = SLOT_BITS * static_cast<std::uint32_t>(level);
+                    if ((this->Now & ((std::uint64_t(1) << shift) - 1)) != 0) continue;
+
+                    const std::size_t place = level * SLOTS + ((this->Now >> shift) & (SLOTS - 1));
+                    while (this->Heads[place] != NONE)
+                    {
+                        const std::uint16_t handle = this->Heads[place];
+                        this->Cancel(handle);
+                        this->Link(handle);
+                    }
+                }
+
+                const std::size_t place = this->Now & (SLOTS - 1);
+                while (this->Heads[place] != NONE)
+                {
+                    const std::uint16_t handle = this->Heads[place];
+                    this->Cancel(handle);
+                    onDue(static_cast<std::size_t>(handle));
+                }
+            }
+        }
+
+        void Clear()
+        {
+            this->Heads.fill(NONE);
+            this->Places.fill(UNSCHEDULED);
+            this->Count = 0;
+        }
+
+    private:
+        static constexpr std::uint16_t NONE        = 0xFFFF;
+        static constexpr std::uint16_t UNSCHEDULED = 0xFFFF;
+
+        // Onto the coarsest level whose slots it doesn't fit within yet
+        void Link(const std::size_t handle)
+        {
+            const std::uint64_t dueAt = this->DueAt[handle];
+            const std::uint64_t delta = dueAt - this->Now;
+
+            std::size_t level = 0;
+            while (level + 1 < LEVELS && delta >= (std::uint64_t(1) << (SLOT_BITS * (level + 1)))) ++level;
+
+            const auto place = static_cast<std::uint16_t>(
+                level * SLOTS + ((dueAt >> (SLOT_BITS * level)) & (SLOTS - 1)));
+
+            this->Prev[handle]   = NONE;
+            this->Next[handle]   = this->Heads[place];
+            this->Places[handle] = place;
+            if (this->Next[handle] != NONE) this->Prev[this->Next[handle]] = static_cast<std::uint16_t>(handle);
+            this->Heads[place] = static_cast<std::uint16_t>(handle);
+            ++this->Count;
+        }
+
+        std::array<std::uint16_t, LEVELS * SLOTS> Heads;
+        std::array<std::uint64_t, Capacity>       DueAt{};
+        std::array<std::uint16_t, Capacity>       Prev{};
+        std::array<std::uint16_t, Capacity>       Next{};
+        std::array<std::uint16_t, Capacity>       Places; // Which level's slot, or UNSCHEDULED
+        std::size_t                               Count = 0; // Scheduled
+        std::uint64_t                             Now   = 0;
+    };
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <windows.h>
 
@@ -17,6 +18,7 @@ namespace Utils
         constexpr float RL_ANGLE90       = RL_ANGLE180 / 2.0f;
         constexpr float MAP_WIDTH        = 8192.0f;
         constexpr float MAP_HEIGHT       = 10240.0f;
+        constexpr float MAP_CEILING      = 2044.0f;
         constexpr float MAP_ASPECT_RATIO = MAP_WIDTH / MAP_HEIGHT;
     }
 
@@ -59,67 +61,81 @@ namespace Utils
         return strTo;
     }
 
-    inline float ComputeVolumeMultiplier(float speed)
+    // How fast the two closed in along the normal; a glancing touch is soft however fast both were going
+    inline float ComputeImpactSpeed(const Vector& relativeVelocity, const Vector& normal)
     {
-        // === Tweakable Parameters ===
-        const float minSpeed    = 100.0f;
-        const float midStart    = 800.0f;
-        const float midEnd      = 2500.0f;
-        const float maxSpeed    = 6000.0f;
-
-        const float minVolume   = 0.0f;
-        const float midVolume   = 0.25f;
-        const float highVolume  = 0.85f;
-        const float maxVolume   = 1.2f;
-
-        float volume = 0.0f;
-
-        if (speed < minSpeed) return 0.0f;
-
-        if (speed <= midStart) {
-            // Ease-in: from minVolume to midVolume
-            float t = (speed - minSpeed) / (midStart - minSpeed);
-            float eased = std::pow(t, 2.0f); // ease-in quad
-            volume = minVolume + eased * (midVolume - minVolume);
-        }
-        else if (speed <= midEnd) {
-            // Linear region: from midVolume to highVolume
-            float t = (speed - midStart) / (midEnd - midStart);
-            volume = midVolume + t * (highVolume - midVolume);
+        const float length = std::sqrt(normal.X * normal.X + normal.Y * normal.Y + normal.Z * normal.Z);
+        if (length <= 0.0f) return relativeVelocity.magnitude();
+
+        const float along = relativeVelocity.X * normal.X + relativeVelocity.Y * normal.Y + relativeVelocity.Z * normal.Z;
+        return std::abs(along) / length;
+    }
+
+    /*
+     * xoshiro128+: a handful of adds, shifts and xors per number. Seeding
+     * a std::mt19937 from std::random_device costs a system call and
+     * kilobytes of state, far too much to do for every sound played.
+     */
+    class FastRandom
+    {
+    public:
+        explicit FastRandom(std::uint64_t seed)
+        {
+            // Spread the seed over all of the state with splitmix64, as the authors suggest
+            for (std::uint32_t& word : this->State)
+            {
+                seed += 0x9E3779B97F4A7C15ull;
+                std::uint64_t z = seed;
+                z    = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z    = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                word = static_cast<std::uint32_t>(z ^ (z >> 31));
+            }
         }
-        else {
-            // Ease-out: from highVolume to maxVolume
-            float t = (speed - midEnd) / (maxSpeed - midEnd);
-            float eased = 1.0f - std::pow(1.0f - t, 2.0f); // ease-out quad
-            volume = highVolume + eased * (maxVolume - highVolume);
+
+        std::uint32_t Next()
+        {
+            const std::uint32_t result = this->State[0] + this->State[3];
+            const std::uint32_t t      = this->State[1] << 9;
+
+            this->State[2] ^= this->State[0];
+            this->State[3] ^= this->State[1];
+            this->State[1] ^= this->State[2];
+            this->State[0] ^= this->State[3];
+            this->State[2] ^= t;
+            this->State[3] = (this->State[3] << 11) | (this->State[3] >> 21);
+
+            return result;
         }
 
-        if (volume > maxVolume)
-            volume = maxVolume;
+        // In [min, max), from the top 24 bits, which are the best ones
+        float Uniform(const float min, const float max)
+        {
+            const float unit = static_cast<float>(this->Next() >> 8) * (1.0f / 16777216.0f);
+            return min + unit * (max - min);
+        }
 
-        if (volume < minVolume)
-            volume = minVolume;
+    private:
+        std::uint32_t State[4];
+    };
 
-        return std::clamp(volume, minVolume, maxVolume);
+    // Seeded once per thread, on first use
+    inline FastRandom& GetRandom()
+    {
+        thread_local FastRandom random(
+            static_cast<std::uint64_t>(std::random_device{}()) << 32 | std::random_device{}());
+        return random;
     }
 
     inline float GetRandomFloat(const float min, const float max)
     {
-        std::mt19937                          gen(std::random_device{}());
-        std::uniform_real_distribution<float> dist(min, max);
-
-        return dist(gen);
+        return GetRandom().Uniform(min, max);
     }
 
     inline Vector GetRandomVector(const float xMax, const float yMax)
     {
-        std::mt19937                          gen(std::random_device{}());
-        std::uniform_real_distribution<float> distX(-xMax, xMax);
-        std::uniform_real_distribution<float> distY(-yMax, yMax);
-
         Vector vector;
-        vector.X = distX(gen);
-        vector.Y = distY(gen);
+        vector.X = GetRandomFloat(-xMax, xMax);
+        vector.Y = GetRandomFloat(-yMax, yMax);
         vector.Z = 20.0f;
 
         return vector;
@@ -127,10 +143,7 @@ namespace Utils
 
     inline Vector GetRandomVector(const float distance)
     {
-        std::mt19937                          gen(std::random_device{}());
-        std::uniform_real_distribution<float> distYaw(-RlAngle180 + 1, RlAngle180);
-
-        const int yaw = static_cast<int>(distYaw(gen) + 0.5f);
+        const int yaw = static_cast<int>(GetRandomFloat(-RlAngle180 + 1, RlAngle180) + 0.5f);
 
         const auto rotation = Rotator(0, yaw, 0);
         Vector     vector   = RotatorToVector(rotation);
@@ -48,5 +48,13 @@ extern std::shared_ptr<GameWrapper>        globalGameWrapper;	  // Game wrapper
 #define SET_EVENT_SOUND_NOTIFIER_PARTIAL  "eventsfx_set_sound_"
 #define SET_EVENT_VOLUME_NOTIFIER_PARTIAL "eventsfx_set_volume_"
 #define SET_EVENT_DELAY_NOTIFIER_PARTIAL  "eventsfx_set_delay_"
+#define SET_EVENT_SEND_NOTIFIER_PARTIAL   "eventsfx_set_send_"
+#define SET_EVENT_CURVE_NOTIFIER_PARTIAL  "eventsfx_set_distance_"
+#define SET_EVENT_LIMIT_NOTIFIER_PARTIAL  "eventsfx_set_limit_"
+#define SET_EVENT_COOLDOWN_NOTIFIER_PARTIAL "eventsfx_set_cooldown_"
+#define SET_EVENT_PICK_NOTIFIER_PARTIAL   "eventsfx_set_selection_"
 #define SAVE_SETTINGS_NOTIFIER            "eventsfx_save_settings"
 #define LOAD_SETTINGS_NOTIFIER            "eventsfx_load_settings"
+#define BENCHMARK_NOTIFIER                "eventsfx_bench"
+#define STATS_NOTIFIER                    "eventsfx_stats"
+#define RECORD_NOTIFIER                   "eventsfx_record"